@@ -40,6 +40,23 @@ namespace DOpE
       return dirichlet_colors_;
     }
 
+    /**
+     * Returns the colors together with their component masks. Unlike this
+     * descriptor, which only references the data of the problem, the key
+     * can be stored to check later on whether constraints built from the
+     * descriptor are still valid.
+     */
+    std::vector<std::pair<unsigned int, std::vector<bool> > >
+    GetKey() const
+    {
+      std::vector<std::pair<unsigned int, std::vector<bool> > > key;
+      for (unsigned int i = 0; i < dirichlet_colors_.size(); ++i)
+        {
+          key.push_back(std::make_pair(dirichlet_colors_[i], dirichlet_comps_[i]));
+        }
+      return key;
+    }
+
   private:
     const std::vector<unsigned int> &dirichlet_colors_;
     const std::vector<std::vector<bool> > &dirichlet_comps_;
@@ -86,10 +86,15 @@ namespace DOpE
      * for Differential Equations
      *
      * for the explanation of the different states.
+     *
+     * patch_interpolation  The weights I_2h z_h - z_h are computed by interpolation
+     *                      on the patches of a once refined mesh into the finite
+     *                      element of twice the degree, see PatchInterpolationDWRContainer.
      */
     enum WeightComputation
     {
-      element_diameter, higher_order_interpolation, higher_order_computation, constant/*Not implemented!*/
+      element_diameter, higher_order_interpolation, higher_order_computation, constant/*Not implemented!*/,
+      patch_interpolation
     };
 
     /**
@@ -152,6 +157,47 @@ namespace DOpE
       local_constraint
     };
 
+    /**
+     * An enum that describes which part of a time step is
+     * assembled by the time stepping schemes in tsschemes/.
+     *
+     * new_part                   Terms at the new time point (one step schemes)
+     * old_part                   Terms at the old time point (one step schemes)
+     * new_for_1st_and_3rd_cycle  Terms at the new time point in the first and
+     *                            third substep of the fractional step theta scheme
+     * old_for_1st_cycle          Terms at the old time point of the first substep
+     * new_for_2nd_cycle          Terms at the new time point of the second substep
+     * old_for_2nd_cycle          Terms at the old time point of the second substep
+     * old_for_3rd_cycle          Terms at the old time point of the third substep
+     */
+    enum StepPart
+    {
+      new_part,
+      old_part,
+      new_for_1st_and_3rd_cycle,
+      old_for_1st_cycle,
+      new_for_2nd_cycle,
+      old_for_2nd_cycle,
+      old_for_3rd_cycle
+    };
+
+    /**
+     * An enum that describes which terms of the matrix of a time step
+     * are assembled by the time stepping schemes in tsschemes/,
+     * see PDEInterface::HasConstantTimeMatrix.
+     *
+     * all_terms                  The complete matrix of the step part
+     * without_time_matrix        All terms except the ElementTimeMatrix
+     * time_matrix_only           Only the ElementTimeMatrix, without the
+     *                            weight of the step part
+     */
+    enum MatrixPart
+    {
+      all_terms,
+      without_time_matrix,
+      time_matrix_only
+    };
+
   }//End of namespace DOpEtypes
 
 
@@ -257,6 +303,37 @@ namespace DOpE
       }
   }
 
+  template <>
+  inline std::string
+  DOpEtypesToString (const DOpEtypes::StepPart &t)
+  {
+    switch (t)
+      {
+      case DOpEtypes::StepPart::new_part:
+        return "New";
+      case DOpEtypes::StepPart::old_part:
+        return "Old";
+      case DOpEtypes::StepPart::new_for_1st_and_3rd_cycle:
+        return "New_for_1st_and_3rd_cycle";
+      case DOpEtypes::StepPart::old_for_1st_cycle:
+        return "Old_for_1st_cycle";
+      case DOpEtypes::StepPart::new_for_2nd_cycle:
+        return "New_for_2nd_cycle";
+      case DOpEtypes::StepPart::old_for_2nd_cycle:
+        return "Old_for_2nd_cycle";
+      case DOpEtypes::StepPart::old_for_3rd_cycle:
+        return "Old_for_3rd_cycle";
+      default:
+      {
+        std::stringstream out;
+        out << "Unknown DOpEtypes::StepPart" << std::endl;
+        out << "Code given is " << t << std::endl;
+        throw DOpEException (out.str (),
+                             "DOpEtypesToString<DOpEtypes::StepPart>");
+      }
+      }
+  }
+
 }//End of Namespace DOpE
 
 #endif /* DOPETYPES_H_ */
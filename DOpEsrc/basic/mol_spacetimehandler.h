@@ -252,6 +252,28 @@ namespace DOpE
            const std::vector<unsigned int> &state_block_component,
            const DirichletDescriptor &DD_state) override
     {
+      if (this->IsShared())
+        {
+          //The discretization has been initialized by a previous problem,
+          //only the constraints depend on its Dirichlet data.
+          if (control_n_blocks != control_dofs_per_block_.size()
+              || state_n_blocks != state_dofs_per_block_.size())
+            {
+              throw DOpEException("The shared discretization has been initialized differently",
+                                  "MethodOfLines_SpaceTimeHandler::ReInit");
+            }
+#if dope_dimension > 0
+          if (dopedim == dealdim && DD_control.GetKey() != control_dirichlet_key_)
+            {
+              MakeControlDoFConstraints(DD_control);
+            }
+#endif
+          if (DD_state.GetKey() != state_dirichlet_key_)
+            {
+              MakeStateDoFConstraints(DD_state);
+            }
+          return;
+        }
 
 #if dope_dimension > 0
       SpaceTimeHandler<FE, DH, SPARSITYPATTERN, VECTOR, dopedim, dealdim>::SetActiveFEIndicesControl(control_dof_handler_);
@@ -276,37 +298,8 @@ namespace DOpE
 #endif
             control_hn_constraints_);
 
-          control_dof_constraints_.clear ();
-          control_dof_constraints_.reinit(this->GetLocallyRelevantDoFs(DOpEtypes::VectorType::control));
-          DoFTools::make_hanging_node_constraints (
-#if DEAL_II_VERSION_GTE(9,3,0)
-            static_cast<dealii::DoFHandler<dopedim, dopedim>&>(control_dof_handler_),
-#else
-            static_cast<DH<dopedim, dopedim>&>(control_dof_handler_),
-#endif
-            control_dof_constraints_);
-          if (GetUserDefinedDoFConstraints() != NULL)
-            GetUserDefinedDoFConstraints()->MakeControlDoFConstraints(control_dof_handler_,
-                                                                      control_dof_constraints_);
-
-          std::vector<unsigned int> dirichlet_colors = DD_control.GetDirichletColors();
-          for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
-            {
-              unsigned int color = dirichlet_colors[i];
-              std::vector<bool> comp_mask = DD_control.GetDirichletCompMask(color);
-
-              //TODO: mapping[0] is a workaround, as deal does not support interpolate
-              // boundary_values with a mapping collection at this point.
-#if DEAL_II_VERSION_GTE(9,0,0)
-              dealii::VectorTools::interpolate_boundary_values(GetMapping()[0], control_dof_handler_.GetDEALDoFHandler(), color, dealii::Functions::ZeroFunction<dopedim>(comp_mask.size()),
-                                                               control_dof_constraints_, comp_mask);
-#else
-              dealii::VectorTools::interpolate_boundary_values(GetMapping()[0], control_dof_handler_.GetDEALDoFHandler(), color, dealii::ZeroFunction<dopedim>(comp_mask.size()),
-                                                               control_dof_constraints_, comp_mask);
-#endif
-            }
           control_hn_constraints_.close ();
-          control_dof_constraints_.close ();
+          MakeControlDoFConstraints(DD_control);
         }
       else
         {
@@ -364,40 +357,8 @@ namespace DOpE
 #endif
         state_hn_constraints_);
 
-      state_dof_constraints_.clear();
-      state_dof_constraints_.reinit (
-        this->GetLocallyRelevantDoFs (DOpEtypes::VectorType::state));
-      DoFTools::make_hanging_node_constraints(
-#if DEAL_II_VERSION_GTE(9,3,0)
-        static_cast<dealii::DoFHandler<dealdim, dealdim>&>(state_dof_handler_),
-#else
-        static_cast<DH<dealdim, dealdim>&>(state_dof_handler_),
-#endif
-        state_dof_constraints_);
-      //TODO Dirichlet ueber Constraints
-      if (GetUserDefinedDoFConstraints() != NULL)
-        GetUserDefinedDoFConstraints()->MakeStateDoFConstraints(
-          state_dof_handler_, state_dof_constraints_);
-
-
-      std::vector<unsigned int> dirichlet_colors = DD_state.GetDirichletColors();
-      for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
-        {
-          unsigned int color = dirichlet_colors[i];
-          std::vector<bool> comp_mask = DD_state.GetDirichletCompMask(color);
-
-          //TODO: mapping[0] is a workaround, as deal does not support interpolate
-          // boundary_values with a mapping collection at this point.
-#if DEAL_II_VERSION_GTE(9,0,0)
-          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::Functions::ZeroFunction<dealdim>(comp_mask.size()),
-                                                   state_dof_constraints_, comp_mask);
-#else
-          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::ZeroFunction<dealdim>(comp_mask.size()),
-                                                   state_dof_constraints_, comp_mask);
-#endif
-        }
       state_hn_constraints_.close();
-      state_dof_constraints_.close();
+      MakeStateDoFConstraints(DD_state);
 
       state_dofs_per_block_.resize(state_n_blocks);
 #if DEAL_II_VERSION_GTE(9,2,0)
@@ -687,14 +648,26 @@ namespace DOpE
     /******************************************************/
     /**
      * Computes the SparsityPattern for the stiffness matrix
-     * of the PDE.
+     * of the PDE. While the discretization is shared, the pattern is
+     * computed only once and copied for the following problems. It is
+     * kept until the constraints change.
      */
     void
     ComputeStateSparsityPattern(SPARSITYPATTERN &sparsity, unsigned int /*time_point*/= std::numeric_limits<unsigned int>::max()) const override
     {
+      if (this->IsShared() && shared_state_sparsity_valid_)
+        {
+          DOpEHelper::copy_sparsity_pattern(sparsity, shared_state_sparsity_);
+          return;
+        }
       this->GetSparsityMaker()->ComputeSparsityPattern(
         this->GetStateDoFHandler(), sparsity,
         this->GetStateDoFConstraints(), this->GetStateDoFsPerBlock());
+      if (this->IsShared())
+        {
+          DOpEHelper::copy_sparsity_pattern(shared_state_sparsity_, sparsity);
+          shared_state_sparsity_valid_ = true;
+        }
     }
 
     /******************************************************/
@@ -777,6 +750,11 @@ namespace DOpE
 
       //make sure that we do not use any coarsening
       assert(!ref_container.UsesCoarsening());
+      if (this->IsShared())
+        {
+          throw DOpEException("The discretization is shared and may not be refined",
+                              "MethodOfLines_SpaceTimeHandler::RefineSpace");
+        }
 
       if (control_mesh_transfer_ != NULL)
         {
@@ -945,6 +923,95 @@ namespace DOpE
     ResetTriangulation(const dealii::Triangulation<dealdim> &tria);
 
   private:
+#if dope_dimension > 0
+    /**
+     * Builds the constraints of the control DoFs given the Dirichlet data
+     * DD_control, see MakeStateDoFConstraints.
+     */
+    void
+    MakeControlDoFConstraints(const DirichletDescriptor &DD_control)
+    {
+      control_dof_constraints_.clear ();
+      control_dof_constraints_.reinit(this->GetLocallyRelevantDoFs(DOpEtypes::VectorType::control));
+      DoFTools::make_hanging_node_constraints (
+#if DEAL_II_VERSION_GTE(9,3,0)
+        static_cast<dealii::DoFHandler<dopedim, dopedim>&>(control_dof_handler_),
+#else
+        static_cast<DH<dopedim, dopedim>&>(control_dof_handler_),
+#endif
+        control_dof_constraints_);
+      if (GetUserDefinedDoFConstraints() != NULL)
+        GetUserDefinedDoFConstraints()->MakeControlDoFConstraints(control_dof_handler_,
+                                                                  control_dof_constraints_);
+
+      std::vector<unsigned int> dirichlet_colors = DD_control.GetDirichletColors();
+      for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
+        {
+          unsigned int color = dirichlet_colors[i];
+          std::vector<bool> comp_mask = DD_control.GetDirichletCompMask(color);
+
+          //TODO: mapping[0] is a workaround, as deal does not support interpolate
+          // boundary_values with a mapping collection at this point.
+#if DEAL_II_VERSION_GTE(9,0,0)
+          dealii::VectorTools::interpolate_boundary_values(GetMapping()[0], control_dof_handler_.GetDEALDoFHandler(), color, dealii::Functions::ZeroFunction<dopedim>(comp_mask.size()),
+                                                           control_dof_constraints_, comp_mask);
+#else
+          dealii::VectorTools::interpolate_boundary_values(GetMapping()[0], control_dof_handler_.GetDEALDoFHandler(), color, dealii::ZeroFunction<dopedim>(comp_mask.size()),
+                                                           control_dof_constraints_, comp_mask);
+#endif
+        }
+      control_dof_constraints_.close ();
+      control_dirichlet_key_ = DD_control.GetKey();
+    }
+#endif
+
+    /**
+     * Builds the constraints of the state DoFs, i.e., the hanging node
+     * constraints, the user defined constraints and the Dirichlet
+     * constraints given by DD_state. The key of DD_state is kept to detect
+     * whether a later problem on the shared discretization needs other
+     * constraints.
+     */
+    void
+    MakeStateDoFConstraints(const DirichletDescriptor &DD_state)
+    {
+      state_dof_constraints_.clear();
+      state_dof_constraints_.reinit (
+        this->GetLocallyRelevantDoFs (DOpEtypes::VectorType::state));
+      DoFTools::make_hanging_node_constraints(
+#if DEAL_II_VERSION_GTE(9,3,0)
+        static_cast<dealii::DoFHandler<dealdim, dealdim>&>(state_dof_handler_),
+#else
+        static_cast<DH<dealdim, dealdim>&>(state_dof_handler_),
+#endif
+        state_dof_constraints_);
+      //TODO Dirichlet ueber Constraints
+      if (GetUserDefinedDoFConstraints() != NULL)
+        GetUserDefinedDoFConstraints()->MakeStateDoFConstraints(
+          state_dof_handler_, state_dof_constraints_);
+
+      std::vector<unsigned int> dirichlet_colors = DD_state.GetDirichletColors();
+      for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
+        {
+          unsigned int color = dirichlet_colors[i];
+          std::vector<bool> comp_mask = DD_state.GetDirichletCompMask(color);
+
+          //TODO: mapping[0] is a workaround, as deal does not support interpolate
+          // boundary_values with a mapping collection at this point.
+#if DEAL_II_VERSION_GTE(9,0,0)
+          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::Functions::ZeroFunction<dealdim>(comp_mask.size()),
+                                                   state_dof_constraints_, comp_mask);
+#else
+          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::ZeroFunction<dealdim>(comp_mask.size()),
+                                                   state_dof_constraints_, comp_mask);
+#endif
+        }
+      state_dof_constraints_.close();
+      state_dirichlet_key_ = DD_state.GetKey();
+      //The sparsity pattern depends on the constraints
+      shared_state_sparsity_valid_ = false;
+    }
+
 #if DEAL_II_VERSION_GTE(9,3,0)
     const SparsityMaker<dealdim> *
 #else
@@ -1014,6 +1081,11 @@ namespace DOpE
 
     std::vector<unsigned int> n_neighbour_to_vertex_;
 
+    //The Dirichlet data the constraints have been built for
+    std::vector<std::pair<unsigned int, std::vector<bool> > > control_dirichlet_key_, state_dirichlet_key_;
+    //The sparsity pattern kept while the discretization is shared
+    mutable SPARSITYPATTERN shared_state_sparsity_;
+    mutable bool shared_state_sparsity_valid_ = false;
   };
 
   /**************************explicit instantiation*************/
@@ -1146,6 +1218,32 @@ namespace DOpE
                                  dealii::Vector<double>, dope_dimension, deal_II_dimension>::ResetTriangulation(
                                    const dealii::Triangulation<deal_II_dimension> &tria);
 
+#endif
+
+  /**************************extern template*************/
+
+  /**
+   * The following instantiations are compiled into the library, see
+   * source/mol_spacetimehandler.cc.
+   */
+#if DEAL_II_VERSION_GTE(9,3,0)
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::FESystem, false,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, dope_dimension, deal_II_dimension>;
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::FESystem, false,
+                          dealii::SparsityPattern, dealii::Vector<double>, dope_dimension, deal_II_dimension>;
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::hp::FECollection, true,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, dope_dimension, deal_II_dimension>;
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::hp::FECollection, true,
+                          dealii::SparsityPattern, dealii::Vector<double>, dope_dimension, deal_II_dimension>;
+#else
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::FESystem, dealii::DoFHandler,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, dope_dimension, deal_II_dimension>;
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::FESystem, dealii::DoFHandler,
+                          dealii::SparsityPattern, dealii::Vector<double>, dope_dimension, deal_II_dimension>;
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::hp::FECollection, dealii::hp::DoFHandler,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, dope_dimension, deal_II_dimension>;
+  extern template class MethodOfLines_SpaceTimeHandler<dealii::hp::FECollection, dealii::hp::DoFHandler,
+                          dealii::SparsityPattern, dealii::Vector<double>, dope_dimension, deal_II_dimension>;
 #endif
 }
 
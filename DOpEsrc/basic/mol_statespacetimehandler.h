@@ -170,6 +170,21 @@ namespace DOpE
            const std::vector<unsigned int> &state_block_component,
            const DirichletDescriptor &DD  ) override
     {
+      if (this->IsShared())
+        {
+          //The discretization has been initialized by a previous problem,
+          //only the constraints depend on its Dirichlet data.
+          if (state_n_blocks != state_dofs_per_block_.size())
+            {
+              throw DOpEException("The shared discretization has been initialized differently",
+                                  "MethodOfLines_StateSpaceTimeHandler::ReInit");
+            }
+          if (DD.GetKey() != state_dirichlet_key_)
+            {
+              MakeStateDoFConstraints(DD);
+            }
+          return;
+        }
       StateSpaceTimeHandler<FE, DH, SPARSITYPATTERN, VECTOR, dealdim>::SetActiveFEIndicesState(
         state_dof_handler_);
       state_dof_handler_.distribute_dofs(GetFESystem("state"));
@@ -193,39 +208,8 @@ namespace DOpE
 #endif
         state_hn_constraints_);
 
-      state_dof_constraints_.clear();
-      state_dof_constraints_.reinit (
-        this->GetLocallyRelevantDoFs (DOpEtypes::VectorType::state));
-      DoFTools::make_hanging_node_constraints (
-#if DEAL_II_VERSION_GTE(9,3,0)
-        static_cast<dealii::DoFHandler<dealdim, dealdim>&> (state_dof_handler_),
-#else
-        static_cast<DH<dealdim, dealdim>&> (state_dof_handler_),
-#endif
-        state_dof_constraints_);
-      //TODO Dirichlet ueber Constraints
-      if (GetUserDefinedDoFConstraints() != NULL) GetUserDefinedDoFConstraints()->MakeStateDoFConstraints(state_dof_handler_, state_dof_constraints_);
-
-
-      std::vector<unsigned int> dirichlet_colors = DD.GetDirichletColors();
-      for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
-        {
-          unsigned int color = dirichlet_colors[i];
-          std::vector<bool> comp_mask = DD.GetDirichletCompMask(color);
-
-          //TODO: mapping[0] is a workaround, as deal does not support interpolate
-          // boundary_values with a mapping collection at this point.
-#if DEAL_II_VERSION_GTE(9,0,0)
-          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::Functions::ZeroFunction<dealdim>(comp_mask.size()),
-                                                   state_dof_constraints_, comp_mask);
-#else
-          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::ZeroFunction<dealdim>(comp_mask.size()),
-                                                   state_dof_constraints_, comp_mask);
-#endif
-        }
-
       state_hn_constraints_.close();
-      state_dof_constraints_.close();
+      MakeStateDoFConstraints(DD);
       state_dofs_per_block_.resize(state_n_blocks);
 
 #if DEAL_II_VERSION_GTE(9,2,0)
@@ -369,10 +353,26 @@ namespace DOpE
     }
 
     /******************************************************/
+    /**
+     * Implementation of virtual function in StateSpaceTimeHandler.
+     * While the discretization is shared, the pattern is computed only
+     * once and copied for the following problems. It is kept until the
+     * constraints change.
+     */
     void ComputeStateSparsityPattern(SPARSITYPATTERN &sparsity,unsigned int /*time_point*/= std::numeric_limits<unsigned int>::max()) const override
     {
+      if (this->IsShared() && shared_state_sparsity_valid_)
+        {
+          DOpEHelper::copy_sparsity_pattern(sparsity, shared_state_sparsity_);
+          return;
+        }
       this->GetSparsityMaker()->ComputeSparsityPattern(this->GetStateDoFHandler(), sparsity, this->GetStateDoFConstraints(),
                                                        this->GetStateDoFsPerBlock());
+      if (this->IsShared())
+        {
+          DOpEHelper::copy_sparsity_pattern(shared_state_sparsity_, sparsity);
+          shared_state_sparsity_valid_ = true;
+        }
     }
 
     /******************************************************/
@@ -447,6 +447,11 @@ namespace DOpE
 
       //make sure that we do not use any coarsening
       assert( !ref_container.UsesCoarsening());
+      if (this->IsShared())
+        {
+          throw DOpEException("The discretization is shared and may not be refined",
+                              "MethodOfLines_StateSpaceTimeHandler::RefineSpace");
+        }
 
       if (state_mesh_transfer_ != NULL)
         {
@@ -570,6 +575,50 @@ namespace DOpE
     }
 
   private:
+    /**
+     * Builds the constraints of the state DoFs, i.e., the hanging node
+     * constraints, the user defined constraints and the Dirichlet
+     * constraints given by DD. The key of DD is kept to detect whether
+     * a later problem on the shared discretization needs other constraints.
+     */
+    void
+    MakeStateDoFConstraints(const DirichletDescriptor &DD)
+    {
+      state_dof_constraints_.clear();
+      state_dof_constraints_.reinit (
+        this->GetLocallyRelevantDoFs (DOpEtypes::VectorType::state));
+      DoFTools::make_hanging_node_constraints (
+#if DEAL_II_VERSION_GTE(9,3,0)
+        static_cast<dealii::DoFHandler<dealdim, dealdim>&> (state_dof_handler_),
+#else
+        static_cast<DH<dealdim, dealdim>&> (state_dof_handler_),
+#endif
+        state_dof_constraints_);
+      //TODO Dirichlet ueber Constraints
+      if (GetUserDefinedDoFConstraints() != NULL) GetUserDefinedDoFConstraints()->MakeStateDoFConstraints(state_dof_handler_, state_dof_constraints_);
+
+      std::vector<unsigned int> dirichlet_colors = DD.GetDirichletColors();
+      for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
+        {
+          unsigned int color = dirichlet_colors[i];
+          std::vector<bool> comp_mask = DD.GetDirichletCompMask(color);
+
+          //TODO: mapping[0] is a workaround, as deal does not support interpolate
+          // boundary_values with a mapping collection at this point.
+#if DEAL_II_VERSION_GTE(9,0,0)
+          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::Functions::ZeroFunction<dealdim>(comp_mask.size()),
+                                                   state_dof_constraints_, comp_mask);
+#else
+          VectorTools::interpolate_boundary_values(GetMapping()[0], state_dof_handler_.GetDEALDoFHandler(), color, dealii::ZeroFunction<dealdim>(comp_mask.size()),
+                                                   state_dof_constraints_, comp_mask);
+#endif
+        }
+      state_dof_constraints_.close();
+      state_dirichlet_key_ = DD.GetKey();
+      //The sparsity pattern depends on the constraints
+      shared_state_sparsity_valid_ = false;
+    }
+
 #if DEAL_II_VERSION_GTE(9,3,0)
     const SparsityMaker<dealdim> *
 #else
@@ -620,7 +669,37 @@ namespace DOpE
 
     std::vector<unsigned int> n_neighbour_to_vertex_;
 
+    //The Dirichlet data the constraints have been built for
+    std::vector<std::pair<unsigned int, std::vector<bool> > > state_dirichlet_key_;
+    //The sparsity pattern kept while the discretization is shared
+    mutable SPARSITYPATTERN shared_state_sparsity_;
+    mutable bool shared_state_sparsity_valid_ = false;
   };
 
+  /**************************extern template*************/
+
+  /**
+   * The following instantiations are compiled into the library, see
+   * source/mol_statespacetimehandler.cc.
+   */
+#if DEAL_II_VERSION_GTE(9,3,0)
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, false,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, false,
+                          dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, true,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, true,
+                          dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+#else
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, dealii::DoFHandler,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, dealii::DoFHandler,
+                          dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, dealii::hp::DoFHandler,
+                          dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+  extern template class MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, dealii::hp::DoFHandler,
+                          dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+#endif
 }
 #endif
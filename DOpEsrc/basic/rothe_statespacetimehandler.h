@@ -517,6 +517,38 @@ namespace DOpE
       abort();
     }
 
+    /******************************************************/
+    /**
+     * Not available, since the time_to_dofhandler_ vector can not
+     * be updated after temporal refinement.
+     */
+    void
+    RefineTimeInterval(const TimeIterator &/*interval*/) override
+    {
+      throw DOpEException("Temporal refinement is not implemented for the Rothe method.",
+                          "Rothe_StateSpaceTimeHandler::RefineTimeInterval");
+    }
+
+    /**
+     * Not available, see RefineTimeInterval.
+     */
+    bool
+    MergeTimeIntervals(const TimeIterator &/*interval*/) override
+    {
+      throw DOpEException("Temporal coarsening is not implemented for the Rothe method.",
+                          "Rothe_StateSpaceTimeHandler::MergeTimeIntervals");
+    }
+
+    /**
+     * Not available, see RefineTimeInterval.
+     */
+    void
+    RefineTimeToLevel(unsigned int /*level*/) override
+    {
+      throw DOpEException("Temporal refinement is not implemented for the Rothe method.",
+                          "Rothe_StateSpaceTimeHandler::RefineTimeToLevel");
+    }
+
     /******************************************************/
     /**
      * This Function is used to refine the spatial mesh globally.
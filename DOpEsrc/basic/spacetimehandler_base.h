@@ -93,6 +93,24 @@ namespace DOpE
       return MPI_COMM_WORLD; // TODO user provided
     }
 
+    /**
+     * Marks the discretization as shared by several problems which are
+     * solved one after another, see BatchDriver. While it is shared, ReInit
+     * keeps the present discretization, which hence needs to be
+     * initialized before, and refinement is not allowed. Only the
+     * constraints are rebuilt if the Dirichlet data differ from those
+     * of the previous problem.
+     */
+    void SetShared(bool shared)
+    {
+      shared_ = shared;
+    }
+
+    bool IsShared() const
+    {
+      return shared_;
+    }
+
     /**
      * This function has to get called after temporal refinement.
      */
@@ -587,6 +605,11 @@ namespace DOpE
       //make sure that we do not use any coarsening
       assert(!ref_container.UsesCoarsening());
       assert(time_triangulation_ != NULL);
+      if (shared_)
+        {
+          throw DOpEException("The discretization is shared and may not be refined",
+                              "SpaceTimeHandlerBase::RefineTime");
+        }
 
       if (DOpEtypes::RefinementType::global == ref_type)
         {
@@ -603,6 +626,114 @@ namespace DOpE
       ReInitTime();
     }
 
+    /******************************************************/
+    /**
+     * This Function bisects a single interval of the temporal mesh.
+     * Since the time DoFs are numbered downstream, all time points
+     * left of the given interval keep their numbers, unless the
+     * mesh smoothing of the time triangulation refines a neighbor
+     * as well. Hence callers need to compare the time points
+     * before and after the refinement.
+     * After calling a refinement function a reinitialization is required!
+     *
+     * @param interval        The interval to be bisected.
+     */
+    virtual void
+    RefineTimeInterval(const TimeIterator &interval)
+    {
+      assert(time_triangulation_ != NULL);
+      if (shared_)
+        {
+          throw DOpEException("The discretization is shared and may not be refined",
+                              "SpaceTimeHandlerBase::RefineTimeInterval");
+        }
+
+      interval.getelement_()->set_refine_flag();
+      time_triangulation_->prepare_coarsening_and_refinement();
+      time_triangulation_->execute_coarsening_and_refinement();
+      ReInitTime();
+    }
+
+    /******************************************************/
+    /**
+     * This Function merges the given interval with the following one
+     * if both are the two children of the same interval of the temporal mesh.
+     * All time points left of the given interval keep their numbers.
+     * After calling a refinement function a reinitialization is required!
+     *
+     * @param interval        The first of the two intervals to be merged.
+     *
+     * @return                True if the intervals have been merged.
+     */
+    virtual bool
+    MergeTimeIntervals(const TimeIterator &interval)
+    {
+      assert(time_triangulation_ != NULL);
+      if (shared_)
+        {
+          throw DOpEException("The discretization is shared and may not be coarsened",
+                              "SpaceTimeHandlerBase::MergeTimeIntervals");
+        }
+      const auto &element = interval.getelement_();
+      if (element->level() == 0)
+        return false;
+      const auto parent = element->parent();
+      if (parent->child(0)->index() != element->index()
+          || parent->child(1)->has_children())
+        return false;
+
+      const unsigned int n_intervals = GetNbrOfIntervals();
+      parent->child(0)->set_coarsen_flag();
+      parent->child(1)->set_coarsen_flag();
+      time_triangulation_->prepare_coarsening_and_refinement();
+      time_triangulation_->execute_coarsening_and_refinement();
+      if (GetNbrOfIntervals() == n_intervals)
+        return false;
+      ReInitTime();
+      return true;
+    }
+
+    /******************************************************/
+    /**
+     * This Function refines all intervals of the temporal mesh whose
+     * level is less than the given one. Intervals which are already
+     * fine enough are not changed, hence calling it repeatedly does not
+     * change the temporal mesh.
+     * After calling a refinement function a reinitialization is required!
+     *
+     * @param level           The minimal level of the intervals.
+     */
+    virtual void
+    RefineTimeToLevel(unsigned int level)
+    {
+      assert(time_triangulation_ != NULL);
+      bool refined = true;
+      while (refined)
+        {
+          refined = false;
+          for (auto element = time_triangulation_->begin_active();
+               element != time_triangulation_->end(); ++element)
+            {
+              if (static_cast<unsigned int>(element->level()) < level)
+                {
+                  element->set_refine_flag();
+                  refined = true;
+                }
+            }
+          if (refined)
+            {
+              if (shared_)
+                {
+                  throw DOpEException("The discretization is shared and may not be refined",
+                                      "SpaceTimeHandlerBase::RefineTimeToLevel");
+                }
+              time_triangulation_->prepare_coarsening_and_refinement();
+              time_triangulation_->execute_coarsening_and_refinement();
+              ReInitTime();
+            }
+        }
+    }
+
     /******************************************************/
     // TODO we need only the VECTOR one of those ...
     /**
@@ -750,6 +881,7 @@ namespace DOpE
     dealii::Triangulation<1> *time_triangulation_;
     unsigned int control_ticket_;
     unsigned int state_ticket_;
+    bool shared_ = false;
     mutable DOpEtypes::VectorAction control_type_;
   };
 
@@ -143,6 +143,20 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Prepares the evaluations in points on the state DoFHandler, see
+     * DOpEWrapper::DoFHandler::PointValue. The stored points are
+     * deleted if the state ticket is no longer valid, and the mapping
+     * of this SpaceTimeHandler is used.
+     */
+    void
+    PreparePointEvaluation () const
+    {
+      GetStateDoFHandler().GetPointEvaluationCache().Prepare(*this);
+    }
+
+    /******************************************************/
+
     /**
      * Returns a reference to a vector of DoFHandlers, the order of the DoFHandlers must
      * be set prior by SetDoFHandlerOrdering
@@ -25,6 +25,7 @@
 #define INSTAT_PDE_PROBLEM_CONTAINER_
 
 #include <container/pdeproblemcontainer.h>
+#include <tsschemes/backward_euler_problem.h>
 
 namespace DOpE
 {
@@ -95,7 +96,7 @@ namespace DOpE
     InstatPDEProblemContainer(PDE &pde,
                               StateSpaceTimeHandler<FE, DH, SPARSITYPATTERN, VECTOR,dealdim> &STH)
       : PDEProblemContainer<PDE,DD,SPARSITYPATTERN,VECTOR,dealdim,FE, DH>(
-          pde,STH), ts_state_problem_(NULL)
+          pde,STH), ts_state_problem_(NULL), ts_embedded_state_problem_(NULL)
     {
     }
 
@@ -105,6 +106,10 @@ namespace DOpE
         {
           delete ts_state_problem_;
         }
+      if (ts_embedded_state_problem_ != NULL)
+        {
+          delete ts_embedded_state_problem_;
+        }
     }
 
     void ReInit(std::string algo_type)
@@ -114,6 +119,11 @@ namespace DOpE
           delete ts_state_problem_;
           ts_state_problem_ = NULL;
         }
+      if (ts_embedded_state_problem_ != NULL)
+        {
+          delete ts_embedded_state_problem_;
+          ts_embedded_state_problem_ = NULL;
+        }
 
       PDEProblemContainer<PDE,DD,SPARSITYPATTERN,VECTOR,dealdim,FE, DH>::ReInit(algo_type);
     }
@@ -143,11 +153,37 @@ namespace DOpE
       return *ts_state_problem_;
     }
 
+    /*******************************************************************************************/
+    /**
+     * Returns a description of the PDE discretized by the backward Euler scheme.
+     * This is used as embedded scheme to estimate the local error of the time
+     * stepping scheme given by PRIMALTSPROBLEM, see InstatPDEProblem.
+     */
+    BackwardEulerProblem<StateProblem<
+    PDEProblemContainer<PDE,DD,SPARSITYPATTERN,VECTOR,dealdim,FE, DH>,
+    PDE, DD, SPARSITYPATTERN, VECTOR, dealdim>,
+    SPARSITYPATTERN, VECTOR, dealdim, FE> &GetEmbeddedStateProblem()
+    {
+      if (ts_embedded_state_problem_ == NULL)
+        {
+          ts_embedded_state_problem_ = new BackwardEulerProblem<StateProblem<
+          PDEProblemContainer<PDE,DD,SPARSITYPATTERN,VECTOR,dealdim,FE, DH>,
+          PDE, DD, SPARSITYPATTERN, VECTOR, dealdim>,
+          SPARSITYPATTERN, VECTOR, dealdim, FE>(PDEProblemContainer<PDE,DD,
+                                                SPARSITYPATTERN,VECTOR,dealdim,FE, DH>::GetStateProblem());
+        }
+      return *ts_embedded_state_problem_;
+    }
+
   private:
     PRIMALTSPROBLEM<StateProblem<
     PDEProblemContainer<PDE,DD,SPARSITYPATTERN,VECTOR,dealdim,FE, DH>,
     PDE, DD, SPARSITYPATTERN, VECTOR, dealdim>,
     SPARSITYPATTERN, VECTOR, dealdim, FE> *ts_state_problem_;
+    BackwardEulerProblem<StateProblem<
+    PDEProblemContainer<PDE,DD,SPARSITYPATTERN,VECTOR,dealdim,FE, DH>,
+    PDE, DD, SPARSITYPATTERN, VECTOR, dealdim>,
+    SPARSITYPATTERN, VECTOR, dealdim, FE> *ts_embedded_state_problem_;
   };
 }
 #endif
@@ -881,6 +881,20 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Returns the auxiliary functional with the given number.
+     * Integrator::ComputeScalars uses this to evaluate several
+     * functionals on each element without changing the type of
+     * the problem.
+     */
+    FUNCTIONAL_INTERFACE *
+    GetAuxFunctional(unsigned int num)
+    {
+      return aux_functionals_[num];
+    }
+
+    /******************************************************/
+
     unsigned int
     GetControlNBlocks() const;
 
@@ -1085,7 +1099,7 @@ namespace DOpE
             else if (dopedim == 0)
               {
                 integrator.AddParamData(it->first,
-                                        &(it->second->GetSpacialVectorCopy()));
+                                        &(it->second->GetSpacialVectorView()));
               }
             else
               {
@@ -1322,6 +1336,17 @@ namespace DOpE
     template<typename ELEMENTITERATOR>
     bool AtInterface(ELEMENTITERATOR &element, unsigned int face) const;
 
+    /**
+     * The container itself is only integrated for functionals and error
+     * estimators, which have no two-sided interface terms. The problem
+     * wrappers (StateProblem, AdjointProblem, ...) forward the ones of the PDE.
+     */
+    bool
+    HasTwoSidedInterfaces() const
+    {
+      return false;
+    }
+
     /**
      * Initializes the HigherOrderDWRDataContainer
      */
@@ -0,0 +1,170 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef PATCH_INTERPOLATION_DWRC_H_
+#define PATCH_INTERPOLATION_DWRC_H_
+
+#include <container/higher_order_dwrc.h>
+#include <include/helper.h>
+
+#include <deal.II/fe/fe_tools.h>
+#include <deal.II/lac/vector.h>
+
+namespace DOpE
+{
+  /**
+   * This class implements the DWRMethod with weights computed by patchwise
+   * higher order interpolation and evaluation of strong element and jump residuals.
+   *
+   * The weights are given by I_2h z_h - z_h, where I_2h interpolates z_h on each
+   * patch, i.e., on the children of an element, into the finite element of
+   * twice the degree on the parent element. This approximates the interpolation
+   * error z - I_h z, and no dual problem is solved in the higher order space.
+   * The higher order STH given to the constructor is only used to represent the
+   * weights, it has to use the same triangulation as the state and a finite
+   * element of twice the degree.
+   *
+   * In contrast to the HigherOrderDWRContainer, the interpolation is done in one
+   * sweep over the patches and the mesh is required to have a patch structure:
+   * each active element has to be a child of an element whose children are all
+   * active, which is guaranteed by Triangulation::MeshSmoothing::patch_level_1 after
+   * one global refinement. Otherwise an exception is thrown, as there is no
+   * higher order interpolation on such an element.
+   */
+  template<class STH, class IDC, class EDC, class FDC, typename VECTOR>
+  class PatchInterpolationDWRContainer : public HigherOrderDWRContainer<STH, IDC, EDC, FDC,
+    VECTOR>
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param higher_order_sth      The STH for the weights, with a finite element of twice
+     *                              the degree of the state on the same triangulation.
+     * @param higher_order_idc      The IDC used for the evaluation of the weights.
+     *                              Contains also the quadrature rules
+     * @param state_behavior        Behaviour of the StateVectors.
+     * @param param_reader          The parameter reader we use here.
+     * @param ee_terms              Which part of the error estimators do we want
+     *                              to compute? (primal, dual, both).
+     */
+    PatchInterpolationDWRContainer(STH &higher_order_sth, IDC &higher_order_idc,
+                                   DOpEtypes::VectorStorageType state_behavior, ParameterReader &param_reader,
+                                   DOpEtypes::EETerms ee_terms = DOpEtypes::EETerms::mixed,
+                                   DOpEtypes::ResidualEvaluation res_eval = DOpEtypes::strong_residual)
+      : HigherOrderDWRContainer<STH, IDC, EDC, FDC, VECTOR>(higher_order_sth, higher_order_idc,
+                                                            state_behavior, param_reader, ee_terms, res_eval)
+    {
+    }
+
+    /**
+     * Computes the weight I_2h u_h - u_h for the dual residual.
+     */
+    void
+    PreparePI_h_u(const StateVector<VECTOR> &u) override
+    {
+      PatchInterpolationDifference(u.GetSpacialVector(), this->GetPI_h_u().GetSpacialVector());
+    }
+
+    /**
+     * Computes the weight I_2h z_h - z_h for the primal residual.
+     */
+    void
+    PreparePI_h_z(const StateVector<VECTOR> &z) override
+    {
+      PatchInterpolationDifference(z.GetSpacialVector(), this->GetPI_h_z().GetSpacialVector());
+    }
+
+    /**
+     * Implementation of virtual method from base class.
+     */
+    virtual DOpEtypes::WeightComputation
+    GetWeightComputation() const override
+    {
+      return DOpEtypes::patch_interpolation;
+    }
+
+  private:
+    /**
+     * Computes weight = I_2h v - v in the higher order space. For each patch,
+     * the values of v on the children are interpolated to the higher order
+     * element on the parent and from there back to the children.
+     */
+    void
+    PatchInterpolationDifference(const VECTOR &v, VECTOR &weight)
+    {
+      const auto &dof_handler = this->GetSTH().GetStateDoFHandler().GetDEALDoFHandler();
+      const auto &dof_handler_high = this->GetHigherOrderSTH().GetStateDoFHandler().GetDEALDoFHandler();
+      const auto &constraints_high = this->GetHigherOrderSTH().GetStateDoFConstraints();
+
+      //v in the higher order space, on the children of each patch this is the
+      //data for the interpolation.
+      DOpEHelper::reinit_work_vector(v_high_, weight);
+      dealii::FETools::interpolate(dof_handler, v, dof_handler_high, constraints_high, v_high_);
+
+      dealii::Vector<double> parent_values(dof_handler_high.get_fe().dofs_per_cell);
+      weight = v_high_;
+      for (auto element = dof_handler_high.begin(); element != dof_handler_high.end(); ++element)
+        {
+          if (element->is_active())
+            {
+              if (element->level() == 0 || !IsPatch(element->parent()))
+                {
+                  throw DOpEException("The active element " + element->id().to_string()
+                                      + " is not part of a patch, use a triangulation with "
+                                      "MeshSmoothing::patch_level_1 that is refined at least once.",
+                                      "PatchInterpolationDWRContainer::PatchInterpolationDifference");
+                }
+              continue;
+            }
+          if (!IsPatch(element))
+            continue;
+          element->get_interpolated_dof_values(v_high_, parent_values);
+          element->set_dof_values_by_interpolation(parent_values, weight);
+        }
+      constraints_high.distribute(weight);
+      weight -= v_high_;
+    }
+
+    /**
+     * Checks whether all children of the element are active.
+     */
+    template<typename ITERATOR>
+    static bool
+    IsPatch(const ITERATOR &element)
+    {
+      for (unsigned int c = 0; c < element->n_children(); ++c)
+        if (!element->child(c)->is_active())
+          return false;
+      return true;
+    }
+
+    /**
+     * The interpolation of the low order vector into the higher order space.
+     * Kept to avoid the reallocation for each weight.
+     */
+    VECTOR v_high_;
+  };
+}
+
+#endif /* PATCH_INTERPOLATION_DWRC_H_ */
@@ -481,6 +481,21 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Returns the auxiliary functional with the given number.
+     * Integrator::ComputeScalars uses this to evaluate several
+     * functionals on each element without changing the type of
+     * the problem.
+     */
+    FunctionalInterface<ElementDataContainer, FaceDataContainer, DH,
+                        VECTOR, dealdim> *
+    GetAuxFunctional(unsigned int num)
+    {
+      return aux_functionals_[num];
+    }
+
+    /******************************************************/
+
     unsigned int
     GetStateNBlocks() const;
 
@@ -904,6 +919,17 @@ namespace DOpE
       return this->GetPDE().AtInterface(element,face);
     }
 
+    /**
+     * The container itself is only integrated for functionals and error
+     * estimators, which have no two-sided interface terms. The problem
+     * wrappers (StateProblem, AdjointProblem, ...) forward the ones of the PDE.
+     */
+    bool
+    HasTwoSidedInterfaces() const
+    {
+      return false;
+    }
+
     /**
      * Initializes the HigherOrderDWRDataContainer
      */
@@ -157,7 +157,9 @@ namespace DOpE
       {
 
         if (dwrc.GetWeightComputation()
-            == DOpEtypes::higher_order_interpolation)
+            == DOpEtypes::higher_order_interpolation
+            || dwrc.GetWeightComputation()
+            == DOpEtypes::patch_interpolation)
           {
             EDC *edc_w = ExtractEDC<EDC>(dwrc);
             switch (dwrc.GetEETerms())
@@ -236,7 +238,9 @@ namespace DOpE
       {
 
         if (dwrc.GetWeightComputation()
-            == DOpEtypes::higher_order_interpolation)
+            == DOpEtypes::higher_order_interpolation
+            || dwrc.GetWeightComputation()
+            == DOpEtypes::patch_interpolation)
           {
             FDC *fdc_w = ExtractFDC<FDC>(dwrc);
             switch (dwrc.GetEETerms())
@@ -314,7 +318,9 @@ namespace DOpE
     if (dwrc.GetResidualEvaluation() == DOpEtypes::strong_residual)
       {
         if (dwrc.GetWeightComputation()
-            == DOpEtypes::higher_order_interpolation)
+            == DOpEtypes::higher_order_interpolation
+            || dwrc.GetWeightComputation()
+            == DOpEtypes::patch_interpolation)
           {
             FDC *fdc_w = ExtractFDC<FDC>(dwrc);
             switch (dwrc.GetEETerms())
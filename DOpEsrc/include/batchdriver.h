@@ -0,0 +1,197 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef BATCH_DRIVER_H_
+#define BATCH_DRIVER_H_
+
+#include <include/parameterreader.h>
+#include <include/dopeexception.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DOpE
+{
+  /**
+   * @class BatchDriver
+   *
+   * This class solves several stationary problems, called scenarios, that
+   * differ only in the values of their runtime parameters, e.g., loads,
+   * coefficients or boundary data. All scenarios use the same space time
+   * handler, i.e., the mesh and the DoF numbering are only built once.
+   *
+   * Each scenario gets its own ParameterReader. It is filled from the common
+   * param file, then the values given by SetParameter are set and the
+   * `results_dir' in the subsection `output parameters' is set to the
+   * directory of the scenario.
+   *
+   * The first scenario initializes the discretization. Then the space time
+   * handler is marked as shared, see SpaceTimeHandlerBase::SetShared, and the
+   * remaining scenarios are solved one after another on the present
+   * discretization. They are not solved concurrently, since the space time
+   * handler keeps state of the problem in use, e.g., the ordering of the
+   * DoFHandlers set by the problem containers.
+   * While the discretization is shared, the method of lines space time
+   * handlers compute the sparsity pattern of the state only once and copy
+   * it for the following scenarios. The constraints are kept together with
+   * the Dirichlet data they have been built for and are only rebuilt for a
+   * scenario with other Dirichlet colors or component masks.
+   *
+   * The function solving a scenario needs to construct all objects that
+   * depend on the parameters, e.g., problem container, reduced problem,
+   * algorithm and output handler.
+   *
+   * @tparam <STH>        The space time handler, e.g., MethodOfLines_StateSpaceTimeHandler.
+   */
+  template<typename STH>
+  class BatchDriver
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param sth              The space time handler shared by all scenarios.
+     * @param parameter_file   The param file read by all scenarios.
+     * @param declare          Declares all parameters, i.e., calls the declare_params
+     *                         functions of all used classes.
+     * @param run              Solves one scenario given its ParameterReader, the
+     *                         shared space time handler and the number of the scenario.
+     */
+    BatchDriver(STH &sth, const std::string &parameter_file,
+                const std::function<void(ParameterReader &)> &declare,
+                const std::function<void(ParameterReader &, STH &, unsigned int)> &run)
+      : sth_(sth), parameter_file_(parameter_file), declare_(declare), run_(run)
+    {
+    }
+
+    /**
+     * Adds a scenario.
+     *
+     * @param results_dir      The output directory of the scenario, e.g., `Results/Case1/'.
+     *
+     * @return                 The number of the scenario.
+     */
+    unsigned int
+    AddScenario(const std::string &results_dir)
+    {
+      results_dirs_.push_back(results_dir);
+      overrides_.push_back(std::vector<Override>());
+      return results_dirs_.size() - 1;
+    }
+
+    /**
+     * Overwrites the value of a parameter in the param file for one scenario.
+     *
+     * @param scenario         The number of the scenario as returned by AddScenario.
+     * @param subsection       The subsection of the parameter.
+     * @param entry            The name of the parameter.
+     * @param value            The new value.
+     */
+    void
+    SetParameter(unsigned int scenario, const std::string &subsection,
+                 const std::string &entry, const std::string &value)
+    {
+      if (scenario >= overrides_.size())
+        {
+          throw DOpEException("Unknown scenario " + std::to_string(scenario),
+                              "BatchDriver::SetParameter");
+        }
+      overrides_[scenario].push_back(Override {subsection, entry, value});
+    }
+
+    unsigned int
+    GetNScenarios() const
+    {
+      return results_dirs_.size();
+    }
+
+    /**
+     * Solves all scenarios.
+     */
+    void
+    Run();
+
+  private:
+    struct Override
+    {
+      std::string subsection, entry, value;
+    };
+
+    STH &sth_;
+    std::string parameter_file_;
+    std::function<void(ParameterReader &)> declare_;
+    std::function<void(ParameterReader &, STH &, unsigned int)> run_;
+
+    std::vector<std::string> results_dirs_;
+    std::vector<std::vector<Override> > overrides_;
+  };
+
+  /*********************************Implementation************************************************/
+
+  template<typename STH>
+  void
+  BatchDriver<STH>::Run()
+  {
+    const unsigned int n_scenarios = GetNScenarios();
+    if (n_scenarios == 0)
+      return;
+
+    //Read all parameters before any scenario is started.
+    std::vector<std::unique_ptr<ParameterReader> > param_readers(n_scenarios);
+    for (unsigned int i = 0; i < n_scenarios; i++)
+      {
+        param_readers[i].reset(new ParameterReader());
+        declare_(*param_readers[i]);
+        param_readers[i]->read_parameters(parameter_file_);
+        for (const Override &o : overrides_[i])
+          {
+            param_readers[i]->SetSubsection(o.subsection);
+            param_readers[i]->set(o.entry, o.value);
+          }
+        param_readers[i]->SetSubsection("output parameters");
+        param_readers[i]->set("results_dir", results_dirs_[i]);
+      }
+
+    //The first scenario initializes the discretization
+    run_(*param_readers[0], sth_, 0);
+    if (n_scenarios == 1)
+      return;
+
+    sth_.SetShared(true);
+    try
+      {
+        for (unsigned int i = 1; i < n_scenarios; i++)
+          run_(*param_readers[i], sth_, i);
+      }
+    catch (...)
+      {
+        sth_.SetShared(false);
+        throw;
+      }
+    sth_.SetShared(false);
+  }
+}
+
+#endif
@@ -0,0 +1,290 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef FORCING_TERM_H_
+#define FORCING_TERM_H_
+
+#include <include/parameterreader.h>
+#include <include/dopeexception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace DOpE
+{
+  namespace internal
+  {
+    /**
+     * Is true if the linear solver provides the methods SetForcingTerm(double)
+     * and GetLastLinearResidual() used by inexact Newton methods.
+     */
+    template <typename LINEARSOLVER, typename = void>
+    struct has_forcing_term : std::false_type
+    {};
+
+    template <typename LINEARSOLVER>
+    struct has_forcing_term<LINEARSOLVER,
+      decltype(std::declval<LINEARSOLVER &>().SetForcingTerm(0.),
+               (void)std::declval<const LINEARSOLVER &>().GetLastLinearResidual())>
+      : std::true_type
+    {};
+  }
+
+  /**
+   * @class ForcingTerm
+   *
+   * This class computes the forcing terms for inexact Newton methods, i.e.,
+   * the relative reduction of the linear residual which is required from the
+   * linear solver in each Newton step. The choices 1 and 2 of
+   * S.C. Eisenstat and H.F. Walker, Choosing the forcing terms in an inexact
+   * Newton method, SIAM J. Sci. Comput. 17 (1996) are implemented, including
+   * their safeguards.
+   *
+   * All residuals given to this class are expected to be measured in the
+   * l2-norm, since this is the norm used by the krylov solvers.
+   */
+  class ForcingTerm
+  {
+  public:
+    inline ForcingTerm(ParameterReader &param_reader);
+
+    static inline void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Returns true if an inexact Newton method has been selected by the parameter
+     * inexact_newton. Otherwise the linear solvers use their own tolerances.
+     */
+    inline bool IsActive() const;
+
+    /**
+     * Needs to be called before the first Newton step.
+     *
+     * @param res                The norm of the initial nonlinear residual.
+     * @param rel_target         The relative tolerance required for the nonlinear residual.
+     *                           It is used to avoid oversolving in the last Newton steps.
+     */
+    inline void Initialize(double res, double rel_target);
+
+    /**
+     * Computes the forcing term for the next Newton step.
+     *
+     * @param res                The norm of the nonlinear residual after the last step.
+     * @param linear_res         The norm of the linear residual reached in the last step.
+     */
+    inline void Update(double res, double linear_res);
+
+    /**
+     * Same as above, the norm of the linear residual is taken from the solver.
+     */
+    template <typename LINEARSOLVER>
+    inline void Update(double res, const LINEARSOLVER &solver);
+
+    /**
+     * Throws an exception if an inexact Newton method is selected but the
+     * LINEARSOLVER does not accept forcing terms. Linear solvers are not
+     * required to provide SetForcingTerm and GetLastLinearResidual otherwise.
+     */
+    template <typename LINEARSOLVER>
+    inline void CheckLinearSolver() const;
+
+    /**
+     * Passes the forcing term for the current Newton step to the linear solver.
+     */
+    template <typename LINEARSOLVER>
+    inline void Apply(LINEARSOLVER &solver) const;
+
+    /**
+     * Resets the linear solver to its own tolerances.
+     */
+    template <typename LINEARSOLVER>
+    inline void Release(LINEARSOLVER &solver) const;
+
+    /**
+     * Returns the forcing term for the current Newton step.
+     */
+    inline double Get() const;
+
+  private:
+    unsigned int choice_;
+    double eta_max_, eta_0_, gamma_, alpha_;
+    double eta_, lastres_, firstres_, rel_target_;
+  };
+
+  /*********************************Implementation************************************************/
+
+  void ForcingTerm::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    param_reader.declare_entry("inexact_newton", "none",Patterns::Selection("none|eisenstat_walker_1|eisenstat_walker_2"),"Choice of the forcing term for an inexact newton method. If none is given the linear solvers use their own tolerances");
+    param_reader.declare_entry("forcing_eta_0", "0.5",Patterns::Double(0,1),"forcing term in the first newton step");
+    param_reader.declare_entry("forcing_eta_max", "0.9",Patterns::Double(0,1),"upper bound for the forcing terms");
+    param_reader.declare_entry("forcing_gamma", "0.9",Patterns::Double(0,1),"parameter gamma for eisenstat_walker_2");
+    param_reader.declare_entry("forcing_alpha", "2.",Patterns::Double(1,2),"parameter alpha for eisenstat_walker_2");
+  }
+
+  /******************************************************/
+
+  ForcingTerm::ForcingTerm(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    std::string inexact = param_reader.get_string("inexact_newton");
+    if (inexact == "eisenstat_walker_1")
+      choice_ = 1;
+    else if (inexact == "eisenstat_walker_2")
+      choice_ = 2;
+    else
+      choice_ = 0;
+    eta_0_   = param_reader.get_double ("forcing_eta_0");
+    eta_max_ = param_reader.get_double ("forcing_eta_max");
+    gamma_   = param_reader.get_double ("forcing_gamma");
+    alpha_   = param_reader.get_double ("forcing_alpha");
+
+    eta_ = eta_0_;
+    lastres_ = firstres_ = 1.;
+    rel_target_ = 0.;
+  }
+
+  /******************************************************/
+
+  bool ForcingTerm::IsActive() const
+  {
+    return choice_ != 0;
+  }
+
+  /******************************************************/
+
+  void ForcingTerm::Initialize(double res, double rel_target)
+  {
+    eta_ = std::min(eta_0_,eta_max_);
+    lastres_ = res;
+    firstres_ = res;
+    rel_target_ = rel_target;
+  }
+
+  /******************************************************/
+
+  void ForcingTerm::Update(double res, double linear_res)
+  {
+    if (lastres_ == 0.)
+      return;
+
+    double eta = 0.;
+    double safeguard = 0.;
+    if (choice_ == 1)
+      {
+        eta = std::fabs(res - linear_res)/lastres_;
+        safeguard = std::pow(eta_,0.5*(1.+std::sqrt(5.)));
+      }
+    else
+      {
+        eta = gamma_*std::pow(res/lastres_,alpha_);
+        safeguard = gamma_*std::pow(eta_,alpha_);
+      }
+    //Prevent the forcing terms from decreasing too fast
+    if (safeguard > 0.1)
+      eta = std::max(eta,safeguard);
+    eta = std::min(eta,eta_max_);
+    //Avoid oversolving once the nonlinear residual is close to the required tolerance
+    if (res > 0.)
+      eta = std::min(eta_max_,std::max(eta,0.5*rel_target_*firstres_/res));
+
+    eta_ = eta;
+    lastres_ = res;
+  }
+
+  /******************************************************/
+
+  double ForcingTerm::Get() const
+  {
+    return eta_;
+  }
+
+  /******************************************************/
+
+  namespace internal
+  {
+    template <typename LINEARSOLVER>
+    void set_forcing_term(LINEARSOLVER &solver, double eta, std::true_type)
+    {
+      solver.SetForcingTerm(eta);
+    }
+
+    template <typename LINEARSOLVER>
+    void set_forcing_term(LINEARSOLVER &/*solver*/, double /*eta*/, std::false_type)
+    {
+    }
+
+    template <typename LINEARSOLVER>
+    double get_last_linear_residual(const LINEARSOLVER &solver, std::true_type)
+    {
+      return solver.GetLastLinearResidual();
+    }
+
+    template <typename LINEARSOLVER>
+    double get_last_linear_residual(const LINEARSOLVER &/*solver*/, std::false_type)
+    {
+      return 0.;
+    }
+  }
+
+  /******************************************************/
+
+  template <typename LINEARSOLVER>
+  void ForcingTerm::Update(double res, const LINEARSOLVER &solver)
+  {
+    Update(res, internal::get_last_linear_residual(solver, internal::has_forcing_term<LINEARSOLVER>()));
+  }
+
+  /******************************************************/
+
+  template <typename LINEARSOLVER>
+  void ForcingTerm::CheckLinearSolver() const
+  {
+    if (IsActive() && !internal::has_forcing_term<LINEARSOLVER>::value)
+      {
+        throw DOpEException("The selected inexact_newton method requires a linear solver providing SetForcingTerm and GetLastLinearResidual.",
+                            "ForcingTerm::CheckLinearSolver");
+      }
+  }
+
+  /******************************************************/
+
+  template <typename LINEARSOLVER>
+  void ForcingTerm::Apply(LINEARSOLVER &solver) const
+  {
+    internal::set_forcing_term(solver, Get(), internal::has_forcing_term<LINEARSOLVER>());
+  }
+
+  /******************************************************/
+
+  template <typename LINEARSOLVER>
+  void ForcingTerm::Release(LINEARSOLVER &solver) const
+  {
+    internal::set_forcing_term(solver, 0., internal::has_forcing_term<LINEARSOLVER>());
+  }
+
+}
+#endif
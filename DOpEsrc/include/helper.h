@@ -25,13 +25,27 @@
 #define DOpEHelper_H_
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
 
 #include <deal.II/lac/block_indices.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/vector.h>
 
 #include <include/parallel_vectors.h>
 
+#ifdef DOPELIB_WITH_TRILINOS
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/trilinos_block_sparse_matrix.h>
+#include <deal.II/lac/trilinos_sparsity_pattern.h>
+#endif
+
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 using namespace dealii;
 
 namespace DOpEHelper
@@ -99,6 +113,174 @@ namespace DOpEHelper
   }
 #endif
 
+  /**
+   * Writes v to the file filename, returns false if the file could not be opened.
+   * For distributed vectors this is a collective operation: all processes write
+   * their locally owned entries into one shared file using MPI-IO, so that there
+   * is one file per vector independent of the number of processes.
+   */
+  template <typename VECTOR>
+  bool
+  write_to_file(const VECTOR &v, const std::string &filename)
+  {
+    std::ofstream stream(filename.c_str());
+    if (stream.fail())
+      return false;
+    write(v, stream);
+    return true;
+  }
+
+  /**
+   * Reads v from the file filename written by write_to_file,
+   * returns false if the file could not be opened.
+   * Distributed vectors need to have the correct layout already.
+   */
+  template <typename VECTOR>
+  bool
+  read_from_file(VECTOR &v, const std::string &filename)
+  {
+    std::ifstream stream(filename.c_str());
+    if (stream.fail())
+      return false;
+    read(v, stream);
+    return true;
+  }
+
+#ifdef DOPELIB_WITH_TRILINOS
+  namespace internal
+  {
+    /**
+     * Returns the position of the first locally owned entry of v in a file
+     * storing the global vector at offset (given in doubles).
+     */
+    inline MPI_Offset
+    owned_position(const TrilinosWrappers::MPI::Vector &v, MPI_Offset offset)
+    {
+      const IndexSet owned = v.locally_owned_elements();
+      AssertThrow(owned.n_elements() == 0 || owned.is_contiguous(),
+                  ExcMessage("Storing distributed vectors requires contiguous locally owned indices."));
+      const MPI_Offset first = (owned.n_elements() == 0) ? 0 : *owned.begin();
+      return (offset + first) * sizeof(double);
+    }
+
+    /**
+     * Writes the locally owned entries of v into the opened file fh.
+     * All processes need to call this, as it uses collective MPI-IO.
+     */
+    inline void
+    write_owned(MPI_File fh, MPI_Offset offset, const TrilinosWrappers::MPI::Vector &v)
+    {
+      const IndexSet owned = v.locally_owned_elements();
+      std::vector<double> buffer;
+      buffer.reserve(owned.n_elements());
+      for (const auto j : owned)
+        buffer.push_back(v(j));
+      const int ierr = MPI_File_write_at_all(fh, owned_position(v, offset), buffer.data(),
+                                             buffer.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+      AssertThrow(ierr == MPI_SUCCESS, ExcMessage("MPI_File_write_at_all failed."));
+    }
+
+    /**
+     * Reads the locally owned entries of v from the opened file fh.
+     * All processes need to call this, as it uses collective MPI-IO.
+     */
+    inline void
+    read_owned(MPI_File fh, MPI_Offset offset, TrilinosWrappers::MPI::Vector &v)
+    {
+      const IndexSet owned = v.locally_owned_elements();
+      std::vector<double> buffer(owned.n_elements());
+      const int ierr = MPI_File_read_at_all(fh, owned_position(v, offset), buffer.data(),
+                                            buffer.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+      AssertThrow(ierr == MPI_SUCCESS, ExcMessage("MPI_File_read_at_all failed."));
+
+      //v may have ghost entries, hence the values are set in a copy
+      //without them and the ghosts are updated by the assignment.
+      TrilinosWrappers::MPI::Vector tmp(owned, v.get_mpi_communicator());
+      unsigned int i = 0;
+      for (const auto j : owned)
+        tmp(j) = buffer[i++];
+      tmp.compress(VectorOperation::insert);
+      v = tmp;
+    }
+
+    /**
+     * Opens filename collectively on comm, calls op(fh) and closes the file.
+     * A file opened for writing is truncated first, as MPI_MODE_CREATE keeps
+     * the content of an existing file and a longer old file would otherwise
+     * leave its tail behind the new data.
+     */
+    template <typename OP>
+    bool
+    with_mpi_file(const std::string &filename, MPI_Comm comm, int mode, OP op)
+    {
+      MPI_File fh;
+      if (MPI_File_open(comm, filename.c_str(), mode, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+        return false;
+      if ((mode & MPI_MODE_WRONLY) && MPI_File_set_size(fh, 0) != MPI_SUCCESS)
+        {
+          MPI_File_close(&fh);
+          return false;
+        }
+      op(fh);
+      MPI_File_close(&fh);
+      return true;
+    }
+  } // namespace internal
+
+  inline bool
+  write_to_file(const TrilinosWrappers::MPI::Vector &v, const std::string &filename)
+  {
+    return internal::with_mpi_file(filename, v.get_mpi_communicator(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                   [&v](MPI_File fh)
+    {
+      internal::write_owned(fh, 0, v);
+    });
+  }
+
+  inline bool
+  read_from_file(TrilinosWrappers::MPI::Vector &v, const std::string &filename)
+  {
+    return internal::with_mpi_file(filename, v.get_mpi_communicator(), MPI_MODE_RDONLY,
+                                   [&v](MPI_File fh)
+    {
+      internal::read_owned(fh, 0, v);
+    });
+  }
+
+  /**
+   * The blocks are stored one after another in the same file.
+   */
+  inline bool
+  write_to_file(const TrilinosWrappers::MPI::BlockVector &v, const std::string &filename)
+  {
+    return internal::with_mpi_file(filename, v.block(0).get_mpi_communicator(),
+                                   MPI_MODE_CREATE | MPI_MODE_WRONLY, [&v](MPI_File fh)
+    {
+      MPI_Offset offset = 0;
+      for (unsigned int b = 0; b < v.n_blocks(); b++)
+        {
+          internal::write_owned(fh, offset, v.block(b));
+          offset += v.block(b).size();
+        }
+    });
+  }
+
+  inline bool
+  read_from_file(TrilinosWrappers::MPI::BlockVector &v, const std::string &filename)
+  {
+    return internal::with_mpi_file(filename, v.block(0).get_mpi_communicator(),
+                                   MPI_MODE_RDONLY, [&v](MPI_File fh)
+    {
+      MPI_Offset offset = 0;
+      for (unsigned int b = 0; b < v.n_blocks(); b++)
+        {
+          internal::read_owned(fh, offset, v.block(b));
+          offset += v.block(b).size();
+        }
+    });
+  }
+#endif
+
   /**
    * Splits an index set source into different blocks according to block_counts.
    * Application: split locally_owned for block vectors
@@ -116,6 +298,202 @@ namespace DOpEHelper
     return result;
   }
 
+  /**
+   * Prepares a persistent work vector for reuse.
+   * The vector work is only reinitialized to the layout of model if their sizes
+   * differ, otherwise the already allocated storage is set to zero.
+   *
+   * @return true if the storage of work has been reallocated.
+   */
+  template <typename VECTOR>
+  bool
+  reinit_work_vector(VECTOR &work, const VECTOR &model)
+  {
+    if (work.size() != model.size())
+      {
+        work.reinit(model);
+        return true;
+      }
+    work = 0.;
+    return false;
+  }
+
+  /**
+   * Overload for block vectors, here the block structure needs to coincide as well.
+   */
+  template <typename number>
+  bool
+  reinit_work_vector(dealii::BlockVector<number> &work, const dealii::BlockVector<number> &model)
+  {
+    bool same_layout = (work.n_blocks() == model.n_blocks());
+    for (unsigned int b = 0; same_layout && b < model.n_blocks(); b++)
+      same_layout = (work.block(b).size() == model.block(b).size());
+    if (!same_layout)
+      {
+        work.reinit(model);
+        return true;
+      }
+    work = 0.;
+    return false;
+  }
+
+  /**
+   * Initializes matrix with the sparsity pattern of model, all entries are
+   * set to zero. Overloads exist for trilinos-based matrices which do not give
+   * access to their sparsity pattern.
+   */
+  template <typename MATRIX>
+  void
+  reinit_like(MATRIX &matrix, const MATRIX &model)
+  {
+    matrix.reinit(model.get_sparsity_pattern());
+  }
+
+#ifdef DOPELIB_WITH_TRILINOS
+  inline void
+  reinit_like(dealii::TrilinosWrappers::SparseMatrix &matrix, const dealii::TrilinosWrappers::SparseMatrix &model)
+  {
+    matrix.reinit(model);
+    matrix = 0.;
+  }
+
+  inline void
+  reinit_like(dealii::TrilinosWrappers::BlockSparseMatrix       &matrix,
+              const dealii::TrilinosWrappers::BlockSparseMatrix &model)
+  {
+    matrix.reinit(model.n_block_rows(), model.n_block_cols());
+    for (unsigned int i = 0; i < model.n_block_rows(); i++)
+      for (unsigned int j = 0; j < model.n_block_cols(); j++)
+        reinit_like(matrix.block(i, j), model.block(i, j));
+    matrix.collect_sizes();
+  }
+#endif
+
+  /**
+   * Copies the sparsity pattern source into sparsity. Overloads exist for
+   * block and trilinos-based sparsity patterns.
+   */
+  inline void
+  copy_sparsity_pattern(dealii::SparsityPattern &sparsity, const dealii::SparsityPattern &source)
+  {
+    sparsity.copy_from(source);
+  }
+
+  inline void
+  copy_sparsity_pattern(dealii::BlockSparsityPattern &sparsity, const dealii::BlockSparsityPattern &source)
+  {
+    sparsity.reinit(source.n_block_rows(), source.n_block_cols());
+    for (unsigned int i = 0; i < source.n_block_rows(); i++)
+      for (unsigned int j = 0; j < source.n_block_cols(); j++)
+        sparsity.block(i, j).copy_from(source.block(i, j));
+    sparsity.collect_sizes();
+  }
+
+#ifdef DOPELIB_WITH_TRILINOS
+  inline void
+  copy_sparsity_pattern(dealii::TrilinosWrappers::SparsityPattern &sparsity,
+                        const dealii::TrilinosWrappers::SparsityPattern &source)
+  {
+    sparsity.copy_from(source);
+  }
+
+  inline void
+  copy_sparsity_pattern(dealii::TrilinosWrappers::BlockSparsityPattern &sparsity,
+                        const dealii::TrilinosWrappers::BlockSparsityPattern &source)
+  {
+    sparsity.reinit(source.n_block_rows(), source.n_block_cols());
+    for (unsigned int i = 0; i < source.n_block_rows(); i++)
+      for (unsigned int j = 0; j < source.n_block_cols(); j++)
+        copy_sparsity_pattern(sparsity.block(i, j), source.block(i, j));
+    sparsity.collect_sizes();
+  }
+#endif
+
+  /**
+   * Moves the diagonal entries of the rows of matrix that belong to DoFs
+   * constrained by constraints into diagonal, i.e., they are stored there
+   * together with their row and set to zero in matrix. These entries are
+   * added by distribute_local_to_global, the remaining entries of these rows
+   * are zero already. Overloads exist for trilinos-based matrices which
+   * only own a range of the rows.
+   */
+  template <typename MATRIX, typename CONSTRAINTS>
+  void
+  extract_constrained_diagonal(MATRIX &matrix, const CONSTRAINTS &constraints,
+                               std::vector<std::pair<dealii::types::global_dof_index, double> > &diagonal)
+  {
+    diagonal.clear();
+    for (dealii::types::global_dof_index i = 0; i < matrix.m(); i++)
+      {
+        if (constraints.is_constrained(i))
+          {
+            diagonal.push_back(std::make_pair(i, static_cast<double>(matrix.el(i, i))));
+            matrix.set(i, i, 0.);
+          }
+      }
+  }
+
+#ifdef DOPELIB_WITH_TRILINOS
+  template <typename CONSTRAINTS>
+  void
+  extract_constrained_diagonal(dealii::TrilinosWrappers::SparseMatrix &matrix, const CONSTRAINTS &constraints,
+                               std::vector<std::pair<dealii::types::global_dof_index, double> > &diagonal)
+  {
+    diagonal.clear();
+    const auto range = matrix.local_range();
+    for (dealii::types::global_dof_index i = range.first; i < range.second; i++)
+      {
+        if (constraints.is_constrained(i))
+          {
+            diagonal.push_back(std::make_pair(i, matrix.el(i, i)));
+            matrix.set(i, i, 0.);
+          }
+      }
+    matrix.compress(dealii::VectorOperation::insert);
+  }
+
+  template <typename CONSTRAINTS>
+  void
+  extract_constrained_diagonal(dealii::TrilinosWrappers::BlockSparseMatrix &matrix, const CONSTRAINTS &constraints,
+                               std::vector<std::pair<dealii::types::global_dof_index, double> > &diagonal)
+  {
+    diagonal.clear();
+    for (unsigned int b = 0; b < matrix.n_block_rows(); b++)
+      {
+        const auto range = matrix.block(b, b).local_range();
+        for (dealii::types::global_dof_index k = range.first; k < range.second; k++)
+          {
+            const dealii::types::global_dof_index i = matrix.get_row_indices().local_to_global(b, k);
+            if (constraints.is_constrained(i))
+              {
+                diagonal.push_back(std::make_pair(i, matrix.el(i, i)));
+                matrix.set(i, i, 0.);
+              }
+          }
+      }
+    matrix.compress(dealii::VectorOperation::insert);
+  }
+#endif
+
+  /**
+   * Indicates whether the operations of a vector type involve communication
+   * between the MPI processes. Such operations need to be called in the same order
+   * on all processes and may hence not be distributed over several threads.
+   */
+  template <typename VECTOR>
+  struct is_distributed_vector : std::false_type
+  {};
+
+#ifdef DOPELIB_WITH_TRILINOS
+  template <>
+  struct is_distributed_vector<dealii::TrilinosWrappers::MPI::Vector> : std::true_type
+  {};
+
+  template <>
+  struct is_distributed_vector<dealii::TrilinosWrappers::MPI::BlockVector> : std::true_type
+  {};
+#endif
+
   // Distributed: vmult, solve, +, -, constraints, assemble into
   // Ghosted: linearization point, output, anything that evaluates
 
@@ -157,6 +535,200 @@ namespace DOpEHelper
   }
 #endif
 
+  namespace internal
+  {
+#ifdef DOPELIB_WITH_TRILINOS
+    /**
+     * Initializes owned with the locally owned entries of the ghosted
+     * vector v. Only the locally owned range is allocated and imported.
+     */
+    inline void
+    owned_copy(const TrilinosWrappers::MPI::Vector &v, TrilinosWrappers::MPI::Vector &owned)
+    {
+      owned.reinit(v.locally_owned_elements(), v.get_mpi_communicator(), true);
+      owned = v;
+    }
+
+    inline void
+    owned_copy(const TrilinosWrappers::MPI::BlockVector &v, TrilinosWrappers::MPI::BlockVector &owned)
+    {
+      std::vector<unsigned int> counts;
+      for (unsigned int b = 0; b < v.n_blocks(); b++)
+        counts.push_back(v.block(b).size());
+
+      owned.reinit(split_blockwise(v.locally_owned_elements(), counts),
+                   v.block(0).get_mpi_communicator(), true);
+      owned = v;
+    }
+#endif
+
+    template <typename VECTOR, typename OP>
+    void
+    update_owned(VECTOR &v, OP op, std::false_type)
+    {
+      op(v);
+    }
+
+    template <typename VECTOR, typename OP>
+    void
+    update_owned(VECTOR &v, OP op, std::true_type)
+    {
+      if (!v.has_ghost_elements())
+        {
+          op(v);
+          return;
+        }
+      VECTOR tmp;
+      owned_copy(v, tmp);
+      op(tmp);
+      // Assigning to the ghosted vector updates the ghost values.
+      v = tmp;
+    }
+
+    template <typename VECTOR, typename OP>
+    void
+    update_owned(VECTOR &v, const VECTOR &w, OP op, std::false_type)
+    {
+      op(v, w);
+    }
+
+    template <typename VECTOR, typename OP>
+    void
+    update_owned(VECTOR &v, const VECTOR &w, OP op, std::true_type)
+    {
+      if (!w.has_ghost_elements())
+        {
+          update_owned(v, [&w, &op](VECTOR &tmp) { op(tmp, w); }, std::true_type());
+          return;
+        }
+      VECTOR w_tmp;
+      owned_copy(w, w_tmp);
+      update_owned(v, [&w_tmp, &op](VECTOR &tmp) { op(tmp, w_tmp); }, std::true_type());
+    }
+
+#ifdef DOPELIB_WITH_TRILINOS
+    inline MPI_Comm
+    get_mpi_communicator(const TrilinosWrappers::MPI::Vector &v)
+    {
+      return v.get_mpi_communicator();
+    }
+
+    inline MPI_Comm
+    get_mpi_communicator(const TrilinosWrappers::MPI::BlockVector &v)
+    {
+      return v.block(0).get_mpi_communicator();
+    }
+#endif
+
+    template <typename VECTOR>
+    double
+    sum_over_processes(double value, const VECTOR &, std::false_type)
+    {
+      return value;
+    }
+
+    template <typename VECTOR>
+    double
+    sum_over_processes(double value, const VECTOR &v, std::true_type)
+    {
+      return dealii::Utilities::MPI::sum(value, get_mpi_communicator(v));
+    }
+
+    template <typename VECTOR>
+    double
+    max_over_processes(double value, const VECTOR &, std::false_type)
+    {
+      return value;
+    }
+
+    template <typename VECTOR>
+    double
+    max_over_processes(double value, const VECTOR &v, std::true_type)
+    {
+      return dealii::Utilities::MPI::max(value, get_mpi_communicator(v));
+    }
+
+    template <typename VECTOR>
+    double
+    dot(const VECTOR &v, const VECTOR &w, std::false_type)
+    {
+      return v * w;
+    }
+
+    template <typename VECTOR>
+    double
+    dot(const VECTOR &v, const VECTOR &w, std::true_type)
+    {
+      if (!v.has_ghost_elements() && !w.has_ghost_elements())
+        return v * w;
+      double local = 0.;
+      for (const auto j : v.locally_owned_elements())
+        local += static_cast<double>(v(j)) * static_cast<double>(w(j));
+      return sum_over_processes(local, v, std::true_type());
+    }
+  } // namespace internal
+
+  /**
+   * Applies the operation op to the vector v, i.e., op(v) is called.
+   * Distributed vectors with ghost entries can not be written to, in this
+   * case op is applied to a copy of the locally owned range and the result
+   * is copied back, which updates the ghost entries of v.
+   *
+   * Any loop over the entries of v within op should only visit
+   * v.locally_owned_elements().
+   */
+  template <typename VECTOR, typename OP>
+  void
+  update_owned(VECTOR &v, OP op)
+  {
+    internal::update_owned(v, op, is_distributed_vector<VECTOR>());
+  }
+
+  /**
+   * Same as above for operations with a second argument, i.e., op(v,w)
+   * is called. If w has ghost entries, op gets a copy of its locally
+   * owned range instead.
+   */
+  template <typename VECTOR, typename OP>
+  void
+  update_owned(VECTOR &v, const VECTOR &w, OP op)
+  {
+    internal::update_owned(v, w, op, is_distributed_vector<VECTOR>());
+  }
+
+  /**
+   * Returns the scalar product of v and w. Distributed vectors
+   * may have ghost entries, which are not counted.
+   */
+  template <typename VECTOR>
+  double
+  dot(const VECTOR &v, const VECTOR &w)
+  {
+    return internal::dot(v, w, is_distributed_vector<VECTOR>());
+  }
+
+  /**
+   * Returns the sum of value over all processes sharing the vector v.
+   * For serial vectors value is returned.
+   */
+  template <typename VECTOR>
+  double
+  sum_over_processes(double value, const VECTOR &v)
+  {
+    return internal::sum_over_processes(value, v, is_distributed_vector<VECTOR>());
+  }
+
+  /**
+   * Returns the maximum of value over all processes sharing the vector v.
+   * For serial vectors value is returned.
+   */
+  template <typename VECTOR>
+  double
+  max_over_processes(double value, const VECTOR &v)
+  {
+    return internal::max_over_processes(value, v, is_distributed_vector<VECTOR>());
+  }
+
 } // namespace DOpEHelper
 
 #endif /* DOpEHelper_H_ */
@@ -0,0 +1,207 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef ITERATE_POOL_H_
+#define ITERATE_POOL_H_
+
+#include <include/parameterreader.h>
+#include <include/controlvector.h>
+
+#include <deque>
+#include <limits>
+
+namespace DOpE
+{
+  /**
+   * @class IteratePool
+   *
+   * This class stores the state and adjoint solutions of the last accepted
+   * iterates of an optimization algorithm together with their controls.
+   * For a new control the stored solutions of the closest control (in the
+   * euclidean norm of the control vectors) can be used as initial guess
+   * of the Newton method. In contrast to the solution of the last call
+   * these are never the solutions to a rejected trial control of a line search.
+   *
+   * The number of stored iterates is given by the parameter iterate_pool_size.
+   * If it is zero, nothing is stored.
+   *
+   * @tparam <VECTOR>     The spatial vector type.
+   */
+  template<typename VECTOR>
+  class IteratePool
+  {
+  public:
+    IteratePool(ParameterReader &param_reader);
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Deletes all stored iterates. Needs to be called if the
+     * discretization changes.
+     */
+    void Clear();
+
+    /**
+     * Stores the state u and the adjoint z belonging to the accepted control q.
+     * If the pool is full the oldest iterate is replaced.
+     */
+    void Add(const ControlVector<VECTOR> &q, const VECTOR &u, const VECTOR &z);
+
+    /**
+     * Copies the state of the stored iterate closest to q into u.
+     *
+     * @return           False if the pool is empty. Then u is not changed.
+     */
+    bool GetState(const ControlVector<VECTOR> &q, VECTOR &u) const;
+
+    /**
+     * Copies the adjoint of the stored iterate closest to q into z.
+     *
+     * @return           False if the pool is empty. Then z is not changed.
+     */
+    bool GetAdjoint(const ControlVector<VECTOR> &q, VECTOR &z) const;
+
+  private:
+    /**
+     * Returns the position of the stored control closest to q.
+     */
+    unsigned int FindClosest(const ControlVector<VECTOR> &q) const;
+
+    unsigned int size_;
+
+    //The most recent iterate first.
+    std::deque<ControlVector<VECTOR> > controls_;
+    std::deque<VECTOR> states_;
+    std::deque<VECTOR> adjoints_;
+  };
+
+  /*********************************Implementation************************************************/
+
+  template<typename VECTOR>
+  void IteratePool<VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("statreducedproblem parameters");
+    param_reader.declare_entry("iterate_pool_size", "0",Patterns::Integer(0),"number of accepted iterates whose state and adjoint are kept as initial guesses. 0 uses the last computed solution");
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  IteratePool<VECTOR>::IteratePool(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("statreducedproblem parameters");
+    size_ = param_reader.get_integer("iterate_pool_size");
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  void IteratePool<VECTOR>::Clear()
+  {
+    controls_.clear();
+    states_.clear();
+    adjoints_.clear();
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  void IteratePool<VECTOR>::Add(const ControlVector<VECTOR> &q, const VECTOR &u, const VECTOR &z)
+  {
+    if (size_ == 0)
+      return;
+    if (controls_.size() < size_)
+      {
+        //The copy constructor only copies the layout of q.
+        controls_.push_front(q);
+        controls_.front() = q;
+        states_.push_front(u);
+        adjoints_.push_front(z);
+      }
+    else
+      {
+        controls_.pop_back();
+        controls_.push_front(q);
+        controls_.front() = q;
+        //Reuse the memory of the oldest iterate
+        states_.push_front(VECTOR());
+        states_.front().swap(states_.back());
+        states_.pop_back();
+        states_.front() = u;
+        adjoints_.push_front(VECTOR());
+        adjoints_.front().swap(adjoints_.back());
+        adjoints_.pop_back();
+        adjoints_.front() = z;
+      }
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  bool IteratePool<VECTOR>::GetState(const ControlVector<VECTOR> &q, VECTOR &u) const
+  {
+    if (controls_.empty())
+      return false;
+    u = states_[FindClosest(q)];
+    return true;
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  bool IteratePool<VECTOR>::GetAdjoint(const ControlVector<VECTOR> &q, VECTOR &z) const
+  {
+    if (controls_.empty())
+      return false;
+    z = adjoints_[FindClosest(q)];
+    return true;
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  unsigned int IteratePool<VECTOR>::FindClosest(const ControlVector<VECTOR> &q) const
+  {
+    if (controls_.size() == 1)
+      return 0;
+
+    ControlVector<VECTOR> tmp(q);
+    unsigned int closest = 0;
+    double min_dist = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < controls_.size(); i++)
+      {
+        tmp = q;
+        tmp.add(-1., controls_[i]);
+        const double dist = tmp * tmp;
+        //On ties the most recent iterate wins.
+        if (dist < min_dist)
+          {
+            min_dist = dist;
+            closest = i;
+          }
+      }
+    return closest;
+  }
+}
+
+#endif
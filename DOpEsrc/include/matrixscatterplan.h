@@ -0,0 +1,484 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef MATRIX_SCATTER_PLAN_H_
+#define MATRIX_SCATTER_PLAN_H_
+
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+
+#include <cstddef>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DOpE
+{
+  namespace internal
+  {
+    /**
+     * Direct access to the entries of a matrix by their position in the
+     * value array of its sparsity pattern. A position is given by the number
+     * of the block and the index in the value array of this block. This is
+     * not available for general matrices, e.g., the trilinos-based ones.
+     */
+    template <typename MATRIX>
+    struct MatrixEntryAccess
+    {
+      static const bool available = false;
+    };
+
+    template <typename number>
+    struct MatrixEntryAccess<dealii::SparseMatrix<number> >
+    {
+      static const bool available = true;
+
+      static const void *
+      Pattern(const dealii::SparseMatrix<number> &matrix)
+      {
+        return &matrix.get_sparsity_pattern();
+      }
+
+      static unsigned int
+      NBlocks(const dealii::SparseMatrix<number> &)
+      {
+        return 1;
+      }
+
+      static std::size_t
+      NEntries(const dealii::SparseMatrix<number> &matrix, unsigned int)
+      {
+        return matrix.n_nonzero_elements();
+      }
+
+      /**
+       * Returns the position of the entry (i,j), the index is
+       * dealii::SparsityPattern::invalid_entry if the entry does not exist.
+       */
+      static std::pair<unsigned int, std::size_t>
+      Locate(const dealii::SparseMatrix<number> &matrix, unsigned int i, unsigned int j)
+      {
+        return std::make_pair(0u, static_cast<std::size_t>(matrix.get_sparsity_pattern()(i, j)));
+      }
+
+      static bool
+      IsValid(const std::pair<unsigned int, std::size_t> &position)
+      {
+        return position.second != dealii::SparsityPattern::invalid_entry;
+      }
+
+      static void
+      Write(dealii::SparseMatrix<number> &matrix, const std::pair<unsigned int, std::size_t> &position,
+            number value, bool overwrite)
+      {
+        typename dealii::SparseMatrix<number>::iterator entry(&matrix, position.second);
+        if (overwrite)
+          entry->value() = value;
+        else
+          entry->value() += value;
+      }
+    };
+
+    template <typename number>
+    struct MatrixEntryAccess<dealii::BlockSparseMatrix<number> >
+    {
+      static const bool available = true;
+
+      static const void *
+      Pattern(const dealii::BlockSparseMatrix<number> &matrix)
+      {
+        return &matrix.get_sparsity_pattern();
+      }
+
+      static unsigned int
+      NBlocks(const dealii::BlockSparseMatrix<number> &matrix)
+      {
+        return matrix.n_block_rows() * matrix.n_block_cols();
+      }
+
+      static std::size_t
+      NEntries(const dealii::BlockSparseMatrix<number> &matrix, unsigned int block)
+      {
+        return matrix.block(block / matrix.n_block_cols(), block % matrix.n_block_cols())
+               .n_nonzero_elements();
+      }
+
+      static std::pair<unsigned int, std::size_t>
+      Locate(const dealii::BlockSparseMatrix<number> &matrix, unsigned int i, unsigned int j)
+      {
+        const auto row = matrix.get_row_indices().global_to_local(i);
+        const auto col = matrix.get_column_indices().global_to_local(j);
+        return std::make_pair(row.first * matrix.n_block_cols() + col.first,
+                              static_cast<std::size_t>(
+                                matrix.block(row.first, col.first).get_sparsity_pattern()(row.second, col.second)));
+      }
+
+      static bool
+      IsValid(const std::pair<unsigned int, std::size_t> &position)
+      {
+        return position.second != dealii::SparsityPattern::invalid_entry;
+      }
+
+      static void
+      Write(dealii::BlockSparseMatrix<number> &matrix, const std::pair<unsigned int, std::size_t> &position,
+            number value, bool overwrite)
+      {
+        typename dealii::SparseMatrix<number>::iterator entry(
+          &matrix.block(position.first / matrix.n_block_cols(), position.first % matrix.n_block_cols()),
+          position.second);
+        if (overwrite)
+          entry->value() = value;
+        else
+          entry->value() += value;
+      }
+    };
+  }
+
+  /**
+   * @class MatrixScatterPlan
+   *
+   * Stores for each element visited by Integrator::ComputeMatrix the global
+   * DoF indices and whether any of them is constrained. Elements without
+   * constrained DoFs can then be added to the matrix directly, without
+   * the constraint resolution of distribute_local_to_global.
+   *
+   * For the matrices of deal.II the plan also stores the positions of the
+   * entries of these elements in the value arrays of the matrix, see
+   * PreparePositions. Their local matrices are then written into the
+   * value arrays without searching the entries in the sparsity pattern.
+   *
+   * The plan is recorded during one assembly and is kept as long as the
+   * DoFHandler, the constraints and the tickets of the SpaceTimeHandler
+   * stay the same.
+   */
+  class MatrixScatterPlan
+  {
+  public:
+    MatrixScatterPlan()
+      : valid_(false), dof_handler_(NULL), constraints_(NULL),
+        state_ticket_(0), control_ticket_(0), pattern_(NULL),
+        use_positions_(false), overwrite_(false), overwrite_possible_(false)
+    {
+    }
+
+    /**
+     * Deletes the stored plan.
+     */
+    void
+    Clear()
+    {
+      valid_ = false;
+      dof_handler_ = NULL;
+      constraints_ = NULL;
+      std::vector<std::vector<unsigned int> >().swap(dof_indices_);
+      std::vector<bool>().swap(constrained_);
+      ClearPositions();
+    }
+
+    /**
+     * Checks if the stored plan can be used for an assembly on the given
+     * DoFHandler with the given constraints. If not, the plan is cleared
+     * and the following assembly needs to record it by calling Record for
+     * each element and Finalize at the end.
+     *
+     * @param sth            The SpaceTimeHandler, only its tickets are checked.
+     * @param dof_handler    The DoFHandler of the assembly.
+     * @param constraints    The constraints of the assembly.
+     *
+     * @return               True if the plan is valid.
+     */
+    template<typename STH, typename DOFHANDLER, typename CONSTRAINTS>
+    bool
+    Prepare(const STH &sth, const DOFHANDLER *dof_handler, const CONSTRAINTS &constraints)
+    {
+      //Both tickets need to be checked, since checking updates them.
+      const bool valid_state = sth.IsValidStateTicket(state_ticket_);
+      const bool valid_control = sth.IsValidControlTicket(control_ticket_);
+      if (valid_ && valid_state && valid_control
+          && dof_handler_ == dof_handler && constraints_ == &constraints)
+        {
+          return true;
+        }
+      Clear();
+      dof_handler_ = dof_handler;
+      constraints_ = &constraints;
+      return false;
+    }
+
+    /**
+     * Stores the global DoF indices of the element with the given number
+     * in the loop over all elements.
+     */
+    template<typename CONSTRAINTS>
+    void
+    Record(unsigned int element, const std::vector<unsigned int> &local_dof_indices,
+           const CONSTRAINTS &constraints)
+    {
+      if (dof_indices_.size() <= element)
+        {
+          dof_indices_.resize(element + 1);
+          constrained_.resize(element + 1, false);
+        }
+      dof_indices_[element] = local_dof_indices;
+      bool constrained = false;
+      for (unsigned int i = 0; i < local_dof_indices.size() && !constrained; i++)
+        {
+          constrained = constraints.is_constrained(local_dof_indices[i]);
+        }
+      constrained_[element] = constrained;
+    }
+
+    /**
+     * Marks the plan as complete. Must be called after the loop over all
+     * elements has finished.
+     */
+    void
+    Finalize()
+    {
+      valid_ = true;
+    }
+
+    const std::vector<unsigned int> &
+    GetDoFIndices(unsigned int element) const
+    {
+      return dof_indices_[element];
+    }
+
+    bool
+    IsConstrained(unsigned int element) const
+    {
+      return constrained_[element];
+    }
+
+    /**
+     * Locates the entries of the local matrices of all unconstrained
+     * elements in the value arrays of matrix, unless this has been done
+     * for the sparsity pattern of matrix already. Must be called before
+     * Add in each assembly with a valid plan. The positions are only
+     * available for the matrices given in internal::MatrixEntryAccess,
+     * otherwise Add uses matrix.add.
+     *
+     * If allow_overwrite is true, no element is constrained and the
+     * elements cover all entries of matrix, Add assigns the first value
+     * written to each entry instead of adding it. Then the matrix needs
+     * not to be zeroed before the assembly.
+     *
+     * @return True if Add overwrites the entries of matrix.
+     */
+    template<typename MATRIX>
+    bool
+    PreparePositions(const MATRIX &matrix, bool allow_overwrite)
+    {
+      LocatePositions(matrix,
+                      std::integral_constant<bool, internal::MatrixEntryAccess<MATRIX>::available>());
+      overwrite_ = use_positions_ && allow_overwrite && overwrite_possible_;
+      return overwrite_;
+    }
+
+    /**
+     * Adds the local matrix of the unconstrained element with the given
+     * number to matrix.
+     */
+    template<typename MATRIX, typename SCALAR>
+    void
+    Add(unsigned int element, const dealii::FullMatrix<SCALAR> &local_matrix, MATRIX &matrix)
+    {
+      AddElement(element, local_matrix, matrix,
+                 std::integral_constant<bool, internal::MatrixEntryAccess<MATRIX>::available>());
+    }
+
+  private:
+    void
+    ClearPositions()
+    {
+      pattern_ = NULL;
+      use_positions_ = false;
+      overwrite_ = false;
+      overwrite_possible_ = false;
+      std::vector<std::vector<std::pair<unsigned int, std::size_t> > >().swap(positions_);
+      std::vector<std::vector<bool> >().swap(first_write_);
+    }
+
+    template<typename MATRIX>
+    void
+    LocatePositions(const MATRIX &, std::false_type)
+    {
+      use_positions_ = false;
+    }
+
+    template<typename MATRIX>
+    void
+    LocatePositions(const MATRIX &matrix, std::true_type)
+    {
+      typedef internal::MatrixEntryAccess<MATRIX> ACCESS;
+      if (pattern_ == ACCESS::Pattern(matrix))
+        {
+          use_positions_ = true;
+          return;
+        }
+      ClearPositions();
+
+      //The elements are visited in the same order in each assembly,
+      //so the first write to each entry is known.
+      std::vector<std::vector<bool> > written(ACCESS::NBlocks(matrix));
+      for (unsigned int b = 0; b < written.size(); b++)
+        {
+          written[b].resize(ACCESS::NEntries(matrix, b), false);
+        }
+      std::size_t n_written = 0;
+      bool constrained = false;
+
+      positions_.resize(dof_indices_.size());
+      first_write_.resize(dof_indices_.size());
+      for (unsigned int element = 0; element < dof_indices_.size(); element++)
+        {
+          if (constrained_[element])
+            {
+              constrained = true;
+              continue;
+            }
+          const std::vector<unsigned int> &indices = dof_indices_[element];
+          const unsigned int n = indices.size();
+          positions_[element].resize(n * n);
+          first_write_[element].resize(n * n, false);
+          for (unsigned int i = 0; i < n; i++)
+            {
+              for (unsigned int j = 0; j < n; j++)
+                {
+                  const std::pair<unsigned int, std::size_t> position
+                    = ACCESS::Locate(matrix, indices[i], indices[j]);
+                  if (!ACCESS::IsValid(position))
+                    {
+                      //The sparsity pattern does not fit, matrix.add
+                      //will report the missing entry.
+                      ClearPositions();
+                      return;
+                    }
+                  positions_[element][i * n + j] = position;
+                  if (!written[position.first][position.second])
+                    {
+                      written[position.first][position.second] = true;
+                      first_write_[element][i * n + j] = true;
+                      n_written++;
+                    }
+                }
+            }
+        }
+      std::size_t n_entries = 0;
+      for (unsigned int b = 0; b < written.size(); b++)
+        {
+          n_entries += written[b].size();
+        }
+
+      pattern_ = ACCESS::Pattern(matrix);
+      use_positions_ = true;
+      overwrite_possible_ = !constrained && n_written == n_entries;
+    }
+
+    template<typename MATRIX, typename SCALAR>
+    void
+    AddElement(unsigned int element, const dealii::FullMatrix<SCALAR> &local_matrix, MATRIX &matrix,
+               std::false_type)
+    {
+      matrix.add(dof_indices_[element], local_matrix);
+    }
+
+    template<typename MATRIX, typename SCALAR>
+    void
+    AddElement(unsigned int element, const dealii::FullMatrix<SCALAR> &local_matrix, MATRIX &matrix,
+               std::true_type)
+    {
+      if (!use_positions_)
+        {
+          matrix.add(dof_indices_[element], local_matrix);
+          return;
+        }
+      typedef internal::MatrixEntryAccess<MATRIX> ACCESS;
+      const std::vector<std::pair<unsigned int, std::size_t> > &positions = positions_[element];
+      const std::vector<bool> &first_write = first_write_[element];
+      const unsigned int n = local_matrix.m();
+      for (unsigned int i = 0; i < n; i++)
+        {
+          for (unsigned int j = 0; j < n; j++)
+            {
+              ACCESS::Write(matrix, positions[i * n + j], local_matrix(i, j),
+                            overwrite_ && first_write[i * n + j]);
+            }
+        }
+    }
+
+    bool valid_;
+    const void *dof_handler_;
+    const void *constraints_;
+    unsigned int state_ticket_, control_ticket_;
+
+    std::vector<std::vector<unsigned int> > dof_indices_;
+    std::vector<bool> constrained_;
+
+    //The sparsity pattern the positions belong to.
+    const void *pattern_;
+    bool use_positions_, overwrite_, overwrite_possible_;
+    std::vector<std::vector<std::pair<unsigned int, std::size_t> > > positions_;
+    std::vector<std::vector<bool> > first_write_;
+  };
+
+  /**
+   * @class MatrixScatterPlans
+   *
+   * Keeps one MatrixScatterPlan for each pair of DoFHandler and constraints
+   * an Integrator assembles matrices for. Thus, the plans are not recorded
+   * again if the assembly alternates between different problems, e.g.,
+   * state and adjoint, or state and control.
+   */
+  class MatrixScatterPlans
+  {
+  public:
+    /**
+     * Deletes all stored plans.
+     */
+    void
+    Clear()
+    {
+      plans_.clear();
+    }
+
+    /**
+     * Returns the plan for the given DoFHandler and constraints. A new,
+     * empty plan is created if none exists yet.
+     */
+    template<typename DOFHANDLER, typename CONSTRAINTS>
+    MatrixScatterPlan &
+    GetPlan(const DOFHANDLER *dof_handler, const CONSTRAINTS &constraints)
+    {
+      return plans_[std::make_pair(static_cast<const void *>(dof_handler),
+                                   static_cast<const void *>(&constraints))];
+    }
+
+  private:
+    std::map<std::pair<const void *, const void *>, MatrixScatterPlan> plans_;
+  };
+}
+
+#endif
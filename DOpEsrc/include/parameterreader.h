@@ -78,6 +78,12 @@ namespace DOpE
      * But the previously subsection is set to the last value set by SetSubsection is used for the declaration.
      */
     inline bool  get_bool (const std::string &entry_name);
+    /**
+     * This is a wrapper to the corresponding dealii::ParameterHandler routine.
+     * But the previously subsection is set to the last value set by SetSubsection is used for the declaration.
+     * It allows to overwrite the values read from the param file.
+     */
+    inline void set (const std::string &entry_name, const std::string &new_value);
 
   private:
     ParameterHandler prm;
@@ -160,5 +166,14 @@ namespace DOpE
     return ret;
   }
 
+  void ParameterReader::set(const std::string &entry_name, const std::string &new_value)
+  {
+    prm.enter_subsection(subsection_);
+    {
+      prm.set(entry_name, new_value);
+    }
+    prm.leave_subsection();
+  }
+
 }
 #endif
@@ -0,0 +1,202 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef POINT_EVALUATION_CACHE_H_
+#define POINT_EVALUATION_CACHE_H_
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <cassert>
+#include <vector>
+
+#include <include/dopeexception.h>
+
+namespace DOpE
+{
+  /**
+   * @class PointEvaluationCache
+   *
+   * Evaluates finite element functions in fixed points. For each point
+   * the element containing it, the global DoF indices of this element and
+   * the values of all shape functions in the point are computed once,
+   * afterwards an evaluation costs O(dofs_per_cell) instead of a search
+   * through the mesh as in dealii::VectorTools::point_value.
+   *
+   * Before the evaluations the cache has to be prepared by Prepare with
+   * the SpaceTimeHandler of the DoFHandler. This sets the mapping and
+   * deletes the stored points if the state ticket of the SpaceTimeHandler
+   * is no longer valid, i.e., if the DoFs have been redistributed.
+   *
+   * @tparam <dim>     The dimension of the domain.
+   */
+  template<int dim>
+  class PointEvaluationCache
+  {
+  public:
+    PointEvaluationCache()
+      : mapping_(NULL), ticket_(0)
+    {
+    }
+
+    /**
+     * Deletes all stored points.
+     */
+    void
+    Clear()
+    {
+      entries_.clear();
+    }
+
+    /**
+     * Prepares the following evaluations. The mapping of sth is used, and
+     * the stored points are deleted if the state DoFs of sth have changed
+     * since the last call.
+     *
+     * @param sth            The SpaceTimeHandler owning the state DoFHandler
+     *                       on which the points are evaluated.
+     */
+    template<typename STH>
+    void
+    Prepare(const STH &sth)
+    {
+      const dealii::Mapping<dim> *mapping = &(sth.GetMapping()[0]);
+      //The ticket needs to be checked in any case, since checking updates it.
+      const bool valid = sth.IsValidStateTicket(ticket_);
+      if (!valid || mapping != mapping_)
+        {
+          Clear();
+        }
+      mapping_ = mapping;
+    }
+
+    /**
+     * Computes the values of all components of the finite element
+     * function v in the point p.
+     *
+     * @param dof_handler    The DoFHandler of v.
+     * @param v              The coefficient vector.
+     * @param p              The point.
+     * @param values         Upon exit, the values of the components of v in p.
+     */
+    template<typename DOFHANDLER, typename VECTOR>
+    void
+    PointValue(const DOFHANDLER &dof_handler, const VECTOR &v,
+               const dealii::Point<dim> &p, dealii::Vector<double> &values)
+    {
+      const Entry &entry = GetEntry(dof_handler, p);
+      values.reinit(entry.shape_values.n());
+      for (unsigned int i = 0; i < entry.dof_indices.size(); i++)
+        {
+          const double v_i = v(entry.dof_indices[i]);
+          for (unsigned int c = 0; c < entry.shape_values.n(); c++)
+            values(c) += v_i * entry.shape_values(i, c);
+        }
+    }
+
+    /**
+     * Adds the point source sum_c weights(c) * delta_p e_c to the right hand
+     * side rhs, i.e., rhs_i += sum_c weights(c) * phi_i^c(p).
+     *
+     * @param dof_handler    The DoFHandler of rhs.
+     * @param p              The point.
+     * @param weights        The weights of the components of the source.
+     * @param rhs            The vector to which the source is added.
+     */
+    template<typename DOFHANDLER, typename VECTOR>
+    void
+    AddPointSource(const DOFHANDLER &dof_handler, const dealii::Point<dim> &p,
+                   const dealii::Vector<double> &weights, VECTOR &rhs)
+    {
+      const Entry &entry = GetEntry(dof_handler, p);
+      assert(weights.size() == entry.shape_values.n());
+      for (unsigned int i = 0; i < entry.dof_indices.size(); i++)
+        {
+          double tmp = 0.;
+          for (unsigned int c = 0; c < entry.shape_values.n(); c++)
+            tmp += weights(c) * entry.shape_values(i, c);
+          rhs(entry.dof_indices[i]) += tmp;
+        }
+    }
+
+  private:
+    struct Entry
+    {
+      dealii::Point<dim> point;
+      std::vector<dealii::types::global_dof_index> dof_indices;
+      /**
+       * Values of the shape functions (rows) in the point
+       * for each component (columns).
+       */
+      dealii::FullMatrix<double> shape_values;
+    };
+
+    template<typename DOFHANDLER>
+    const Entry &
+    GetEntry(const DOFHANDLER &dof_handler, const dealii::Point<dim> &p)
+    {
+      if (mapping_ == NULL)
+        {
+          throw DOpEException("The cache has not been prepared by a SpaceTimeHandler.",
+                              "PointEvaluationCache::GetEntry");
+        }
+      for (const Entry &entry : entries_)
+        {
+          if (entry.point == p)
+            return entry;
+        }
+
+      const dealii::Mapping<dim> &mapping = *mapping_;
+      const auto element_point =
+        dealii::GridTools::find_active_cell_around_point(mapping, dof_handler, p);
+      const auto &fe = element_point.first->get_fe();
+      const dealii::Quadrature<dim> quadrature(
+        dealii::GeometryInfo<dim>::project_to_unit_cell(element_point.second));
+      dealii::FEValues<dim> fe_values(mapping, fe, quadrature, dealii::update_values);
+      fe_values.reinit(element_point.first);
+
+      Entry entry;
+      entry.point = p;
+      entry.dof_indices.resize(fe.dofs_per_cell);
+      element_point.first->get_dof_indices(entry.dof_indices);
+      entry.shape_values.reinit(fe.dofs_per_cell, fe.n_components());
+      for (unsigned int i = 0; i < fe.dofs_per_cell; i++)
+        for (unsigned int c = 0; c < fe.n_components(); c++)
+          entry.shape_values(i, c) = fe_values.shape_value_component(i, 0, c);
+
+      entries_.push_back(entry);
+      return entries_.back();
+    }
+
+    std::vector<Entry> entries_;
+    const dealii::Mapping<dim> *mapping_;
+    unsigned int ticket_;
+  };
+}
+
+#endif
@@ -131,6 +131,25 @@ namespace DOpE
      * Hence prior to calling this Function again UnLockCopy must be called.
      */
     const dealii::Vector<double> &GetSpacialVectorCopy() const;
+    /**
+     * Returns the spatial vector associated to the last time given by SetTime*
+     * as dealii::Vector<double>, for any VECTOR type. If VECTOR is
+     * dealii::Vector<double> the returned reference is the spatial vector
+     * itself, nothing is copied. For other vector types it is a snapshot as
+     * in GetSpacialVectorCopy, which is kept and only copied anew if the
+     * vector has been changed by one of the non-const methods since, or if
+     * another time point is requested. Hence this is the function of choice
+     * to pass parameter (dopedim = 0) vectors to Integrator::AddParamData,
+     * e.g., in each time step.
+     *
+     * Changes made through references obtained from the non-const
+     * GetSpacialVector after a view has been taken are seen by the view for
+     * dealii::Vector<double>, but not by the snapshot of other vector types.
+     * Hence they must not be made while the view is in use.
+     *
+     * As for GetSpacialVectorCopy, the vector is locked until UnLockCopy is called.
+     */
+    const dealii::Vector<double> &GetSpacialVectorView() const;
     /**
      * Sets all the vector to a constant value. This function calls SetTime(0).
      *
@@ -241,7 +260,7 @@ namespace DOpE
      */
     void PrintInfos(std::stringstream &out);
     /**
-     * This unlocks the function GetSpacialVectorCopy
+     * This unlocks the functions GetSpacialVectorCopy and GetSpacialVectorView
      */
     void UnLockCopy() const
     {
@@ -352,6 +371,14 @@ namespace DOpE
      * @return                A bool indicating whether the file exists or not.
      */
     bool FileExists(unsigned int time_point) const;
+    /**
+     * Executes the shell command on the files in tmp_dir_.
+     * Distributed vectors share one file per time point, hence the command
+     * is only executed on the first process and its result is communicated.
+     *
+     * @return                The return value of the command.
+     */
+    int ExecuteCommand(const std::string &command) const;
     /**
      * The Function swaps the Pointers a and b.
      *
@@ -370,18 +397,72 @@ namespace DOpE
      */
     void ResizeLocalVectors(unsigned int size) const;
 
+    /**
+     * Calls f(i) for all time points i of a fullmem vector. The time points
+     * are distributed over the available threads, unless the spatial vectors
+     * are distributed over MPI processes. Reductions need to be computed per time
+     * point by f and summed up afterwards in the order of the time points, this
+     * keeps the result independent of the number of threads.
+     */
+    template<typename FUNCTION>
+    void ForAllTimePoints(const FUNCTION &f) const;
+
+    /**
+     * Passes once through all time points of a store_on_disc vector and calls
+     * f(v, w) for each of them, where v is the spatial vector of this vector
+     * at the time point and w the one of dq (or v again if dq is NULL).
+     * Each time point is read and written exactly once. The time points are
+     * visited in the order 1,...,N,0 such that the vector is left at time point 0,
+     * as after SetTimeDoFNumber(0), without reading it a second time.
+     *
+     * @param dq          The second argument of the operation, may be NULL.
+     * @param fetch_own   Whether the stored values of v need to be read. This is not
+     *                    needed if f overwrites v anyhow.
+     */
+    template<typename FUNCTION>
+    void UpdateTimePoints(const SpaceTimeVector *dq, bool fetch_own,
+                          const FUNCTION &f);
+
+    /**
+     * Read only counterpart of UpdateTimePoints. Calls f(v, w) for the time points
+     * 0,...,N in this order, where v and w are the spatial vectors of this
+     * vector and of dq. Time points that are currently loaded are taken from
+     * the memory, all others are read from the disc. The time point the vector is
+     * set to is not changed.
+     */
+    template<typename FUNCTION>
+    void ReadTimePoints(const SpaceTimeVector &dq, const FUNCTION &f) const;
+
+    /**
+     * Returns the spatial vector GetSpacialVectorCopy and GetSpacialVectorView
+     * copy from. Does not check the lock.
+     */
+    const VECTOR &GetCurrentSpacialVector() const;
+
+    /**
+     * Returns the view of the current spatial vector for GetSpacialVectorView,
+     * i.e., the vector itself if it is a dealii::Vector<double> and the
+     * snapshot view_stvector_ otherwise.
+     */
+    const dealii::Vector<double> &GetView(const dealii::Vector<double> &current) const;
+    template<typename OTHERVECTOR>
+    const dealii::Vector<double> &GetView(const OTHERVECTOR &current) const;
+
     mutable std::vector<VECTOR *> stvector_;
     mutable std::vector<SpatialVectorInfos> stvector_information_;
 
     mutable VECTOR local_stvector_;
     mutable dealii::Vector<double> copy_stvector_;
+    //The snapshot of GetSpacialVectorView for vectors other than
+    //dealii::Vector<double> and its time point, -1 if invalid.
+    mutable dealii::Vector<double> view_stvector_;
+    mutable int view_time_point_;
     mutable int accessor_;
 
     mutable bool lock_;
 
     //Needed in the store_on_disc case for read/write operations on the hard disc
     mutable std::string filename_;
-    mutable std::fstream filestream_;
 
     //Needed in the only_recent case to decide if the operation is allowed.
     mutable unsigned int current_dof_number_;
@@ -0,0 +1,183 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef TIME_STEP_PREDICTOR_H_
+#define TIME_STEP_PREDICTOR_H_
+
+#include <include/parameterreader.h>
+
+#include <deque>
+
+namespace DOpE
+{
+  /**
+   * @class TimeStepPredictor
+   *
+   * This class computes initial guesses for the Newton method in each time
+   * step of a time loop. The solutions of the last time steps are
+   * extrapolated to the new time point by the interpolation polynomial of
+   * degree predictor_order, i.e., constant (the last solution, which is
+   * the default of the Newton solvers), linear or quadratic in time.
+   *
+   * In optimization loops the state (adjoint) of the last accepted
+   * optimization iterate at the same time point is often a better guess.
+   * Whether it should be used, if available, is given by the parameter
+   * predictor_previous_iterate. Trial controls rejected by a line search
+   * are never used.
+   *
+   * @tparam <VECTOR>     The spatial vector type.
+   */
+  template<typename VECTOR>
+  class TimeStepPredictor
+  {
+  public:
+    TimeStepPredictor(ParameterReader &param_reader);
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Deletes all stored solutions. Needs to be called before each time loop.
+     */
+    void Clear();
+
+    /**
+     * Stores the solution u at the time t. Only the last predictor_order+1
+     * solutions are kept.
+     */
+    void Push(const VECTOR &u, double t);
+
+    /**
+     * Extrapolates the stored solutions to the time t.
+     *
+     * @param t          The time point of the next step.
+     * @param guess      Upon exit the extrapolated solution, if the
+     *                   return value is true. Otherwise it is not changed.
+     *
+     * @return           False if no extrapolation is available, i.e., if the
+     *                   predictor_order is zero or less than two solutions are stored.
+     *                   Then the last solution should be used as usual.
+     */
+    bool Predict(double t, VECTOR &guess) const;
+
+    /**
+     * Returns if the solution of the last accepted optimization iterate
+     * should be used instead of the extrapolation.
+     */
+    bool UsePreviousIterate() const
+    {
+      return previous_iterate_;
+    }
+
+  private:
+    unsigned int order_;
+    bool previous_iterate_;
+
+    //The most recent solution first.
+    std::deque<VECTOR> solutions_;
+    std::deque<double> times_;
+  };
+
+  /*********************************Implementation************************************************/
+
+  template<typename VECTOR>
+  void TimeStepPredictor<VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    param_reader.declare_entry("predictor_order", "0",Patterns::Integer(0,2),"order of the extrapolation in time used as initial guess in each time step. 0 uses the last solution");
+    param_reader.declare_entry("predictor_previous_iterate", "false",Patterns::Bool(),"use the state and adjoint of the last accepted optimization iterate as initial guess if available");
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  TimeStepPredictor<VECTOR>::TimeStepPredictor(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    order_ = param_reader.get_integer("predictor_order");
+    previous_iterate_ = param_reader.get_bool("predictor_previous_iterate");
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  void TimeStepPredictor<VECTOR>::Clear()
+  {
+    solutions_.clear();
+    times_.clear();
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  void TimeStepPredictor<VECTOR>::Push(const VECTOR &u, double t)
+  {
+    if (order_ == 0)
+      return;
+    if (solutions_.size() < order_ + 1)
+      {
+        solutions_.push_front(u);
+      }
+    else
+      {
+        //Reuse the memory of the oldest solution
+        solutions_.push_front(VECTOR());
+        solutions_.front().swap(solutions_.back());
+        solutions_.pop_back();
+        times_.pop_back();
+        solutions_.front() = u;
+      }
+    times_.push_front(t);
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  bool TimeStepPredictor<VECTOR>::Predict(double t, VECTOR &guess) const
+  {
+    if (solutions_.size() < 2)
+      return false;
+
+    //Lagrange interpolation through the stored time points, evaluated at t.
+    for (unsigned int k = 0; k < solutions_.size(); k++)
+      {
+        double weight = 1.;
+        for (unsigned int j = 0; j < solutions_.size(); j++)
+          {
+            if (j != k)
+              weight *= (t - times_[j]) / (times_[k] - times_[j]);
+          }
+        if (k == 0)
+          {
+            guess = solutions_[0];
+            guess *= weight;
+          }
+        else
+          {
+            guess.add(weight, solutions_[k]);
+          }
+      }
+    return true;
+  }
+}
+
+#endif
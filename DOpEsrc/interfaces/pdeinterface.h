@@ -840,6 +840,58 @@ namespace DOpE
       throw DOpEException("Not Implemented", "PDEInterface::ElementTimeMatrix");
     }
 
+    /******************************************************/
+    /**
+     * Fused version of ElementEquation and ElementTimeEquation used by
+     * the time stepping schemes in tsschemes/ if HasFusedElementTerms
+     * returns true. It has to add
+     *
+     * ElementEquation(edc, local_vector, scale, scale_ico)
+     * + ElementTimeEquation(edc, local_vector, scale_time)
+     *
+     * to local_vector, so that the values of the ElementDataContainer
+     * need to be fetched only once per quadrature point.
+     *
+     * @param edc                The ElementDataContainer object.
+     * @param local_vector       The vector containing the integrals.
+     * @param scale              The scale of ElementEquation.
+     * @param scale_ico          The scale_ico of ElementEquation.
+     * @param scale_time         The scale of ElementTimeEquation.
+     */
+    virtual void
+    ElementEquationAndTimeEquation(
+      const EDC<DH, VECTOR, dealdim> & /*edc*/,
+      dealii::Vector<double> &/*local_vector*/,
+      double /*scale*/,
+      double /*scale_ico*/,
+      double /*scale_time*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::ElementEquationAndTimeEquation");
+    }
+
+    /******************************************************/
+    /**
+     * Fused version of ElementMatrix and ElementTimeMatrix, see
+     * ElementEquationAndTimeEquation. It has to add
+     *
+     * ElementMatrix(edc, local_entry_matrix, scale, scale_ico)
+     * + scale_time * ElementTimeMatrix(edc, local_entry_matrix)
+     *
+     * to local_entry_matrix.
+     */
+    virtual void
+    ElementMatrixAndTimeMatrix(
+      const EDC<DH, VECTOR, dealdim> & /*edc*/,
+      dealii::FullMatrix<double> &/*local_entry_matrix*/,
+      double /*scale*/,
+      double /*scale_ico*/,
+      double /*scale_time*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::ElementMatrixAndTimeMatrix");
+    }
+
     /******************************************************/
     /**
      * The transposed of ElementTimeEquation.
@@ -1388,6 +1440,153 @@ namespace DOpE
       throw DOpEException("Not Implemented", "PDEInterface::InterfaceMatrix");
     }
 
+    /******************************************************/
+    // Two-sided integrals over interfaces, used instead of
+    // FaceEquation and InterfaceEquation (resp. FaceMatrix and
+    // InterfaceMatrix) on faces where AtInterface is true if
+    // HasTwoSidedInterfaces returns true. Each interior face is
+    // then visited only once and the contributions for the test
+    // functions of both adjacent elements are computed at once,
+    // i.e., with the shape functions from GetFEFaceValuesState
+    // and GetNbrFEFaceValuesState.
+    // The problem wrappers use the derivatives _U, _UT and _UTT
+    // below for the adjoint, tangent and adjoint hessian problems,
+    // and InterfaceMatrixTwoSided_T for the transposed matrices.
+
+    /**
+     * Computes the terms of FaceEquation and InterfaceEquation from both sides
+     * of an interior face.
+     *
+     * @param fdc                 The FDC, initialized on the face and the neighbor.
+     * @param local_vector        The contributions for the test functions of the element.
+     * @param nbr_local_vector    The contributions for the test functions of the neighbor.
+     */
+    virtual void
+    InterfaceEquationTwoSided(
+      const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+      dealii::Vector<double> &/*local_vector*/,
+      dealii::Vector<double> &/*nbr_local_vector*/,
+      double /*scale*/,
+      double /*scale_ico*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::InterfaceEquationTwoSided");
+    }
+
+    /******************************************************/
+
+    /**
+     * Computes the terms of FaceMatrix and InterfaceMatrix from both sides
+     * of an interior face. The first index of each matrix belongs to the test,
+     * the second to the ansatz functions.
+     *
+     * @param fdc                     The FDC, initialized on the face and the neighbor.
+     * @param local_entry_matrix      Element - element coupling.
+     * @param element_nbr_matrix      Element - neighbor coupling.
+     * @param nbr_element_matrix      Neighbor - element coupling.
+     * @param nbr_matrix              Neighbor - neighbor coupling.
+     */
+    virtual void
+    InterfaceMatrixTwoSided(
+      const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+      dealii::FullMatrix<double> &/*local_entry_matrix*/,
+      dealii::FullMatrix<double> &/*element_nbr_matrix*/,
+      dealii::FullMatrix<double> &/*nbr_element_matrix*/,
+      dealii::FullMatrix<double> &/*nbr_matrix*/,
+      double /*scale*/,
+      double /*scale_ico*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::InterfaceMatrixTwoSided");
+    }
+
+    /******************************************************/
+
+    /**
+     * Transposed version of InterfaceMatrixTwoSided, used by the adjoint
+     * problems. The default implementation computes InterfaceMatrixTwoSided
+     * and adds the transposed couplings, i.e., the element - neighbor
+     * coupling of the transposed matrix is the transposed neighbor - element
+     * coupling of InterfaceMatrixTwoSided.
+     */
+    virtual void
+    InterfaceMatrixTwoSided_T(
+      const FDC<DH, VECTOR, dealdim> &fdc,
+      dealii::FullMatrix<double> &local_entry_matrix,
+      dealii::FullMatrix<double> &element_nbr_matrix,
+      dealii::FullMatrix<double> &nbr_element_matrix,
+      dealii::FullMatrix<double> &nbr_matrix,
+      double scale,
+      double scale_ico)
+    {
+      const unsigned int n_dofs = local_entry_matrix.m();
+      const unsigned int n_nbr_dofs = nbr_matrix.m();
+      dealii::FullMatrix<double> tmp(n_dofs, n_dofs);
+      dealii::FullMatrix<double> tmp_element_nbr(n_dofs, n_nbr_dofs);
+      dealii::FullMatrix<double> tmp_nbr_element(n_nbr_dofs, n_dofs);
+      dealii::FullMatrix<double> tmp_nbr(n_nbr_dofs, n_nbr_dofs);
+      InterfaceMatrixTwoSided(fdc, tmp, tmp_element_nbr, tmp_nbr_element,
+                              tmp_nbr, scale, scale_ico);
+      local_entry_matrix.Tadd(1., tmp);
+      element_nbr_matrix.Tadd(1., tmp_nbr_element);
+      nbr_element_matrix.Tadd(1., tmp_element_nbr);
+      nbr_matrix.Tadd(1., tmp_nbr);
+    }
+
+    /******************************************************/
+
+    /**
+     * Derivative of InterfaceEquationTwoSided with respect to the state,
+     * tested with the adjoint, as InterfaceEquation_U.
+     */
+    virtual void
+    InterfaceEquation_UTwoSided(
+      const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+      dealii::Vector<double> &/*local_vector*/,
+      dealii::Vector<double> &/*nbr_local_vector*/,
+      double /*scale*/,
+      double /*scale_ico*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::InterfaceEquation_UTwoSided");
+    }
+
+    /******************************************************/
+
+    /**
+     * Derivative of InterfaceEquationTwoSided in the tangent direction,
+     * as InterfaceEquation_UT.
+     */
+    virtual void
+    InterfaceEquation_UTTwoSided(
+      const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+      dealii::Vector<double> &/*local_vector*/,
+      dealii::Vector<double> &/*nbr_local_vector*/,
+      double /*scale*/,
+      double /*scale_ico*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::InterfaceEquation_UTTwoSided");
+    }
+
+    /******************************************************/
+
+    /**
+     * Derivative of InterfaceEquation_UTwoSided for the adjoint hessian,
+     * as InterfaceEquation_UTT.
+     */
+    virtual void
+    InterfaceEquation_UTTTwoSided(
+      const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+      dealii::Vector<double> &/*local_vector*/,
+      dealii::Vector<double> &/*nbr_local_vector*/,
+      double /*scale*/,
+      double /*scale_ico*/)
+    {
+      throw DOpEException("Not Implemented",
+                          "PDEInterface::InterfaceEquation_UTTTwoSided");
+    }
+
     /******************************************************/
     //Functions for Interface Integrals
     virtual void
@@ -1860,6 +2059,19 @@ namespace DOpE
       return false;
     }
 
+    /**
+     * Should return true, if the interface terms are given by
+     * InterfaceEquationTwoSided and InterfaceMatrixTwoSided. Then the
+     * integrator visits each face where AtInterface is true only once.
+     *
+     * The default is false.
+     */
+    virtual bool
+    HasTwoSidedInterfaces() const
+    {
+      return false;
+    }
+
     /**
      * Is an evaluation of quantities at vertices needed,
      * e.g., for the dual-basis of vertex based elements
@@ -1872,6 +2084,35 @@ namespace DOpE
       return false;
     }
 
+    /**
+     * Does the ElementTimeMatrix (and ElementTimeMatrix_T) neither depend
+     * on the time, nor on the state or control, e.g., if it is a mass matrix?
+     * In this case the time stepping newton solvers assemble it only once
+     * after each change of the mesh and add it to the remaining terms
+     * of the matrix in each time step.
+     *
+     * Defaults to false
+     */
+    virtual bool
+    HasConstantTimeMatrix() const
+    {
+      return false;
+    }
+
+    /**
+     * Are ElementEquationAndTimeEquation and ElementMatrixAndTimeMatrix
+     * implemented? Then the time stepping schemes of the state equation
+     * use them instead of calling ElementEquation and ElementTimeEquation
+     * (resp. ElementMatrix and ElementTimeMatrix) separately.
+     *
+     * Defaults to false
+     */
+    virtual bool
+    HasFusedElementTerms() const
+    {
+      return false;
+    }
+
     /******************************************************/
 
     void
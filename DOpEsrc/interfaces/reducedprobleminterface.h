@@ -487,6 +487,19 @@ namespace DOpE
                           "ReducedProblemInterface::ComputeReducedHessianInverseVector");
     }
 
+    /**
+     * Informs the reduced problem that q has been accepted as new iterate
+     * by the optimization algorithm. We assume that the state u(q) and the
+     * adjoint z(u(q)) are already computed. Implementations may keep them
+     * as initial guesses for later solves. The default does nothing.
+     *
+     * @param q            The accepted ControlVector.
+     */
+    virtual void
+    AcceptIterate(const ControlVector<VECTOR> & /*q*/)
+    {
+    }
+
     /**
      * We assume that the constraints g have been evaluated at the corresponding
      * point q. This comutes the reduced gradient of the global constraint num
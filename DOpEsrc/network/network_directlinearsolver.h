@@ -90,6 +90,18 @@ namespace DOpE
       template<typename PROBLEM, typename INTEGRATOR>
       void Solve(PROBLEM &pde, INTEGRATOR &integr, BlockVector<double> &rhs, BlockVector<double> &solution, bool force_matrix_build=false);
 
+      /**
+       * The system is solved directly, hence the forcing terms
+       * of inexact Newton methods are ignored.
+       */
+      void SetForcingTerm(double eta);
+
+      /**
+       * Returns the norm of the linear residual reached in the last call of Solve,
+       * which is zero for a direct solver.
+       */
+      double GetLastLinearResidual() const;
+
     protected:
 
     private:
@@ -194,6 +206,19 @@ namespace DOpE
 
     }
 
+    /******************************************************/
+
+    void DirectLinearSolverWithMatrix::SetForcingTerm(double /*eta*/)
+    {
+    }
+
+    /******************************************************/
+
+    double DirectLinearSolverWithMatrix::GetLastLinearResidual() const
+    {
+      return 0.;
+    }
+
 ///////////////Endof Namespaces
   }
 }
@@ -29,12 +29,15 @@
 #include <include/dopeexceptionhandler.h>
 #include <include/outputhandler.h>
 #include <include/controlvector.h>
+#include <include/helper.h>
 
 #include <deal.II/lac/vector.h>
+#include <deal.II/base/parallel.h>
 
 #include <iostream>
 #include <assert.h>
 #include <iomanip>
+#include <vector>
 
 namespace DOpE
 {
@@ -134,17 +137,6 @@ namespace DOpE
     virtual void
     CheckGrads(double c, ControlVector<VECTOR> &q,
                ControlVector<VECTOR> &dq, unsigned int niter = 1, double eps = 1.);
-    /**
-     * Is called to calculate first difference quotients
-     *
-     * @double exact      The value of j'(q)
-     * @param eps         The value for eps in the difference quotient .
-     * @param q           The point at which we try to approximate the derivative.
-     * @param dq          The direction.
-     */
-    virtual void
-    FirstDifferenceQuotient(double exact, double eps,
-                            const ControlVector<VECTOR> &q, const ControlVector<VECTOR> &dq);
     /**
      * This function calculates dq*H(q)dq , i.e., some diagonal entry of the hessian
      * and corresponting difference quotients for comparison.
@@ -162,16 +154,74 @@ namespace DOpE
     CheckHessian(double c, ControlVector<VECTOR> &q,
                  ControlVector<VECTOR> &dq, unsigned int niter = 1, double eps = 1.);
     /**
-     * Is called to calculate second difference quotients
+     * Compares j'(q)dq to the first difference quotients for several
+     * directions at once. All cost functional evaluations are independent
+     * of each other and are distributed over the reduced problem and all
+     * instances added by AddReducedProblemInstance, see
+     * ComputeReducedCostFunctionals. The results are written as one table.
      *
-     * @double exact      The value of j'(q)
-     * @param eps         The value for eps in the difference quotient .
-     * @param q           The point at which we try to approximate the derivative.
-     * @param dq          The direction.
+     * @param q           The point at which we calculate the derivative.
+     * @param directions  The directions dq != 0.
+     * @param niter       Number of difference quotient evaluations, i.e., how many times
+     *                    eps is reduced.
+     * @param eps         The initial value for eps in the difference quotients.
      */
     virtual void
-    SecondDifferenceQuotient(double exact, double eps,
-                             const ControlVector<VECTOR> &q, const ControlVector<VECTOR> &dq);
+    CheckGrads(ControlVector<VECTOR> &q,
+               const std::vector<const ControlVector<VECTOR>*> &directions,
+               unsigned int niter = 1, double eps = 1.);
+
+    /**
+     * Compares dq*H(q)dq to the second difference quotients for several
+     * directions at once. See CheckGrads for the evaluation of the
+     * difference quotients.
+     *
+     * @param q           The point at which we calculate the derivative.
+     * @param directions  The directions dq != 0.
+     * @param niter       Number of difference quotient evaluations, i.e., how many times
+     *                    eps is reduced.
+     * @param eps         The initial value for eps in the difference quotients.
+     */
+    virtual void
+    CheckHessian(ControlVector<VECTOR> &q,
+                 const std::vector<const ControlVector<VECTOR>*> &directions,
+                 unsigned int niter = 1, double eps = 1.);
+
+    /**
+     * Adds a further instance of the reduced problem which is used to
+     * evaluate the cost functional concurrently to the one given in the
+     * constructor, see ComputeReducedCostFunctionals.
+     *
+     * The instance must solve the same problem on the same discretization,
+     * but must not share any object that is modified during a solve with
+     * the other instances, i.e., it needs its own problem container,
+     * integrator, and space time handler. Further it needs its own output
+     * and exception handler registered. The instance is not deleted by
+     * this class.
+     *
+     * @param S           The additional reduced problem.
+     */
+    void
+    AddReducedProblemInstance(ReducedProblemInterface<PROBLEM,VECTOR> *S)
+    {
+      assert(S);
+      assert(S != Solver_);
+      instances_.push_back(S);
+    }
+
+    /**
+     * Evaluates j at all given points. The points are distributed over
+     * the reduced problem and the instances added by AddReducedProblemInstance
+     * which evaluate their share concurrently. Meanwhile, all output
+     * of the reduced problems is suppressed. For distributed vectors the
+     * evaluation is done sequentially by the reduced problem alone.
+     *
+     * @param points      The points at which j is evaluated.
+     * @param costs       Upon exit costs[i] = j(points[i]).
+     */
+    void
+    ComputeReducedCostFunctionals(std::vector<ControlVector<VECTOR> > &points,
+                                  std::vector<double> &costs);
 
     DOpEExceptionHandler<VECTOR> *
     GetExceptionHandler()
@@ -226,6 +276,7 @@ namespace DOpE
   private:
     PROBLEM *OP_;
     ReducedProblemInterface<PROBLEM,VECTOR> *Solver_;
+    std::vector<ReducedProblemInterface<PROBLEM,VECTOR> *> instances_;
     DOpEExceptionHandler<VECTOR> *ExceptionHandler_;
     DOpEOutputHandler<VECTOR> *OutputHandler_;
     bool rem_exception_;
@@ -356,7 +407,6 @@ namespace DOpE
                                                 ControlVector<VECTOR> &q, ControlVector<VECTOR> &dq, unsigned int niter,
                                                 double eps)
   {
-    q.ReInit();
     dq.ReInit();
     if (c != 0)
       {
@@ -366,78 +416,115 @@ namespace DOpE
       {
         assert(dq.Norm("infty","all") != 0.);
       }
-    ControlVector<VECTOR> point(q);
-    point = q;
-    std::stringstream out;
-
-    ControlVector<VECTOR> gradient(q), gradient_transposed(q);
-
-    this->GetReducedProblem()->ComputeReducedCostFunctional(point);
-    this->GetReducedProblem()->ComputeReducedGradient(point, gradient,
-                                                      gradient_transposed);
-    double cost_diff = gradient * dq;
-    out << "Checking Gradients...." << std::endl;
-    out << " Epsilon \t Exact \t Diff.Quot. \t Rel. Error ";
-    this->GetOutputHandler()->Write(out, 3 + this->GetBasePriority());
+    CheckGrads(q, std::vector<const ControlVector<VECTOR>*>(1, &dq), niter, eps);
+  }
+  /******************************************************/
 
-    for (unsigned int i = 0; i < niter; i++)
+  template<typename PROBLEM, typename VECTOR>
+  void
+  ReducedAlgorithm<PROBLEM, VECTOR>::CheckHessian(double c,
+                                                  ControlVector<VECTOR> &q, ControlVector<VECTOR> &dq, unsigned int niter,
+                                                  double eps)
+  {
+    dq.ReInit();
+    if (c != 0)
       {
-        FirstDifferenceQuotient(cost_diff, eps, q, dq);
-        eps /= 10.;
+        dq = c;
       }
+    else
+      {
+        assert(dq.Norm("infty","all") != 0.);
+      }
+    CheckHessian(q, std::vector<const ControlVector<VECTOR>*>(1, &dq), niter, eps);
   }
   /******************************************************/
 
   template<typename PROBLEM, typename VECTOR>
   void
-  ReducedAlgorithm<PROBLEM, VECTOR>::FirstDifferenceQuotient(
-    double exact, double eps, const ControlVector<VECTOR> &q,
-    const ControlVector<VECTOR> &dq)
+  ReducedAlgorithm<PROBLEM, VECTOR>::CheckGrads(ControlVector<VECTOR> &q,
+                                                const std::vector<const ControlVector<VECTOR>*> &directions,
+                                                unsigned int niter, double eps)
   {
+    q.ReInit();
+    for (unsigned int k = 0; k < directions.size(); k++)
+      {
+        assert(directions[k]->Norm("infty","all") != 0.);
+      }
     ControlVector<VECTOR> point(q);
     point = q;
-
     std::stringstream out;
 
-    point.add(eps, dq);
-
-    double cost_right = 0.;
-    //Differenzenquotient
-    cost_right = this->GetReducedProblem()->ComputeReducedCostFunctional(
-                   point);
+    ControlVector<VECTOR> gradient(q), gradient_transposed(q);
 
-    point.add(-2. * eps, dq);
+    this->GetReducedProblem()->ComputeReducedCostFunctional(point);
+    this->GetReducedProblem()->ComputeReducedGradient(point, gradient,
+                                                      gradient_transposed);
+    std::vector<double> cost_diff(directions.size());
+    for (unsigned int k = 0; k < directions.size(); k++)
+      {
+        cost_diff[k] = gradient * (*directions[k]);
+      }
 
-    double cost_left = 0.;
-    //Differenzenquotient
-    cost_left = this->GetReducedProblem()->ComputeReducedCostFunctional(
-                  point);
+    //The points q + eps dq and q - eps dq for all directions and eps.
+    std::vector<double> epsilons(niter);
+    for (unsigned int i = 0; i < niter; i++)
+      {
+        epsilons[i] = eps;
+        eps /= 10.;
+      }
+    //The copy constructor only copies the layout of q, and the
+    //reserved capacity avoids copies on reallocation.
+    std::vector<ControlVector<VECTOR> > points;
+    points.reserve(2 * directions.size() * niter);
+    for (unsigned int k = 0; k < directions.size(); k++)
+      {
+        for (unsigned int i = 0; i < niter; i++)
+          {
+            points.push_back(q);
+            points.back() = q;
+            points.back().add(epsilons[i], *directions[k]);
+            points.push_back(q);
+            points.back() = q;
+            points.back().add(-epsilons[i], *directions[k]);
+          }
+      }
+    std::vector<double> costs;
+    ComputeReducedCostFunctionals(points, costs);
 
-    double diffquot = (cost_right - cost_left) / (2. * eps);
-    out << eps << "\t" << exact << "\t" << diffquot << "\t"
-        << (exact - diffquot) / exact << std::endl;
+    out << "Checking Gradients...." << std::endl;
+    if (directions.size() > 1)
+      out << " Direction \t";
+    out << " Epsilon \t Exact \t Diff.Quot. \t Rel. Error ";
     this->GetOutputHandler()->Write(out, 3 + this->GetBasePriority());
+
+    for (unsigned int k = 0; k < directions.size(); k++)
+      {
+        for (unsigned int i = 0; i < niter; i++)
+          {
+            const unsigned int pos = 2 * (k * niter + i);
+            double diffquot = (costs[pos] - costs[pos + 1]) / (2. * epsilons[i]);
+            if (directions.size() > 1)
+              out << k << "\t";
+            out << epsilons[i] << "\t" << cost_diff[k] << "\t" << diffquot << "\t"
+                << (cost_diff[k] - diffquot) / cost_diff[k] << std::endl;
+            this->GetOutputHandler()->Write(out, 3 + this->GetBasePriority());
+          }
+      }
   }
 
   /******************************************************/
 
   template<typename PROBLEM, typename VECTOR>
   void
-  ReducedAlgorithm<PROBLEM, VECTOR>::CheckHessian(double c,
-                                                  ControlVector<VECTOR> &q, ControlVector<VECTOR> &dq, unsigned int niter,
-                                                  double eps)
+  ReducedAlgorithm<PROBLEM, VECTOR>::CheckHessian(ControlVector<VECTOR> &q,
+                                                  const std::vector<const ControlVector<VECTOR>*> &directions,
+                                                  unsigned int niter, double eps)
   {
     q.ReInit();
-    dq.ReInit();
-    if (c != 0)
+    for (unsigned int k = 0; k < directions.size(); k++)
       {
-        dq = c;
+        assert(directions[k]->Norm("infty","all") != 0.);
       }
-    else
-      {
-        assert(dq.Norm("infty","all") != 0.);
-      }
-
     ControlVector<VECTOR> point(q);
     point = q;
     std::stringstream out;
@@ -449,55 +536,115 @@ namespace DOpE
     this->GetReducedProblem()->ComputeReducedGradient(point, gradient,
                                                       gradient_transposed);
 
-    this->GetReducedProblem()->ComputeReducedHessianVector(point, dq, hessian,
-                                                           hessian_transposed);
+    std::vector<double> cost_diff(directions.size());
+    for (unsigned int k = 0; k < directions.size(); k++)
+      {
+        this->GetReducedProblem()->ComputeReducedHessianVector(point, *directions[k], hessian,
+                                                               hessian_transposed);
+        cost_diff[k] = hessian * (*directions[k]);
+      }
+
+    //The point q itself and q + eps dq and q - eps dq for all directions and eps.
+    std::vector<double> epsilons(niter);
+    for (unsigned int i = 0; i < niter; i++)
+      {
+        epsilons[i] = eps;
+        eps /= 10.;
+      }
+    std::vector<ControlVector<VECTOR> > points;
+    points.reserve(1 + 2 * directions.size() * niter);
+    points.push_back(q);
+    points.back() = q;
+    for (unsigned int k = 0; k < directions.size(); k++)
+      {
+        for (unsigned int i = 0; i < niter; i++)
+          {
+            points.push_back(q);
+            points.back() = q;
+            points.back().add(epsilons[i], *directions[k]);
+            points.push_back(q);
+            points.back() = q;
+            points.back().add(-epsilons[i], *directions[k]);
+          }
+      }
+    std::vector<double> costs;
+    ComputeReducedCostFunctionals(points, costs);
 
-    double cost_diff = hessian * dq;
     out << "Checking Hessian...." << std::endl;
+    if (directions.size() > 1)
+      out << " Direction \t";
     out << " Epsilon \t Exact \t Diff.Quot. \t Rel. Error ";
     this->GetOutputHandler()->Write(out, 3 + this->GetBasePriority());
 
-    for (unsigned int i = 0; i < niter; i++)
+    for (unsigned int k = 0; k < directions.size(); k++)
       {
-        SecondDifferenceQuotient(cost_diff, eps, q, dq);
-        eps /= 10.;
+        for (unsigned int i = 0; i < niter; i++)
+          {
+            const unsigned int pos = 1 + 2 * (k * niter + i);
+            double diffquot = (costs[pos + 1] - 2. * costs[0] + costs[pos])
+                              / (epsilons[i] * epsilons[i]);
+            if (directions.size() > 1)
+              out << k << "\t";
+            out << epsilons[i] << "\t" << cost_diff[k] << "\t" << diffquot << "\t"
+                << (cost_diff[k] - diffquot) / cost_diff[k] << std::endl;
+            this->GetOutputHandler()->Write(out, 3 + this->GetBasePriority());
+          }
       }
   }
+
   /******************************************************/
 
   template<typename PROBLEM, typename VECTOR>
   void
-  ReducedAlgorithm<PROBLEM, VECTOR>::SecondDifferenceQuotient(
-    double exact, double eps, const ControlVector<VECTOR> &q,
-    const ControlVector<VECTOR> &dq)
+  ReducedAlgorithm<PROBLEM, VECTOR>::ComputeReducedCostFunctionals(
+    std::vector<ControlVector<VECTOR> > &points, std::vector<double> &costs)
   {
-    ControlVector<VECTOR> point(q);
-    point = q;
-    std::stringstream out;
-
-    double cost_mid = 0.;
-    //Differenzenquotient
-    cost_mid = this->GetReducedProblem()->ComputeReducedCostFunctional(point);
-
-    point.add(eps, dq);
-
-    double cost_right = 0.;
-    //Differenzenquotient
-    cost_right = this->GetReducedProblem()->ComputeReducedCostFunctional(
-                   point);
-
-    point.add(-2. * eps, dq);
-
-    double cost_left = 0.;
-    //Differenzenquotient
-    cost_left = this->GetReducedProblem()->ComputeReducedCostFunctional(
-                  point);
+    costs.resize(points.size());
+    if (instances_.empty() || DOpEHelper::is_distributed_vector<VECTOR>::value)
+      {
+        for (unsigned int i = 0; i < points.size(); i++)
+          {
+            costs[i] = this->GetReducedProblem()->ComputeReducedCostFunctional(points[i]);
+          }
+        return;
+      }
 
-    double diffquot = (cost_left - 2. * cost_mid + cost_right) / (eps * eps);
+    std::vector<ReducedProblemInterface<PROBLEM,VECTOR> *> solvers(1, Solver_);
+    solvers.insert(solvers.end(), instances_.begin(), instances_.end());
+    const unsigned int n_solvers = solvers.size();
 
-    out << eps << "\t" << exact << "\t" << diffquot << "\t"
-        << (exact - diffquot) / exact << std::endl;
-    this->GetOutputHandler()->Write(out, 3 + this->GetBasePriority());
+    //The output handlers are not thread safe
+    for (unsigned int k = 0; k < n_solvers; k++)
+      {
+        solvers[k]->GetOutputHandler()->DisallowAllOutput();
+      }
+    try
+      {
+        //Each instance evaluates every n_solvers-th point.
+        dealii::parallel::apply_to_subranges(0u, n_solvers,
+                                             [&solvers,&points,&costs,n_solvers](unsigned int begin, unsigned int end)
+        {
+          for (unsigned int k = begin; k < end; k++)
+            {
+              for (unsigned int i = k; i < points.size(); i += n_solvers)
+                {
+                  costs[i] = solvers[k]->ComputeReducedCostFunctional(points[i]);
+                }
+            }
+        }, 1);
+      }
+    catch (...)
+      {
+        for (unsigned int k = 0; k < n_solvers; k++)
+          {
+            solvers[k]->GetOutputHandler()->ResumeOutput();
+          }
+        throw;
+      }
+    for (unsigned int k = 0; k < n_solvers; k++)
+      {
+        solvers[k]->GetOutputHandler()->ResumeOutput();
+      }
   }
 
   /******************************************************/
@@ -30,6 +30,8 @@
 #include <iostream>
 #include <assert.h>
 #include <iomanip>
+#include <deque>
+#include <vector>
 namespace DOpE
 {
   /**
@@ -114,6 +116,11 @@ namespace DOpE
      *                              (gradient_transposed,gradient)_{l^2} = \|j'(q)\|_Q^2
      * @param dq                    The solution of the model minimization, i.e.,
      *                              H(q)dq = - j'(q).
+     *
+     * If hessian_preconditioner_pairs is positive, the CG-algorithm is preconditioned
+     * with a limited memory BFGS approximation of H^{-1} built from the search
+     * directions d and the products H(q)d of the previous call. These are recycled
+     * from the last Newton step, so no additional Hessian-vector products are needed.
      */
     virtual int SolveReducedLinearSystem(const ControlVector<VECTOR> &q,
                                          const ControlVector<VECTOR> &gradient,
@@ -146,7 +153,34 @@ namespace DOpE
       return  gradient*gradient_transposed;
     }
   private:
-    unsigned int nonlinear_maxiter_, linear_maxiter_, line_maxiter_;
+    /**
+     * A search direction d of the CG-algorithm together with the
+     * product H(q)d in both representations and the curvature d*H(q)d.
+     */
+    struct CurvaturePair
+    {
+      ControlVector<VECTOR> d, Hd, Hd_transposed;
+      double dHd;
+    };
+
+    /**
+     * Applies the limited memory BFGS approximation of the inverse Hessian
+     * given by the stored curvature pairs to the residual, i.e., the two-loop
+     * recursion from Nocedal & Wright, Algorithm 7.4. Without stored pairs
+     * z = r_transposed, i.e., the CG-algorithm is not preconditioned.
+     *
+     * @param r                     The l^2 residual.
+     * @param r_transposed          The transposed of the residual.
+     * @param z                     Upon exit the preconditioned residual.
+     * @param tmp                   A temporary vector of the same size.
+     */
+    void ApplyHessianPreconditioner(const ControlVector<VECTOR> &r,
+                                    const ControlVector<VECTOR> &r_transposed,
+                                    ControlVector<VECTOR> &z,
+                                    ControlVector<VECTOR> &tmp) const;
+
+    unsigned int nonlinear_maxiter_, linear_maxiter_, line_maxiter_, hessian_preconditioner_pairs_;
+    std::deque<CurvaturePair> recycled_pairs_;
     double       nonlinear_tol_, nonlinear_global_tol_, linear_tol_, linear_global_tol_, lineasearch_rho_, linesearch_c_;
     bool         compute_functionals_in_every_step_;
     std::string postindex_;
@@ -170,6 +204,7 @@ namespace DOpE
     param_reader.declare_entry("linear_maxiter", "40",Patterns::Integer(0));
     param_reader.declare_entry("linear_tol", "1.e-10",Patterns::Double(0));
     param_reader.declare_entry("linear_global_tol", "1.e-12",Patterns::Double(0));
+    param_reader.declare_entry("hessian_preconditioner_pairs", "0",Patterns::Integer(0),"number of CG directions of the last Newton step used to precondition the next CG solve. 0 means no preconditioning");
 
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0));
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0));
@@ -199,6 +234,7 @@ namespace DOpE
     linear_maxiter_       = param_reader.get_integer ("linear_maxiter");
     linear_tol_           = param_reader.get_double ("linear_tol");
     linear_global_tol_    = param_reader.get_double ("linear_global_tol");
+    hessian_preconditioner_pairs_ = param_reader.get_integer ("hessian_preconditioner_pairs");
 
     line_maxiter_         = param_reader.get_integer ("line_maxiter");
     lineasearch_rho_       = param_reader.get_double ("linesearch_rho");
@@ -255,6 +291,8 @@ namespace DOpE
     q.ReInit();
     //Solve j'(q) = 0
     ControlVector<VECTOR> dq(q), gradient(q), gradient_transposed(q);
+    //The control space may have changed since the last call.
+    recycled_pairs_.clear();
 
     unsigned int iter=0;
     double cost=0.;
@@ -307,6 +345,7 @@ namespace DOpE
       {
         this->GetExceptionHandler()->HandleCriticalException(e,"ReducedNewtonAlgorithm::Solve");
       }
+    this->GetReducedProblem()->AcceptIterate(q);
 
     double res = Residual(gradient,gradient_transposed);//gradient*gradient_transposed;
     double firstres = res;
@@ -413,6 +452,7 @@ namespace DOpE
           {
             this->GetExceptionHandler()->HandleCriticalException(e,"ReducedNewtonAlgorithm::Solve");
           }
+        this->GetReducedProblem()->AcceptIterate(q);
 
         this->GetOutputHandler()->Write(q,"Control"+postindex_,"control");
         this->GetOutputHandler()->Write(gradient,"NewtonResidual"+postindex_,"control");
@@ -456,13 +496,17 @@ namespace DOpE
   {
     std::stringstream out;
     dq = 0.;
-    ControlVector<VECTOR> r(q), r_transposed(q),  d(q), Hd(q), Hd_transposed(q);
+    ControlVector<VECTOR> r(q), r_transposed(q),  d(q), Hd(q), Hd_transposed(q), z(q), tmp(q);
+    //The directions of this call precondition the next one
+    std::deque<CurvaturePair> new_pairs;
 
     r            = gradient;
     r_transposed = gradient_transposed;
-    d.equ(-1,gradient_transposed);
+    ApplyHessianPreconditioner(r,r_transposed,z,tmp);
+    d.equ(-1,z);
 
     double res = Residual(r,r_transposed);//r*r_transposed;
+    double rz = r*z;
     double firstres = res;
 
     assert(res >= 0.);
@@ -471,7 +515,7 @@ namespace DOpE
     this->GetOutputHandler()->Write(out,4+this->GetBasePriority());
 
     unsigned int iter = 0;
-    double cgalpha, cgbeta, oldres;
+    double cgalpha, cgbeta, oldrz;
 
     this->GetOutputHandler()->SetIterationNumber(iter,"OptNewtonCg"+postindex_);
 
@@ -483,6 +527,8 @@ namespace DOpE
         this->GetOutputHandler()->SetIterationNumber(iter,"OptNewtonCg"+postindex_);
         if (iter > linear_maxiter_)
           {
+            if (!new_pairs.empty())
+              recycled_pairs_.swap(new_pairs);
             throw DOpEIterationException("Iteration count exceeded bounds!","ReducedNewtonAlgorithm::SolveReducedLinearSystem");
           }
 
@@ -495,7 +541,20 @@ namespace DOpE
             this->GetExceptionHandler()->HandleCriticalException(e,"ReducedNewtonAlgorithm::SolveReducedLinearSystem");
           }
 
-        cgalpha = res / (Hd*d);
+        double dHd = Hd*d;
+        cgalpha = rz / dHd;
+
+        if (hessian_preconditioner_pairs_ > 0 && dHd > 0.)
+          {
+            if (new_pairs.size() == hessian_preconditioner_pairs_)
+              new_pairs.pop_front();
+            //The copy constructor only copies the layout of the vectors.
+            new_pairs.push_back(CurvaturePair {d,Hd,Hd_transposed,dHd});
+            CurvaturePair &pair = new_pairs.back();
+            pair.d = d;
+            pair.Hd = Hd;
+            pair.Hd_transposed = Hd_transposed;
+          }
 
         if (cgalpha < 0)
           {
@@ -503,6 +562,8 @@ namespace DOpE
               {
                 dq.add(cgalpha,d);
               }
+            if (!new_pairs.empty())
+              recycled_pairs_.swap(new_pairs);
             throw DOpENegativeCurvatureException("Negative curvature detected!","ReducedNewtonAlgorithm::SolveReducedLinearSystem");
           }
 
@@ -510,7 +571,6 @@ namespace DOpE
         r.add(cgalpha,Hd);
         r_transposed.add(cgalpha,Hd_transposed);
 
-        oldres = res;
         res = Residual(r,r_transposed);//r*r_transposed;
         if (res < 0.)
           {
@@ -543,13 +603,52 @@ namespace DOpE
         out<<"\t Cg step: " <<iter<<"\t Residual: "<<this->GetOutputHandler()->ZeroTolerance(sqrt(res),firstres);
         this->GetOutputHandler()->Write(out,4+this->GetBasePriority());
 
-        cgbeta = res / oldres; //Fletcher-Reeves
+        ApplyHessianPreconditioner(r,r_transposed,z,tmp);
+        oldrz = rz;
+        rz = r*z;
+        cgbeta = rz / oldrz; //Fletcher-Reeves
         d*= cgbeta;
-        d.add(-1,r_transposed);
+        d.add(-1,z);
       }
+    if (!new_pairs.empty())
+      recycled_pairs_.swap(new_pairs);
     return iter;
   }
 
+  /******************************************************/
+
+  template <typename PROBLEM, typename VECTOR>
+  void ReducedNewtonAlgorithm<PROBLEM, VECTOR>::ApplyHessianPreconditioner(const ControlVector<VECTOR> &r,
+      const ControlVector<VECTOR> &r_transposed,
+      ControlVector<VECTOR> &z,
+      ControlVector<VECTOR> &tmp) const
+  {
+    z = r_transposed;
+    if (recycled_pairs_.empty())
+      return;
+
+    //tmp is the l^2 representation of z during the first loop
+    tmp = r;
+    const unsigned int n_pairs = recycled_pairs_.size();
+    std::vector<double> a(n_pairs);
+    for (int i = n_pairs-1; i >= 0; i--)
+      {
+        const CurvaturePair &p = recycled_pairs_[i];
+        a[i] = (p.d*tmp)/p.dHd;
+        z.add(-a[i],p.Hd_transposed);
+        tmp.add(-a[i],p.Hd);
+      }
+    //Scaling of the initial approximation by the newest pair
+    const CurvaturePair &newest = recycled_pairs_.back();
+    z *= newest.dHd/(newest.Hd*newest.Hd_transposed);
+    for (unsigned int i = 0; i < n_pairs; i++)
+      {
+        const CurvaturePair &p = recycled_pairs_[i];
+        double b = (p.Hd*z)/p.dHd;
+        z.add(a[i]-b,p.d);
+      }
+  }
+
 
   /******************************************************/
 
@@ -335,6 +335,7 @@ namespace DOpE
       {
         this->GetExceptionHandler()->HandleCriticalException(e);
       }
+    this->GetReducedProblem()->AcceptIterate(q);
 
     double res = Residual(gradient,gradient_transposed);
     double firstres = res;
@@ -472,6 +473,7 @@ namespace DOpE
           {
             this->GetExceptionHandler()->HandleCriticalException(e);
           }
+        this->GetReducedProblem()->AcceptIterate(q);
 
         res = Residual(gradient,gradient_transposed);
 
@@ -271,6 +271,30 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_entry_matrix, double scale = 1.,double scale_ico = 1.);
 
+    /**
+     * Computes the interface terms on both sides of an interior
+     * face, see PDEInterface::InterfaceEquation_UTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale = 1., double scale_ico = 1.);
+
+    /**
+     * Computes the interface matrices on both sides of an interior
+     * face, see PDEInterface::InterfaceMatrixTwoSided_T.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix,
+                            double scale = 1., double scale_ico = 1.);
+
     /**
     * Functions providing the required information for the integrator.
     * see OptProblemContainer for details.
@@ -339,12 +363,25 @@ namespace DOpE
     inline bool
     HasInterfaces() const;
 
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided?
+     */
+    inline bool
+    HasTwoSidedInterfaces() const;
+
     /**
       * Do we need evaluation at the vertices?
       */
     inline bool
     HasVertices() const;
 
+    /**
+      * Is the time matrix constant? See PDEInterface for details.
+      */
+    inline bool
+    HasConstantTimeMatrix() const;
+
     /**
     * Functions providing the required information for the integrator.
     * see OptProblemContainer for details.
@@ -803,6 +840,41 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  AdjointProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+                 dim>::InterfaceEquationTwoSided(const FDC &fdc,
+                                                   dealii::Vector<double> &local_vector,
+                                                   dealii::Vector<double> &nbr_local_vector,
+                                                   double scale, double scale_ico)
+  {
+    pde_.InterfaceEquation_UTwoSided(fdc, local_vector, nbr_local_vector,
+                                     scale*interval_length_, scale_ico*interval_length_);
+  }
+
+  /******************************************************/
+
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  AdjointProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+                 dim>::InterfaceMatrixTwoSided(const FDC &fdc,
+                                                 FullMatrix<double> &local_entry_matrix,
+                                                 FullMatrix<double> &element_nbr_matrix,
+                                                 FullMatrix<double> &nbr_element_matrix,
+                                                 FullMatrix<double> &nbr_matrix,
+                                                 double scale, double scale_ico)
+  {
+    pde_.InterfaceMatrixTwoSided_T(fdc, local_entry_matrix, element_nbr_matrix,
+                                   nbr_element_matrix, nbr_matrix,
+                                   scale*interval_length_, scale_ico*interval_length_);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename FDC>
@@ -954,6 +1026,16 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  AdjointProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasTwoSidedInterfaces() const
+  {
+    return pde_.HasTwoSidedInterfaces();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   bool
@@ -964,6 +1046,16 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  AdjointProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasConstantTimeMatrix() const
+  {
+    return pde_.HasConstantTimeMatrix();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   const std::vector<unsigned int> &
@@ -377,6 +377,30 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_entry_matrix, double scale = 1.,double scale_ico = 1.);
 
+    /**
+     * Computes the interface terms on both sides of an interior
+     * face, they are never needed for this problem.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale = 1., double scale_ico = 1.);
+
+    /**
+     * Computes the interface matrices on both sides of an interior
+     * face, they are never needed for this problem.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix,
+                            double scale = 1., double scale_ico = 1.);
+
     /**
      * Computes the value of face on a boundary.
      * It has the same functionality as ElementEquation. We refer to its
@@ -455,6 +479,13 @@ namespace DOpE
     inline bool
     HasInterfaces() const;
 
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided?
+     */
+    inline bool
+    HasTwoSidedInterfaces() const;
+
     /**
       * Do we need evaluation at the vertices?
       */
@@ -828,6 +859,38 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  AuxiliaryNodalErrorProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+                             dim>::InterfaceEquationTwoSided(const FDC &/*fdc*/,
+                                                               dealii::Vector<double> &/*local_vector*/,
+                                                               dealii::Vector<double> &/*nbr_local_vector*/,
+                                                               double /*scale*/, double /*scale_ico*/)
+  {
+    throw DOpEException("This should never be called!","AuxiliaryNodalErrorProblem");
+  }
+
+  /******************************************************/
+
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  AuxiliaryNodalErrorProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+                             dim>::InterfaceMatrixTwoSided(const FDC &/*fdc*/,
+                                                             FullMatrix<double> &/*local_entry_matrix*/,
+                                                             FullMatrix<double> &/*element_nbr_matrix*/,
+                                                             FullMatrix<double> &/*nbr_element_matrix*/,
+                                                             FullMatrix<double> &/*nbr_matrix*/,
+                                                             double /*scale*/, double /*scale_ico*/)
+  {
+    throw DOpEException("This should never be called!","AuxiliaryNodalErrorProblem");
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename FDC>
@@ -950,6 +1013,16 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  AuxiliaryNodalErrorProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasTwoSidedInterfaces() const
+  {
+    return pde_.HasTwoSidedInterfaces();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   bool
@@ -144,6 +144,30 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix, double scale = 1., double scale_ico = 1.);
 
+    /**
+     * Computes the interface terms on both sides of an interior
+     * face, see PDEInterface::InterfaceEquationTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale = 1., double scale_ico = 1.);
+
+    /**
+     * Computes the interface matrices on both sides of an interior
+     * face, see PDEInterface::InterfaceMatrixTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix,
+                            double scale = 1., double scale_ico = 1.);
+
     /**
     * Functions providing the required information for the integrator.
     * see OptProblemContainer for details.
@@ -211,6 +235,13 @@ namespace DOpE
     inline bool
     HasInterfaces() const;
 
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided?
+     */
+    inline bool
+    HasTwoSidedInterfaces() const;
+
     /**
       * Do we need evaluation at the vertices?
       */
@@ -497,6 +528,32 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBEM, typename PDE, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  InitialNewtonProblem<OPTPROBEM, PDE, VECTOR, dim>::InterfaceEquationTwoSided(const FDC &/*fdc*/,
+                                                                               dealii::Vector<double> &/*local_vector*/,
+                                                                               dealii::Vector<double> &/*nbr_local_vector*/,
+                                                                               double /*scale*/, double /*scale_ico*/)
+  {
+  }
+
+  /******************************************************/
+
+  template<typename OPTPROBEM, typename PDE, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  InitialNewtonProblem<OPTPROBEM, PDE, VECTOR, dim>::InterfaceMatrixTwoSided(const FDC &/*fdc*/,
+                                                                             FullMatrix<double> &/*local_entry_matrix*/,
+                                                                             FullMatrix<double> &/*element_nbr_matrix*/,
+                                                                             FullMatrix<double> &/*nbr_element_matrix*/,
+                                                                             FullMatrix<double> &/*nbr_matrix*/,
+                                                                             double /*scale*/, double /*scale_ico*/)
+  {
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBEM, typename PDE, typename VECTOR, int dim>
   template<typename FDC>
   void
@@ -604,6 +661,15 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBEM, typename PDE, typename VECTOR, int dim>
+  bool
+  InitialNewtonProblem<OPTPROBEM, PDE, VECTOR, dim>::HasTwoSidedInterfaces() const
+  {
+    return pde_.HasTwoSidedInterfaces();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBEM, typename PDE, typename VECTOR, int dim>
   bool
   InitialNewtonProblem<OPTPROBEM, PDE, VECTOR, dim>::HasVertices() const
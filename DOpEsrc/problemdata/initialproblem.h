@@ -143,6 +143,30 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix, double scale = 1., double scale_ico = 1.);
 
+    /**
+     * Computes the interface terms on both sides of an interior
+     * face, see PDEInterface::InterfaceEquationTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale = 1., double scale_ico = 1.);
+
+    /**
+     * Computes the interface matrices on both sides of an interior
+     * face, see PDEInterface::InterfaceMatrixTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix,
+                            double scale = 1., double scale_ico = 1.);
+
     /**
     * Functions providing the required information for the integrator.
     * see OptProblemContainer for details.
@@ -210,6 +234,13 @@ namespace DOpE
     inline bool
     HasInterfaces() const;
 
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided?
+     */
+    inline bool
+    HasTwoSidedInterfaces() const;
+
     /**
       * Do we need evaluation at the vertices?
       */
@@ -444,6 +475,35 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename PDE, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  InitialProblem<PDE, VECTOR, dim>::InterfaceEquationTwoSided(const FDC &fdc,
+                                                              dealii::Vector<double> &local_vector,
+                                                              dealii::Vector<double> &nbr_local_vector,
+                                                              double scale, double scale_ico)
+  {
+    pde_.Init_InterfaceEquationTwoSided(fdc, local_vector, nbr_local_vector, scale, scale_ico);
+  }
+
+  /******************************************************/
+
+  template<typename PDE, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  InitialProblem<PDE, VECTOR, dim>::InterfaceMatrixTwoSided(const FDC &fdc,
+                                                            FullMatrix<double> &local_entry_matrix,
+                                                            FullMatrix<double> &element_nbr_matrix,
+                                                            FullMatrix<double> &nbr_element_matrix,
+                                                            FullMatrix<double> &nbr_matrix,
+                                                            double scale, double scale_ico)
+  {
+    pde_.Init_InterfaceMatrixTwoSided(fdc, local_entry_matrix, element_nbr_matrix,
+                                      nbr_element_matrix, nbr_matrix, scale, scale_ico);
+  }
+
+  /******************************************************/
+
   template<typename PDE, typename VECTOR, int dim>
   template<typename FDC>
   void
@@ -551,6 +611,15 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename PDE, typename VECTOR, int dim>
+  bool
+  InitialProblem<PDE, VECTOR, dim>::HasTwoSidedInterfaces() const
+  {
+    return pde_.HasTwoSidedInterfaces();
+  }
+
+  /******************************************************/
+
   template<typename PDE, typename VECTOR, int dim>
   bool
   InitialProblem<PDE, VECTOR, dim>::HasVertices() const
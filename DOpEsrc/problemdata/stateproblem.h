@@ -242,6 +242,16 @@ namespace DOpE
     ElementTimeEquationExplicit(const EDC &edc,
                                 dealii::Vector<double> &local_vector, double scale = 1.);
 
+    /**
+     * Fused version of ElementEquation and ElementTimeEquation,
+     * see PDEInterface::ElementEquationAndTimeEquation.
+     */
+    template<typename EDC>
+    inline void
+    ElementEquationAndTimeEquation(const EDC &edc,
+                                   dealii::Vector<double> &local_vector, double scale,
+                                   double scale_ico, double scale_time);
+
     /**
      * Computes the value of the right-hand side of the problem at hand.
      *
@@ -336,6 +346,16 @@ namespace DOpE
     ElementTimeMatrixExplicit(const EDC &edc,
                               dealii::FullMatrix<double> &local_entry_matrix);
 
+    /**
+     * Fused version of ElementMatrix and ElementTimeMatrix,
+     * see PDEInterface::ElementMatrixAndTimeMatrix.
+     */
+    template<typename EDC>
+    inline void
+    ElementMatrixAndTimeMatrix(const EDC &edc,
+                               dealii::FullMatrix<double> &local_entry_matrix, double scale,
+                               double scale_ico, double scale_time);
+
     /**
      * Computes the value of face on a element.
      * It has the same functionality as ElementEquation. We refer to its
@@ -391,6 +411,30 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_entry_matrix, double scale = 1.,double scale_ico = 1.);
 
+    /**
+     * Computes the face and interface terms on both sides of an interior
+     * face, see PDEInterface::InterfaceEquationTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale = 1., double scale_ico = 1.);
+
+    /**
+     * Computes the face and interface matrices on both sides of an interior
+     * face, see PDEInterface::InterfaceMatrixTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix,
+                            double scale = 1., double scale_ico = 1.);
+
     /**
      * Computes the value of face on a boundary.
      * It has the same functionality as ElementEquation. We refer to its
@@ -469,12 +513,31 @@ namespace DOpE
     inline bool
     HasInterfaces() const;
 
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided?
+     */
+    inline bool
+    HasTwoSidedInterfaces() const;
+
     /**
       * Do we need evaluation at the vertices?
       */
     inline bool
     HasVertices() const;
 
+    /**
+      * Is the time matrix constant? See PDEInterface for details.
+      */
+    inline bool
+    HasConstantTimeMatrix() const;
+
+    /**
+      * Are fused element kernels available? See PDEInterface for details.
+      */
+    inline bool
+    HasFusedElementTerms() const;
+
     /**
     * Functions providing the required information for the integrator.
     * see OptProblemContainer for details.
@@ -694,6 +757,21 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename EDC>
+  void
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+               dim>::ElementEquationAndTimeEquation(const EDC &edc,
+                                                    dealii::Vector<double> &local_vector, double scale,
+                                                    double scale_ico, double scale_time)
+  {
+    pde_.ElementEquationAndTimeEquation(edc, local_vector, scale*interval_length_,
+                                        scale_ico*interval_length_, scale_time);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename FDC>
@@ -824,6 +902,21 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename EDC>
+  void
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+               dim>::ElementMatrixAndTimeMatrix(const EDC &edc,
+                                                dealii::FullMatrix<double> &local_entry_matrix, double scale,
+                                                double scale_ico, double scale_time)
+  {
+    pde_.ElementMatrixAndTimeMatrix(edc, local_entry_matrix, scale*interval_length_,
+                                    scale_ico*interval_length_, scale_time);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename FDC>
@@ -852,6 +945,41 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+               dim>::InterfaceEquationTwoSided(const FDC &fdc,
+                                               dealii::Vector<double> &local_vector,
+                                               dealii::Vector<double> &nbr_local_vector,
+                                               double scale, double scale_ico)
+  {
+    pde_.InterfaceEquationTwoSided(fdc, local_vector, nbr_local_vector,
+                                   scale*interval_length_, scale_ico*interval_length_);
+  }
+
+  /******************************************************/
+
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+               dim>::InterfaceMatrixTwoSided(const FDC &fdc,
+                                             FullMatrix<double> &local_entry_matrix,
+                                             FullMatrix<double> &element_nbr_matrix,
+                                             FullMatrix<double> &nbr_element_matrix,
+                                             FullMatrix<double> &nbr_matrix,
+                                             double scale, double scale_ico)
+  {
+    pde_.InterfaceMatrixTwoSided(fdc, local_entry_matrix, element_nbr_matrix,
+                                 nbr_element_matrix, nbr_matrix,
+                                 scale*interval_length_, scale_ico*interval_length_);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename FDC>
@@ -1000,6 +1128,16 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasTwoSidedInterfaces() const
+  {
+    return pde_.HasTwoSidedInterfaces();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   bool
@@ -1010,6 +1148,26 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasConstantTimeMatrix() const
+  {
+    return pde_.HasConstantTimeMatrix();
+  }
+
+  /******************************************************/
+
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasFusedElementTerms() const
+  {
+    return pde_.HasFusedElementTerms();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   const std::vector<unsigned int> &
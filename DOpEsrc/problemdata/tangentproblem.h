@@ -326,6 +326,30 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_entry_matrix, double scale = 1.,double scale_ico = 1.);
 
+    /**
+     * Computes the interface terms on both sides of an interior
+     * face, see PDEInterface::InterfaceEquation_UTTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale = 1., double scale_ico = 1.);
+
+    /**
+     * Computes the interface matrices on both sides of an interior
+     * face, see PDEInterface::InterfaceMatrixTwoSided.
+     */
+    template<typename FDC>
+    inline void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix,
+                            double scale = 1., double scale_ico = 1.);
+
     /**
      * Computes the value of face on a boundary.
      * It has the same functionality as ElementEquation. We refer to its
@@ -404,12 +428,25 @@ namespace DOpE
     inline bool
     HasInterfaces() const;
 
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided?
+     */
+    inline bool
+    HasTwoSidedInterfaces() const;
+
     /**
       * Do we need evaluation at the vertices?
       */
     inline bool
     HasVertices() const;
 
+    /**
+      * Is the time matrix constant? See PDEInterface for details.
+      */
+    inline bool
+    HasConstantTimeMatrix() const;
+
     /**
     * Functions providing the required information for the integrator.
     * see OptProblemContainer for details.
@@ -790,6 +827,41 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  TangentProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+                 dim>::InterfaceEquationTwoSided(const FDC &fdc,
+                                                   dealii::Vector<double> &local_vector,
+                                                   dealii::Vector<double> &nbr_local_vector,
+                                                   double scale, double scale_ico)
+  {
+    pde_.InterfaceEquation_UTTwoSided(fdc, local_vector, nbr_local_vector,
+                                      scale*interval_length_, scale_ico*interval_length_);
+  }
+
+  /******************************************************/
+
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename FDC>
+  void
+  TangentProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+                 dim>::InterfaceMatrixTwoSided(const FDC &fdc,
+                                                 FullMatrix<double> &local_entry_matrix,
+                                                 FullMatrix<double> &element_nbr_matrix,
+                                                 FullMatrix<double> &nbr_element_matrix,
+                                                 FullMatrix<double> &nbr_matrix,
+                                                 double scale, double scale_ico)
+  {
+    pde_.InterfaceMatrixTwoSided(fdc, local_entry_matrix, element_nbr_matrix,
+                                 nbr_element_matrix, nbr_matrix,
+                                 scale*interval_length_, scale_ico*interval_length_);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename FDC>
@@ -938,6 +1010,16 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  TangentProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasTwoSidedInterfaces() const
+  {
+    return pde_.HasTwoSidedInterfaces();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   bool
@@ -948,6 +1030,16 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  bool
+  TangentProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR, dim>::HasConstantTimeMatrix() const
+  {
+    return pde_.HasConstantTimeMatrix();
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   const std::vector<unsigned int> &
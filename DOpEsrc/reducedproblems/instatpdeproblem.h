@@ -64,6 +64,8 @@
 
 #include <fstream>
 #include <string>
+#include <cmath>
+#include <type_traits>
 
 namespace DOpE
 {
@@ -281,7 +283,74 @@ namespace DOpE
     template<typename PDE>
     void BackwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_grads);
 
+    /******************************************************/
+
+    /**
+     * This function does the loop over time with adaptive choice of the time steps.
+     * In each interval the step of the given scheme is compared to the step
+     * of the embedded backward Euler scheme. If the difference exceeds the
+     * tolerance the step is rejected and the interval is bisected, i.e., the
+     * temporal mesh is refined. If the error of an accepted step is so small
+     * that the doubled step is expected to be accepted as well, the next
+     * interval is merged with its successor, provided that both are the
+     * children of the same interval. The time points left of the actual
+     * interval are not changed, hence the accepted solution in sol stays valid.
+     * Consequently, the final temporal mesh is the one on which sol is given.
+     *
+     * The temporal mesh is the time triangulation of the space time handler.
+     * It is shared by all problems using this handler and is not restored
+     * after the loop. All later computations, e.g., the adjoint or a further
+     * call of this loop, start from the adapted temporal mesh.
+     *
+     * Before the loop all intervals are refined to at least the level
+     * time_step_fine_start. The steps may grow by merging up to the
+     * intervals of the coarse temporal mesh, but not beyond.
+     *
+     * The embedded scheme is the backward Euler scheme, hence the given
+     * scheme must not be backward Euler itself.
+     *
+     * @param problem            Describes the nonstationary pde to be solved
+     * @param embedded_problem   The same pde discretized by the embedded scheme.
+     * @param outname            The name prefix given to the solution vectors
+     *                           if they are written to files, e.g., State, Tangent, ...
+     * @param eval_funcs         Decide wether to evaluate the functionals or not.
+     */
+    template<typename PDE, typename EMBEDDEDPDE>
+    void AdaptiveForwardTimeLoop(PDE &problem, EMBEDDEDPDE &embedded_problem,
+                                 StateVector<VECTOR> &sol, std::string outname, bool eval_funcs);
+
   private:
+    /**
+     * Restores the accepted solution in sol after the temporal mesh has been
+     * refined. Time points inserted left of the last accepted one, e.g., by
+     * the mesh smoothing, get the linear interpolation of their neighbors.
+     *
+     * @param sol              The solution, already reinitialized on the new mesh.
+     * @param accepted_times   The time points of the accepted solution before the refinement.
+     *
+     * @return                 The new number of the last accepted time point.
+     */
+    unsigned int
+    RestoreAcceptedTimePoints(StateVector<VECTOR> &sol,
+                              const std::vector<double> &accepted_times);
+
+    /**
+     * Returns the interval whose left end is the given time point.
+     */
+    TimeIterator
+    GetIntervalStartingAt(unsigned int time_point);
+
+    /**
+     * Computes a single time step on the interval given by local_to_global
+     * with the given solver. Used in the AdaptiveForwardTimeLoop.
+     */
+    template<typename PDE>
+    void
+    SolveTimeStep(PDE &problem, NONLINEARSOLVER &solver, bool &build_matrix,
+                  const TimeIterator &interval,
+                  const std::vector<unsigned int> &local_to_global,
+                  const VECTOR &u_old, VECTOR &solution);
+
     /**
      * Helper function to prevent code duplicity. Adds the user defined
      * user Data to the Integrator.
@@ -365,9 +434,15 @@ namespace DOpE
     INTEGRATOR integrator_;
     NONLINEARSOLVER nonlinear_state_solver_;
     NONLINEARSOLVER nonlinear_adjoint_solver_;
+    NONLINEARSOLVER nonlinear_embedded_solver_;
 
     bool build_state_matrix_ = false, build_adjoint_matrix_ = false;
-    bool state_reinit_ = false, adjoint_reinit_ = false;
+    bool build_embedded_matrix_ = false;
+    bool state_reinit_ = false, adjoint_reinit_ = false, embedded_reinit_ = false;
+
+    bool adaptive_time_stepping_ = false;
+    double time_step_abs_tol_, time_step_rel_tol_, min_time_step_;
+    unsigned int time_step_fine_start_;
 
     bool project_initial_data_ = false;
 
@@ -394,6 +469,22 @@ namespace DOpE
     param_reader.declare_entry("number of patches", "0",
                                Patterns::Integer(0));
 
+    param_reader.SetSubsection("instatpdeproblem parameters");
+    param_reader.declare_entry("adaptive_time_stepping", "false",
+                               Patterns::Bool(),
+                               "Choose the time steps by comparison with the embedded backward Euler scheme. The adapted temporal mesh is kept in the space time handler");
+    param_reader.declare_entry("time_step_abs_tol", "1.e-6",
+                               Patterns::Double(0),
+                               "Absolute tolerance for the local error of a time step");
+    param_reader.declare_entry("time_step_rel_tol", "1.e-4",
+                               Patterns::Double(0),
+                               "Relative tolerance for the local error of a time step");
+    param_reader.declare_entry("min_time_step", "1.e-8",
+                               Patterns::Double(0),
+                               "Time steps are not bisected below this size");
+    param_reader.declare_entry("time_step_fine_start", "0",
+                               Patterns::Integer(0),
+                               "Intervals of the temporal mesh below this level are bisected before the adaptive time loop. The steps can grow back to the coarse intervals by merging");
   }
   /******************************************************/
 
@@ -414,12 +505,21 @@ namespace DOpE
                      z_for_ee_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                      integrator_(idc),
                      nonlinear_state_solver_(integrator_, param_reader),
-                     nonlinear_adjoint_solver_(integrator_, param_reader)
+                     nonlinear_adjoint_solver_(integrator_, param_reader),
+                     nonlinear_embedded_solver_(integrator_, param_reader)
   {
+    param_reader.SetSubsection("instatpdeproblem parameters");
+    adaptive_time_stepping_ = param_reader.get_bool("adaptive_time_stepping");
+    time_step_abs_tol_ = param_reader.get_double("time_step_abs_tol");
+    time_step_rel_tol_ = param_reader.get_double("time_step_rel_tol");
+    min_time_step_ = param_reader.get_double("min_time_step");
+    time_step_fine_start_ = param_reader.get_integer("time_step_fine_start");
+
     // Solvers should be ReInited
     {
       state_reinit_ = true;
       adjoint_reinit_ = true;
+      embedded_reinit_ = true;
     }
   }
 
@@ -468,10 +568,12 @@ namespace DOpE
     {
       state_reinit_ = true;
       adjoint_reinit_ = true;
+      embedded_reinit_ = true;
     }
 
     build_state_matrix_ = true;
     build_adjoint_matrix_ = true;
+    build_embedded_matrix_ = true;
 
     GetU().ReInit();
 
@@ -501,8 +603,20 @@ namespace DOpE
         state_reinit_ = false;
       }
 
-    this->ForwardTimeLoop(problem,this->GetU(),"State",true);
-
+    if (adaptive_time_stepping_)
+      {
+        auto &embedded_problem = this->GetProblem()->GetEmbeddedStateProblem();
+        if (embedded_reinit_ == true)
+          {
+            nonlinear_embedded_solver_.ReInit(embedded_problem);
+            embedded_reinit_ = false;
+          }
+        this->AdaptiveForwardTimeLoop(problem,embedded_problem,this->GetU(),"State",true);
+      }
+    else
+      {
+        this->ForwardTimeLoop(problem,this->GetU(),"State",true);
+      }
   }
   /******************************************************/
 
@@ -671,10 +785,13 @@ namespace DOpE
                     this->SetProblemType("aux_error",i);
                     auto &problem = this->GetProblem()->GetErrorPrecomputations();
 
-                    this->GetIntegrator().ComputeNonlinearRhs(problem, aux_nodal_values[i]->GetSpacialVector());
-
-                    //Distribute for hanging nodes
-                    problem.GetDoFConstraints().distribute(aux_nodal_values[i]->GetSpacialVector());
+                    //Distributed vectors are assembled into a copy without ghost entries.
+                    DOpEHelper::update_owned(aux_nodal_values[i]->GetSpacialVector(), [this, &problem](VECTOR &v)
+                    {
+                      this->GetIntegrator().ComputeNonlinearRhs(problem, v);
+                      //Distribute for hanging nodes
+                      problem.GetDoFConstraints().distribute(v);
+                    });
                     //output (in vtk files)
                     this->GetOutputHandler()->Write(aux_nodal_values[i]->GetSpacialVector(),
                                                     "Aux_Error_Indicators_"+i,"state");
@@ -780,10 +897,13 @@ namespace DOpE
                 this->SetProblemType("aux_error",i);
                 auto &problem = this->GetProblem()->GetErrorPrecomputations();
 
-                this->GetIntegrator().ComputeNonlinearRhs(problem, aux_nodal_values[i]->GetSpacialVector());
-
-                //Distribute for hanging nodes
-                problem.GetDoFConstraints().distribute(aux_nodal_values[i]->GetSpacialVector());
+                //Distributed vectors are assembled into a copy without ghost entries.
+                DOpEHelper::update_owned(aux_nodal_values[i]->GetSpacialVector(), [this, &problem](VECTOR &v)
+                {
+                  this->GetIntegrator().ComputeNonlinearRhs(problem, v);
+                  //Distribute for hanging nodes
+                  problem.GetDoFConstraints().distribute(v);
+                });
                 //output (in vtk files)
                 this->GetOutputHandler()->Write(aux_nodal_values[i]->GetSpacialVector(),
                                                 "Aux_Error_Indicators_"+i,"state");
@@ -874,12 +994,9 @@ namespace DOpE
     this->GetIntegrator().AddDomainData("state", &(GetU().GetSpacialVector()));
     {
       //Aux Functionals
-      double ret = 0;
-      bool found = false;
+      std::vector<unsigned int> functionals;
       for (unsigned int i = 0; i < this->GetProblem()->GetNFunctionals(); i++)
         {
-          ret = 0;
-          found = false;
           this->SetProblemType("aux_functional", i);
           if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
             {
@@ -897,86 +1014,69 @@ namespace DOpE
                   auto func_vals = GetAuxiliaryTimeParams(tmp.str());
                   this->GetIntegrator().AddParamData(tmp.str(),&(func_vals->second[step]));
                 }
-              if (this->GetProblem()->GetFunctionalType().find("domain") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeDomainScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("point") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputePointScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("boundary") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeBoundaryScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("face") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeFaceScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("algebraic")
-                  != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeAlgebraicScalar(*(this->GetProblem()));
-                }
-              if (!found)
-                {
-                  throw DOpEException(
-                    "Unknown Functional Type: " + this->GetProblem()->GetFunctionalType(),
-                    "InstatPDEProblem::ComputeTimeFunctionals");
-                }
-              if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
+              functionals.push_back(i);
+            }
+        }
+
+      //All functionals of this time point are evaluated in one loop over the mesh.
+      std::vector<double> values;
+      this->GetIntegrator().ComputeScalars(*(this->GetProblem()), functionals, [this](unsigned int i)
+      {
+        this->SetProblemType("aux_functional", i);
+      }, values);
+
+      for (unsigned int j = 0; j < functionals.size(); j++)
+        {
+          const unsigned int i = functionals[j];
+          const double ret = values[j];
+          this->SetProblemType("aux_functional", i);
+          if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
+            {
+              std::stringstream tmp;
+              tmp << "aux_functional_"<<i<<"_pre";
+              this->GetIntegrator().DeleteParamData(tmp.str());
+            }
+          // Save value
+          if (this->GetProblem()->GetFunctionalType().find("timelocal") != std::string::npos)
+            {
+              std::stringstream out;
+              this->GetOutputHandler()->InitOut(out);
+              out << "\t" << this->GetProblem()->GetFunctionalName() << ": " << ret;
+              this->GetOutputHandler()->Write(out, 5 + this->GetBasePriority());
+              this->GetFunctionalValues()[i].push_back(ret);
+            }
+          else if (this->GetProblem()->GetFunctionalType().find("timedistributed") != std::string::npos)
+            {
+              if (this->GetFunctionalValues()[i].size() != 1)
                 {
-                  std::stringstream tmp;
-                  tmp << "aux_functional_"<<i<<"_pre";
-                  this->GetIntegrator().DeleteParamData(tmp.str());
+                  this->GetFunctionalValues()[i].resize(1);
+                  this->GetFunctionalValues()[i][0] = 0.;
                 }
-              // Save value
-              if (this->GetProblem()->GetFunctionalType().find("timelocal") != std::string::npos)
+              double w = 0.;
+              if ((step == 0))
                 {
-                  std::stringstream out;
-                  this->GetOutputHandler()->InitOut(out);
-                  out << "\t" << this->GetProblem()->GetFunctionalName() << ": " << ret;
-                  this->GetOutputHandler()->Write(out, 5 + this->GetBasePriority());
-                  this->GetFunctionalValues()[i].push_back(ret);
+                  w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
+                             - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
                 }
-              else if (this->GetProblem()->GetFunctionalType().find("timedistributed") != std::string::npos)
+              else if (step  == num_steps)
                 {
-                  if (this->GetFunctionalValues()[i].size() != 1)
-                    {
-                      this->GetFunctionalValues()[i].resize(1);
-                      this->GetFunctionalValues()[i][0] = 0.;
-                    }
-                  double w = 0.;
-                  if ((step == 0))
-                    {
-                      w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
-                                 - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
-                    }
-                  else if (step  == num_steps)
-                    {
-                      w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
-                                 - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
-                    }
-                  else
-                    {
-                      w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
-                                 - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
-                      w += 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
-                                  - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
-                    }
-                  this->GetFunctionalValues()[i][0] += w * ret;
+                  w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
+                             - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
                 }
               else
                 {
-                  throw DOpEException(
-                    "Unknown Functional Type: " + this->GetProblem()->GetFunctionalType(),
-                    "InstatPDEProblem::ComputeTimeFunctionals");
+                  w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
+                             - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
+                  w += 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
+                              - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
                 }
+              this->GetFunctionalValues()[i][0] += w * ret;
+            }
+          else
+            {
+              throw DOpEException(
+                "Unknown Functional Type: " + this->GetProblem()->GetFunctionalType(),
+                "InstatPDEProblem::ComputeTimeFunctionals");
             }
         }
     }
@@ -1370,6 +1470,331 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename NONLINEARSOLVER,
+           typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  template<typename PDE, typename EMBEDDEDPDE>
+  void InstatPDEProblem<NONLINEARSOLVER,
+       INTEGRATOR, PROBLEM, VECTOR, dealdim>::
+       AdaptiveForwardTimeLoop(PDE &problem, EMBEDDEDPDE &embedded_problem,
+                               StateVector<VECTOR> &sol, std::string outname, bool eval_funcs)
+  {
+    auto *sth = this->GetProblem()->GetSpaceTimeHandler();
+
+    if (sth->GetTimeDoFHandler().GetLocalNbrOfDoFs() != 2)
+      {
+        throw DOpEException("Adaptive time stepping is only available for one step schemes.",
+                            "InstatPDEProblem::AdaptiveForwardTimeLoop");
+      }
+    if (sol.GetBehavior() != DOpEtypes::VectorStorageType::fullmem)
+      {
+        throw DOpEException("Adaptive time stepping requires the storage type fullmem for the state, as the accepted time steps need to be kept when the temporal mesh is refined.",
+                            "InstatPDEProblem::AdaptiveForwardTimeLoop");
+      }
+    if (!this->GetUserTimeDomainData().empty())
+      {
+        throw DOpEException("Adaptive time stepping can not be used with user defined time domain data.",
+                            "InstatPDEProblem::AdaptiveForwardTimeLoop");
+      }
+    if (std::is_same<PDE, EMBEDDEDPDE>::value)
+      {
+        throw DOpEException("Adaptive time stepping estimates the error by comparison with the embedded backward Euler scheme, hence the given scheme must not be backward Euler.",
+                            "InstatPDEProblem::AdaptiveForwardTimeLoop");
+      }
+
+    //Start on the finer temporal mesh, the steps can grow by merging.
+    sth->RefineTimeToLevel(time_step_fine_start_);
+    sol.ReInit();
+
+    VECTOR u_old, u_embedded;
+    std::vector<unsigned int> local_to_global(2);
+    {
+      TimeIterator it = sth->GetTimeDoFHandler().first_interval();
+      it.get_time_dof_indices(local_to_global);
+      problem.SetTime(sth->GetTime(local_to_global[0]), local_to_global[0], it,true);
+      sol.SetTimeDoFNumber(local_to_global[0], it);
+    }
+    // Set u_old to initial_values
+    sth->ReinitVector(u_old, DOpEtypes::state);
+    sth->ReinitVector(u_embedded, DOpEtypes::state);
+    // Projection of initial data
+    this->GetOutputHandler()->SetIterationNumber(0, "Time");
+    {
+      this->GetOutputHandler()->Write("Computing Initial Values:",
+                                      4 + this->GetBasePriority());
+
+      auto &initial_problem = problem.GetInitialProblem();
+      this->GetProblem()->AddAuxiliaryToIntegrator(this->GetIntegrator());
+
+      build_state_matrix_ = this->GetNonlinearSolver("state").NonlinearSolve_Initial(
+                              initial_problem, u_old, true, true);
+      build_state_matrix_ = true;
+
+      this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetIntegrator());
+    }
+    sol.GetSpacialVector() = u_old;
+    this->GetOutputHandler()->Write(u_old, outname + this->GetPostIndex(),
+                                    problem.GetDoFType());
+
+    unsigned int n_accepted = 0, n_rejected = 0, n_merged = 0;
+    //The matrices depend on the step size, so they need to be rebuild
+    //whenever the step size changes.
+    double last_k = -1.;
+    TimeIterator it = sth->GetTimeDoFHandler().first_interval();
+    while (it != sth->GetTimeDoFHandler().after_last_interval())
+      {
+        it.get_time_dof_indices(local_to_global);
+        const double k = it.get_k();
+
+        this->GetOutputHandler()->SetIterationNumber(local_to_global[1],
+                                                     "Time");
+        sth->SetInterval(it,local_to_global[1]);
+        if (sth->TemporalMeshTransferState(u_old, local_to_global[0], local_to_global[1]))
+          {
+            throw DOpEException("Adaptive time stepping is not available with temporally changing meshes.",
+                                "InstatPDEProblem::AdaptiveForwardTimeLoop");
+          }
+
+        std::stringstream out;
+        this->GetOutputHandler()->InitOut(out);
+        out << "\t Timestep: " << local_to_global[1] << " ("
+            << sth->GetTime(local_to_global[0]) << " -> " << sth->GetTime(local_to_global[1])
+            << ") using " << problem.GetName();
+        problem.GetOutputHandler()->Write(out,
+                                          4 + this->GetBasePriority());
+
+        if (k != last_k)
+          {
+            build_state_matrix_ = true;
+            build_embedded_matrix_ = true;
+            last_k = k;
+          }
+
+        sol.SetTimeDoFNumber(local_to_global[1], it);
+        sol.GetSpacialVector() = 0;
+        SolveTimeStep(problem, nonlinear_state_solver_, build_state_matrix_,
+                      it, local_to_global, u_old, sol.GetSpacialVector());
+        u_embedded = 0;
+        SolveTimeStep(embedded_problem, nonlinear_embedded_solver_, build_embedded_matrix_,
+                      it, local_to_global, u_old, u_embedded);
+
+        double error = 0.;
+        DOpEHelper::update_owned(u_embedded, sol.GetSpacialVector(),
+                                 [this, &error](VECTOR &e, const VECTOR &u)
+        {
+          e -= u;
+          error = e.linfty_norm() / (time_step_abs_tol_ + time_step_rel_tol_ * u.linfty_norm());
+        });
+
+        if (error > 1.)
+          {
+            if (0.5 * k < min_time_step_)
+              {
+                std::stringstream msg;
+                msg << "The local error " << error << " of time step " << local_to_global[1]
+                    << " exceeds the tolerance, but the step size " << k
+                    << " may not be bisected below min_time_step " << min_time_step_ << ".";
+                throw DOpEException(msg.str(),
+                                    "InstatPDEProblem::AdaptiveForwardTimeLoop");
+              }
+            std::stringstream rejected;
+            this->GetOutputHandler()->InitOut(rejected);
+            rejected << "\t Step rejected (local error " << error << "), bisecting the interval";
+            problem.GetOutputHandler()->Write(rejected,
+                                              4 + this->GetBasePriority());
+            n_rejected++;
+
+            std::vector<double> accepted_times(local_to_global[0] + 1);
+            for (unsigned int i = 0; i < accepted_times.size(); i++)
+              {
+                accepted_times[i] = sth->GetTime(i);
+              }
+            sth->RefineTimeInterval(it);
+            sol.ReInit();
+            it = GetIntervalStartingAt(RestoreAcceptedTimePoints(sol, accepted_times));
+            continue;
+          }
+
+        std::stringstream accepted;
+        this->GetOutputHandler()->InitOut(accepted);
+        accepted << "\t Step accepted (local error " << error << ")";
+        problem.GetOutputHandler()->Write(accepted,
+                                          5 + this->GetBasePriority());
+        n_accepted++;
+
+        u_old = sol.GetSpacialVector();
+        this->GetOutputHandler()->Write(sol.GetSpacialVector(),
+                                        outname + this->GetPostIndex(), problem.GetDoFType());
+        ++it;
+
+        //The difference of the two schemes is of second order in the step size,
+        //so doubling the step is expected to increase the error by a factor of four.
+        //With a safety factor of two the next two intervals are merged if this is
+        //still acceptable. Only time points right of the accepted ones are removed.
+        if (8. * error < 1. && it != sth->GetTimeDoFHandler().after_last_interval())
+          {
+            if (sth->MergeTimeIntervals(it))
+              {
+                n_merged++;
+                sol.ReInit();
+                it = GetIntervalStartingAt(local_to_global[1]);
+              }
+          }
+      }
+    {
+      std::stringstream out;
+      this->GetOutputHandler()->InitOut(out);
+      out << "\t Adaptive time stepping: " << n_accepted << " steps accepted, "
+          << n_rejected << " rejected, " << n_merged << " merged";
+      this->GetOutputHandler()->Write(out, 4 + this->GetBasePriority());
+    }
+
+    //The temporal mesh is final only now, hence the functionals
+    //are evaluated in a separate sweep over the accepted time points.
+    if (eval_funcs)
+      {
+        const unsigned int max_timestep = sth->GetMaxTimePoint();
+        for (TimeIterator it = sth->GetTimeDoFHandler().first_interval();
+             it != sth->GetTimeDoFHandler().after_last_interval(); ++it)
+          {
+            it.get_time_dof_indices(local_to_global);
+            const bool first = (local_to_global[0] == 0);
+            for (unsigned int i = (first ? 0 : 1); i < 2; i++)
+              {
+                problem.SetTime(sth->GetTime(local_to_global[i]), local_to_global[i], it, first && i == 0);
+                sol.SetTimeDoFNumber(local_to_global[i], it);
+                AddUDD(local_to_global[i], it);
+                ComputeTimeFunctionals(local_to_global[i], max_timestep);
+                DeleteUDD();
+                this->SetProblemType("state");
+              }
+          }
+      }
+  }
+
+  /******************************************************/
+
+  template<typename NONLINEARSOLVER,
+           typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  unsigned int InstatPDEProblem<NONLINEARSOLVER,
+           INTEGRATOR, PROBLEM, VECTOR, dealdim>::
+           RestoreAcceptedTimePoints(StateVector<VECTOR> &sol,
+                                     const std::vector<double> &accepted_times)
+  {
+    auto *sth = this->GetProblem()->GetSpaceTimeHandler();
+
+    //The refinement only inserts time points, so the new numbers are
+    //found by searching for the closest time point from left to right.
+    std::vector<unsigned int> new_number(accepted_times.size());
+    unsigned int j = 0;
+    for (unsigned int i = 0; i < accepted_times.size(); i++)
+      {
+        while (j < sth->GetMaxTimePoint()
+               && std::fabs(sth->GetTime(j + 1) - accepted_times[i])
+               < std::fabs(sth->GetTime(j) - accepted_times[i]))
+          {
+            j++;
+          }
+        new_number[i] = j;
+      }
+    if (new_number.back() == accepted_times.size() - 1)
+      return new_number.back();
+
+    //Move the accepted vectors from right to left, such that none is
+    //overwritten before it is moved.
+    VECTOR tmp;
+    for (unsigned int i = accepted_times.size(); i-- > 0;)
+      {
+        if (new_number[i] != i)
+          {
+            sol.SetTimeDoFNumber(i);
+            tmp = sol.GetSpacialVector();
+            sol.SetTimeDoFNumber(new_number[i]);
+            sol.GetSpacialVector() = tmp;
+          }
+      }
+    for (unsigned int i = 1; i < accepted_times.size(); i++)
+      {
+        for (unsigned int m = new_number[i - 1] + 1; m < new_number[i]; m++)
+          {
+            const double lambda = (sth->GetTime(m) - accepted_times[i - 1])
+                                  / (accepted_times[i] - accepted_times[i - 1]);
+            sol.SetTimeDoFNumber(new_number[i - 1]);
+            tmp = sol.GetSpacialVector();
+            tmp *= 1. - lambda;
+            sol.SetTimeDoFNumber(new_number[i]);
+            tmp.add(lambda, sol.GetSpacialVector());
+            sol.SetTimeDoFNumber(m);
+            sol.GetSpacialVector() = tmp;
+          }
+      }
+    return new_number.back();
+  }
+
+  /******************************************************/
+
+  template<typename NONLINEARSOLVER,
+           typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  TimeIterator InstatPDEProblem<NONLINEARSOLVER,
+           INTEGRATOR, PROBLEM, VECTOR, dealdim>::
+           GetIntervalStartingAt(unsigned int time_point)
+  {
+    auto *sth = this->GetProblem()->GetSpaceTimeHandler();
+    std::vector<unsigned int> local_to_global(2);
+    TimeIterator it = sth->GetTimeDoFHandler().first_interval();
+    it.get_time_dof_indices(local_to_global);
+    while (local_to_global[0] != time_point)
+      {
+        ++it;
+        assert(it != sth->GetTimeDoFHandler().after_last_interval());
+        it.get_time_dof_indices(local_to_global);
+      }
+    return it;
+  }
+
+  /******************************************************/
+
+  template<typename NONLINEARSOLVER,
+           typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  template<typename PDE>
+  void InstatPDEProblem<NONLINEARSOLVER,
+       INTEGRATOR, PROBLEM, VECTOR, dealdim>::
+       SolveTimeStep(PDE &problem, NONLINEARSOLVER &solver, bool &build_matrix,
+                     const TimeIterator &interval,
+                     const std::vector<unsigned int> &local_to_global,
+                     const VECTOR &u_old, VECTOR &solution)
+  {
+    auto *sth = this->GetProblem()->GetSpaceTimeHandler();
+
+    problem.SetTime(sth->GetTime(local_to_global[0]), local_to_global[0], interval);
+    //Only set Time for DoFHandler to have the correct unknowns.
+    sth->SetInterval(interval,local_to_global[1]);
+
+    this->GetProblem()->AddAuxiliaryToIntegrator(
+      this->GetIntegrator());
+    solver.NonlinearLastTimeEvals(problem, u_old, solution);
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(
+      this->GetIntegrator());
+
+    problem.SetTime(sth->GetTime(local_to_global[1]), local_to_global[1], interval);
+
+    this->GetProblem()->AddAuxiliaryToIntegrator(
+      this->GetIntegrator());
+    this->GetProblem()->AddPreviousAuxiliaryToIntegrator(
+      this->GetIntegrator());
+    build_matrix = solver.NonlinearSolve(problem, u_old, solution, true,
+                                         build_matrix);
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(
+      this->GetIntegrator());
+    this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(
+      this->GetIntegrator());
+  }
+
+  /******************************************************/
+
   template<typename NONLINEARSOLVER,
            typename INTEGRATOR, typename PROBLEM,
            typename VECTOR, int dealdim>
@@ -29,6 +29,7 @@
 #include <include/parameterreader.h>
 #include <include/statevector.h>
 #include <include/solutionextractor.h>
+#include <include/timesteppredictor.h>
 #include <interfaces/pdeinterface.h>
 #include <interfaces/functionalinterface.h>
 #include <interfaces/dirichletdatainterface.h>
@@ -246,6 +247,19 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Implementation of Virtual Method in Base Class
+     * ReducedProblemInterface
+     *
+     * If predictor_previous_iterate is set, the complete state and adjoint
+     * of the accepted iterate are kept. The time loops use them as initial
+     * guesses. Solutions computed for trial controls that are not accepted,
+     * e.g., in a line search, are never used.
+     */
+    void AcceptIterate(const ControlVector<VECTOR> & /*q*/) override;
+
+    /******************************************************/
+
     /**
      *  Here, the given ControlVector<VECTOR> v is printed to a file of *.vtk or *.gpl format.
      *  However, in later implementations other file formats will be available.
@@ -464,6 +478,15 @@ namespace DOpE
     NONLINEARSOLVER nonlinear_state_solver_;
     NONLINEARSOLVER nonlinear_adjoint_solver_;
     CONTROLNONLINEARSOLVER nonlinear_gradient_solver_;
+    TimeStepPredictor<VECTOR> predictor_;
+
+    //Whether u_ and z_ contain the complete solution of a previous call.
+    bool state_available_ = false, adjoint_available_ = false;
+    //The state and adjoint of the last accepted iterate, used as initial
+    //guess if predictor_.UsePreviousIterate().
+    StateVector<VECTOR> accepted_u_;
+    StateVector<VECTOR> accepted_z_;
+    bool accepted_state_available_ = false, accepted_adjoint_available_ = false;
 
     bool build_state_matrix_ = false, build_adjoint_matrix_ = false, build_control_matrix_ = false;
     bool state_reinit_, adjoint_reinit_, gradient_reinit_;
@@ -489,6 +512,7 @@ namespace DOpE
          ParameterReader &param_reader)
   {
     NONLINEARSOLVER::declare_params(param_reader);
+    TimeStepPredictor<VECTOR>::declare_params(param_reader);
   }
   /******************************************************/
 
@@ -509,11 +533,14 @@ namespace DOpE
                          z_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                          du_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                          dz_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
+                         accepted_u_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
+                         accepted_z_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                          integrator_(idc),
                          control_integrator_(idc),
                          nonlinear_state_solver_(integrator_, param_reader),
                          nonlinear_adjoint_solver_(integrator_, param_reader),
-                         nonlinear_gradient_solver_(control_integrator_, param_reader)
+                         nonlinear_gradient_solver_(control_integrator_, param_reader),
+                         predictor_(param_reader)
   {
     // Solvers should be ReInited
     {
@@ -542,11 +569,14 @@ namespace DOpE
                          z_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                          du_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                          dz_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
+                         accepted_u_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
+                         accepted_z_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
                          integrator_(s_idc),
                          control_integrator_(c_idc),
                          nonlinear_state_solver_(integrator_, param_reader),
                          nonlinear_adjoint_solver_(integrator_, param_reader),
-                         nonlinear_gradient_solver_(control_integrator_, param_reader)
+                         nonlinear_gradient_solver_(control_integrator_, param_reader),
+                         predictor_(param_reader)
   {
     //Solvers should be ReInited
     {
@@ -629,6 +659,10 @@ namespace DOpE
 
     build_state_matrix_ = true;
     build_adjoint_matrix_ = true;
+    state_available_ = false;
+    adjoint_available_ = false;
+    accepted_state_available_ = false;
+    accepted_adjoint_available_ = false;
 
     GetU().ReInit();
     GetZ().ReInit();
@@ -645,6 +679,32 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER, typename CONTROLINTEGRATOR,
+           typename INTEGRATOR, typename PROBLEM, typename VECTOR, int dopedim,
+           int dealdim>
+  void InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER, CONTROLINTEGRATOR, INTEGRATOR,
+       PROBLEM, VECTOR, dopedim, dealdim>::AcceptIterate(const ControlVector<VECTOR> & /*q*/)
+  {
+    if (!predictor_.UsePreviousIterate()
+        || GetU().GetBehavior() != DOpEtypes::VectorStorageType::fullmem)
+      {
+        return;
+      }
+    //Only complete solutions, i.e., of time loops that have not been interrupted, are kept.
+    accepted_state_available_ = state_available_;
+    if (state_available_)
+      {
+        accepted_u_ = GetU();
+      }
+    accepted_adjoint_available_ = adjoint_available_;
+    if (adjoint_available_)
+      {
+        accepted_z_ = GetZ();
+      }
+  }
+
+  /******************************************************/
+
   template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER, typename CONTROLINTEGRATOR,
            typename INTEGRATOR, typename PROBLEM, typename VECTOR, int dopedim,
            int dealdim>
@@ -795,7 +855,7 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetControlIntegrator().AddParamData("control",
-                                                      &(q.GetSpacialVectorCopy()));
+                                                      &(q.GetSpacialVectorView()));
           }
         else
           {
@@ -824,7 +884,7 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                      &(gradient_transposed.GetSpacialVectorCopy()));
+                                                      &(gradient_transposed.GetSpacialVectorView()));
             this->GetControlIntegrator().ComputeNonlinearResidual(
               *(this->GetProblem()), gradient.GetSpacialVector());
 
@@ -908,9 +968,9 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetControlIntegrator().AddParamData("control",
-                                                      &(q.GetSpacialVectorCopy()));
+                                                      &(q.GetSpacialVectorView()));
             this->GetControlIntegrator().AddParamData("fixed_rhs",
-                                                      &(tmp.GetSpacialVectorCopy()));
+                                                      &(tmp.GetSpacialVectorView()));
           }
         else
           {
@@ -934,7 +994,7 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                      &(gradient_transposed.GetSpacialVectorCopy()));
+                                                      &(gradient_transposed.GetSpacialVectorView()));
             this->GetControlIntegrator().ComputeNonlinearResidual(
               *(this->GetProblem()), gradient.GetSpacialVector());
 
@@ -1209,7 +1269,7 @@ namespace DOpE
           else if (dopedim == 0)
             {
               this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                        &(hessian_direction_transposed.GetSpacialVectorCopy()));
+                                                        &(hessian_direction_transposed.GetSpacialVectorView()));
               this->GetControlIntegrator().ComputeNonlinearResidual(
                 *(this->GetProblem()), hessian_direction.GetSpacialVector());
               this->GetControlIntegrator().DeleteParamData("last_newton_solution");
@@ -1289,9 +1349,9 @@ namespace DOpE
           else if (dopedim == 0)
             {
               this->GetControlIntegrator().AddParamData("fixed_rhs",
-                                                        &(tmp.GetSpacialVectorCopy()));
+                                                        &(tmp.GetSpacialVectorView()));
               this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                        &(hessian_direction_transposed.GetSpacialVectorCopy()));
+                                                        &(hessian_direction_transposed.GetSpacialVectorView()));
               this->GetControlIntegrator().ComputeNonlinearResidual(
                 *(this->GetProblem()), hessian_direction.GetSpacialVector());
               this->GetControlIntegrator().DeleteParamData("last_newton_solution");
@@ -1474,12 +1534,9 @@ namespace DOpE
     }
     {
       //Aux Functionals
-      double ret = 0;
-      bool found = false;
+      std::vector<unsigned int> functionals;
       for (unsigned int i = 0; i < this->GetProblem()->GetNFunctionals(); i++)
         {
-          ret = 0;
-          found = false;
           this->SetProblemType("aux_functional", i);
           if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
             {
@@ -1497,86 +1554,69 @@ namespace DOpE
                   auto func_vals = GetAuxiliaryTimeParams(tmp.str());
                   this->GetIntegrator().AddParamData(tmp.str(),&(func_vals->second[step]));
                 }
-              if (this->GetProblem()->GetFunctionalType().find("domain") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeDomainScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("point") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputePointScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("boundary") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeBoundaryScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("face") != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeFaceScalar(*(this->GetProblem()));
-                }
-              if (this->GetProblem()->GetFunctionalType().find("algebraic")
-                  != std::string::npos)
-                {
-                  found = true;
-                  ret += this->GetIntegrator().ComputeAlgebraicScalar(*(this->GetProblem()));
-                }
-              if (!found)
-                {
-                  throw DOpEException(
-                    "Unknown Functional Type: " + this->GetProblem()->GetFunctionalType(),
-                    "InstatReducedProblem::ComputeTimeFunctionals");
-                }
-              if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
+              functionals.push_back(i);
+            }
+        }
+
+      //All functionals of this time point are evaluated in one loop over the mesh.
+      std::vector<double> values;
+      this->GetIntegrator().ComputeScalars(*(this->GetProblem()), functionals, [this](unsigned int i)
+      {
+        this->SetProblemType("aux_functional", i);
+      }, values);
+
+      for (unsigned int j = 0; j < functionals.size(); j++)
+        {
+          const unsigned int i = functionals[j];
+          const double ret = values[j];
+          this->SetProblemType("aux_functional", i);
+          if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
+            {
+              std::stringstream tmp;
+              tmp << "aux_functional_"<<i<<"_pre";
+              this->GetIntegrator().DeleteParamData(tmp.str());
+            }
+          // Save value
+          if (this->GetProblem()->GetFunctionalType().find("timelocal") != std::string::npos)
+            {
+              std::stringstream out;
+              this->GetOutputHandler()->InitOut(out);
+              out << "\t" << this->GetProblem()->GetFunctionalName() << ": " << ret;
+              this->GetOutputHandler()->Write(out, 5 + this->GetBasePriority());
+              this->GetFunctionalValues()[i + 1].push_back(ret);
+            }
+          else if (this->GetProblem()->GetFunctionalType().find("timedistributed") != std::string::npos)
+            {
+              if (this->GetFunctionalValues()[i + 1].size() != 1)
                 {
-                  std::stringstream tmp;
-                  tmp << "aux_functional_"<<i<<"_pre";
-                  this->GetIntegrator().DeleteParamData(tmp.str());
+                  this->GetFunctionalValues()[i + 1].resize(1);
+                  this->GetFunctionalValues()[i + 1][0] = 0.;
                 }
-              // Save value
-              if (this->GetProblem()->GetFunctionalType().find("timelocal") != std::string::npos)
+              double w = 0.;
+              if ((step == 0))
                 {
-                  std::stringstream out;
-                  this->GetOutputHandler()->InitOut(out);
-                  out << "\t" << this->GetProblem()->GetFunctionalName() << ": " << ret;
-                  this->GetOutputHandler()->Write(out, 5 + this->GetBasePriority());
-                  this->GetFunctionalValues()[i + 1].push_back(ret);
+                  w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
+                             - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
                 }
-              else if (this->GetProblem()->GetFunctionalType().find("timedistributed") != std::string::npos)
+              else if (step  == num_steps)
                 {
-                  if (this->GetFunctionalValues()[i + 1].size() != 1)
-                    {
-                      this->GetFunctionalValues()[i + 1].resize(1);
-                      this->GetFunctionalValues()[i + 1][0] = 0.;
-                    }
-                  double w = 0.;
-                  if ((step == 0))
-                    {
-                      w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
-                                 - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
-                    }
-                  else if (step  == num_steps)
-                    {
-                      w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
-                                 - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
-                    }
-                  else
-                    {
-                      w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
-                                 - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
-                      w += 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
-                                  - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
-                    }
-                  this->GetFunctionalValues()[i + 1][0] += w * ret;
+                  w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
+                             - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
                 }
               else
                 {
-                  throw DOpEException(
-                    "Unknown Functional Type: " + this->GetProblem()->GetFunctionalType(),
-                    "InstatReducedProblem::ComputeTimeFunctionals");
+                  w = 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step + 1)
+                             - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step));
+                  w += 0.5 * (this->GetProblem()->GetSpaceTimeHandler()->GetTime(step)
+                              - this->GetProblem()->GetSpaceTimeHandler()->GetTime(step - 1));
                 }
+              this->GetFunctionalValues()[i + 1][0] += w * ret;
+            }
+          else
+            {
+              throw DOpEException(
+                "Unknown Functional Type: " + this->GetProblem()->GetFunctionalType(),
+                "InstatReducedProblem::ComputeTimeFunctionals");
             }
         }
     }
@@ -1657,7 +1697,7 @@ namespace DOpE
        CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
        ForwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_funcs)
   {
-    VECTOR u_old;
+    VECTOR u_old, initial_guess;
 
     unsigned int max_timestep =
       problem.GetSpaceTimeHandler()->GetMaxTimePoint();
@@ -1701,6 +1741,16 @@ namespace DOpE
 
     }
     sol.GetSpacialVector() = u_old;
+
+    //Only the state of an accepted iterate is used.
+    const bool use_previous_iterate = predictor_.UsePreviousIterate() && outname == "State"
+                                      && accepted_state_available_;
+    if (outname == "State")
+      {
+        state_available_ = false;
+      }
+    predictor_.Clear();
+    predictor_.Push(u_old, times[local_to_global[0]]);
     this->GetOutputHandler()->Write(u_old, outname + this->GetPostIndex(),
                                     problem.GetDoFType());
 
@@ -1758,6 +1808,18 @@ namespace DOpE
                                               4 + this->GetBasePriority());
 
             sol.SetTimeDoFNumber(local_to_global[i], it);
+            //Initial guess for the Newton method, the default is u_old.
+            bool use_initial_guess = false;
+            if (use_previous_iterate)
+              {
+                accepted_u_.SetTimeDoFNumber(local_to_global[i], it);
+                initial_guess = accepted_u_.GetSpacialVector();
+                use_initial_guess = true;
+              }
+            else
+              {
+                use_initial_guess = predictor_.Predict(time, initial_guess);
+              }
             sol.GetSpacialVector() = 0;
 
             this->GetProblem()->AddAuxiliaryToIntegrator(
@@ -1777,7 +1839,8 @@ namespace DOpE
 
             build_state_matrix_
               = this->GetNonlinearSolver("state").NonlinearSolve(problem,
-                                                                 u_old, sol.GetSpacialVector(), true,
+                                                                 u_old, use_initial_guess ? initial_guess : u_old,
+                                                                 sol.GetSpacialVector(), true,
                                                                  build_state_matrix_);
 
             this->GetProblem()->DeleteAuxiliaryFromIntegrator(
@@ -1810,8 +1873,13 @@ namespace DOpE
               } // End precomputation of values
             //TODO do a transfer to the next grid for changing spatial meshes!
             u_old = sol.GetSpacialVector();
+            predictor_.Push(u_old, time);
           }
       }
+    if (outname == "State")
+      {
+        state_available_ = true;
+      }
   }
 
   /******************************************************/
@@ -1824,7 +1892,7 @@ namespace DOpE
        CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
        BackwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, ControlVector<VECTOR> &temp_q, ControlVector<VECTOR> &temp_q_trans, std::string outname, bool eval_grads)
   {
-    VECTOR u_old;
+    VECTOR u_old, initial_guess;
 
     unsigned int max_timestep =
       problem.GetSpaceTimeHandler()->GetMaxTimePoint();
@@ -1890,6 +1958,16 @@ namespace DOpE
 
     }
     sol.GetSpacialVector() = u_old;
+
+    //Only the adjoint of an accepted iterate is used.
+    const bool use_previous_iterate = predictor_.UsePreviousIterate() && outname == "Adjoint"
+                                      && accepted_adjoint_available_;
+    if (outname == "Adjoint")
+      {
+        adjoint_available_ = false;
+      }
+    predictor_.Clear();
+    predictor_.Push(u_old, times[max_timestep]);
     this->GetOutputHandler()->Write(u_old, outname + this->GetPostIndex(),
                                     problem.GetDoFType());
 
@@ -1922,6 +2000,18 @@ namespace DOpE
                                               4 + this->GetBasePriority());
 
             sol.SetTimeDoFNumber(local_to_global[j], it);
+            //Initial guess for the Newton method, the default is u_old.
+            bool use_initial_guess = false;
+            if (use_previous_iterate)
+              {
+                accepted_z_.SetTimeDoFNumber(local_to_global[j], it);
+                initial_guess = accepted_z_.GetSpacialVector();
+                use_initial_guess = true;
+              }
+            else
+              {
+                use_initial_guess = predictor_.Predict(time, initial_guess);
+              }
             sol.GetSpacialVector() = 0;
 
             this->GetProblem()->AddAuxiliaryToIntegrator(
@@ -1985,7 +2075,8 @@ namespace DOpE
 
             build_adjoint_matrix_
               = this->GetNonlinearSolver("adjoint").NonlinearSolve(problem,
-                                                                   u_old, sol.GetSpacialVector(), true,
+                                                                   u_old, use_initial_guess ? initial_guess : u_old,
+                                                                   sol.GetSpacialVector(), true,
                                                                    build_adjoint_matrix_);
 
             this->GetProblem()->DeleteAuxiliaryFromIntegrator(
@@ -2007,6 +2098,7 @@ namespace DOpE
 
             //TODO do a transfer to the next grid for changing spatial meshes!
             u_old = sol.GetSpacialVector();
+            predictor_.Push(u_old, time);
             this->GetOutputHandler()->Write(sol.GetSpacialVector(),
                                             outname + this->GetPostIndex(), problem.GetDoFType());
 
@@ -2037,6 +2129,7 @@ namespace DOpE
                             this->GetControlIntegrator().AddDomainData("adjoint",&(sol.GetSpacialVector()));
 
                             VECTOR tmp = temp_q.GetSpacialVector();
+                            DOpEHelper::make_distributed(tmp);
                             if (dopedim == dealdim)
                               {
                                 VECTOR tmp_2 = temp_q.GetSpacialVector();
@@ -2057,7 +2150,10 @@ namespace DOpE
                                 temp_q.UnLockCopy();
                               }
                             this->GetControlIntegrator().DeleteDomainData("adjoint");
-                            temp_q.GetSpacialVector() -= tmp;
+                            DOpEHelper::update_owned(temp_q.GetSpacialVector(), tmp, [](VECTOR &v, const VECTOR &w)
+                            {
+                              v -= w;
+                            });
                             this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetControlIntegrator());
                           }
                       }//End of type stationary
@@ -2079,23 +2175,37 @@ namespace DOpE
                           {
                             this->GetControlIntegrator().AddDomainData("last_newton_solution",
                                                                        &(temp_q_trans.GetSpacialVector()));
-                            this->GetControlIntegrator().ComputeNonlinearResidual(
-                              *(this->GetProblem()), temp_q.GetSpacialVector());
+                            DOpEHelper::update_owned(temp_q.GetSpacialVector(), [this](VECTOR &v)
+                            {
+                              this->GetControlIntegrator().ComputeNonlinearResidual(
+                                *(this->GetProblem()), v);
+                            });
                             this->GetControlIntegrator().DeleteDomainData("last_newton_solution");
                           }
                         else if (dopedim == 0)
                           {
                             this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                                      &(temp_q_trans.GetSpacialVectorCopy()));
-                            this->GetControlIntegrator().ComputeNonlinearResidual(
-                              *(this->GetProblem()), temp_q.GetSpacialVector());
+                                                                      &(temp_q_trans.GetSpacialVectorView()));
+                            DOpEHelper::update_owned(temp_q.GetSpacialVector(), [this](VECTOR &v)
+                            {
+                              this->GetControlIntegrator().ComputeNonlinearResidual(
+                                *(this->GetProblem()), v);
+                            });
 
                             this->GetControlIntegrator().DeleteParamData("last_newton_solution");
                             temp_q_trans.UnLockCopy();
                           }
-                        temp_q.GetSpacialVector() *= -1.;
+                        DOpEHelper::update_owned(temp_q.GetSpacialVector(), [](VECTOR &v)
+                        {
+                          v *= -1.;
+                        });
                         //Prescale with inverse of time step size to anticipate the time-scalar product.
-                        temp_q_trans.GetSpacialVector().equ(1./problem.GetSpaceTimeHandler()->GetStepSize(),temp_q.GetSpacialVector());
+                        const double inv_k = 1./problem.GetSpaceTimeHandler()->GetStepSize();
+                        DOpEHelper::update_owned(temp_q_trans.GetSpacialVector(), temp_q.GetSpacialVector(),
+                                                 [inv_k](VECTOR &v, const VECTOR &w)
+                        {
+                          v.equ(inv_k, w);
+                        });
                         //Compute l^2 representation of the Gradient
 
                         build_control_matrix_ = this->GetControlNonlinearSolver().NonlinearSolve(
@@ -2142,6 +2252,7 @@ namespace DOpE
                             this->GetControlIntegrator().AddDomainData("adjoint_hessian",&(sol.GetSpacialVector()));
 
                             VECTOR tmp = temp_q.GetSpacialVector();
+                            DOpEHelper::make_distributed(tmp);
                             if (dopedim == dealdim)
                               {
                                 VECTOR tmp_2 = temp_q.GetSpacialVector();
@@ -2162,7 +2273,10 @@ namespace DOpE
                                 temp_q.UnLockCopy();
                               }
                             this->GetControlIntegrator().DeleteDomainData("adjoint_hessian");
-                            temp_q.GetSpacialVector() -= tmp;
+                            DOpEHelper::update_owned(temp_q.GetSpacialVector(), tmp, [](VECTOR &v, const VECTOR &w)
+                            {
+                              v -= w;
+                            });
                             this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetControlIntegrator());
                           }
                       }//End stationary
@@ -2183,23 +2297,37 @@ namespace DOpE
                           {
                             this->GetControlIntegrator().AddDomainData("last_newton_solution",
                                                                        &(temp_q_trans.GetSpacialVector()));
-                            this->GetControlIntegrator().ComputeNonlinearResidual(
-                              *(this->GetProblem()), temp_q.GetSpacialVector());
+                            DOpEHelper::update_owned(temp_q.GetSpacialVector(), [this](VECTOR &v)
+                            {
+                              this->GetControlIntegrator().ComputeNonlinearResidual(
+                                *(this->GetProblem()), v);
+                            });
                             this->GetControlIntegrator().DeleteDomainData("last_newton_solution");
                           }
                         else if (dopedim == 0)
                           {
                             this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                                      &(temp_q_trans.GetSpacialVectorCopy()));
-                            this->GetControlIntegrator().ComputeNonlinearResidual(
-                              *(this->GetProblem()), temp_q.GetSpacialVector());
+                                                                      &(temp_q_trans.GetSpacialVectorView()));
+                            DOpEHelper::update_owned(temp_q.GetSpacialVector(), [this](VECTOR &v)
+                            {
+                              this->GetControlIntegrator().ComputeNonlinearResidual(
+                                *(this->GetProblem()), v);
+                            });
                             this->GetControlIntegrator().DeleteParamData("last_newton_solution");
                             temp_q_trans.UnLockCopy();
                           }
 
-                        temp_q.GetSpacialVector() *= -1.;
+                        DOpEHelper::update_owned(temp_q.GetSpacialVector(), [](VECTOR &v)
+                        {
+                          v *= -1.;
+                        });
                         //Prescale with inverse of time step size to anticipate the time-scalar product.
-                        temp_q_trans.GetSpacialVector().equ(1./problem.GetSpaceTimeHandler()->GetStepSize(),temp_q.GetSpacialVector());
+                        const double inv_k = 1./problem.GetSpaceTimeHandler()->GetStepSize();
+                        DOpEHelper::update_owned(temp_q_trans.GetSpacialVector(), temp_q.GetSpacialVector(),
+                                                 [inv_k](VECTOR &v, const VECTOR &w)
+                        {
+                          v.equ(inv_k, w);
+                        });
 
                         //Compute l^2 representation of the HessianVector
                         //hessian Matrix is the same as control matrix
@@ -2232,6 +2360,10 @@ namespace DOpE
               }
           }//End interval loop
       }//End time loop
+    if (outname == "Adjoint")
+      {
+        adjoint_available_ = true;
+      }
   }
 
   /******************************************************/
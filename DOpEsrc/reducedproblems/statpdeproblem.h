@@ -61,6 +61,8 @@
 #include <deal.II/lac/sparse_direct.h>
 
 #include <fstream>
+#include <functional>
+#include <memory>
 namespace DOpE
 {
   /**
@@ -161,6 +163,23 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Computes the states for several right hand sides of a linear PDE,
+     * e.g., different load cases. The matrix is only assembled and factorized
+     * once, see NewtonSolver::NonlinearSolveMultipleRhs.
+     *
+     * @param states       The states, one for each right hand side. Empty entries
+     *                     are created with the values of the current state. All
+     *                     entries are used as initial values.
+     * @param select_rhs   Is called with the number k of a right hand side and should
+     *                     switch the PDE to the k-th case.
+     */
+    void
+    ComputeReducedStates(std::vector<std::unique_ptr<StateVector<VECTOR> > > &states,
+                         const std::function<void(unsigned int)> &select_rhs);
+
+    /******************************************************/
+
     /**
      * Computes the error indicators for the error of a previosly
      * specified functional. Assumes that the primal state solution
@@ -538,7 +557,7 @@ namespace DOpE
           {
             //Only apply initial state if no previous values are present (i.e., u == 0)
             //thus, we can reuse good values from previous calculations
-            if ( GetU().GetSpacialVector().linfty_norm() < std::numeric_limits<double>::min() )
+            if ( GetU().Norm("infty") < std::numeric_limits<double>::min() )
               {
                 this->GetOutputHandler()->Write("Computing Initial Values:",
                                                 4 + this->GetBasePriority());
@@ -577,6 +596,58 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename NONLINEARSOLVER, typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  void
+  StatPDEProblem<NONLINEARSOLVER, INTEGRATOR, PROBLEM, VECTOR, dealdim>::ComputeReducedStates(
+    std::vector<std::unique_ptr<StateVector<VECTOR> > > &states,
+    const std::function<void(unsigned int)> &select_rhs)
+  {
+    this->SetProblemType("state");
+    auto &problem = this->GetProblem()->GetStateProblem();
+    if (state_reinit_ == true)
+      {
+        GetNonlinearSolver("state").ReInit(problem);
+        state_reinit_ = false;
+      }
+
+    std::vector<VECTOR *> solutions(states.size());
+    for (unsigned int k = 0; k < states.size(); k++)
+      {
+        if (!states[k])
+          {
+            //The copy constructor only copies the layout, the values
+            //of the current state have to be assigned.
+            states[k].reset(new StateVector<VECTOR>(GetU()));
+            *states[k] = GetU();
+          }
+        solutions[k] = &(states[k]->GetSpacialVector());
+      }
+
+    this->GetOutputHandler()->Write("Computing State Solutions:",
+                                    4 + this->GetBasePriority());
+
+    this->GetProblem()->AddAuxiliaryToIntegrator(this->GetIntegrator());
+
+    AddUDD();
+
+    build_state_matrix_ = this->GetNonlinearSolver("state").NonlinearSolveMultipleRhs(
+                            problem, solutions, select_rhs, true, build_state_matrix_);
+
+    DeleteUDD();
+
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetIntegrator());
+
+    for (unsigned int k = 0; k < states.size(); k++)
+      {
+        this->GetOutputHandler()->Write(*(solutions[k]),
+                                        "State_" + std::to_string(k) + this->GetPostIndex(),
+                                        problem.GetDoFType());
+      }
+  }
+
+  /******************************************************/
+
   template<typename NONLINEARSOLVER, typename INTEGRATOR, typename PROBLEM,
            typename VECTOR, int dealdim>
   void
@@ -585,7 +656,8 @@ namespace DOpE
   {
     this->GetOutputHandler()->Write("Computing Dual for Error Estimation:",
                                     4 + this->GetBasePriority());
-    if (weight_comp == DOpEtypes::higher_order_interpolation)
+    if (weight_comp == DOpEtypes::higher_order_interpolation
+        || weight_comp == DOpEtypes::patch_interpolation)
       {
         this->SetProblemType("adjoint_for_ee");
       }
@@ -640,11 +712,11 @@ namespace DOpE
                                         &(GetU().GetSpacialVector()));
     AddUDD();
 
-    for (unsigned int i = 0; i < this->GetProblem()->GetNFunctionals(); i++)
+    const unsigned int n_functionals = this->GetProblem()->GetNFunctionals();
+    std::vector<unsigned int> functionals(n_functionals);
+    for (unsigned int i = 0; i < n_functionals; i++)
       {
-        double ret = 0;
-        bool found = false;
-
+        functionals[i] = i;
         this->SetProblemType("aux_functional", i);
         if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
           {
@@ -656,47 +728,18 @@ namespace DOpE
             auto func_vals = GetAuxiliaryParams(tmp.str());
             this->GetIntegrator().AddParamData(tmp.str(),&(func_vals->second));
           }
-        if (this->GetProblem()->GetFunctionalType().find("domain")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeDomainScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("point")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputePointScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("boundary")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeBoundaryScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("face")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeFaceScalar(*(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("algebraic")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeAlgebraicScalar(*(this->GetProblem()));
-          }
+      }
 
-        if (!found)
-          {
-            throw DOpEException(
-              "Unknown Functional Type: "
-              + this->GetProblem()->GetFunctionalType(),
-              "StatPDEProblem::ComputeReducedFunctionals");
-          }
+    //All functionals are evaluated in one loop over the mesh.
+    std::vector<double> values;
+    this->GetIntegrator().ComputeScalars(*(this->GetProblem()), functionals, [this](unsigned int i)
+    {
+      this->SetProblemType("aux_functional", i);
+    }, values);
+
+    for (unsigned int i = 0; i < n_functionals; i++)
+      {
+        this->SetProblemType("aux_functional", i);
         if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
           {
             std::stringstream tmp;
@@ -704,10 +747,10 @@ namespace DOpE
             this->GetIntegrator().DeleteParamData(tmp.str());
           }
 
-        this->GetFunctionalValues()[i].push_back(ret);
+        this->GetFunctionalValues()[i].push_back(values[i]);
         std::stringstream out;
         this->GetOutputHandler()->InitOut(out);
-        out << this->GetProblem()->GetFunctionalName() << ": " << ret;
+        out << this->GetProblem()->GetFunctionalName() << ": " << values[i];
         this->GetOutputHandler()->Write(out, 2 + this->GetBasePriority());
       }
 
@@ -737,11 +780,11 @@ namespace DOpE
                                         &(GetU().GetSpacialVector()));
     AddUDD();
 
-    for (unsigned int i = 0; i < this->GetProblem()->GetNFunctionals(); i++)
+    const unsigned int n_functionals = this->GetProblem()->GetNFunctionals();
+    std::vector<unsigned int> functionals(n_functionals);
+    for (unsigned int i = 0; i < n_functionals; i++)
       {
-        double ret = 0;
-        bool found = false;
-
+        functionals[i] = i;
         this->SetProblemType("aux_functional", i);
         if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
           {
@@ -753,47 +796,18 @@ namespace DOpE
             auto func_vals = GetAuxiliaryParams(tmp.str());
             this->GetIntegrator().AddParamData(tmp.str(),&(func_vals->second));
           }
-        if (this->GetProblem()->GetFunctionalType().find("domain")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeDomainScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("point")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputePointScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("boundary")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeBoundaryScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("face")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeFaceScalar(*(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("algebraic")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeAlgebraicScalar(*(this->GetProblem()));
-          }
+      }
 
-        if (!found)
-          {
-            throw DOpEException(
-              "Unknown Functional Type: "
-              + this->GetProblem()->GetFunctionalType(),
-              "StatPDEProblem::ComputeReducedFunctionals");
-          }
+    //All functionals are evaluated in one loop over the mesh.
+    std::vector<double> values;
+    this->GetIntegrator().ComputeScalars(*(this->GetProblem()), functionals, [this](unsigned int i)
+    {
+      this->SetProblemType("aux_functional", i);
+    }, values);
+
+    for (unsigned int i = 0; i < n_functionals; i++)
+      {
+        this->SetProblemType("aux_functional", i);
         if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
           {
             std::stringstream tmp;
@@ -801,10 +815,10 @@ namespace DOpE
             this->GetIntegrator().DeleteParamData(tmp.str());
           }
 
-        this->GetFunctionalValues()[i].push_back(ret);
+        this->GetFunctionalValues()[i].push_back(values[i]);
         std::stringstream out;
         this->GetOutputHandler()->InitOut(out);
-        out << this->GetProblem()->GetFunctionalName() << ": " << ret;
+        out << this->GetProblem()->GetFunctionalName() << ": " << values[i];
         this->GetOutputHandler()->Write(out, 2 + this->GetBasePriority());
       }
 
@@ -47,6 +47,8 @@
 #include <templates/voidlinearsolver.h>
 #include <interfaces/constraintinterface.h>
 #include <include/solutionextractor.h>
+#include <include/iteratepool.h>
+#include <include/helper.h>
 
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/numerics/data_out.h>
@@ -252,6 +254,22 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Implementation of Virtual Method in Base Class
+     * ReducedProblemInterface
+     *
+     * Stores the current state and adjoint in the pool of accepted iterates.
+     * ComputeReducedState and ComputeReducedAdjoint start from the stored
+     * solutions of the closest accepted control, if any.
+     */
+    void
+    AcceptIterate(const ControlVector<VECTOR> &q) override
+    {
+      iterate_pool_.Add(q, GetU().GetSpacialVector(), GetZ().GetSpacialVector());
+    }
+
+    /******************************************************/
+
     /**
      * Implementation of Virtual Method in Base Class
      * ReducedProblemInterface
@@ -466,6 +484,7 @@ namespace DOpE
     NONLINEARSOLVER nonlinear_state_solver_;
     NONLINEARSOLVER nonlinear_adjoint_solver_;
     CONTROLNONLINEARSOLVER nonlinear_gradient_solver_;
+    IteratePool<VECTOR> iterate_pool_;
 
     bool build_state_matrix_ = false, build_adjoint_matrix_ = false, build_control_matrix_ = false;
     bool state_reinit_, adjoint_reinit_, gradient_reinit_;
@@ -492,6 +511,7 @@ namespace DOpE
                        ParameterReader &param_reader)
   {
     NONLINEARSOLVER::declare_params(param_reader);
+    IteratePool<VECTOR>::declare_params(param_reader);
   }
   /******************************************************/
 
@@ -513,7 +533,7 @@ namespace DOpE
                                                                             state_behavior, param_reader), integrator_(idc), control_integrator_(
                            idc), nonlinear_state_solver_(integrator_, param_reader), nonlinear_adjoint_solver_(
                            integrator_, param_reader), nonlinear_gradient_solver_(
-                           control_integrator_, param_reader)
+                           control_integrator_, param_reader), iterate_pool_(param_reader)
 
   {
     //ReducedProblems should be ReInited
@@ -545,7 +565,7 @@ namespace DOpE
                                                                             state_behavior, param_reader), integrator_(s_idc), control_integrator_(
                            c_idc), nonlinear_state_solver_(integrator_, param_reader), nonlinear_adjoint_solver_(
                            integrator_, param_reader), nonlinear_gradient_solver_(
-                           control_integrator_, param_reader)
+                           control_integrator_, param_reader), iterate_pool_(param_reader)
 
   {
     //ReducedProblems should be ReInited
@@ -642,6 +662,7 @@ namespace DOpE
     GetDU().ReInit();
     GetDZ().ReInit();
     GetZForEE().ReInit();
+    iterate_pool_.Clear();
 
     build_control_matrix_ = true;
     cost_needs_precomputations_ = 0;
@@ -662,6 +683,9 @@ namespace DOpE
 
     this->SetProblemType("state");
     auto &problem = this->GetProblem()->GetStateProblem();
+    //Start from the state of the closest accepted iterate, not from
+    //the state of a rejected trial control.
+    iterate_pool_.GetState(q, GetU().GetSpacialVector());
     if (state_reinit_ == true)
       {
         GetNonlinearSolver("state").ReInit(problem);
@@ -671,7 +695,7 @@ namespace DOpE
           {
             //Only apply initial state if no previous values are present (i.e., u == 0)
             //thus, we can reuse good values from previous calculations
-            if ( GetU().GetSpacialVector().linfty_norm() <= std::numeric_limits<double>::min() )
+            if ( GetU().Norm("infty") <= std::numeric_limits<double>::min() )
               {
                 this->GetOutputHandler()->Write("Computing Initial Values:",
                                                 4 + this->GetBasePriority());
@@ -685,7 +709,7 @@ namespace DOpE
                 else if (dopedim == 0)
                   {
                     this->GetIntegrator().AddParamData("control",
-                                                       &(q.GetSpacialVectorCopy()));
+                                                       &(q.GetSpacialVectorView()));
                   }
                 else
                   {
@@ -732,7 +756,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetIntegrator().AddParamData("control",
-                                           &(q.GetSpacialVectorCopy()));
+                                           &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -815,7 +839,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetControlIntegrator().AddParamData("control",
-                                                  &(q.GetSpacialVectorCopy()));
+                                                  &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -862,7 +886,7 @@ namespace DOpE
             else if (dopedim == 0)
               {
                 this->GetIntegrator().AddParamData("control",
-                                                   &(q.GetSpacialVectorCopy()));
+                                                   &(q.GetSpacialVectorView()));
               }
             else
               {
@@ -984,6 +1008,7 @@ namespace DOpE
         GetNonlinearSolver("adjoint").ReInit(problem);
         adjoint_reinit_ = false;
       }
+    iterate_pool_.GetAdjoint(q, GetZ().GetSpacialVector());
 
     this->GetProblem()->AddAuxiliaryToIntegrator(this->GetIntegrator());
     if (cost_needs_precomputations_ != 0)
@@ -1001,7 +1026,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetIntegrator().AddParamData("control",
-                                           &(q.GetSpacialVectorCopy()));
+                                           &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -1054,7 +1079,8 @@ namespace DOpE
     this->GetOutputHandler()->Write("Computing Dual for Error Estimation:",
                                     4 + this->GetBasePriority());
 
-    if (weight_comp == DOpEtypes::higher_order_interpolation)
+    if (weight_comp == DOpEtypes::higher_order_interpolation
+        || weight_comp == DOpEtypes::patch_interpolation)
       {
         this->SetProblemType("adjoint_for_ee");
       }
@@ -1084,7 +1110,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetIntegrator().AddParamData("control",
-                                           &(q.GetSpacialVectorCopy()));
+                                           &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -1154,7 +1180,7 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetIntegrator().AddParamData("control",
-                                               &(q.GetSpacialVectorCopy()));
+                                               &(q.GetSpacialVectorView()));
           }
         else
           {
@@ -1172,9 +1198,13 @@ namespace DOpE
                                             &(GetZ().GetSpacialVector()));
 
 //        this->GetIntegrator().ComputeNonlinearResidual(problem, tmp, false);
-        this->GetIntegrator().ComputeNonlinearResidual(problem, tmp);
-
-        tmp *= -1.;
+        //tmp is ghosted in the distributed case, so that it can be
+        //evaluated later on, hence assembly uses an owned copy.
+        DOpEHelper::update_owned(tmp, [this, &problem](VECTOR &v)
+        {
+          this->GetIntegrator().ComputeNonlinearResidual(problem, v);
+          v *= -1.;
+        });
 
         if (dopedim == dealdim)
           {
@@ -1219,7 +1249,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetControlIntegrator().AddParamData("control",
-                                                  &(q.GetSpacialVectorCopy()));
+                                                  &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -1245,18 +1275,24 @@ namespace DOpE
                                                    &(gradient_transposed.GetSpacialVector()));
 //        this->GetControlIntegrator().ComputeNonlinearResidual(
 //            *(this->GetProblem()), gradient.GetSpacialVector(), true);
-        this->GetControlIntegrator().ComputeNonlinearResidual(
-          *(this->GetProblem()), gradient.GetSpacialVector());
+        DOpEHelper::update_owned(gradient.GetSpacialVector(), [this](VECTOR &v)
+        {
+          this->GetControlIntegrator().ComputeNonlinearResidual(
+            *(this->GetProblem()), v);
+        });
         this->GetControlIntegrator().DeleteDomainData("last_newton_solution");
       }
     else if (dopedim == 0)
       {
         this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                  &(gradient_transposed.GetSpacialVectorCopy()));
+                                                  &(gradient_transposed.GetSpacialVectorView()));
 //        this->GetControlIntegrator().ComputeNonlinearResidual(
 //            *(this->GetProblem()), gradient.GetSpacialVector(), true);
-        this->GetControlIntegrator().ComputeNonlinearResidual(
-          *(this->GetProblem()), gradient.GetSpacialVector());
+        DOpEHelper::update_owned(gradient.GetSpacialVector(), [this](VECTOR &v)
+        {
+          this->GetControlIntegrator().ComputeNonlinearResidual(
+            *(this->GetProblem()), v);
+        });
 
         this->GetControlIntegrator().DeleteParamData("last_newton_solution");
         gradient_transposed.UnLockCopy();
@@ -1336,7 +1372,7 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetIntegrator().AddParamData("control",
-                                               &(q.GetSpacialVectorCopy()));
+                                               &(q.GetSpacialVectorView()));
           }
         else
           {
@@ -1377,7 +1413,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetIntegrator().AddParamData("control",
-                                           &(q.GetSpacialVectorCopy()));
+                                           &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -1482,7 +1518,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetIntegrator().AddParamData("control",
-                                           &(q.GetSpacialVectorCopy()));
+                                           &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -1493,11 +1529,11 @@ namespace DOpE
                                         &(GetU().GetSpacialVector()));
     AddUDD();
 
-    for (unsigned int i = 0; i < this->GetProblem()->GetNFunctionals(); i++)
+    const unsigned int n_functionals = this->GetProblem()->GetNFunctionals();
+    std::vector<unsigned int> functionals(n_functionals);
+    for (unsigned int i = 0; i < n_functionals; i++)
       {
-        double ret = 0;
-        bool found = false;
-
+        functionals[i] = i;
         this->SetProblemType("aux_functional", i);
         if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
           {
@@ -1509,48 +1545,18 @@ namespace DOpE
             auto func_vals = GetAuxiliaryParams(tmp.str());
             this->GetIntegrator().AddParamData(tmp.str(),&(func_vals->second));
           }
+      }
 
-        if (this->GetProblem()->GetFunctionalType().find("domain")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeDomainScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("point")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputePointScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("boundary")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeBoundaryScalar(
-                     *(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("face")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeFaceScalar(*(this->GetProblem()));
-          }
-        if (this->GetProblem()->GetFunctionalType().find("algebraic")
-            != std::string::npos)
-          {
-            found = true;
-            ret += this->GetIntegrator().ComputeAlgebraicScalar(*(this->GetProblem()));
-          }
+    //All functionals are evaluated in one loop over the mesh.
+    std::vector<double> values;
+    this->GetIntegrator().ComputeScalars(*(this->GetProblem()), functionals, [this](unsigned int i)
+    {
+      this->SetProblemType("aux_functional", i);
+    }, values);
 
-        if (!found)
-          {
-            throw DOpEException(
-              "Unknown Functional Type: "
-              + this->GetProblem()->GetFunctionalType(),
-              "StatReducedProblem::ComputeReducedFunctionals");
-          }
+    for (unsigned int i = 0; i < n_functionals; i++)
+      {
+        this->SetProblemType("aux_functional", i);
         if (this->GetProblem()->FunctionalNeedPrecomputations() != 0)
           {
             std::stringstream tmp;
@@ -1558,10 +1564,10 @@ namespace DOpE
             this->GetIntegrator().DeleteParamData(tmp.str());
           }
 
-        this->GetFunctionalValues()[i + 1].push_back(ret);
+        this->GetFunctionalValues()[i + 1].push_back(values[i]);
         std::stringstream out;
         this->GetOutputHandler()->InitOut(out);
-        out << this->GetProblem()->GetFunctionalName() << ": " << ret;
+        out << this->GetProblem()->GetFunctionalName() << ": " << values[i];
         this->GetOutputHandler()->Write(out, 2 + this->GetBasePriority());
       }
 
@@ -1625,7 +1631,7 @@ namespace DOpE
         else if (dopedim == 0)
           {
             this->GetIntegrator().AddParamData("control",
-                                               &(q.GetSpacialVectorCopy()));
+                                               &(q.GetSpacialVectorView()));
           }
         else
           {
@@ -1721,9 +1727,9 @@ namespace DOpE
       else if (dopedim == 0)
         {
           this->GetIntegrator().AddParamData("dq",
-                                             &(direction.GetSpacialVectorCopy()));
+                                             &(direction.GetSpacialVectorView()));
           this->GetIntegrator().AddParamData("control",
-                                             &(q.GetSpacialVectorCopy()));
+                                             &(q.GetSpacialVectorView()));
         }
       else
         {
@@ -1813,8 +1819,11 @@ namespace DOpE
                                               &(GetZ().GetSpacialVector()));
 
 //    this->GetIntegrator().ComputeNonlinearResidual(problem, tmp_second, false);
-          this->GetIntegrator().ComputeNonlinearResidual(problem, tmp_second);
-          tmp_second *= -1.;
+          DOpEHelper::update_owned(tmp_second, [this, &problem](VECTOR &v)
+          {
+            this->GetIntegrator().ComputeNonlinearResidual(problem, v);
+            v *= -1.;
+          });
 
           this->GetIntegrator().DeleteDomainData("last_newton_solution");
         }//End Adjoint
@@ -1827,8 +1836,11 @@ namespace DOpE
                                               &(GetDZ().GetSpacialVector()));
 
 //    this->GetIntegrator().ComputeNonlinearResidual(problem, tmp, false);
-          this->GetIntegrator().ComputeNonlinearResidual(problem, tmp);
-          tmp *= -1.;
+          DOpEHelper::update_owned(tmp, [this, &problem](VECTOR &v)
+          {
+            this->GetIntegrator().ComputeNonlinearResidual(problem, v);
+            v *= -1.;
+          });
 
           this->GetIntegrator().DeleteDomainData("last_newton_solution");
         }
@@ -1855,9 +1867,9 @@ namespace DOpE
         direction.UnLockCopy();
         q.UnLockCopy();
         this->GetControlIntegrator().AddParamData("dq",
-                                                  &(direction.GetSpacialVectorCopy()));
+                                                  &(direction.GetSpacialVectorView()));
         this->GetControlIntegrator().AddParamData("control",
-                                                  &(q.GetSpacialVectorCopy()));
+                                                  &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -1880,19 +1892,25 @@ namespace DOpE
 //          this->GetControlIntegrator().ComputeNonlinearResidual(
 //              *(this->GetProblem()), hessian_direction.GetSpacialVector(),
 //              true);
-          this->GetControlIntegrator().ComputeNonlinearResidual(
-            *(this->GetProblem()), hessian_direction.GetSpacialVector());
+          DOpEHelper::update_owned(hessian_direction.GetSpacialVector(), [this](VECTOR &v)
+          {
+            this->GetControlIntegrator().ComputeNonlinearResidual(
+              *(this->GetProblem()), v);
+          });
           this->GetControlIntegrator().DeleteDomainData("last_newton_solution");
         }
       else if (dopedim == 0)
         {
           this->GetControlIntegrator().AddParamData("last_newton_solution",
-                                                    &(hessian_direction_transposed.GetSpacialVectorCopy()));
+                                                    &(hessian_direction_transposed.GetSpacialVectorView()));
 //         this->GetControlIntegrator().ComputeNonlinearResidual(
 //             *(this->GetProblem()), hessian_direction.GetSpacialVector(),
 //              true);
-          this->GetControlIntegrator().ComputeNonlinearResidual(
-            *(this->GetProblem()), hessian_direction.GetSpacialVector());
+          DOpEHelper::update_owned(hessian_direction.GetSpacialVector(), [this](VECTOR &v)
+          {
+            this->GetControlIntegrator().ComputeNonlinearResidual(
+              *(this->GetProblem()), v);
+          });
           this->GetControlIntegrator().DeleteParamData("last_newton_solution");
           hessian_direction_transposed.UnLockCopy();
         }
@@ -1985,7 +2003,7 @@ namespace DOpE
     else if (dopedim == 0)
       {
         this->GetControlIntegrator().AddParamData("control",
-                                                  &(q.GetSpacialVectorCopy()));
+                                                  &(q.GetSpacialVectorView()));
       }
     else
       {
@@ -2001,7 +2019,10 @@ namespace DOpE
 
     //Compute
 //      this->GetControlIntegrator().ComputeNonlinearRhs(*(this->GetProblem()), gradient.GetSpacialVector(), true);
-    this->GetControlIntegrator().ComputeNonlinearRhs(*(this->GetProblem()), gradient.GetSpacialVector());
+    DOpEHelper::update_owned(gradient.GetSpacialVector(), [this](VECTOR &v)
+    {
+      this->GetControlIntegrator().ComputeNonlinearRhs(*(this->GetProblem()), v);
+    });
     gradient_transposed = gradient;
 
     this->GetControlIntegrator().DeleteDomainData("constraints_local");
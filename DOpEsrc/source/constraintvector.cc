@@ -24,6 +24,7 @@
 
 #include <include/constraintvector.h>
 #include <include/dopeexception.h>
+#include <include/helper.h>
 
 #include <iostream>
 #include <assert.h>
@@ -304,7 +305,11 @@ namespace DOpE
           {
             assert(local_control_constraint_[i] != NULL);
             assert(dq.local_control_constraint_[i] != NULL);
-            local_control_constraint_[i]->operator+=(*(dq.local_control_constraint_[i]));
+            DOpEHelper::update_owned(*(local_control_constraint_[i]),*(dq.local_control_constraint_[i]),
+                                     [](VECTOR &v, const VECTOR &w)
+            {
+              v += w;
+            });
           }
         if (global_constraint_.size() > 0)
           global_constraint_ += dq.global_constraint_;
@@ -324,7 +329,10 @@ namespace DOpE
         for (unsigned int i = 0; i < local_control_constraint_.size(); i++)
           {
             assert(local_control_constraint_[i] != NULL);
-            local_control_constraint_[i]->operator*=(a);
+            DOpEHelper::update_owned(*(local_control_constraint_[i]),[a](VECTOR &v)
+            {
+              v *= a;
+            });
           }
         if (global_constraint_.size() > 0)
           global_constraint_ *= a;
@@ -348,7 +356,7 @@ namespace DOpE
           {
             assert(local_control_constraint_[i] != NULL);
             assert(dq.local_control_constraint_[i] != NULL);
-            ret += local_control_constraint_[i]->operator*(*(dq.local_control_constraint_[i]));
+            ret += DOpEHelper::dot(*(local_control_constraint_[i]),*(dq.local_control_constraint_[i]));
           }
         if (global_constraint_.size() > 0)
           ret += global_constraint_ * dq.global_constraint_;
@@ -372,7 +380,11 @@ namespace DOpE
           {
             assert(local_control_constraint_[i] != NULL);
             assert(dq.local_control_constraint_[i] != NULL);
-            local_control_constraint_[i]->add(s,*(dq.local_control_constraint_[i]));
+            DOpEHelper::update_owned(*(local_control_constraint_[i]),*(dq.local_control_constraint_[i]),
+                                     [s](VECTOR &v, const VECTOR &w)
+            {
+              v.add(s,w);
+            });
           }
         if (global_constraint_.size() > 0)
           global_constraint_.add(s,dq.global_constraint_);
@@ -395,7 +407,11 @@ namespace DOpE
           {
             assert(local_control_constraint_[i] != NULL);
             assert(dq.local_control_constraint_[i] != NULL);
-            local_control_constraint_[i]->equ(s,*(dq.local_control_constraint_[i]));
+            DOpEHelper::update_owned(*(local_control_constraint_[i]),*(dq.local_control_constraint_[i]),
+                                     [s](VECTOR &v, const VECTOR &w)
+            {
+              v.equ(s,w);
+            });
           }
         if (global_constraint_.size() > 0)
           global_constraint_.equ(s,dq.global_constraint_);
@@ -458,10 +474,12 @@ namespace DOpE
             for (unsigned int i = 0; i < local_control_constraint_.size(); i++)
               {
                 const VECTOR &tmp = *(local_control_constraint_[i]);
-                for ( unsigned int j = 0; j < tmp.size(); j++)
+                double local = 0.;
+                for (const auto j : tmp.locally_owned_elements())
                   {
-                    ret = std::max(ret,std::fabs(tmp(j)));
+                    local = std::max(local,std::fabs(tmp(j)));
                   }
+                ret = std::max(ret,DOpEHelper::max_over_processes(local,tmp));
               }
             for (unsigned int i = 0; i< global_constraint_.size(); i++)
               {
@@ -473,10 +491,12 @@ namespace DOpE
             for (unsigned int i = 0; i < local_control_constraint_.size(); i++)
               {
                 const VECTOR &tmp = *(local_control_constraint_[i]);
-                for ( unsigned int j = 0; j < tmp.size(); j++)
+                double local = 0.;
+                for (const auto j : tmp.locally_owned_elements())
                   {
-                    ret = std::max(ret,std::max(0.,tmp(j)));
+                    local = std::max(local,std::max(0.,tmp(j)));
                   }
+                ret = std::max(ret,DOpEHelper::max_over_processes(local,tmp));
               }
             for (unsigned int i = 0; i< global_constraint_.size(); i++)
               {
@@ -495,10 +515,12 @@ namespace DOpE
             for (unsigned int i = 0; i < local_control_constraint_.size(); i++)
               {
                 const VECTOR &tmp = *(local_control_constraint_[i]);
-                for ( unsigned int j = 0; j < tmp.size(); j++)
+                double local = 0.;
+                for (const auto j : tmp.locally_owned_elements())
                   {
-                    ret += std::fabs(tmp(j));
+                    local += std::fabs(tmp(j));
                   }
+                ret += DOpEHelper::sum_over_processes(local,tmp);
               }
             for (unsigned int i = 0; i< global_constraint_.size(); i++)
               {
@@ -510,10 +532,12 @@ namespace DOpE
             for (unsigned int i = 0; i < local_control_constraint_.size(); i++)
               {
                 const VECTOR &tmp = *(local_control_constraint_[i]);
-                for ( unsigned int j = 0; j < tmp.size(); j++)
+                double local = 0.;
+                for (const auto j : tmp.locally_owned_elements())
                   {
-                    ret += std::max(0.,tmp(j));
+                    local += std::max(0.,tmp(j));
                   }
+                ret += DOpEHelper::sum_over_processes(local,tmp);
               }
             for (unsigned int i = 0; i< global_constraint_.size(); i++)
               {
@@ -0,0 +1,44 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <basic/mol_statespacetimehandler.h>
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, false,
+                 dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, false,
+                 dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, true,
+                 dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, true,
+                 dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+#else
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, dealii::DoFHandler,
+                 dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::FESystem, dealii::DoFHandler,
+                 dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, dealii::hp::DoFHandler,
+                 dealii::BlockSparsityPattern, dealii::BlockVector<double>, deal_II_dimension>;
+template class DOpE::MethodOfLines_StateSpaceTimeHandler<dealii::hp::FECollection, dealii::hp::DoFHandler,
+                 dealii::SparsityPattern, dealii::Vector<double>, deal_II_dimension>;
+#endif
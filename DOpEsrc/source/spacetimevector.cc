@@ -26,6 +26,8 @@
 #include <include/dopeexception.h>
 #include <include/helper.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <iostream>
 #include <assert.h>
 #include <iomanip>
@@ -120,7 +122,7 @@ namespace DOpE
       {
         //make the directory
         std::string command = "mkdir -p " + tmp_dir_;
-        if (system(command.c_str()) != 0)
+        if (ExecuteCommand(command) != 0)
           {
             throw DOpEException("The command " + command + "failed!",
                                 "SpaceTimeVector<VECTOR>::SpaceTimeVector");
@@ -129,11 +131,8 @@ namespace DOpE
         if (num_active_ == 0)
           {
             filename_ = tmp_dir_ + "SpaceTimeVector_lock";
-            assert(!filestream_.is_open());
-            filestream_.open(filename_.c_str(), std::fstream::in);
-            if (!filestream_.fail())
+            if (ExecuteCommand("test ! -e " + filename_) != 0)
               {
-                filestream_.close();
                 throw DOpEException(
                   "The directory " + tmp_dir_
                   + " is probably already in use.",
@@ -142,7 +141,7 @@ namespace DOpE
             else
               {
                 command = "touch " + tmp_dir_ + "SpaceTimeVector_lock";
-                if (system(command.c_str()) != 0)
+                if (ExecuteCommand(command) != 0)
                   {
                     throw DOpEException("The command " + command + "failed!",
                                         "SpaceTimeVector<VECTOR>::SpaceTimeVector");
@@ -166,6 +165,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::ReInit()
   {
+    view_time_point_ = -1;
     if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
       {
         //In the only_recent storage case, reinit must be
@@ -206,6 +206,12 @@ namespace DOpE
               }
             else
               {
+                //The temporal mesh may have been coarsened
+                for (unsigned int t = GetSpaceTimeHandler()->GetMaxTimePoint() + 1;
+                     t < stvector_.size(); t++)
+                  {
+                    delete stvector_[t];
+                  }
                 stvector_.resize(GetSpaceTimeHandler()->GetMaxTimePoint() + 1, NULL);
                 for (unsigned int t = 0; t
                      <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
@@ -227,7 +233,7 @@ namespace DOpE
                 //delete all old DOpE-Files in the directory
                 std::string command = "rm -f " + tmp_dir_ + "*."
                                       + Utilities::int_to_string(unique_id_) + ".dope";
-                if (system(command.c_str()) != 0)
+                if (ExecuteCommand(command) != 0)
                   {
                     throw DOpEException("The command " + command + "failed!",
                                         "SpaceTimeVector<VECTOR>::ReInit");
@@ -279,7 +285,7 @@ namespace DOpE
                 std::string command = "rm -f " + tmp_dir_ + "*."
                                       + Utilities::int_to_string(unique_id_) + ".dope; rm -f "
                                       + tmp_dir_ + "SpaceTimeVector_lock";
-                if (system(command.c_str()) != 0)
+                if (ExecuteCommand(command) != 0)
                   {
                     std::cout<<"The command "<< command << "failed! in SpaceTimeVector<VECTOR>::~SpaceTimeVector"<<std::endl;
                     abort();
@@ -289,7 +295,7 @@ namespace DOpE
               {
                 std::string command = "rm -f " + tmp_dir_ + "*."
                                       + Utilities::int_to_string(unique_id_) + ".dope";
-                if (system(command.c_str()) != 0)
+                if (ExecuteCommand(command) != 0)
                   {
                     std::cout<<"The command "<< command << "failed! in SpaceTimeVector<VECTOR>::~SpaceTimeVector"<<std::endl;
                     abort();
@@ -422,6 +428,7 @@ namespace DOpE
   VECTOR &
   SpaceTimeVector<VECTOR>::GetSpacialVector()
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -638,6 +645,7 @@ namespace DOpE
   VECTOR &
   SpaceTimeVector<VECTOR>::GetNextSpacialVector()
   {
+    view_time_point_ = -1;
     if (GetAction() == DOpEtypes::VectorAction::stationary || GetAction() == DOpEtypes::VectorAction::initial)
       {
         throw DOpEException("Can not call GetNextSpacialVector in VectorAction case " +
@@ -720,6 +728,7 @@ namespace DOpE
   VECTOR &
   SpaceTimeVector<VECTOR>::GetPreviousSpacialVector()
   {
+    view_time_point_ = -1;
     if (GetAction() == DOpEtypes::VectorAction::stationary || GetAction() == DOpEtypes::VectorAction::initial)
       {
         throw DOpEException("Can not call GetPreviousSpacialVector in VectorAction case " +
@@ -809,11 +818,67 @@ namespace DOpE
           "SpaceTimeVector::GetSpacialVectorCopy");
       }
     lock_ = true;
+    copy_stvector_ = GetCurrentSpacialVector();
+    return copy_stvector_;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  const Vector<double> &
+  SpaceTimeVector<VECTOR>::GetSpacialVectorView() const
+  {
+    if (lock_)
+      {
+        throw DOpEException(
+          "Trying to create a new view while the old is still in use!",
+          "SpaceTimeVector::GetSpacialVectorView");
+      }
+    lock_ = true;
+    return GetView(GetCurrentSpacialVector());
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  const Vector<double> &
+  SpaceTimeVector<VECTOR>::GetView(const Vector<double> &current) const
+  {
+    return current;
+  }
 
+  /******************************************************/
+  template<typename VECTOR>
+  template<typename OTHERVECTOR>
+  const Vector<double> &
+  SpaceTimeVector<VECTOR>::GetView(const OTHERVECTOR &current) const
+  {
+    //The snapshot can only be kept if the time point identifies the stored
+    //vector, i.e., SetTimeDoFNumber does not reuse the memory.
+    if (GetAction() == DOpEtypes::VectorAction::stationary
+        || GetAction() == DOpEtypes::VectorAction::initial
+        || (GetBehavior() == DOpEtypes::VectorStorageType::fullmem && accessor_ >= 0))
+      {
+        if (view_time_point_ != accessor_)
+          {
+            view_stvector_ = current;
+            view_time_point_ = accessor_;
+          }
+      }
+    else
+      {
+        view_stvector_ = current;
+        view_time_point_ = -1;
+      }
+    return view_stvector_;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  const VECTOR &
+  SpaceTimeVector<VECTOR>::GetCurrentSpacialVector() const
+  {
     if (GetAction() == DOpEtypes::VectorAction::stationary || GetAction() == DOpEtypes::VectorAction::initial)
       {
-        copy_stvector_ = *(stvector_[accessor_]);
-        return copy_stvector_;
+        return *(stvector_[accessor_]);
       }
     else
       {
@@ -824,10 +889,10 @@ namespace DOpE
             if (accessor_ >= 0)
               {
                 assert(stvector_[accessor_] != NULL);
-                copy_stvector_ = *(stvector_[accessor_]);
+                return *(stvector_[accessor_]);
               }
             else
-              copy_stvector_ = local_stvector_;
+              return local_stvector_;
           }
         else
           {
@@ -836,18 +901,17 @@ namespace DOpE
                 if (accessor_ >= 0)
                   {
                     assert(global_to_local_.find(accessor_) !=global_to_local_.end());
-                    copy_stvector_ = *(local_vectors_[global_to_local_[accessor_]]);
+                    return *(local_vectors_[global_to_local_[accessor_]]);
                   }
                 else
-                  copy_stvector_ = local_stvector_;
+                  return local_stvector_;
               }
             else
               {
                 throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),
-                                    "SpaceTimeVector<VECTOR>::GetSpacialVectorCopy");
+                                    "SpaceTimeVector<VECTOR>::GetCurrentSpacialVector");
               }
           }
-        return copy_stvector_;
       }
   }
 
@@ -856,6 +920,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::operator=(double value)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -866,11 +931,11 @@ namespace DOpE
       {
         if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
           {
-            for (unsigned int i = 0; i < stvector_.size(); i++)
-              {
-                assert(stvector_[i] != NULL);
-                stvector_[i]->operator=(value);
-              }
+            ForAllTimePoints([this,value](unsigned int i)
+            {
+              assert(stvector_[i] != NULL);
+              stvector_[i]->operator=(value);
+            });
             SetTimeDoFNumber(0);
           }
         else if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -892,13 +957,11 @@ namespace DOpE
           {
             if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
               {
-                for (unsigned int t = 0; t
-                     <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
-                  {
-                    SetTimeDoFNumber(t);
-                    local_vectors_[0]->operator=(value);
-                  }
-                SetTimeDoFNumber(0);
+                //The old values are overwritten, so there is no need to read them.
+                UpdateTimePoints(NULL, false, [value](VECTOR &v, const VECTOR &)
+                {
+                  v = value;
+                });
               }
             else
               {
@@ -914,6 +977,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::operator=(const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -952,12 +1016,12 @@ namespace DOpE
                       }
                   }
 
-                for (unsigned int i = 0; i < stvector_.size(); i++)
-                  {
-                    assert(stvector_[i] != NULL);
-                    assert(dq.stvector_[i] != NULL);
-                    stvector_[i]->operator=(*(dq.stvector_[i]));
-                  }
+                ForAllTimePoints([this,&dq](unsigned int i)
+                {
+                  assert(stvector_[i] != NULL);
+                  assert(dq.stvector_[i] != NULL);
+                  stvector_[i]->operator=(*(dq.stvector_[i]));
+                });
                 SetTimeDoFNumber(0);
               }//endif fullmem
             else if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -974,7 +1038,7 @@ namespace DOpE
                     std::string command = "mkdir -p " + tmp_dir_ + "; rm -f "
                                           + tmp_dir_ + "*." + Utilities::int_to_string(
                                             unique_id_) + ".dope";
-                    if (system(command.c_str()) != 0)
+                    if (ExecuteCommand(command) != 0)
                       {
                         throw DOpEException(
                           "The command " + command + "failed!",
@@ -990,7 +1054,7 @@ namespace DOpE
                         MakeName(t);
                         assert(dq.FileExists(t));
                         command = "cp " + dq.filename_ + " " + filename_;
-                        if (system(command.c_str()) != 0)
+                        if (ExecuteCommand(command) != 0)
                           {
                             throw DOpEException(
                               "The command " + command + "failed!",
@@ -1026,6 +1090,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::operator+=(const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1039,12 +1104,15 @@ namespace DOpE
             if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
               {
                 assert(dq.stvector_.size() == stvector_.size());
-                for (unsigned int i = 0; i < stvector_.size(); i++)
+                ForAllTimePoints([this,&dq](unsigned int i)
+                {
+                  assert(stvector_[i] != NULL);
+                  assert(dq.stvector_[i] != NULL);
+                  DOpEHelper::update_owned(*(stvector_[i]),*(dq.stvector_[i]),[](VECTOR &v, const VECTOR &w)
                   {
-                    assert(stvector_[i] != NULL);
-                    assert(dq.stvector_[i] != NULL);
-                    stvector_[i]->operator+=(*(dq.stvector_[i]));
-                  }
+                    v += w;
+                  });
+                });
                 SetTimeDoFNumber(0);
               }//endif fullmem
             else if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -1058,17 +1126,13 @@ namespace DOpE
                 if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
                   {
                     assert(dq.GetSpaceTimeHandler()->GetMaxTimePoint() == GetSpaceTimeHandler()->GetMaxTimePoint() );
-                    dq.StoreOnDisc();
-                    for (unsigned int t = 0; t
-                         <= dq.GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
+                    UpdateTimePoints(&dq, true, [](VECTOR &v, const VECTOR &w)
+                    {
+                      DOpEHelper::update_owned(v,w,[](VECTOR &t, const VECTOR &tn)
                       {
-                        SetTimeDoFNumber(t);//this makes sure that everything is stored an local_vectors_ has length 1.
-                        GetSpaceTimeHandler ()->ReinitVector (local_stvector_,
-                                                              vector_type_,t);
-                        dq.FetchFromDisc(t, local_stvector_);
-                        local_vectors_[0]->operator+=(local_stvector_);
-                      }
-                    SetTimeDoFNumber(0);
+                        t += tn;
+                      });
+                    });
                   }
                 else
                   throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),
@@ -1091,6 +1155,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::operator*=(double value)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1101,11 +1166,14 @@ namespace DOpE
       {
         if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
           {
-            for (unsigned int i = 0; i < stvector_.size(); i++)
+            ForAllTimePoints([this,value](unsigned int i)
+            {
+              assert(stvector_[i] != NULL);
+              DOpEHelper::update_owned(*(stvector_[i]),[value](VECTOR &v)
               {
-                assert(stvector_[i] != NULL);
-                stvector_[i]->operator*=(value);
-              }
+                v *= value;
+              });
+            });
             SetTimeDoFNumber(0);
           }//endif fullmem
         else if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -1118,13 +1186,13 @@ namespace DOpE
           {
             if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
               {
-                for (unsigned int t = 0; t
-                     <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
+                UpdateTimePoints(NULL, true, [value](VECTOR &v, const VECTOR &)
+                {
+                  DOpEHelper::update_owned(v,[value](VECTOR &t)
                   {
-                    SetTimeDoFNumber(t);//this makes sure that everything is stored an local_vectors_ has length 1.
-                    local_vectors_[0]->operator*=(value);
-                  }
-                SetTimeDoFNumber(0);
+                    t *= value;
+                  });
+                });
               }
             else
               {
@@ -1146,13 +1214,17 @@ namespace DOpE
           {
             assert(dq.stvector_.size() == stvector_.size());
 
+            //The products of the time points are summed up in a fixed order.
+            std::vector<double> partial(stvector_.size(), 0.);
+            ForAllTimePoints([this,&dq,&partial](unsigned int i)
+            {
+              assert(stvector_[i] != NULL);
+              assert(dq.stvector_[i] != NULL);
+              partial[i] = DOpEHelper::dot(*(stvector_[i]),*(dq.stvector_[i]));
+            });
             double ret = 0.;
-            for (unsigned int i = 0; i < stvector_.size(); i++)
-              {
-                assert(stvector_[i] != NULL);
-                assert(dq.stvector_[i] != NULL);
-                ret += stvector_[i]->operator*(*(dq.stvector_[i]));
-              }
+            for (unsigned int i = 0; i < partial.size(); i++)
+              ret += partial[i];
             return ret;
           }//endif fullmem
         if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -1174,20 +1246,10 @@ namespace DOpE
                 assert(dq.GetSpaceTimeHandler()->GetMaxTimePoint() == GetSpaceTimeHandler()->GetMaxTimePoint() );
 
                 double ret = 0;
-
-                StoreOnDisc();
-                dq.StoreOnDisc();
-                for (unsigned int t = 0; t
-                     <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
-                  {
-                    GetSpaceTimeHandler ()->ReinitVector (local_stvector_,
-                                                          vector_type_,t);
-                    FetchFromDisc(t, local_stvector_);
-                    dq.GetSpaceTimeHandler ()->ReinitVector (dq.local_stvector_,
-                                                             vector_type_,t);
-                    dq.FetchFromDisc(t, dq.local_stvector_);
-                    ret += local_stvector_.operator*(dq.local_stvector_);
-                  }
+                ReadTimePoints(dq, [&ret](const VECTOR &v, const VECTOR &w)
+                {
+                  ret += DOpEHelper::dot(v,w);
+                });
                 return ret;
               }
           }
@@ -1212,6 +1274,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::add(double s, const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1226,12 +1289,15 @@ namespace DOpE
               {
                 assert(dq.stvector_.size() == stvector_.size());
 
-                for (unsigned int i = 0; i < stvector_.size(); i++)
+                ForAllTimePoints([this,s,&dq](unsigned int i)
+                {
+                  assert(stvector_[i] != NULL);
+                  assert(dq.stvector_[i] != NULL);
+                  DOpEHelper::update_owned(*(stvector_[i]),*(dq.stvector_[i]),[s](VECTOR &v, const VECTOR &w)
                   {
-                    assert(stvector_[i] != NULL);
-                    assert(dq.stvector_[i] != NULL);
-                    stvector_[i]->add(s, *(dq.stvector_[i]));
-                  }
+                    v.add(s, w);
+                  });
+                });
                 SetTimeDoFNumber(0);
               }//endif fullmem
             else if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -1245,18 +1311,13 @@ namespace DOpE
                 if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
                   {
                     assert(dq.GetSpaceTimeHandler()->GetMaxTimePoint() == GetSpaceTimeHandler()->GetMaxTimePoint() );
-
-                    dq.StoreOnDisc();
-                    for (unsigned int t = 0; t
-                         <= dq.GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
+                    UpdateTimePoints(&dq, true, [s](VECTOR &v, const VECTOR &w)
+                    {
+                      DOpEHelper::update_owned(v,w,[s](VECTOR &t, const VECTOR &tn)
                       {
-                        SetTimeDoFNumber(t);//this makes sure that everything is stored an local_vectors_ has length 1.
-                        GetSpaceTimeHandler ()->ReinitVector (local_stvector_,
-                                                              vector_type_,t);
-                        dq.FetchFromDisc(t, local_stvector_);
-                        local_vectors_[0]->add(s, local_stvector_);
-                      }
-                    SetTimeDoFNumber(0);
+                        t.add(s, tn);
+                      });
+                    });
                   }
                 else
                   throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),
@@ -1279,6 +1340,7 @@ namespace DOpE
   void
   SpaceTimeVector<VECTOR>::equ(double s, const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1292,12 +1354,15 @@ namespace DOpE
             if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
               {
                 assert(dq.stvector_.size() == stvector_.size());
-                for (unsigned int i = 0; i < stvector_.size(); i++)
+                ForAllTimePoints([this,s,&dq](unsigned int i)
+                {
+                  assert(stvector_[i] != NULL);
+                  assert(dq.stvector_[i] != NULL);
+                  DOpEHelper::update_owned(*(stvector_[i]),*(dq.stvector_[i]),[s](VECTOR &v, const VECTOR &w)
                   {
-                    assert(stvector_[i] != NULL);
-                    assert(dq.stvector_[i] != NULL);
-                    stvector_[i]->equ(s, *(dq.stvector_[i]));
-                  }
+                    v.equ(s, w);
+                  });
+                });
                 SetTimeDoFNumber(0);
               }//endif fullmem
             else if (GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
@@ -1310,18 +1375,14 @@ namespace DOpE
               {
                 if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
                   {
-                    dq.StoreOnDisc();
-                    for (unsigned int t = 0; t
-                         <= dq.GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
+                    //The own values are overwritten, unless dq is this vector.
+                    UpdateTimePoints(&dq, &dq == this, [s](VECTOR &v, const VECTOR &w)
+                    {
+                      DOpEHelper::update_owned(v,w,[s](VECTOR &t, const VECTOR &tn)
                       {
-                        SetTimeDoFNumber(t);//this makes sure that everything is stored an local_vectors_ has length 1.
-                        GetSpaceTimeHandler ()->ReinitVector (local_stvector_,
-                                                              vector_type_,t);
-                        dq.FetchFromDisc(t, local_stvector_);
-                        local_vectors_[0]->equ(s, local_stvector_);
-
-                      }
-                    SetTimeDoFNumber(0);
+                        t.equ(s, tn);
+                      });
+                    });
                   }
                 else
                   throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),
@@ -1343,6 +1404,7 @@ namespace DOpE
   template<typename VECTOR>
   void SpaceTimeVector<VECTOR>::max(const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1357,27 +1419,36 @@ namespace DOpE
           + DOpEtypesToString(dq.GetBehavior()),
           "SpaceTimeVector<VECTOR>::max");
       }
+    auto local_max = [](VECTOR &v, const VECTOR &w)
+    {
+      assert(v.size() == w.size());
+      DOpEHelper::update_owned(v,w,[](VECTOR &t, const VECTOR &tn)
+      {
+        for (const auto j : t.locally_owned_elements())
+          {
+            // For Trilinos vectors, we have to explicitly cast them to doubles
+            typename VECTOR::value_type a = t (j);
+            typename VECTOR::value_type b = tn (j);
+            t (j) = std::max (a, b);
+          }
+      });
+    };
     if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
       {
         assert(dq.stvector_.size() == stvector_.size());
 
-        for (unsigned int i = 0; i < stvector_.size(); i++)
-          {
-            assert(stvector_[i] != NULL);
-            assert(dq.stvector_[i] != NULL);
-            VECTOR &t = *(stvector_[i]);
-            const VECTOR &tn = *(dq.stvector_[i]);
-            assert(t.size() == tn.size());
-            for (unsigned int j = 0; j < t.size() ; j++)
-              {
-                // For Trilinos vectors, we have to explicitly cast them to doubles
-                typename VECTOR::value_type a = t (j);
-                typename VECTOR::value_type b = tn (j);
-                t (j) = std::max (a, b);
-              }
-          }
+        ForAllTimePoints([this,&dq,&local_max](unsigned int i)
+        {
+          assert(stvector_[i] != NULL);
+          assert(dq.stvector_[i] != NULL);
+          local_max(*(stvector_[i]),*(dq.stvector_[i]));
+        });
         SetTimeDoFNumber(0);
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+      {
+        UpdateTimePoints(&dq, true, local_max);
+      }
     else
       {
         throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),"SpaceTimeVector<VECTOR>::max");
@@ -1389,6 +1460,7 @@ namespace DOpE
   template<typename VECTOR>
   void SpaceTimeVector<VECTOR>::min(const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1403,27 +1475,36 @@ namespace DOpE
           + DOpEtypesToString(dq.GetBehavior()),
           "SpaceTimeVector<VECTOR>::min");
       }
+    auto local_min = [](VECTOR &v, const VECTOR &w)
+    {
+      assert(v.size() == w.size());
+      DOpEHelper::update_owned(v,w,[](VECTOR &t, const VECTOR &tn)
+      {
+        for (const auto j : t.locally_owned_elements())
+          {
+            // For Trilinos vectors, we have to explicitly cast them to doubles
+            typename VECTOR::value_type a = t (j);
+            typename VECTOR::value_type b = tn (j);
+            t (j) = std::min (a, b);
+          }
+      });
+    };
     if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
       {
         assert(dq.stvector_.size() == stvector_.size());
 
-        for (unsigned int i = 0; i < stvector_.size(); i++)
-          {
-            assert(stvector_[i] != NULL);
-            assert(dq.stvector_[i] != NULL);
-            VECTOR &t = *(stvector_[i]);
-            const VECTOR &tn = *(dq.stvector_[i]);
-            assert(t.size() == tn.size());
-            for (unsigned int j = 0; j < t.size() ; j++)
-              {
-                // For Trilinos vectors, we have to explicitly cast them to doubles
-                typename VECTOR::value_type a = t (j);
-                typename VECTOR::value_type b = tn (j);
-                t (j) = std::min (a, b);
-              }
-          }
+        ForAllTimePoints([this,&dq,&local_min](unsigned int i)
+        {
+          assert(stvector_[i] != NULL);
+          assert(dq.stvector_[i] != NULL);
+          local_min(*(stvector_[i]),*(dq.stvector_[i]));
+        });
         SetTimeDoFNumber(0);
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+      {
+        UpdateTimePoints(&dq, true, local_min);
+      }
     else
       {
         throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),"SpaceTimeVector<VECTOR>::min");
@@ -1433,6 +1514,7 @@ namespace DOpE
   template<typename VECTOR>
   void SpaceTimeVector<VECTOR>::comp_mult(const SpaceTimeVector &dq)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
@@ -1447,24 +1529,31 @@ namespace DOpE
           + DOpEtypesToString(dq.GetBehavior()),
           "SpaceTimeVector<VECTOR>::comp_mult");
       }
+    //scale is the componentwise product, and is threaded by deal.II
+    auto local_mult = [](VECTOR &v, const VECTOR &w)
+    {
+      assert(v.size() == w.size());
+      DOpEHelper::update_owned(v,w,[](VECTOR &t, const VECTOR &tn)
+      {
+        t.scale(tn);
+      });
+    };
     if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
       {
         assert(dq.stvector_.size() == stvector_.size());
 
-        for (unsigned int i = 0; i < stvector_.size(); i++)
-          {
-            assert(stvector_[i] != NULL);
-            assert(dq.stvector_[i] != NULL);
-            VECTOR &t = *(stvector_[i]);
-            const VECTOR &tn = *(dq.stvector_[i]);
-            assert(t.size() == tn.size());
-            for (unsigned int j = 0; j < t.size() ; j++)
-              {
-                t(j) = t(j)*tn(j);
-              }
-          }
+        ForAllTimePoints([this,&dq,&local_mult](unsigned int i)
+        {
+          assert(stvector_[i] != NULL);
+          assert(dq.stvector_[i] != NULL);
+          local_mult(*(stvector_[i]),*(dq.stvector_[i]));
+        });
         SetTimeDoFNumber(0);
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+      {
+        UpdateTimePoints(&dq, true, local_mult);
+      }
     else
       {
         throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),"SpaceTimeVector<VECTOR>::comp_mult");
@@ -1475,25 +1564,36 @@ namespace DOpE
   template<typename VECTOR>
   void SpaceTimeVector<VECTOR>::comp_invert()
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
           "Trying to use add while a copy is in use!",
           "SpaceTimeVector::comp_invert");
       }
-    if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
+    auto local_invert = [](VECTOR &v, const VECTOR &)
+    {
+      DOpEHelper::update_owned(v,[](VECTOR &t)
       {
-        for (unsigned int i = 0; i < stvector_.size(); i++)
+        for (const auto j : t.locally_owned_elements())
           {
-            assert(stvector_[i] != NULL);
-            VECTOR &t = *(stvector_[i]);
-            for (unsigned int j = 0; j < t.size() ; j++)
-              {
-                t(j) = 1./t(j);
-              }
+            t(j) = 1./t(j);
           }
+      });
+    };
+    if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
+      {
+        ForAllTimePoints([this,&local_invert](unsigned int i)
+        {
+          assert(stvector_[i] != NULL);
+          local_invert(*(stvector_[i]),*(stvector_[i]));
+        });
         SetTimeDoFNumber(0);
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+      {
+        UpdateTimePoints(NULL, true, local_invert);
+      }
     else
       {
         throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),"SpaceTimeVector<VECTOR>::comp_invert");
@@ -1504,36 +1604,47 @@ namespace DOpE
   template<typename VECTOR>
   void SpaceTimeVector<VECTOR>::init_by_sign(double smaller, double larger, double unclear, double TOL)
   {
+    view_time_point_ = -1;
     if (lock_)
       {
         throw DOpEException(
           "Trying to use add while a copy is in use!",
           "SpaceTimeVector::init_by_sign");
       }
-    if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
+    auto local_init = [smaller,larger,unclear,TOL](VECTOR &v, const VECTOR &)
+    {
+      DOpEHelper::update_owned(v,[smaller,larger,unclear,TOL](VECTOR &t)
       {
-        for (unsigned int i = 0; i < stvector_.size(); i++)
+        for (const auto j : t.locally_owned_elements())
           {
-            assert(stvector_[i] != NULL);
-            VECTOR &t = *(stvector_[i]);
-            for (unsigned int j = 0; j < t.size() ; j++)
+            if (t(j) < -TOL)
               {
-                if (t(j) < -TOL)
-                  {
-                    t(j) = smaller;
-                  }
-                else if (t(j) > TOL)
-                  {
-                    t(j) = larger;
-                  }
-                else
-                  {
-                    t(j) = unclear;
-                  }
+                t(j) = smaller;
+              }
+            else if (t(j) > TOL)
+              {
+                t(j) = larger;
+              }
+            else
+              {
+                t(j) = unclear;
               }
           }
+      });
+    };
+    if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
+      {
+        ForAllTimePoints([this,&local_init](unsigned int i)
+        {
+          assert(stvector_[i] != NULL);
+          local_init(*(stvector_[i]),*(stvector_[i]));
+        });
         SetTimeDoFNumber(0);
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+      {
+        UpdateTimePoints(NULL, true, local_init);
+      }
     else
       {
         throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),"SpaceTimeVector<VECTOR>::init_by_sign");
@@ -1549,77 +1660,69 @@ namespace DOpE
           "Trying to use Norm while a copy is in use!",
           "SpaceTimeVector::Norm");
       }
+    if (name != "infty" && name != "l1")
+      {
+        throw DOpEException("Unknown type: " + name,"SpaceTimeVector<VECTOR>::Norm");
+      }
+    if (restriction != "all" && restriction != "positive")
+      {
+        throw DOpEException("Unknown restriction: " + restriction,"SpaceTimeVector<VECTOR>::Norm");
+      }
+    const bool infty = (name == "infty");
+    //Norm of a single time point. The unrestricted norms of serial
+    //vectors are threaded by deal.II, otherwise the locally owned
+    //entries are visited and combined over all processes.
+    auto local_norm = [infty,restriction](const VECTOR &tmp) -> double
+    {
+      if (restriction == "all" && !DOpEHelper::is_distributed_vector<VECTOR>::value)
+        {
+          return infty ? tmp.linfty_norm() : tmp.l1_norm();
+        }
+      double ret = 0.;
+      for (const auto j : tmp.locally_owned_elements())
+        {
+          const double value = (restriction == "all")
+                               ? std::fabs(static_cast<double>(tmp(j)))
+                               : std::max(0.,static_cast<double>(tmp(j)));
+          if (infty)
+            ret = std::max(ret,value);
+          else
+            ret += value;
+        }
+      return infty ? DOpEHelper::max_over_processes(ret,tmp) : DOpEHelper::sum_over_processes(ret,tmp);
+    };
+
+    std::vector<double> partial;
     if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
       {
-        double ret = 0.;
-        if (name == "infty")
-          {
-            if ( restriction == "all")
-              {
-                for (unsigned int i = 0; i < stvector_.size(); i++)
-                  {
-                    const VECTOR &tmp = *(stvector_[i]);
-                    for ( unsigned int j = 0; j < tmp.size(); j++)
-                      {
-                        ret = std::max(ret,std::fabs(tmp(j)));
-                      }
-                  }
-              }
-            else if (restriction == "positive")
-              {
-                for (unsigned int i = 0; i < stvector_.size(); i++)
-                  {
-                    const VECTOR &tmp = *(stvector_[i]);
-                    for ( unsigned int j = 0; j < tmp.size(); j++)
-                      {
-                        ret = std::max(ret,std::max(0.,tmp(j)));
-                      }
-                  }
-              }
-            else
-              {
-                throw DOpEException("Unknown restriction: " + restriction,"SpaceTimeVector<VECTOR>::Norm");
-              }
-          }
-        else if (name == "l1")
-          {
-            if ( restriction == "all")
-              {
-                for (unsigned int i = 0; i < stvector_.size(); i++)
-                  {
-                    const VECTOR &tmp = *(stvector_[i]);
-                    for ( unsigned int j = 0; j < tmp.size(); j++)
-                      {
-                        ret += std::fabs(tmp(j));
-                      }
-                  }
-              }
-            else if (restriction == "positive")
-              {
-                for (unsigned int i = 0; i < stvector_.size(); i++)
-                  {
-                    const VECTOR &tmp = *(stvector_[i]);
-                    for ( unsigned int j = 0; j < tmp.size(); j++)
-                      {
-                        ret += std::max(0.,tmp(j));
-                      }
-                  }
-              }
-            else
-              {
-                throw DOpEException("Unknown restriction: " + restriction,"ConstraintVector<VECTOR>::Norm");
-              }
-          }
-        else
-          {
-            throw DOpEException("Unknown type: " + name,"ConstraintVector<VECTOR>::Norm");
-          }
-        return ret;
+        partial.resize(stvector_.size(), 0.);
+        ForAllTimePoints([this,&partial,&local_norm](unsigned int i)
+        {
+          assert(stvector_[i] != NULL);
+          partial[i] = local_norm(*(stvector_[i]));
+        });
+      }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+      {
+        ReadTimePoints(*this, [&partial,&local_norm](const VECTOR &v, const VECTOR &)
+        {
+          partial.push_back(local_norm(v));
+        });
       }
     else
       {
         throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),"SpaceTimeVector<VECTOR>::Norm");
       }
+    //Combine the time points in a fixed order.
+    double ret = 0.;
+    for (unsigned int i = 0; i < partial.size(); i++)
+      {
+        if (infty)
+          ret = std::max(ret,partial[i]);
+        else
+          ret += partial[i];
+      }
+    return ret;
   }
 
 
@@ -1743,13 +1846,9 @@ namespace DOpE
         if (local_vectors_[global_to_local_[accessor_]]->size() != 0)
           {
             MakeName(accessor_);
-            assert(!filestream_.is_open());
-            filestream_.open(filename_.c_str(), std::fstream::out);
-            if (!filestream_.fail())
+            if (DOpEHelper::write_to_file (*local_vectors_[global_to_local_[accessor_]],
+                                           filename_))
               {
-                DOpEHelper::write (*local_vectors_[global_to_local_[accessor_]],
-                                   filestream_);
-                filestream_.close();
                 stvector_information_.at(accessor_).on_disc_ = true;
               }
             else
@@ -1768,20 +1867,34 @@ namespace DOpE
   SpaceTimeVector<VECTOR>::FetchFromDisc(unsigned int time_point, VECTOR &vector) const
   {
     MakeName(time_point);
-    assert(!filestream_.is_open());
-    filestream_.open(filename_.c_str(), std::fstream::in);
-    if (!filestream_.fail())
-      {
-        DOpEHelper::read (vector, filestream_);
-        filestream_.close();
-      }
-    else
+    if (!DOpEHelper::read_from_file (vector, filename_))
       {
         throw DOpEException("Could not fetch " + filename_ + "from disc.",
                             "SpaceTimeVector<VECTOR>::StoreOnDisc");
       }
   }
 
+  /******************************************************/
+  template<typename VECTOR>
+  int
+  SpaceTimeVector<VECTOR>::ExecuteCommand(const std::string &command) const
+  {
+    if (!DOpEHelper::is_distributed_vector<VECTOR>::value)
+      {
+        return system(command.c_str());
+      }
+    const MPI_Comm comm = GetSpaceTimeHandler()->GetMPIComm();
+    int ret = 0;
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      {
+        ret = system(command.c_str());
+      }
+    //The broadcast also makes sure that no process continues
+    //before the command is completed.
+    MPI_Bcast(&ret, 1, MPI_INT, 0, comm);
+    return ret;
+  }
+
   /******************************************************/
   template<typename VECTOR>
   void
@@ -1899,6 +2012,119 @@ namespace DOpE
       }
   }
 
+  /******************************************************/
+
+  template<typename VECTOR>
+  template<typename FUNCTION>
+  void
+  SpaceTimeVector<VECTOR>::ForAllTimePoints(const FUNCTION &f) const
+  {
+    assert(GetBehavior() == DOpEtypes::VectorStorageType::fullmem);
+
+    const unsigned int n_time_points = stvector_.size();
+    //Operations on MPI vectors communicate, hence they have to be called
+    //in the same order on all processes.
+    if (n_time_points > 1 && !DOpEHelper::is_distributed_vector<VECTOR>::value)
+      {
+        dealii::parallel::apply_to_subranges(0u, n_time_points,
+                                             [&f](unsigned int begin, unsigned int end)
+        {
+          for (unsigned int i = begin; i < end; i++)
+            f(i);
+        }, 1);
+      }
+    else
+      {
+        for (unsigned int i = 0; i < n_time_points; i++)
+          f(i);
+      }
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  template<typename FUNCTION>
+  void
+  SpaceTimeVector<VECTOR>::UpdateTimePoints(const SpaceTimeVector *dq,
+                                            bool fetch_own,
+                                            const FUNCTION &f)
+  {
+    assert(GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc);
+
+    //make sure that the currently loaded vectors are stored on the disc
+    StoreOnDisc();
+    if (dq != NULL && dq != this)
+      dq->StoreOnDisc();
+    ResizeLocalVectors(1);
+    accessor_index_ = -3;
+
+    const unsigned int n_time_points = GetSpaceTimeHandler()->GetMaxTimePoint() + 1;
+    VECTOR &v = *local_vectors_[0];
+    for (unsigned int k = 1; k <= n_time_points; k++)
+      {
+        const unsigned int t = k % n_time_points;
+        accessor_ = t;
+        global_to_local_.clear();
+        global_to_local_[accessor_] = 0;
+
+        GetSpaceTimeHandler ()->ReinitVector (v, vector_type_, t);
+        if (fetch_own && FileExists(t))
+          {
+            FetchFromDisc(t, v);
+          }
+        if (dq == NULL || dq == this)
+          {
+            f(v, v);
+          }
+        else
+          {
+            dq->GetSpaceTimeHandler ()->ReinitVector (dq->local_stvector_,
+                                                      vector_type_, t);
+            dq->FetchFromDisc(t, dq->local_stvector_);
+            f(v, dq->local_stvector_);
+          }
+        stvector_information_.at(t).size_ = v.size();
+        StoreOnDisc();
+      }
+  }
+
+  /******************************************************/
+
+  template<typename VECTOR>
+  template<typename FUNCTION>
+  void
+  SpaceTimeVector<VECTOR>::ReadTimePoints(const SpaceTimeVector &dq,
+                                          const FUNCTION &f) const
+  {
+    assert(GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc);
+
+    //Returns the spatial vector of x at time point t, from the memory if
+    //possible and from the disc otherwise.
+    auto get = [](const SpaceTimeVector &x, unsigned int t) -> const VECTOR &
+    {
+      if (x.accessor_ >= 0)
+        {
+          auto it = x.global_to_local_.find(t);
+          if (it != x.global_to_local_.end())
+            return *(x.local_vectors_[it->second]);
+        }
+      x.GetSpaceTimeHandler ()->ReinitVector (x.local_stvector_,
+                                              x.vector_type_, t);
+      x.FetchFromDisc(t, x.local_stvector_);
+      return x.local_stvector_;
+    };
+
+    const unsigned int n_time_points = GetSpaceTimeHandler()->GetMaxTimePoint() + 1;
+    for (unsigned int t = 0; t < n_time_points; t++)
+      {
+        const VECTOR &v = get(*this, t);
+        if (&dq == this)
+          f(v, v);
+        else
+          f(v, get(dq, t));
+      }
+  }
+
 }//end of namespace
 /******************************************************/
 /******************************************************/
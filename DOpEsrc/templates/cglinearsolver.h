@@ -38,6 +38,8 @@
 #include <deal.II/dofs/dof_tools.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <wrapper/preconditioner_wrapper.h>
+
 #include <vector>
 
 namespace DOpE
@@ -92,6 +94,18 @@ namespace DOpE
     template<typename PROBLEM, typename INTEGRATOR>
     void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
 
+    /**
+     * Sets the relative reduction of the residual that is required in the
+     * following calls of Solve, as needed by inexact Newton methods.
+     * If it is zero (default) only the tolerances from the parameter file are used.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve.
+     */
+    double GetLastLinearResidual() const;
+
   protected:
 
   private:
@@ -101,6 +115,7 @@ namespace DOpE
 
     double linear_global_tol_, linear_tol_;
     int  linear_maxiter_;
+    double forcing_term_ = 0., last_linear_residual_ = 0.;
   };
 
   /*********************************Implementation************************************************/
@@ -162,19 +177,35 @@ namespace DOpE
     if (force_matrix_build)
       {
         integr.ComputeMatrix (pde,matrix_);
+        DOpEWrapper::SetDiscretizationData(*precondition_, pde);
         precondition_->initialize(matrix_);
       }
 
 
-    dealii::SolverControl solver_control (linear_maxiter_, linear_global_tol_,false,false);
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, forcing_term_,false,false);
     dealii::SolverCG<VECTOR> cg (solver_control);
     cg.solve (matrix_, solution, rhs,
               *precondition_);
 
+    last_linear_residual_ = solver_control.last_value();
     pde.GetDoFConstraints().distribute(solution);
   }
   /******************************************************/
 
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void CGLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::SetForcingTerm(double eta)
+  {
+    forcing_term_ = eta;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  double CGLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::GetLastLinearResidual() const
+  {
+    return last_linear_residual_;
+  }
+
 
 
 }
@@ -39,8 +39,10 @@
 #include <deal.II/dofs/dof_tools.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <algorithm>
 #include <vector>
 
+#include <include/helper.h>
 #include <include/parameterreader.h>
 
 namespace DOpE
@@ -52,6 +54,15 @@ namespace DOpE
    * Here we interface to the UMFPACK-Solver provided via dealii
    * The use of this function requires that dealii is compiled with UMFPACK
    *
+   * If reuse_factorization is set, a new matrix does not imply a new factorization.
+   * Instead the old factorization is used for an iterative refinement against the
+   * new matrix. Only if the refinement stalls the matrix is factorized again.
+   *
+   * The factorization is always computed in double precision: dealii::SparseDirectUMFPACK
+   * copies any matrix into double arrays before calling UMFPACK, so a single precision
+   * factorization (mixed precision refinement) is not offered by this class. The
+   * refinement only saves the refactorizations, not factor memory.
+   *
    * @tparam <SPARSITYPATTERN>    The sparsity pattern for the matrix
    * @tparam <MATRIX>             The matrix type that is used for the storage of the system_matrix
    * @tparam <VECTOR>             The vector type for the solution and righthandside data,
@@ -95,29 +106,89 @@ namespace DOpE
     template<typename PROBLEM, typename INTEGRATOR>
     void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
 
+    /**
+     * The system is solved directly, hence the forcing terms of inexact
+     * Newton methods are only used as tolerance for the iterative
+     * refinement with an outdated factorization.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve,
+     * which is zero unless an outdated factorization has been used.
+     */
+    double GetLastLinearResidual() const;
+
+    /**
+     * Returns how many work vectors of this class had to be reallocated during the last call
+     * of Solve. As long as the size of the problem does not change
+     * this is expected to be zero.
+     */
+    unsigned int GetNSolveWorkVectorReallocations() const;
+
+    /**
+     * Returns the number of factorizations computed since the last ReInit.
+     * With reuse_factorization this is less than the number of matrices
+     * as long as the iterative refinement succeeds.
+     */
+    unsigned int GetNFactorizations() const;
+
   protected:
 
   private:
+    /**
+     * Iterative refinement of solution using the outdated factorization
+     * in A_direct_ and the current matrix_.
+     *
+     * @return false if the refinement stalls.
+     */
+    bool RefineSolution(const VECTOR &rhs, VECTOR &solution);
+
     SPARSITYPATTERN sparsity_pattern_;
     MATRIX matrix_;
 
     dealii::SparseDirectUMFPACK *A_direct_;
 
+    bool reuse_factorization_;
+    bool factorization_outdated_ = false;
+    int refinement_maxiter_;
+    double refinement_tol_, refinement_rate_;
+    double forcing_term_ = 0., last_linear_residual_ = 0.;
+    VECTOR residual_, update_;
+
+    /**
+     * Work vector for UMFPACK, kept between the calls of Solve
+     * to avoid a reallocation in each linear solve.
+     */
+    dealii::Vector<double> sol_;
+    unsigned int n_solve_work_vector_reallocations_ = 0;
+    unsigned int n_factorizations_ = 0;
+
   };
 
   /*********************************Implementation************************************************/
 
   template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
-  void DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::declare_params(ParameterReader &/*param_reader*/)
+  void DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::declare_params(ParameterReader &param_reader)
   {
+    param_reader.SetSubsection("directlinearsolver parameters");
+    param_reader.declare_entry("reuse_factorization", "false",Patterns::Bool(),"reuse the last factorization for an iterative refinement if a new matrix is build");
+    param_reader.declare_entry("refinement_tol", "1.e-12",Patterns::Double(0),"relative tolerance for the iterative refinement");
+    param_reader.declare_entry("refinement_maxiter", "10",Patterns::Integer(0),"maximal number of refinement steps before the matrix is factorized again");
+    param_reader.declare_entry("refinement_rate", "0.5",Patterns::Double(0,1),"minimal reduction of the residual in each refinement step, otherwise the matrix is factorized again");
   }
 
   /******************************************************/
 
   template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
   DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::DirectLinearSolverWithMatrix(
-    ParameterReader &/*param_reader*/)
+    ParameterReader &param_reader)
   {
+    param_reader.SetSubsection("directlinearsolver parameters");
+    reuse_factorization_ = param_reader.get_bool ("reuse_factorization");
+    refinement_tol_      = param_reader.get_double ("refinement_tol");
+    refinement_maxiter_  = param_reader.get_integer ("refinement_maxiter");
+    refinement_rate_     = param_reader.get_double ("refinement_rate");
     A_direct_ = NULL;
   }
 
@@ -141,6 +212,11 @@ namespace DOpE
     matrix_.clear();
     pde.ComputeSparsityPattern(sparsity_pattern_);
     matrix_.reinit(sparsity_pattern_);
+    dealii::Vector<double>().swap(sol_);
+    VECTOR().swap(residual_);
+    VECTOR().swap(update_);
+    factorization_outdated_ = false;
+    n_factorizations_ = 0;
 
     if (A_direct_ != NULL)
       {
@@ -168,21 +244,118 @@ namespace DOpE
       {
         A_direct_ = new dealii::SparseDirectUMFPACK;
         A_direct_->initialize(matrix_);
+        n_factorizations_++;
       }
     else if (force_matrix_build)
       {
-        A_direct_->factorize(matrix_);
+        if (reuse_factorization_)
+          {
+            factorization_outdated_ = true;
+          }
+        else
+          {
+            A_direct_->factorize(matrix_);
+            n_factorizations_++;
+          }
       }
 
-    dealii::Vector<double> sol;
-    sol = rhs;
-    A_direct_->solve(sol);
-    solution = sol;
+    n_solve_work_vector_reallocations_ = (sol_.size() != rhs.size()) ? 1 : 0;
+    if (sol_.size() != rhs.size())
+      sol_.reinit(rhs.size(),true);
+    sol_ = rhs;
+    A_direct_->solve(sol_);
+    solution = sol_;
+    last_linear_residual_ = 0.;
+
+    if (factorization_outdated_ && !RefineSolution(rhs,solution))
+      {
+        //The old factorization is too far off, so we need a new one.
+        A_direct_->factorize(matrix_);
+        n_factorizations_++;
+        factorization_outdated_ = false;
+        last_linear_residual_ = 0.;
+
+        sol_ = rhs;
+        A_direct_->solve(sol_);
+        solution = sol_;
+      }
 
     pde.GetDoFConstraints().distribute(solution);
 
   }
 
+  /******************************************************/
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  unsigned int DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::GetNSolveWorkVectorReallocations() const
+  {
+    return n_solve_work_vector_reallocations_;
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  unsigned int DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::GetNFactorizations() const
+  {
+    return n_factorizations_;
+  }
+
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::SetForcingTerm(double eta)
+  {
+    forcing_term_ = eta;
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  double DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::GetLastLinearResidual() const
+  {
+    return last_linear_residual_;
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  bool DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::RefineSolution(const VECTOR &rhs,
+      VECTOR &solution)
+  {
+    DOpEHelper::reinit_work_vector(residual_,rhs);
+    DOpEHelper::reinit_work_vector(update_,rhs);
+
+    const double tol = std::max(refinement_tol_,forcing_term_)*rhs.l2_norm();
+
+    matrix_.vmult(residual_,solution);
+    residual_.sadd(-1.,1.,rhs);
+    double res = residual_.l2_norm();
+
+    int iter = 0;
+    while (res > tol)
+      {
+        iter++;
+        if (iter > refinement_maxiter_)
+          {
+            return false;
+          }
+        sol_ = residual_;
+        A_direct_->solve(sol_);
+        update_ = sol_;
+        solution += update_;
+
+        matrix_.vmult(residual_,solution);
+        residual_.sadd(-1.,1.,rhs);
+        double new_res = residual_.l2_norm();
+        if (new_res > refinement_rate_*res)
+          {
+            return false;
+          }
+        res = new_res;
+      }
+    last_linear_residual_ = res;
+    return true;
+  }
 
 }
 #endif
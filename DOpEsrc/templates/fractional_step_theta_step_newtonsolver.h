@@ -33,8 +33,12 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <memory>
 
+#include <include/forcingterm.h>
+#include <include/helper.h>
 #include <include/parameterreader.h>
+#include <templates/timematrixcachingintegrator.h>
 
 
 
@@ -119,6 +123,16 @@ namespace DOpE
                         bool apply_boundary_values=true,
                         bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ");
 
+    /**
+     * Same as above, but the Newton iteration starts from initial_guess instead
+     * of last_time_solution, e.g., an extrapolation computed by a TimeStepPredictor.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution,
+                        const VECTOR &initial_guess, VECTOR &solution,
+                        bool apply_boundary_values=true,
+                        bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ");
+
     /******************************************************/
 
     /**
@@ -168,15 +182,56 @@ namespace DOpE
     template<typename PROBLEM>
     void NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &residual);
 
+    /**
+     * Returns how many work vectors of this class had to be reallocated during the last call
+     * of NonlinearSolve, NonlinearSolve_Initial, or NonlinearLastTimeEvals.
+     * As long as the size of the problem does not change this is expected to be zero.
+     */
+    unsigned int GetNWorkVectorReallocations() const;
+
   protected:
 
     inline INTEGRATOR &GetIntegrator();
 
   private:
+    /**
+     * Resets the work vector to the layout of solution,
+     * reallocating only if the size has changed.
+     */
+    inline void PrepareWorkVector(VECTOR &work, const VECTOR &solution);
+
     INTEGRATOR &integrator_;
 
+    /**
+     * Is given to the linear solvers in the time steps to keep
+     * a constant time matrix, see PDEInterface::HasConstantTimeMatrix.
+     */
+    TimeMatrixCachingIntegrator<INTEGRATOR> matrix_integrator_;
+
     bool build_matrix_ = false;
 
+    /**
+     * The matrix of the second substep differs from the one of the first
+     * and third substep. If separate_substep_matrices is set, it is kept in its own
+     * linear solver, so that both matrices (and their factorizations) can be
+     * reused in the following time steps.
+     */
+    std::unique_ptr<LINEARSOLVER> substep_solver_;
+    bool build_substep_matrix_ = true;
+
+    /**
+     * Work vectors used in the nonlinear solves. They are kept between the calls
+     * to avoid the reallocation in each time step, and reset in ReInit.
+     */
+    VECTOR residual_, time_residual_, tmp_residual_, du_, tmp_last_time_solution_;
+    unsigned int n_work_vector_reallocations_ = 0;
+
+    /**
+     * Computes the relative tolerances of the linear solves
+     * if an inexact Newton method is selected.
+     */
+    ForcingTerm forcing_;
+
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
     int nonlinear_maxiter_, line_maxiter_;
@@ -196,7 +251,9 @@ namespace DOpE
 
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
+    param_reader.declare_entry("separate_substep_matrices", "false",Patterns::Bool(),"keep an own matrix for the second substep of the fractional step theta scheme");
 
+    ForcingTerm::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -205,7 +262,8 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   FractionalStepThetaStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::FractionalStepThetaStepNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), matrix_integrator_(integrator),
+      forcing_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -215,6 +273,12 @@ namespace DOpE
 
     line_maxiter_   = param_reader.get_integer ("line_maxiter");
     linesearch_rho_ = param_reader.get_double ("linesearch_rho");
+    forcing_.CheckLinearSolver<LINEARSOLVER>();
+
+    if (param_reader.get_bool ("separate_substep_matrices"))
+      {
+        substep_solver_.reset(new LINEARSOLVER(param_reader));
+      }
   }
 
   /*******************************************************************************************/
@@ -232,6 +296,17 @@ namespace DOpE
   ::ReInit(PROBLEM &pde)
   {
     LINEARSOLVER::ReInit(pde);
+    if (substep_solver_)
+      {
+        substep_solver_->ReInit(pde);
+        build_substep_matrix_ = true;
+      }
+    matrix_integrator_.ReInit();
+    VECTOR().swap(residual_);
+    VECTOR().swap(time_residual_);
+    VECTOR().swap(tmp_residual_);
+    VECTOR().swap(du_);
+    VECTOR().swap(tmp_last_time_solution_);
   }
 
   /*******************************************************************************************/
@@ -241,12 +316,13 @@ namespace DOpE
   ::NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution
                            ,VECTOR &residual)
   {
-    VECTOR tmp_residual;
-    tmp_residual.reinit(residual);
+    VECTOR &tmp_residual = tmp_residual_;
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(tmp_residual,residual);
     residual =0.;
     GetIntegrator().AddDomainData("last_newton_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
-    pde.SetStepPart("Old_for_1st_cycle");
+    pde.SetStepPart(DOpEtypes::StepPart::old_for_1st_cycle);
     GetIntegrator().ComputeNonlinearLhs(pde,residual);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
@@ -264,13 +340,14 @@ namespace DOpE
                            bool force_matrix_build, int priority, std::string algo_level)
   {
     bool build_matrix = force_matrix_build;
-    VECTOR residual;
-    VECTOR du;
+    VECTOR &residual = residual_;
+    VECTOR &du = du_;
     std::stringstream out;
     pde.GetOutputHandler()->InitNewtonOut(out);
 
-    du.reinit(solution);
-    residual.reinit(solution);
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(du,solution);
+    PrepareWorkVector(residual,solution);
 
     if (apply_boundary_values)
       {
@@ -288,6 +365,10 @@ namespace DOpE
     double res = residual.linfty_norm();
     double firstres = res;
     double lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
 
 
     out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
@@ -313,6 +394,12 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply<LINEARSOLVER>(*this);
+          }
         LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
         bool was_build = build_matrix;
 
@@ -377,6 +464,10 @@ namespace DOpE
                   build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update<LINEARSOLVER>(residual.l2_norm(),*this);
+                }
 
               out << algo_level
                   << "Newton step: "
@@ -396,6 +487,11 @@ namespace DOpE
       }
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
+    if (forcing_.IsActive())
+      {
+        forcing_.Release<LINEARSOLVER>(*this);
+      }
+
     return build_matrix;
   }
 
@@ -411,10 +507,35 @@ namespace DOpE
                    int priority,
                    std::string algo_level)
   {
+    return NonlinearSolve(pde, last_time_solution, last_time_solution, solution,
+                          apply_boundary_values, force_matrix_build, priority, algo_level);
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER,  typename VECTOR>
+  template<typename PROBLEM>
+  bool FractionalStepThetaStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolve(PROBLEM &pde,
+                   const VECTOR &last_time_solution,
+                   const VECTOR &initial_guess,
+                   VECTOR &solution,
+                   bool apply_boundary_values,
+                   bool force_matrix_build,
+                   int priority,
+                   std::string algo_level)
+  {
 
     bool build_matrix = force_matrix_build;
-    VECTOR residual, time_residual, tmp_residual;
-    VECTOR du, tmp_last_time_solution;
+    if (force_matrix_build)
+      {
+        build_substep_matrix_ = true;
+      }
+    VECTOR &residual = residual_;
+    VECTOR &time_residual = time_residual_;
+    VECTOR &tmp_residual = tmp_residual_;
+    VECTOR &du = du_;
+    VECTOR &tmp_last_time_solution = tmp_last_time_solution_;
     std::stringstream out;
     pde.GetOutputHandler()->InitNewtonOut(out);
 
@@ -422,16 +543,17 @@ namespace DOpE
     double firstres = 0.0;
     double lastres = 0.0;
 
-    du.reinit(solution);
-    residual.reinit(solution);
-    time_residual.reinit(solution);
-    tmp_residual.reinit(solution);
-    tmp_last_time_solution.reinit(solution);
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(du,solution);
+    PrepareWorkVector(residual,solution);
+    PrepareWorkVector(time_residual,solution);
+    PrepareWorkVector(tmp_residual,solution);
+    PrepareWorkVector(tmp_last_time_solution,solution);
 
     //Transfer from previous timestep
     residual +=solution;
-    // last_time_solution is very good starting value
-    solution = last_time_solution;
+    // last_time_solution is very good starting value, unless a better guess is given
+    solution = initial_guess;
 
 
     // First cycle of FS-scheme
@@ -443,7 +565,7 @@ namespace DOpE
     // Righthandside for the current timestep f^{n+1}
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
-    pde.SetStepPart("New_for_1st_and_3rd_cycle");
+    pde.SetStepPart(DOpEtypes::StepPart::new_for_1st_and_3rd_cycle);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
     residual += tmp_residual;
@@ -464,6 +586,10 @@ namespace DOpE
     res = residual.linfty_norm();
     firstres = res;
     lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
     int iter=0;
 
     out<<algo_level<<"Newton step: " <<0<<"\t Residual (abs.): "
@@ -485,7 +611,13 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply<LINEARSOLVER>(*this);
+          }
+        LINEARSOLVER::Solve(pde,matrix_integrator_,residual,du,build_matrix);
         bool was_build = build_matrix;
         //Linesearch
         {
@@ -547,6 +679,10 @@ namespace DOpE
                   build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update<LINEARSOLVER>(residual.l2_norm(),*this);
+                }
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
                  << pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
@@ -563,6 +699,8 @@ namespace DOpE
 
 
     // 2nd cycle of FS-scheme
+    LINEARSOLVER &substep_solver = (substep_solver_) ? *substep_solver_ : static_cast<LINEARSOLVER &>(*this);
+    bool &substep_build_matrix = (substep_solver_) ? build_substep_matrix_ : build_matrix;
     tmp_last_time_solution = 0;
     tmp_last_time_solution = solution;
 
@@ -572,7 +710,7 @@ namespace DOpE
 
     // Calculate residual parts corresponding to the last time-step
     GetIntegrator().AddDomainData("last_newton_solution",&tmp_last_time_solution);
-    pde.SetStepPart("Old_for_2nd_cycle");
+    pde.SetStepPart(DOpEtypes::StepPart::old_for_2nd_cycle);
     GetIntegrator().ComputeNonlinearLhs(pde,residual);
 
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
@@ -590,7 +728,7 @@ namespace DOpE
 
     // Righthandside for the current timestep f^{n+1}
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
-    pde.SetStepPart("New_for_2nd_cycle");
+    pde.SetStepPart(DOpEtypes::StepPart::new_for_2nd_cycle);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
     residual += tmp_residual;
@@ -611,6 +749,10 @@ namespace DOpE
     res = residual.linfty_norm();
     firstres = res;
     lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
     iter=0;
 
     out<<algo_level<<"Newton step: " <<0<<"\t Residual (abs.): "
@@ -631,8 +773,14 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
-        bool was_build = build_matrix;
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply(substep_solver);
+          }
+        substep_solver.Solve(pde,matrix_integrator_,residual,du,substep_build_matrix);
+        bool was_build = substep_build_matrix;
         //Linesearch
         {
           solution += du;
@@ -645,9 +793,9 @@ namespace DOpE
           int lineiter=0;
           double rho = linesearch_rho_;
           double alpha=1;
-          if ( res > lastres && build_matrix == false)
+          if ( res > lastres && substep_build_matrix == false)
             {
-              build_matrix = true;
+              substep_build_matrix = true;
               // Reuse of Matrix seems to be a bad idea, rebuild and repeat
               solution -= du;
               GetIntegrator().ComputeNonlinearResidual(pde,residual);
@@ -661,7 +809,7 @@ namespace DOpE
             }
           else
             {
-              build_matrix = false;
+              substep_build_matrix = false;
               while (res > lastres)
                 {
                   out<<algo_level<<"\t Linesearch step: " <<lineiter<<"\t Residual (rel.): "
@@ -689,9 +837,13 @@ namespace DOpE
                 }
               if (res/lastres > nonlinear_rho_)
                 {
-                  build_matrix=true;
+                  substep_build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update(residual.l2_norm(),substep_solver);
+                }
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
                  << pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
@@ -717,7 +869,7 @@ namespace DOpE
 
     // Calculate residual parts corresponding to the last time-step
     GetIntegrator().AddDomainData("last_newton_solution",&tmp_last_time_solution);
-    pde.SetStepPart("Old_for_3rd_cycle");
+    pde.SetStepPart(DOpEtypes::StepPart::old_for_3rd_cycle);
     GetIntegrator().ComputeNonlinearLhs(pde,residual);
 
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
@@ -734,7 +886,7 @@ namespace DOpE
 
     // Righthandside for the current timestep f^{n+1}
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
-    pde.SetStepPart("New_for_1st_and_3rd_cycle");
+    pde.SetStepPart(DOpEtypes::StepPart::new_for_1st_and_3rd_cycle);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
     residual += tmp_residual;
@@ -755,6 +907,10 @@ namespace DOpE
     res = residual.linfty_norm();
     firstres = res;
     lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
     iter=0;
 
     out<<algo_level<<"Newton step: " <<0<<"\t Residual (abs.): "
@@ -775,7 +931,13 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply<LINEARSOLVER>(*this);
+          }
+        LINEARSOLVER::Solve(pde,matrix_integrator_,residual,du,build_matrix);
         bool was_build = build_matrix;
         //Linesearch
         {
@@ -836,6 +998,10 @@ namespace DOpE
                   build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update<LINEARSOLVER>(residual.l2_norm(),*this);
+                }
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
                  << pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
@@ -852,10 +1018,35 @@ namespace DOpE
 
 
 
+    if (forcing_.IsActive())
+      {
+        forcing_.Release<LINEARSOLVER>(*this);
+        if (substep_solver_)
+          forcing_.Release(*substep_solver_);
+      }
+
     return build_matrix;
   }
 
 
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void FractionalStepThetaStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::PrepareWorkVector(VECTOR &work, const VECTOR &solution)
+  {
+    const bool reallocated = DOpEHelper::reinit_work_vector(work,solution);
+    if (reallocated)
+      n_work_vector_reallocations_++;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  unsigned int FractionalStepThetaStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetNWorkVectorReallocations() const
+  {
+    return n_work_vector_reallocations_;
+  }
+
   /*******************************************************************************************/
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   INTEGRATOR &FractionalStepThetaStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
@@ -40,6 +40,8 @@
 
 #include <deal.II/numerics/vector_tools.h>
 
+#include <wrapper/preconditioner_wrapper.h>
+
 #include <vector>
 
 namespace DOpE
@@ -49,7 +51,9 @@ namespace DOpE
    * @class GMRESLinearSolverWithMatrix
    *
    * This class provides a linear solve for the nonlinear solvers of DOpE.
-   * Here we interface to the GMRES-Solver of dealii
+   * Here we interface to the GMRES-Solver of dealii. If a forcing term is set,
+   * the preconditioner is applied from the right, so that the forcing term refers
+   * to the unpreconditioned residual. Otherwise it is applied from the left.
    *
    * @tparam <PRECONDITIONER>     The preconditioner class to be used with the solver
    * @tparam <SPARSITYPATTERN>    The sparsity pattern for the matrix
@@ -94,6 +98,18 @@ namespace DOpE
     template<typename PROBLEM, typename INTEGRATOR>
     void Solve(PROBLEM &pde,INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
 
+    /**
+     * Sets the relative reduction of the residual that is required in the
+     * following calls of Solve, as needed by inexact Newton methods.
+     * If it is zero (default) only the tolerances from the parameter file are used.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve.
+     */
+    double GetLastLinearResidual() const;
+
   protected:
 
   private:
@@ -102,6 +118,7 @@ namespace DOpE
     PRECONDITIONER *precondition_;
     double linear_global_tol_, linear_tol_ = 0;
     int  linear_maxiter_, no_tmp_vectors_;
+    double forcing_term_ = 0., last_linear_residual_ = 0.;
   };
 
   /*********************************Implementation************************************************/
@@ -163,25 +180,48 @@ namespace DOpE
     if (force_matrix_build)
       {
         integr.ComputeMatrix (pde,matrix_);
+        DOpEWrapper::SetDiscretizationData(*precondition_, pde);
         precondition_->initialize(matrix_);
       }
 
 
-    dealii::SolverControl solver_control (linear_maxiter_, linear_global_tol_,false,false);
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, forcing_term_,false,false);
 
     // This is gmres specific
     dealii::GrowingVectorMemory<VECTOR> vector_memory;
     typename dealii::SolverGMRES<VECTOR>::AdditionalData gmres_data;
     gmres_data.max_n_tmp_vectors = no_tmp_vectors_;
+    //With right preconditioning the solver control (and hence last_linear_residual_)
+    //measures the residual of the original system, as required by the forcing terms.
+    gmres_data.right_preconditioning = (forcing_term_ > 0.);
 
 
     dealii::SolverGMRES<VECTOR> gmres (solver_control, vector_memory, gmres_data);
     gmres.solve (matrix_, solution, rhs,
                  *precondition_);
 
+    last_linear_residual_ = solver_control.last_value();
     pde.GetDoFConstraints().distribute(solution);
   }
 
 
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void GMRESLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::SetForcingTerm(double eta)
+  {
+    forcing_term_ = eta;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  double GMRESLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::GetLastLinearResidual() const
+  {
+    return last_linear_residual_;
+  }
+
+
+
 }
 #endif
@@ -0,0 +1,342 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef INSTAT_STEP_EXPLICIT_SOLVER_H_
+#define INSTAT_STEP_EXPLICIT_SOLVER_H_
+
+#include <deal.II/base/index_set.h>
+
+#include <include/helper.h>
+#include <include/parameterreader.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <tsschemes/forward_euler_problem.h>
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace DOpE
+{
+  namespace internal
+  {
+    /**
+     * Is true if the PROBLEM is a ForwardEulerProblem, the only
+     * time stepping scheme the InstatStepExplicitSolver can be used with.
+     */
+    template <typename PROBLEM>
+    struct is_forward_euler_problem : std::false_type
+    {};
+
+    template <typename OPTPROBLEM, typename SPARSITYPATTERN, typename VECTOR,
+              int dealdim, template <int, int> class FE>
+    struct is_forward_euler_problem<ForwardEulerProblem<OPTPROBLEM, SPARSITYPATTERN,
+      VECTOR, dealdim, FE> > : std::true_type
+    {};
+  }
+
+  /**
+   * A solver class for explicit time stepping, i.e., for the ForwardEulerProblem.
+   * It can be used in place of the InstatStepNewtonSolver.
+   *
+   * The matrix of the new time point is replaced by a lumped (diagonal) mass matrix,
+   * which is computed once after each call of ReInit or change of the
+   * state DoFs of the SpaceTimeHandler. Each time step then consists
+   * of the assembly of the residual and a scaling with the inverse lumped mass,
+   * no matrix is build and no linear system is solved.
+   * The lumped mass is given by the row sums of the matrix of the new time point,
+   * which are computed as the residual of the new time point for a constant
+   * function one. Hence the terms of the new time point, i.e., the ElementTimeEquation,
+   * need to be linear and may not depend on time, e.g., a mass matrix.
+   *
+   * Besides the forward Euler method the two-stage strong stability preserving
+   * Runge-Kutta method of Shu and Osher can be selected by the parameter
+   * explicit_scheme. Its stages are forward Euler steps which are combined convexly.
+   *
+   * The initial values are still computed by NonlinearSolve_Initial of the
+   * InstatStepNewtonSolver, using the LINEARSOLVER.
+   *
+   * @tparam <INTEGRATOR>          Integration routines to compute domain-, face-, and right-hand side values.
+   * @tparam <LINEARSOLVER>        A linear solver for the computation of the initial values.
+   * @tparam <VECTOR>              A template class for arbitrary vectors which are given to the
+                                   scheme and where the solution is stored in.
+   */
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  class InstatStepExplicitSolver : public InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR>
+  {
+  public:
+    /**
+     * Constructor of this class.
+     *
+     * @param integrator          A reference of the integrator is given to the solver.
+     * @param param_reader        An object which has run time data for the solver.
+     */
+    InstatStepExplicitSolver(INTEGRATOR &integrator, ParameterReader &param_reader);
+    ~InstatStepExplicitSolver();
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /******************************************************/
+
+    /**
+       This Function should be called once after grid refinement, or changes in boundary values
+       to  recompute sparsity patterns, constraint matrices, and the lumped mass.
+     */
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde);
+
+    /******************************************************/
+
+    /**
+     * Computes the solution of an explicit time step described by the PROBLEM.
+     * The arguments are the same as for InstatStepNewtonSolver::NonlinearSolve.
+     *
+     * @return false, since no matrix is build by this solver.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
+                        bool apply_boundary_values=true,
+                        bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ");
+
+  private:
+    /**
+     * Computes the inverse of the lumped mass. Entries belonging
+     * to constrained DoFs are set to zero. The domain data last_time_solution
+     * needs to be set.
+     */
+    template<typename PROBLEM>
+    void ComputeInverseLumpedMass(PROBLEM &pde, const VECTOR &solution);
+
+    /**
+     * Performs a forward Euler step, i.e.,
+     * solution -= M_L^{-1} (A_new(solution) + old_residual - f_new)
+     * where old_residual contains the terms of the old time point.
+     * The domain data last_newton_solution needs to be set to solution.
+     *
+     * @return The l2-norm of the update.
+     */
+    template<typename PROBLEM>
+    double ExplicitStep(PROBLEM &pde, const VECTOR &old_residual, VECTOR &solution);
+
+    unsigned int n_stages_;
+
+    VECTOR inverse_lumped_mass_;
+    /**
+     * Ticket of the SpaceTimeHandler for which inverse_lumped_mass_ has
+     * been computed.
+     */
+    unsigned int state_ticket_ = 0;
+    /**
+     * Work vectors, they are kept between the calls
+     * to avoid the reallocation in each time step.
+     */
+    VECTOR residual_, tmp_residual_, update_, stage_solution_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("explicitsolver parameters");
+    param_reader.declare_entry("explicit_scheme", "forward_euler",Patterns::Selection("forward_euler|ssp_rk2"),"explicit scheme, either the forward euler method or the two-stage strong stability preserving runge-kutta method");
+
+    InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR>::declare_params(param_reader);
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::InstatStepExplicitSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
+    : InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR>(integrator,param_reader)
+  {
+    param_reader.SetSubsection("explicitsolver parameters");
+    if (param_reader.get_string("explicit_scheme") == "ssp_rk2")
+      n_stages_ = 2;
+    else
+      n_stages_ = 1;
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::~InstatStepExplicitSolver()
+  {
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::ReInit(PROBLEM &pde)
+  {
+    InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR>::ReInit(pde);
+    VECTOR().swap(inverse_lumped_mass_);
+    state_ticket_ = 0;
+    VECTOR().swap(residual_);
+    VECTOR().swap(tmp_residual_);
+    VECTOR().swap(update_);
+    VECTOR().swap(stage_solution_);
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::ComputeInverseLumpedMass(PROBLEM &pde, const VECTOR &solution)
+  {
+    DOpEHelper::reinit_work_vector(inverse_lumped_mass_,solution);
+    update_ = 1.;
+
+    this->GetIntegrator().AddDomainData("last_newton_solution",&update_);
+    pde.SetStepPart(DOpEtypes::StepPart::new_part);
+    this->GetIntegrator().ComputeNonlinearLhs(pde,inverse_lumped_mass_);
+    this->GetIntegrator().DeleteDomainData("last_newton_solution");
+
+    const auto &constraints = pde.GetDoFConstraints();
+    const dealii::IndexSet owned = inverse_lumped_mass_.locally_owned_elements();
+    for (unsigned int k = 0; k < owned.n_elements(); k++)
+      {
+        const unsigned int i = owned.nth_index_in_set(k);
+        if (constraints.is_constrained(i))
+          {
+            inverse_lumped_mass_(i) = 0.;
+          }
+        else if (inverse_lumped_mass_(i) == 0.)
+          {
+            throw DOpEException("The lumped mass matrix is singular, an explicit scheme can not be used!",
+                                "InstatStepExplicitSolver::ComputeInverseLumpedMass");
+          }
+        else
+          {
+            inverse_lumped_mass_(i) = 1./inverse_lumped_mass_(i);
+          }
+      }
+    inverse_lumped_mass_.compress(VectorOperation::insert);
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  double InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::ExplicitStep(PROBLEM &pde, const VECTOR &old_residual, VECTOR &solution)
+  {
+    pde.SetStepPart(DOpEtypes::StepPart::new_part);
+    this->GetIntegrator().ComputeNonlinearLhs(pde,tmp_residual_);
+    tmp_residual_ += old_residual;
+    this->GetIntegrator().ComputeNonlinearRhs(pde,update_);
+    tmp_residual_ -= update_;
+
+    update_ = tmp_residual_;
+    update_.scale(inverse_lumped_mass_);
+    update_ *= -1.;
+    pde.GetDoFConstraints().distribute(update_);
+
+    solution += update_;
+    return update_.l2_norm();
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  bool InstatStepExplicitSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolve(PROBLEM &pde,
+                   const VECTOR &last_time_solution,
+                   VECTOR &solution,
+                   bool apply_boundary_values,
+                   bool /*force_matrix_build*/,
+                   int priority,
+                   std::string algo_level)
+  {
+    static_assert(internal::is_forward_euler_problem<PROBLEM>::value,
+                  "The InstatStepExplicitSolver can only be used with the ForwardEulerProblem");
+
+    VECTOR &residual = residual_;
+    std::stringstream out;
+    pde.GetOutputHandler()->InitNewtonOut(out);
+
+    DOpEHelper::reinit_work_vector(residual,solution);
+    DOpEHelper::reinit_work_vector(tmp_residual_,solution);
+    DOpEHelper::reinit_work_vector(update_,solution);
+
+    //Transfer from previous timestep
+    residual = solution;
+    solution = last_time_solution;
+
+    if (apply_boundary_values)
+      {
+        this->GetIntegrator().ApplyInitialBoundaryValues(pde,solution);
+      }
+
+    // First stage: forward euler step from the last time solution
+    this->GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
+    if (!pde.GetSpaceTimeHandler()->IsValidStateTicket(state_ticket_)
+        || inverse_lumped_mass_.size() != solution.size())
+      {
+        ComputeInverseLumpedMass(pde,solution);
+      }
+    this->GetIntegrator().AddDomainData("last_newton_solution",&solution);
+    double update = ExplicitStep(pde,residual,solution);
+    this->GetIntegrator().DeleteDomainData("last_newton_solution");
+    this->GetIntegrator().DeleteDomainData("last_time_solution");
+
+    if (n_stages_ == 2)
+      {
+        // Second stage: forward euler step from the first stage at the new time,
+        // combined with the last time solution
+        DOpEHelper::reinit_work_vector(stage_solution_,solution);
+        stage_solution_ = solution;
+
+        this->GetIntegrator().AddDomainData("last_time_solution",&stage_solution_);
+        this->GetIntegrator().AddDomainData("last_newton_solution",&stage_solution_);
+        pde.SetStepPart(DOpEtypes::StepPart::old_part);
+        this->GetIntegrator().ComputeNonlinearLhs(pde,residual);
+        this->GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual_);
+        residual -= tmp_residual_;
+        this->GetIntegrator().DeleteDomainData("last_newton_solution");
+
+        this->GetIntegrator().AddDomainData("last_newton_solution",&solution);
+        update = ExplicitStep(pde,residual,solution);
+        this->GetIntegrator().DeleteDomainData("last_newton_solution");
+        this->GetIntegrator().DeleteDomainData("last_time_solution");
+
+        solution.sadd(0.5,0.5,last_time_solution);
+        if (apply_boundary_values)
+          {
+            this->GetIntegrator().ApplyInitialBoundaryValues(pde,solution);
+          }
+      }
+
+    out<<algo_level<<"Explicit step: " <<n_stages_<<" stage(s)\t Update (abs.): "
+       <<pde.GetOutputHandler()->ZeroTolerance(update, 1.0);
+    pde.GetOutputHandler()->Write(out,priority);
+
+    return false;
+  }
+
+  /*******************************************************************************************/
+
+}
+#endif
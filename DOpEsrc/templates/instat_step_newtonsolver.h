@@ -33,8 +33,12 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <type_traits>
 
+#include <include/forcingterm.h>
+#include <include/helper.h>
 #include <include/parameterreader.h>
+#include <templates/timematrixcachingintegrator.h>
 
 
 
@@ -46,6 +50,11 @@ namespace DOpE
    * One-Step theta schemes. This class differ from the FractionalStepThetaStepNewtonSolver
    * since the time interval is not split up.
    *
+   * The solver can be used with distributed vectors, see DOpEHelper::is_distributed_vector.
+   * Then the vectors given to it are expected to have ghost entries, as they are
+   * the linearization points for the integrator, and the newton iteration itself
+   * is done on copies without ghost entries.
+   *
    * @tparam <INTEGRATOR>          Integration routines to compute domain-, face-, and right-hand side values.
    * @tparam <LINEARSOLVER>        A linear solver to solve the linear subproblems.
    * @tparam <VECTOR>              A template class for arbitrary vectors which are given to the
@@ -111,6 +120,16 @@ namespace DOpE
     bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
                         bool apply_boundary_values=true,
                         bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ");
+
+    /**
+     * Same as above, but the Newton iteration starts from initial_guess instead
+     * of last_time_solution, e.g., an extrapolation computed by a TimeStepPredictor.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution,
+                        const VECTOR &initial_guess, VECTOR &solution,
+                        bool apply_boundary_values=true,
+                        bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ");
     /******************************************************/
 
     /**
@@ -161,15 +180,73 @@ namespace DOpE
     template<typename PROBLEM>
     void NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &residual);
 
+    /**
+     * Returns how many work vectors of this class had to be reallocated during the last call
+     * of NonlinearSolve, NonlinearSolve_Initial, or NonlinearLastTimeEvals.
+     * As long as the size of the problem does not change this is expected to be zero.
+     */
+    unsigned int GetNWorkVectorReallocations() const;
+
   protected:
 
     inline INTEGRATOR &GetIntegrator();
 
   private:
+    /**
+     * Resets the work vector to the layout of solution without ghost entries,
+     * reallocating only if the size has changed.
+     */
+    inline void PrepareWorkVector(VECTOR &work, const VECTOR &solution);
+
+    /**
+     * Returns the vector the iteration can work on in place of v.
+     * For serial vectors this is v itself, for distributed vectors
+     * it is work, set to the locally owned entries of v.
+     */
+    VECTOR &GetOwned(VECTOR &work, VECTOR &v);
+    VECTOR &GetOwned(VECTOR &work, VECTOR &v, std::false_type);
+    VECTOR &GetOwned(VECTOR &work, VECTOR &v, std::true_type);
+
+    /**
+     * Copies owned, obtained from GetOwned, back to v if they are different vectors.
+     */
+    inline void UpdateFromOwned(const VECTOR &owned, VECTOR &v);
+
+    /**
+     * Writes v with the output handler of the pde. A distributed v has no
+     * ghost entries, it is written through the ghosted work vector.
+     */
+    template<typename PROBLEM>
+    void Write(PROBLEM &pde, const VECTOR &v, std::string name);
+    template<typename PROBLEM>
+    void Write(PROBLEM &pde, const VECTOR &v, std::string name, std::false_type);
+    template<typename PROBLEM>
+    void Write(PROBLEM &pde, const VECTOR &v, std::string name, std::true_type);
+
     INTEGRATOR &integrator_;
 
+    /**
+     * Is given to the linear solvers in the time steps to keep
+     * a constant time matrix, see PDEInterface::HasConstantTimeMatrix.
+     */
+    TimeMatrixCachingIntegrator<INTEGRATOR> matrix_integrator_;
+
     bool build_matrix_ = false;
 
+    /**
+     * Work vectors used in the nonlinear solves. They are kept between the calls
+     * to avoid the reallocation in each time step, and reset in ReInit.
+     * u_ and ghosted_ are only used for distributed vectors.
+     */
+    VECTOR residual_, time_residual_, tmp_residual_, du_, u_, ghosted_;
+    unsigned int n_work_vector_reallocations_ = 0;
+
+    /**
+     * Computes the relative tolerances of the linear solves
+     * if an inexact Newton method is selected.
+     */
+    ForcingTerm forcing_;
+
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
     int nonlinear_maxiter_, line_maxiter_;
@@ -190,6 +267,7 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    ForcingTerm::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -198,7 +276,8 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::InstatStepNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), matrix_integrator_(integrator),
+      forcing_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -208,6 +287,7 @@ namespace DOpE
 
     line_maxiter_   = param_reader.get_integer ("line_maxiter");
     linesearch_rho_ = param_reader.get_double ("linesearch_rho");
+    forcing_.CheckLinearSolver<LINEARSOLVER>();
   }
 
   /*******************************************************************************************/
@@ -225,6 +305,13 @@ namespace DOpE
   ::ReInit(PROBLEM &pde)
   {
     LINEARSOLVER::ReInit(pde);
+    matrix_integrator_.ReInit();
+    VECTOR().swap(residual_);
+    VECTOR().swap(time_residual_);
+    VECTOR().swap(tmp_residual_);
+    VECTOR().swap(du_);
+    VECTOR().swap(u_);
+    VECTOR().swap(ghosted_);
   }
 
   /*******************************************************************************************/
@@ -233,20 +320,23 @@ namespace DOpE
   void InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &residual)
   {
-    VECTOR tmp_residual;
-    tmp_residual.reinit(residual);
-    residual =0.;
+    VECTOR &tmp_residual = tmp_residual_;
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(tmp_residual,residual);
+    // A distributed residual is assembled into an owned copy.
+    VECTOR &owned_residual = GetOwned(residual_,residual);
+    owned_residual =0.;
     GetIntegrator().AddDomainData("last_newton_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
-    pde.SetStepPart("Old");
-    GetIntegrator().ComputeNonlinearLhs(pde,residual);
+    pde.SetStepPart(DOpEtypes::StepPart::old_part);
+    GetIntegrator().ComputeNonlinearLhs(pde,owned_residual);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
-    residual += tmp_residual;
+    owned_residual += tmp_residual;
 
     GetIntegrator().DeleteDomainData("last_newton_solution");
     GetIntegrator().DeleteDomainData("last_time_solution");
-
+    UpdateFromOwned(owned_residual,residual);
   }
   /*******************************************************************************************/
 
@@ -257,18 +347,22 @@ namespace DOpE
                            bool force_matrix_build, int priority, std::string algo_level)
   {
     bool build_matrix = force_matrix_build;
-    VECTOR residual;
-    VECTOR du;
+    VECTOR &residual = residual_;
+    VECTOR &du = du_;
     std::stringstream out;
     pde.GetOutputHandler()->InitNewtonOut(out);
 
-    du.reinit(solution);
-    residual.reinit(solution);
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(du,solution);
+    PrepareWorkVector(residual,solution);
+    // The iterate, solution itself is only updated as the linearization point.
+    VECTOR &u = GetOwned(u_,solution);
 
     if (apply_boundary_values)
       {
-        GetIntegrator().ApplyInitialBoundaryValues(pde,solution);
+        GetIntegrator().ApplyInitialBoundaryValues(pde,u);
       }
+    UpdateFromOwned(u,solution);
 
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
 
@@ -276,11 +370,15 @@ namespace DOpE
     residual *= -1.;
 
     pde.GetOutputHandler()->SetIterationNumber(0,"PDENewton");
-    pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+    Write(pde,residual,"Residual"+pde.GetType());
 
     double res = residual.linfty_norm();
     double firstres = res;
     double lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
 
 
     out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
@@ -306,17 +404,24 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply<LINEARSOLVER>(*this);
+          }
         LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
         bool was_build = build_matrix;
 
         //Linesearch
         {
-          solution += du;
+          u += du;
+          UpdateFromOwned(u,solution);
           GetIntegrator().ComputeNonlinearResidual(pde,residual);
           residual *= -1.;
 
-          pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
-          pde.GetOutputHandler()->Write(du,"Update"+pde.GetType(),pde.GetDoFType());
+          Write(pde,residual,"Residual"+pde.GetType());
+          Write(pde,du,"Update"+pde.GetType());
 
           res = residual.linfty_norm();
           int lineiter=0;
@@ -326,7 +431,8 @@ namespace DOpE
             {
               build_matrix = true;
               // Reuse of Matrix seems to be a bad idea, rebuild and repeat
-              solution -= du;
+              u -= du;
+              UpdateFromOwned(u,solution);
               GetIntegrator().ComputeNonlinearResidual(pde,residual);
               residual *= -1.;
               out << algo_level
@@ -355,12 +461,13 @@ namespace DOpE
                       GetIntegrator().DeleteAllData();
                       throw DOpEIterationException("Line-Iteration count exceeded bounds!","InstatStepNewtonSolver::NonlinearSolve_Initial");
                     }
-                  solution.add(alpha*(rho-1.),du);
+                  u.add(alpha*(rho-1.),du);
                   alpha*= rho;
+                  UpdateFromOwned(u,solution);
 
                   GetIntegrator().ComputeNonlinearResidual(pde,residual);
                   residual *= -1.;
-                  pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+                  Write(pde,residual,"Residual"+pde.GetType());
 
                   res = residual.linfty_norm();
 
@@ -370,6 +477,10 @@ namespace DOpE
                   build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update<LINEARSOLVER>(residual.l2_norm(),*this);
+                }
 
               out << algo_level
                   << "Newton step: "
@@ -388,6 +499,11 @@ namespace DOpE
       }
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
+    if (forcing_.IsActive())
+      {
+        forcing_.Release<LINEARSOLVER>(*this);
+      }
+
     return build_matrix;
   }
 
@@ -403,10 +519,30 @@ namespace DOpE
                    int priority,
                    std::string algo_level)
   {
+    return NonlinearSolve(pde, last_time_solution, last_time_solution, solution,
+                          apply_boundary_values, force_matrix_build, priority, algo_level);
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  bool InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolve(PROBLEM &pde,
+                   const VECTOR &last_time_solution,
+                   const VECTOR &initial_guess,
+                   VECTOR &solution,
+                   bool apply_boundary_values,
+                   bool force_matrix_build,
+                   int priority,
+                   std::string algo_level)
+  {
 
     bool build_matrix = force_matrix_build;
-    VECTOR residual, time_residual, tmp_residual;
-    VECTOR du;
+    VECTOR &residual = residual_;
+    VECTOR &time_residual = time_residual_;
+    VECTOR &tmp_residual = tmp_residual_;
+    VECTOR &du = du_;
     std::stringstream out;
     pde.GetOutputHandler()->InitNewtonOut(out);
 
@@ -414,25 +550,29 @@ namespace DOpE
     double firstres = 0.0;
     double lastres = 0.0;
 
-    du.reinit(solution);
-    residual.reinit(solution);
-    time_residual.reinit(solution);
-    tmp_residual.reinit(solution);
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(du,solution);
+    PrepareWorkVector(residual,solution);
+    PrepareWorkVector(time_residual,solution);
+    PrepareWorkVector(tmp_residual,solution);
 
     //Transfer from previous timestep
     residual =solution;
-    // last_time_solution is very good starting value?
-    solution = last_time_solution;
+    // The iterate, solution itself is only updated as the linearization point.
+    VECTOR &u = GetOwned(u_,solution);
+    // last_time_solution is very good starting value, unless a better guess is given
+    u = initial_guess;
 
     if (apply_boundary_values)
       {
-        GetIntegrator().ApplyInitialBoundaryValues(pde,solution);
+        GetIntegrator().ApplyInitialBoundaryValues(pde,u);
       }
+    UpdateFromOwned(u,solution);
 
     // Righthandside for the current timestep f^{n+1}
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
-    pde.SetStepPart("New");
+    pde.SetStepPart(DOpEtypes::StepPart::new_part);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
     residual += tmp_residual;
@@ -448,13 +588,17 @@ namespace DOpE
     residual *=-1.; // due to A(U)(\psi) = - A(U)(du,\psi)
 
     pde.GetOutputHandler()->SetIterationNumber(0,"PDENewton");
-    pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+    Write(pde,residual,"Residual"+pde.GetType());
     //Write out initial solution after applying boundary values as 'Update' in iteration 0
     pde.GetOutputHandler()->Write(solution,"Update"+pde.GetType(),pde.GetDoFType());
 
     res = residual.linfty_norm();
     firstres = res;
     lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
     int iter=0;
 
     out<<algo_level<<"Newton step: " <<0<<"\t Residual (abs.): "
@@ -476,16 +620,23 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply<LINEARSOLVER>(*this);
+          }
+        LINEARSOLVER::Solve(pde,matrix_integrator_,residual,du,build_matrix);
         bool was_build = build_matrix;
         //Linesearch
         {
-          solution += du;
+          u += du;
+          UpdateFromOwned(u,solution);
           GetIntegrator().ComputeNonlinearLhs(pde,residual);
           residual -= time_residual;
           residual *= -1.;
-          pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
-          pde.GetOutputHandler()->Write(du,"Update"+pde.GetType(),pde.GetDoFType());
+          Write(pde,residual,"Residual"+pde.GetType());
+          Write(pde,du,"Update"+pde.GetType());
 
           res = residual.linfty_norm();
           int lineiter=0;
@@ -495,7 +646,8 @@ namespace DOpE
             {
               build_matrix = true;
               // Reuse of Matrix seems to be a bad idea, rebuild and repeat
-              solution -= du;
+              u -= du;
+              UpdateFromOwned(u,solution);
               GetIntegrator().ComputeNonlinearLhs(pde,residual);
               residual -= time_residual;
               residual *= -1.;
@@ -522,13 +674,14 @@ namespace DOpE
                       GetIntegrator().DeleteAllData();
                       throw DOpEIterationException("Line-Iteration count exceeded bounds!","StatSolver::NonlinearSolve");
                     }
-                  solution.add(alpha*(rho-1.),du);
+                  u.add(alpha*(rho-1.),du);
                   alpha*= rho;
+                  UpdateFromOwned(u,solution);
 
                   GetIntegrator().ComputeNonlinearLhs(pde,residual);
                   residual -= time_residual;
                   residual *= -1.;
-                  pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+                  Write(pde,residual,"Residual"+pde.GetType());
 
                   res = residual.linfty_norm();
 
@@ -538,6 +691,10 @@ namespace DOpE
                   build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update<LINEARSOLVER>(residual.l2_norm(),*this);
+                }
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
                  << pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
@@ -553,9 +710,100 @@ namespace DOpE
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
 
+    if (forcing_.IsActive())
+      {
+        forcing_.Release<LINEARSOLVER>(*this);
+      }
+
     return build_matrix;
   }
 
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::PrepareWorkVector(VECTOR &work, const VECTOR &solution)
+  {
+    const bool reallocated = DOpEHelper::reinit_work_vector(work,solution);
+    if (reallocated)
+      n_work_vector_reallocations_++;
+    DOpEHelper::make_distributed(work);
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  VECTOR &InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetOwned(VECTOR &work, VECTOR &v)
+  {
+    return GetOwned(work,v,DOpEHelper::is_distributed_vector<VECTOR>());
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  VECTOR &InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetOwned(VECTOR &/*work*/, VECTOR &v, std::false_type)
+  {
+    return v;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  VECTOR &InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetOwned(VECTOR &work, VECTOR &v, std::true_type)
+  {
+    PrepareWorkVector(work,v);
+    work = v;
+    // ghosted_ keeps the layout of v for the output of owned vectors.
+    const bool reallocated = DOpEHelper::reinit_work_vector(ghosted_,v);
+    if (reallocated)
+      n_work_vector_reallocations_++;
+    return work;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::UpdateFromOwned(const VECTOR &owned, VECTOR &v)
+  {
+    if (&owned != &v)
+      v = owned;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::Write(PROBLEM &pde, const VECTOR &v, std::string name)
+  {
+    Write(pde,v,name,DOpEHelper::is_distributed_vector<VECTOR>());
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::Write(PROBLEM &pde, const VECTOR &v, std::string name, std::false_type)
+  {
+    pde.GetOutputHandler()->Write(v,name,pde.GetDoFType());
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::Write(PROBLEM &pde, const VECTOR &v, std::string name, std::true_type)
+  {
+    ghosted_ = v;
+    pde.GetOutputHandler()->Write(ghosted_,name,pde.GetDoFType());
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  unsigned int InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetNWorkVectorReallocations() const
+  {
+    return n_work_vector_reallocations_;
+  }
+
   /*******************************************************************************************/
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   INTEGRATOR &InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
@@ -31,6 +31,7 @@
 #include <deal.II/numerics/matrix_tools.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <functional>
 #include <vector>
 
 #include <basic/dopetypes.h>
@@ -38,6 +39,7 @@
 #include <container/elementdatacontainer.h>
 #include <container/facedatacontainer.h>
 #include <container/residualestimator.h>
+#include <include/matrixscatterplan.h>
 
 namespace DOpE
 {
@@ -136,6 +138,27 @@ namespace DOpE
      */
     template <typename PROBLEM>
     void ComputeNonlinearRhs(PROBLEM &pde, VECTOR &residual);
+    /**
+     * This method evaluates several right hand sides of the same equation in
+     * one sweep over the mesh, e.g., for different load cases. Element and face
+     * data are computed once per element (face) and shared by all right hand
+     * sides. Before the terms of the k-th right hand side are evaluated,
+     * select_rhs(k) is called, which should switch the problem, e.g., the
+     * LocalPDE, to the k-th case.
+     *
+     * It assumes the same methods of the PROBLEM as ComputeNonlinearRhs.
+     *
+     * @tparam <PROBLEM>                The problem description
+     *
+     * @param pde                       The object containing the description of
+     * the nonlinear pde.
+     * @param rhs                       A vector of vectors, one for each right
+     * hand side. They need to be initialized with the correct size.
+     * @param select_rhs                Selects the right hand side to evaluate.
+     */
+    template <typename PROBLEM>
+    void ComputeNonlinearRhs(PROBLEM &pde, std::vector<VECTOR> &rhs,
+                             const std::function<void(unsigned int)> &select_rhs);
     /**
      * This method is used to calculate the matrix corresponding to the linearized
      * equation.
@@ -268,6 +291,36 @@ namespace DOpE
      * @return                          The value of the functional
      */
     template <typename PROBLEM> SCALAR ComputeAlgebraicScalar(PROBLEM &pde);
+    /**
+     * This method evaluates several functionals at once. The domain,
+     * boundary and face parts of all functionals are computed in a
+     * single loop over the elements, i.e., each element and face is
+     * initialized only once. Point and algebraic parts are added
+     * afterwards.
+     *
+     * The type of each functional is determined by its GetFunctionalType
+     * as in the methods Compute*Scalar. The functionals are selected
+     * only once each, before the loop. Inside the loop the domain,
+     * boundary and face values are taken directly from the auxiliary
+     * functionals of the problem, see GetAuxFunctional.
+     *
+     * @tparam <PROBLEM>                The problem description
+     * @tparam <SELECTOR>               A callable taking an unsigned int.
+     *
+     * @param pde                       The object containing the description of
+     * the functionals.
+     * @param functionals               The numbers of the auxiliary functionals
+     *                                  to be evaluated.
+     * @param select                    select(functionals[i]) has to set pde such
+     *                                  that it evaluates the i-th functional, e.g.,
+     *                                  by calling SetType("aux_functional",functionals[i]).
+     * @param values                    Upon exit, values[i] is the value of
+     *                                  the functional functionals[i].
+     */
+    template <typename PROBLEM, typename SELECTOR>
+    void ComputeScalars(PROBLEM &pde,
+                        const std::vector<unsigned int> &functionals,
+                        const SELECTOR &select, std::vector<SCALAR> &values);
 
     /**
      * This method applies inhomogeneous dirichlet boundary values.
@@ -329,6 +382,17 @@ namespace DOpE
      *                     the integrator.
      */
     inline void DeleteDomainData(std::string name);
+    /**
+     * This function grants access to previously added domain data.
+     *
+     * Requesting data that is not present in the integrator will
+     * cause an exception.
+     *
+     * @param name         The identifier of the requested data.
+     *
+     * @return A pointer to the data.
+     */
+    inline const VECTOR *GetDomainData(std::string name) const;
     /**
      * This function can be used to pass parameter data, i.e., data independent
      * of the spatial position, to the problem.
@@ -430,6 +494,14 @@ namespace DOpE
     inline void AddPresetRightHandSide(double s, VECTOR &residual) const;
 
   private:
+    /**
+     * Evaluates the right hand sides for both public versions of
+     * ComputeNonlinearRhs. If select_rhs is empty, it is not called,
+     * which is used for a single right hand side.
+     */
+    template <typename PROBLEM>
+    void ComputeNonlinearRhs(PROBLEM &pde, const std::vector<VECTOR *> &rhs,
+                             const std::function<void(unsigned int)> &select_rhs);
 #if DEAL_II_VERSION_GTE(9,3,0)
     template <bool DH>
 #else
@@ -447,6 +519,34 @@ namespace DOpE
                               std::map<unsigned int, SCALAR> &boundary_values,
                               const std::vector<bool> &comp_mask) const;
 
+    /**
+     * Decides for PDEs with HasTwoSidedInterfaces() if the interface
+     * behind the given face of the element is integrated from this element.
+     * Each interior face is integrated once: from the finer element if the
+     * neighbor is coarser, otherwise from the element with the smaller CellId.
+     * If the neighbor is not locally owned, both processes integrate the face
+     * and keep only the contributions to their own element.
+     *
+     * Must not be called if the neighbor has children.
+     */
+    template <typename ELEMENTITERATOR>
+    static bool IntegrateInterfaceHere(const ELEMENTITERATOR &element,
+                                       unsigned int face);
+
+    /**
+     * Computes the two-sided interface matrices on the face for which fdc
+     * has been initialized, adds the element - element part to local_matrix
+     * and the couplings with the neighbor to the global matrix. The rows of
+     * the neighbor are only assembled if it is locally owned.
+     */
+    template <typename PROBLEM, typename MATRIX, typename FDC,
+              typename ELEMENTITERATOR, typename NEIGHBORITERATOR>
+    void AssembleTwoSidedInterfaceMatrix(PROBLEM &pde, const FDC &fdc,
+                                         const ELEMENTITERATOR &element,
+                                         const NEIGHBORITERATOR &neighbor,
+                                         dealii::FullMatrix<SCALAR> &local_matrix,
+                                         MATRIX &matrix) const;
+
     //        /**
     //         * Given a vector of active element iterators and a facenumber,
     //         checks if the face
@@ -476,6 +576,8 @@ namespace DOpE
 
     std::map<std::string, const VECTOR *> domain_data_;
     std::map<std::string, const dealii::Vector<SCALAR> *> param_data_;
+
+    MatrixScatterPlans scatter_plans_;
   };
 
   /**********************************Implementation*******************************************/
@@ -502,7 +604,65 @@ namespace DOpE
 
   template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
             int dim>
-  void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ReInit() {}
+  void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ReInit()
+  {
+    scatter_plans_.Clear();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+            int dim>
+  template <typename ELEMENTITERATOR>
+  bool Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::IntegrateInterfaceHere(
+    const ELEMENTITERATOR &element, unsigned int face)
+  {
+    const auto neighbor = element[0]->neighbor(face);
+    if (!neighbor->is_locally_owned())
+      return true;
+    if (element[0]->neighbor_is_coarser(face))
+      return true;
+    return element[0]->id() < neighbor->id();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+            int dim>
+  template <typename PROBLEM, typename MATRIX, typename FDC,
+            typename ELEMENTITERATOR, typename NEIGHBORITERATOR>
+  void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::AssembleTwoSidedInterfaceMatrix(
+    PROBLEM &pde, const FDC &fdc, const ELEMENTITERATOR &element,
+    const NEIGHBORITERATOR &neighbor, dealii::FullMatrix<SCALAR> &local_matrix,
+    MATRIX &matrix) const
+  {
+    const unsigned int dofs_per_element = fdc.GetNDoFsPerElement();
+    const unsigned int nbr_dofs_per_element = fdc.GetNbrNDoFsPerElement();
+    dealii::FullMatrix<SCALAR> element_nbr_matrix(dofs_per_element,
+                                                  nbr_dofs_per_element);
+    dealii::FullMatrix<SCALAR> nbr_element_matrix(nbr_dofs_per_element,
+                                                  dofs_per_element);
+    dealii::FullMatrix<SCALAR> nbr_matrix(nbr_dofs_per_element,
+                                          nbr_dofs_per_element);
+
+    pde.InterfaceMatrixTwoSided(fdc, local_matrix, element_nbr_matrix,
+                                nbr_element_matrix, nbr_matrix);
+
+    std::vector<unsigned int> local_dof_indices(dofs_per_element, 0);
+    std::vector<unsigned int> nbr_local_dof_indices(nbr_dofs_per_element, 0);
+    element[0]->get_dof_indices(local_dof_indices);
+    neighbor->get_dof_indices(nbr_local_dof_indices);
+
+    const auto &C = pde.GetDoFConstraints();
+    C.distribute_local_to_global(element_nbr_matrix, local_dof_indices,
+                                 nbr_local_dof_indices, matrix);
+    if (neighbor->is_locally_owned())
+      {
+        C.distribute_local_to_global(nbr_element_matrix, nbr_local_dof_indices,
+                                     local_dof_indices, matrix);
+        C.distribute_local_to_global(nbr_matrix, nbr_local_dof_indices, matrix);
+      }
+  }
 
   /*******************************************************************************************/
 
@@ -534,6 +694,10 @@ namespace DOpE
 
     bool need_faces = pde.HasFaces();
     bool need_interfaces = pde.HasInterfaces();
+    // Interfaces given by two-sided terms are visited only once.
+    const bool two_sided_interfaces = need_interfaces && pde.HasTwoSidedInterfaces();
+    dealii::Vector<SCALAR> nbr_local_vector;
+    std::vector<unsigned int> nbr_local_dof_indices;
     std::vector<unsigned int> boundary_equation_colors =
       pde.GetBoundaryEquationColors();
     bool need_boundary_integrals = (boundary_equation_colors.size() > 0);
@@ -619,7 +783,58 @@ namespace DOpE
                     // auto face_it = element[0]->face(face);
                     // first, check if we are at an interface, i.e. not the neighbour
                     // exists and it has a different material_id than the actual element
-                    if (pde.AtInterface(element, face))
+                    if (two_sided_interfaces && pde.AtInterface(element, face))
+                      {
+                        if (element[0]->neighbor(face)->has_children())
+                          {
+                            // The face is integrated from the finer neighbors,
+                            // unless they belong to another process.
+                            for (unsigned int subface_no = 0;
+                                 subface_no < element[0]->face(face)->n_children();
+                                 ++subface_no)
+                              {
+                                fdc.ReInit(face, subface_no);
+                                if (!element[0]->neighbor_child_on_subface(face, subface_no)->is_locally_owned())
+                                  {
+                                    fdc.ReInitNbr();
+                                    nbr_local_vector.reinit(fdc.GetNbrNDoFsPerElement());
+                                    pde.InterfaceEquationTwoSided(fdc, local_vector, nbr_local_vector, 1., 1.);
+                                  }
+                                if (need_faces)
+                                  {
+                                    pde.FaceRhs(fdc, local_vector, -1.);
+                                  }
+                              }
+                          }
+                        else if (IntegrateInterfaceHere(element, face))
+                          {
+                            fdc.ReInit(face);
+                            fdc.ReInitNbr();
+                            nbr_local_vector.reinit(fdc.GetNbrNDoFsPerElement());
+                            pde.InterfaceEquationTwoSided(fdc, local_vector, nbr_local_vector, 1., 1.);
+                            if (need_faces)
+                              {
+                                pde.FaceRhs(fdc, local_vector, -1.);
+                              }
+                            const auto neighbor = element[0]->neighbor(face);
+                            if (neighbor->is_locally_owned())
+                              {
+                                nbr_local_dof_indices.resize(0);
+                                nbr_local_dof_indices.resize(nbr_local_vector.size(), 0);
+                                neighbor->get_dof_indices(nbr_local_dof_indices);
+                                const auto &C = pde.GetDoFConstraints();
+                                C.distribute_local_to_global(nbr_local_vector, nbr_local_dof_indices,
+                                                             residual);
+                              }
+                          }
+                        else if (need_faces)
+                          {
+                            // Integrated from the other side, only the face rhs remains.
+                            fdc.ReInit(face);
+                            pde.FaceRhs(fdc, local_vector, -1.);
+                          }
+                      }
+                    else if (pde.AtInterface(element, face))
                       {
                         // There exist now 3 different scenarios, given the actual element
                         // and face:
@@ -695,6 +910,7 @@ namespace DOpE
       {
         VECTOR point_rhs;
         point_rhs.reinit(residual);
+        pde.GetBaseProblem().GetSpaceTimeHandler()->PreparePointEvaluation();
         pde.PointRhs(this->GetParamData(), this->GetDomainData(), point_rhs, -1.);
         residual += point_rhs;
       }
@@ -733,6 +949,10 @@ namespace DOpE
 
     bool need_faces = pde.HasFaces();
     bool need_interfaces = pde.HasInterfaces();
+    // Interfaces given by two-sided terms are visited only once.
+    const bool two_sided_interfaces = need_interfaces && pde.HasTwoSidedInterfaces();
+    dealii::Vector<SCALAR> nbr_local_vector;
+    std::vector<unsigned int> nbr_local_dof_indices;
     std::vector<unsigned int> boundary_equation_colors =
       pde.GetBoundaryEquationColors();
     bool need_boundary_integrals = (boundary_equation_colors.size() > 0);
@@ -814,7 +1034,44 @@ namespace DOpE
                     // auto face_it = element[0]->face(face);
                     // first, check if we are at an interface, i.e. not the neighbour
                     // exists and it has a different material_id than the actual element
-                    if (pde.AtInterface(element, face))
+                    if (two_sided_interfaces && pde.AtInterface(element, face))
+                      {
+                        if (element[0]->neighbor(face)->has_children())
+                          {
+                            // The face is integrated from the finer neighbors,
+                            // unless they belong to another process.
+                            for (unsigned int subface_no = 0;
+                                 subface_no < element[0]->face(face)->n_children();
+                                 ++subface_no)
+                              {
+                                if (!element[0]->neighbor_child_on_subface(face, subface_no)->is_locally_owned())
+                                  {
+                                    fdc.ReInit(face, subface_no);
+                                    fdc.ReInitNbr();
+                                    nbr_local_vector.reinit(fdc.GetNbrNDoFsPerElement());
+                                    pde.InterfaceEquationTwoSided(fdc, local_vector, nbr_local_vector, 1., 1.);
+                                  }
+                              }
+                          }
+                        else if (IntegrateInterfaceHere(element, face))
+                          {
+                            fdc.ReInit(face);
+                            fdc.ReInitNbr();
+                            nbr_local_vector.reinit(fdc.GetNbrNDoFsPerElement());
+                            pde.InterfaceEquationTwoSided(fdc, local_vector, nbr_local_vector, 1., 1.);
+                            const auto neighbor = element[0]->neighbor(face);
+                            if (neighbor->is_locally_owned())
+                              {
+                                nbr_local_dof_indices.resize(0);
+                                nbr_local_dof_indices.resize(nbr_local_vector.size(), 0);
+                                neighbor->get_dof_indices(nbr_local_dof_indices);
+                                const auto &C = pde.GetDoFConstraints();
+                                C.distribute_local_to_global(nbr_local_vector, nbr_local_dof_indices,
+                                                             residual);
+                              }
+                          }
+                      }
+                    else if (pde.AtInterface(element, face))
                       {
                         // There exist now 3 different scenarios, given the actual element
                         // and face:
@@ -890,10 +1147,46 @@ namespace DOpE
   void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeNonlinearRhs(
     PROBLEM &pde, VECTOR &residual)
   {
-    residual = 0.;
+    ComputeNonlinearRhs(pde, std::vector<VECTOR *>(1, &residual),
+                        std::function<void(unsigned int)>());
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+            int dim>
+  template <typename PROBLEM>
+  void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeNonlinearRhs(
+    PROBLEM &pde, std::vector<VECTOR> &rhs,
+    const std::function<void(unsigned int)> &select_rhs)
+  {
+    std::vector<VECTOR *> rhs_ptr(rhs.size());
+    for (unsigned int k = 0; k < rhs.size(); k++)
+      rhs_ptr[k] = &rhs[k];
+    ComputeNonlinearRhs(pde, rhs_ptr, select_rhs);
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+            int dim>
+  template <typename PROBLEM>
+  void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeNonlinearRhs(
+    PROBLEM &pde, const std::vector<VECTOR *> &rhs,
+    const std::function<void(unsigned int)> &select_rhs)
+  {
+    const unsigned int n_rhs = rhs.size();
+    for (unsigned int k = 0; k < n_rhs; k++)
+      *rhs[k] = 0.;
+    //A single right hand side needs no selection
+    auto select = [&select_rhs](unsigned int k)
+    {
+      if (select_rhs)
+        select_rhs(k);
+    };
     // Begin integration
     unsigned int dofs_per_element;
-    dealii::Vector<SCALAR> local_vector;
+    std::vector<dealii::Vector<SCALAR> > local_vectors(n_rhs);
     std::vector<unsigned int> local_dof_indices;
 
     const bool need_point_rhs = pde.HasPoints();
@@ -910,14 +1203,6 @@ namespace DOpE
       element, this->GetParamData(), this->GetDomainData(), pde.HasVertices());
     auto &edc = GetIntegratorDataContainer().GetElementDataContainer();
 
-    //       We don't have interface terms in the Rhs! They are all to be
-    //       included in the Equation!
-    //        bool need_interfaces = pde.HasInterfaces();
-    //        if(need_interfaces )
-    //        {
-    //          throw DOpEException(" Interfaces not implemented yet!",
-    //              "Integrator::ComputeNonlinearRhs");
-    //        }
     bool need_faces = pde.HasFaces();
     bool need_interfaces = pde.HasInterfaces();
     std::vector<unsigned int> boundary_equation_colors =
@@ -945,12 +1230,14 @@ namespace DOpE
             edc.ReInit();
             dofs_per_element = element[0]->get_fe().dofs_per_cell;
 
-            local_vector.reinit(dofs_per_element);
-            local_vector = 0;
-
             local_dof_indices.resize(0);
             local_dof_indices.resize(dofs_per_element, 0);
-            pde.ElementRhs(edc, local_vector, 1.);
+            for (unsigned int k = 0; k < n_rhs; k++)
+              {
+                local_vectors[k].reinit(dofs_per_element);
+                select(k);
+                pde.ElementRhs(edc, local_vectors[k], 1.);
+              }
 
             if (need_boundary_integrals)
               {
@@ -972,7 +1259,11 @@ namespace DOpE
 #endif
                       {
                         fdc.ReInit(face);
-                        pde.BoundaryRhs(fdc, local_vector, 1.);
+                        for (unsigned int k = 0; k < n_rhs; k++)
+                          {
+                            select(k);
+                            pde.BoundaryRhs(fdc, local_vectors[k], 1.);
+                          }
                       }
                   }
               }
@@ -984,14 +1275,19 @@ namespace DOpE
                     if (element[0]->neighbor_index(face) != -1)
                       {
                         fdc.ReInit(face);
-                        pde.FaceRhs(fdc, local_vector);
+                        for (unsigned int k = 0; k < n_rhs; k++)
+                          {
+                            select(k);
+                            pde.FaceRhs(fdc, local_vectors[k]);
+                          }
                       }
                   }
               }
             // LocalToGlobal
             const auto &C = pde.GetDoFConstraints();
             element[0]->get_dof_indices(local_dof_indices);
-            C.distribute_local_to_global(local_vector, local_dof_indices, residual);
+            for (unsigned int k = 0; k < n_rhs; k++)
+              C.distribute_local_to_global(local_vectors[k], local_dof_indices, *rhs[k]);
           } // endif locally owned
 
         for (unsigned int dh = 1; dh < dof_handler.size(); dh++)
@@ -1000,18 +1296,23 @@ namespace DOpE
           }
       } // endfor element
 
-    residual.compress(VectorOperation::add);
-
-    // check if we need the evaluation of PointRhs
-    if (need_point_rhs)
+    VECTOR point_rhs;
+    for (unsigned int k = 0; k < n_rhs; k++)
       {
-        VECTOR point_rhs;
-        point_rhs.reinit(residual);
-        pde.PointRhs(this->GetParamData(), this->GetDomainData(), point_rhs, 1.);
-        residual += point_rhs;
+        rhs[k]->compress(VectorOperation::add);
+
+        // check if we need the evaluation of PointRhs
+        if (need_point_rhs)
+          {
+            select(k);
+            point_rhs.reinit(*rhs[k]);
+            pde.GetBaseProblem().GetSpaceTimeHandler()->PreparePointEvaluation();
+            pde.PointRhs(this->GetParamData(), this->GetDomainData(), point_rhs, 1.);
+            *rhs[k] += point_rhs;
+          }
+        // Check if some preset righthandside exists.
+        AddPresetRightHandSide(1., *rhs[k]);
       }
-    // Check if some preset righthandside exists.
-    AddPresetRightHandSide(1., residual);
   }
 
   /*******************************************************************************************/
@@ -1022,7 +1323,6 @@ namespace DOpE
   void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeMatrix(
     PROBLEM &pde, MATRIX &matrix)
   {
-    matrix = 0.;
     // Begin integration
     unsigned int dofs_per_element;
     std::vector<unsigned int> local_dof_indices;
@@ -1044,6 +1344,8 @@ namespace DOpE
 
     bool need_faces = pde.HasFaces();
     bool need_interfaces = pde.HasInterfaces();
+    // Interfaces given by two-sided terms are visited only once.
+    const bool two_sided_interfaces = need_interfaces && pde.HasTwoSidedInterfaces();
     std::vector<unsigned int> boundary_equation_colors =
       pde.GetBoundaryEquationColors();
     bool need_boundary_integrals = (boundary_equation_colors.size() > 0);
@@ -1053,7 +1355,29 @@ namespace DOpE
       element, this->GetParamData(), this->GetDomainData(), need_interfaces);
     auto &fdc = GetIntegratorDataContainer().GetFaceDataContainer();
 
-    for (; element[0] != endc[0]; element[0]++)
+    // The DoF indices of the elements are only computed if the mesh
+    // or the constraints have changed since the last assembly.
+    MatrixScatterPlan &scatter_plan =
+      scatter_plans_.GetPlan(dof_handler[0], pde.GetDoFConstraints());
+    const bool use_scatter_plan = scatter_plan.Prepare(
+                                    *(pde.GetBaseProblem().GetSpaceTimeHandler()), dof_handler[0],
+                                    pde.GetDoFConstraints());
+    // If the elements of the plan write all entries of the matrix, the first
+    // write to each entry overwrites it and the matrix needs not to be zeroed.
+    // Interface terms are written by other elements, hence they exclude this.
+    const bool overwrite = use_scatter_plan
+                           && scatter_plan.PreparePositions(matrix, !need_interfaces);
+    if (!overwrite)
+      {
+        matrix = 0.;
+      }
+    // The local matrices are reused for all elements, reinit only
+    // reallocates if the number of DoFs grows.
+    dealii::FullMatrix<SCALAR> local_matrix;
+    dealii::FullMatrix<SCALAR> local_interface_matrix;
+    unsigned int element_number = 0;
+
+    for (; element[0] != endc[0]; element[0]++, element_number++)
       {
         for (unsigned int dh = 1; dh < dof_handler.size(); dh++)
           {
@@ -1069,9 +1393,7 @@ namespace DOpE
             edc.ReInit();
             dofs_per_element = element[0]->get_fe().dofs_per_cell;
 
-            dealii::FullMatrix<SCALAR> local_matrix(dofs_per_element,
-                                                    dofs_per_element);
-            local_matrix = 0;
+            local_matrix.reinit(dofs_per_element, dofs_per_element);
 
             local_dof_indices.resize(0);
             local_dof_indices.resize(dofs_per_element, 0);
@@ -1123,7 +1445,37 @@ namespace DOpE
                     // first, check if we are at an interface, i.e. not the neighbour
                     // exists and it has a different material_id than the actual
                     // element
-                    if (pde.AtInterface(element, face))
+                    if (two_sided_interfaces && pde.AtInterface(element, face))
+                      {
+                        if (element[0]->neighbor(face)->has_children())
+                          {
+                            // The face is integrated from the finer neighbors,
+                            // unless they belong to another process.
+                            for (unsigned int subface_no = 0;
+                                 subface_no < element[0]->face(face)->n_children();
+                                 ++subface_no)
+                              {
+                                const auto neighbor =
+                                  element[0]->neighbor_child_on_subface(face, subface_no);
+                                if (!neighbor->is_locally_owned())
+                                  {
+                                    fdc.ReInit(face, subface_no);
+                                    fdc.ReInitNbr();
+                                    AssembleTwoSidedInterfaceMatrix(pde, fdc, element, neighbor,
+                                                                    local_matrix, matrix);
+                                  }
+                              }
+                          }
+                        else if (IntegrateInterfaceHere(element, face))
+                          {
+                            fdc.ReInit(face);
+                            fdc.ReInitNbr();
+                            AssembleTwoSidedInterfaceMatrix(pde, fdc, element,
+                                                            element[0]->neighbor(face),
+                                                            local_matrix, matrix);
+                          }
+                      }
+                    else if (pde.AtInterface(element, face))
                       {
                         // There exist now 3 different scenarios, given the actual
                         // element and face:
@@ -1150,9 +1502,8 @@ namespace DOpE
                                 nbr_dofs_per_element = fdc.GetNbrNDoFsPerElement();
                                 nbr_local_dof_indices.resize(0);
                                 nbr_local_dof_indices.resize(nbr_dofs_per_element, 0);
-                                dealii::FullMatrix<SCALAR> local_interface_matrix(
-                                  dofs_per_element, nbr_dofs_per_element);
-                                local_interface_matrix = 0;
+                                local_interface_matrix.reinit(dofs_per_element,
+                                                              nbr_dofs_per_element);
 
                                 pde.InterfaceMatrix(fdc, local_interface_matrix);
 
@@ -1180,9 +1531,8 @@ namespace DOpE
                             nbr_dofs_per_element = fdc.GetNbrNDoFsPerElement();
                             nbr_local_dof_indices.resize(0);
                             nbr_local_dof_indices.resize(nbr_dofs_per_element, 0);
-                            dealii::FullMatrix<SCALAR> local_interface_matrix(
-                              dofs_per_element, nbr_dofs_per_element);
-                            local_interface_matrix = 0;
+                            local_interface_matrix.reinit(dofs_per_element,
+                                                          nbr_dofs_per_element);
 
                             pde.InterfaceMatrix(fdc, local_interface_matrix);
 
@@ -1213,8 +1563,20 @@ namespace DOpE
 
             // LocalToGlobal
             const auto &C = pde.GetDoFConstraints();
-            element[0]->get_dof_indices(local_dof_indices);
-            C.distribute_local_to_global(local_matrix, local_dof_indices, matrix);
+            if (use_scatter_plan)
+              {
+                if (scatter_plan.IsConstrained(element_number))
+                  C.distribute_local_to_global(local_matrix,
+                                               scatter_plan.GetDoFIndices(element_number), matrix);
+                else
+                  scatter_plan.Add(element_number, local_matrix, matrix);
+              }
+            else
+              {
+                element[0]->get_dof_indices(local_dof_indices);
+                scatter_plan.Record(element_number, local_dof_indices, C);
+                C.distribute_local_to_global(local_matrix, local_dof_indices, matrix);
+              }
           } // endif locally owned
 
         for (unsigned int dh = 1; dh < dof_handler.size(); dh++)
@@ -1222,6 +1584,7 @@ namespace DOpE
             element[dh]++;
           }
       } // endfor element
+    scatter_plan.Finalize();
 
     matrix.compress(VectorOperation::add);
   }
@@ -1282,6 +1645,7 @@ namespace DOpE
 
     {
       SCALAR ret = 0.;
+      pde.GetBaseProblem().GetSpaceTimeHandler()->PreparePointEvaluation();
       ret += pde.PointFunctional(this->GetParamData(), this->GetDomainData());
 
       return ret;
@@ -1450,6 +1814,191 @@ namespace DOpE
 
   /*******************************************************************************************/
 
+  template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+            int dim>
+  template <typename PROBLEM, typename SELECTOR>
+  void Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeScalars(
+    PROBLEM &pde, const std::vector<unsigned int> &functionals,
+    const SELECTOR &select, std::vector<SCALAR> &values)
+  {
+    const unsigned int n_functionals = functionals.size();
+    values.assign(n_functionals, 0.);
+
+    // Sort the functionals by the parts they consist of and collect
+    // the data needed to evaluate all of them in one loop.
+    std::vector<unsigned int> domain, point, boundary, face, algebraic;
+    std::vector<std::vector<unsigned int> > boundary_functional_colors(n_functionals);
+    dealii::UpdateFlags update_flags = dealii::update_default;
+    dealii::UpdateFlags face_update_flags = dealii::update_default;
+    bool need_vertices = false;
+    bool any_interfaces = false;
+    std::vector<decltype(pde.GetAuxFunctional(0))> aux_functionals(n_functionals);
+
+    for (unsigned int i = 0; i < n_functionals; i++)
+      {
+        select(functionals[i]);
+        aux_functionals[i] = pde.GetAuxFunctional(functionals[i]);
+        const std::string type = pde.GetFunctionalType();
+        bool found = false;
+        if (type.find("domain") != std::string::npos)
+          {
+            found = true;
+            domain.push_back(i);
+            update_flags = update_flags | pde.GetUpdateFlags();
+            need_vertices = need_vertices || pde.HasVertices();
+          }
+        if (type.find("point") != std::string::npos)
+          {
+            found = true;
+            point.push_back(i);
+          }
+        if (type.find("boundary") != std::string::npos)
+          {
+            found = true;
+            boundary.push_back(i);
+            boundary_functional_colors[i] = pde.GetBoundaryFunctionalColors();
+            if (boundary_functional_colors[i].size() == 0)
+              {
+                throw DOpEException("No boundary colors given!",
+                                    "Integrator::ComputeScalars");
+              }
+          }
+        if (type.find("face") != std::string::npos)
+          {
+            found = true;
+            face.push_back(i);
+            if (!pde.HasFaces())
+              {
+                throw DOpEException("No faces required!", "Integrator::ComputeScalars");
+              }
+          }
+        if (type.find("algebraic") != std::string::npos)
+          {
+            found = true;
+            algebraic.push_back(i);
+          }
+        if (!found)
+          {
+            throw DOpEException("Unknown Functional Type: " + type,
+                                "Integrator::ComputeScalars");
+          }
+        if (type.find("boundary") != std::string::npos
+            || type.find("face") != std::string::npos)
+          {
+            face_update_flags = face_update_flags | pde.GetFaceUpdateFlags();
+            any_interfaces = any_interfaces || pde.HasInterfaces();
+          }
+      }
+
+    if (domain.size() > 0 || boundary.size() > 0 || face.size() > 0)
+      {
+        const auto &dof_handler =
+          pde.GetBaseProblem().GetSpaceTimeHandler()->GetDoFHandler();
+        auto element =
+          pde.GetBaseProblem().GetSpaceTimeHandler()->GetDoFHandlerBeginActive();
+        auto endc = pde.GetBaseProblem().GetSpaceTimeHandler()->GetDoFHandlerEnd();
+
+        GetIntegratorDataContainerFunc().InitializeEDC(
+          update_flags, *(pde.GetBaseProblem().GetSpaceTimeHandler()),
+          element, this->GetParamData(), this->GetDomainData(),
+          need_vertices);
+        GetIntegratorDataContainerFunc().InitializeFDC(
+          face_update_flags, *(pde.GetBaseProblem().GetSpaceTimeHandler()),
+          element, this->GetParamData(), this->GetDomainData(), any_interfaces);
+        auto &edc = GetIntegratorDataContainerFunc().GetElementDataContainer();
+        auto &fdc = GetIntegratorDataContainerFunc().GetFaceDataContainer();
+
+        for (; element[0] != endc[0]; element[0]++)
+          {
+            for (unsigned int dh = 1; dh < dof_handler.size(); dh++)
+              {
+                if (element[dh] == endc[dh])
+                  {
+                    throw DOpEException("Elementnumbers in DoFHandlers are not matching!",
+                                        "Integrator::ComputeScalars");
+                  }
+              }
+
+            if (element[0]->is_locally_owned())
+              {
+                if (domain.size() > 0)
+                  {
+                    edc.ReInit();
+                    for (unsigned int i : domain)
+                      {
+                        values[i] += aux_functionals[i]->ElementValue(edc);
+                      }
+                  }
+                for (unsigned int face_no = 0;
+                     face_no < dealii::GeometryInfo<dim>::faces_per_cell; ++face_no)
+                  {
+                    if (element[0]->face(face_no)->at_boundary())
+                      {
+                        bool initialized = false;
+                        for (unsigned int i : boundary)
+                          {
+#if DEAL_II_VERSION_GTE(8, 3, 0)
+                            if (find(boundary_functional_colors[i].begin(),
+                                     boundary_functional_colors[i].end(),
+                                     element[0]->face(face_no)->boundary_id()) ==
+                                boundary_functional_colors[i].end())
+#else
+                            if (find(boundary_functional_colors[i].begin(),
+                                     boundary_functional_colors[i].end(),
+                                     element[0]->face(face_no)->boundary_indicator()) ==
+                                boundary_functional_colors[i].end())
+#endif
+                              continue;
+                            if (!initialized)
+                              {
+                                fdc.ReInit(face_no);
+                                initialized = true;
+                              }
+                            values[i] += aux_functionals[i]->BoundaryValue(fdc);
+                          }
+                      }
+                    else if (face.size() > 0 && element[0]->neighbor_index(face_no) != -1)
+                      {
+                        fdc.ReInit(face_no);
+                        if (any_interfaces)
+                          {
+                            fdc.ReInitNbr();
+                          }
+                        for (unsigned int i : face)
+                          {
+                            values[i] += aux_functionals[i]->FaceValue(fdc);
+                          }
+                      }
+                  }
+              } // endif locally owned
+
+            for (unsigned int dh = 1; dh < dof_handler.size(); dh++)
+              {
+                element[dh]++;
+              }
+          }
+        std::vector<SCALAR> local_values(values);
+        dealii::Utilities::MPI::sum(local_values, MPI_COMM_WORLD, values);
+      }
+
+    if (point.size() > 0)
+      {
+        pde.GetBaseProblem().GetSpaceTimeHandler()->PreparePointEvaluation();
+      }
+    for (unsigned int i : point)
+      {
+        select(functionals[i]);
+        values[i] += pde.PointFunctional(this->GetParamData(), this->GetDomainData());
+      }
+    for (unsigned int i : algebraic)
+      {
+        select(functionals[i]);
+        values[i] += pde.AlgebraicFunctional(this->GetParamData(), this->GetDomainData());
+      }
+  }
+
+  /*******************************************************************************************/
+
   template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
             int dim>
   template <typename PROBLEM>
@@ -1561,6 +2110,24 @@ namespace DOpE
 
   /*******************************************************************************************/
 
+  template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+            int dim>
+  const VECTOR *
+  Integrator<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::GetDomainData(
+    std::string name) const
+  {
+    typename std::map<std::string, const VECTOR *>::const_iterator it =
+      domain_data_.find(name);
+    if (it == domain_data_.end())
+      {
+        throw DOpEException("Data " + name + " not found",
+                            "Integrator::GetDomainData");
+      }
+    return it->second;
+  }
+
+  /*******************************************************************************************/
+
   template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
             int dim>
   const std::map<std::string, const VECTOR *> &
@@ -101,6 +101,13 @@ namespace DOpE
     template<typename PROBLEM>
     SCALAR
     ComputeAlgebraicScalar(PROBLEM &pde);
+    /**
+     * Evaluates several functionals, see Integrator::ComputeScalars.
+     */
+    template<typename PROBLEM, typename SELECTOR>
+    void
+    ComputeScalars(PROBLEM &pde, const std::vector<unsigned int> &functionals,
+                   const SELECTOR &select, std::vector<SCALAR> &values);
 
     template<typename PROBLEM>
     void
@@ -840,6 +847,56 @@ namespace DOpE
 
   /*******************************************************************************************/
 
+  template<typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,
+           int dim>
+  template<typename PROBLEM, typename SELECTOR>
+  void
+  IntegratorMultiMesh<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeScalars(
+    PROBLEM &pde, const std::vector<unsigned int> &functionals,
+    const SELECTOR &select, std::vector<SCALAR> &values)
+  {
+    //The functionals are evaluated one after another.
+    values.assign(functionals.size(), 0.);
+    for (unsigned int i = 0; i < functionals.size(); i++)
+      {
+        select(functionals[i]);
+        const std::string type = pde.GetFunctionalType();
+        bool found = false;
+        if (type.find("domain") != std::string::npos)
+          {
+            found = true;
+            values[i] += ComputeDomainScalar(pde);
+          }
+        if (type.find("point") != std::string::npos)
+          {
+            found = true;
+            values[i] += ComputePointScalar(pde);
+          }
+        if (type.find("boundary") != std::string::npos)
+          {
+            found = true;
+            values[i] += ComputeBoundaryScalar(pde);
+          }
+        if (type.find("face") != std::string::npos)
+          {
+            found = true;
+            values[i] += ComputeFaceScalar(pde);
+          }
+        if (type.find("algebraic") != std::string::npos)
+          {
+            found = true;
+            values[i] += ComputeAlgebraicScalar(pde);
+          }
+        if (!found)
+          {
+            throw DOpEException("Unknown Functional Type: " + type,
+                                "IntegratorMultiMesh::ComputeScalars");
+          }
+      }
+  }
+
+  /*******************************************************************************************/
+
   template <typename INTEGRATORDATACONT, typename VECTOR, typename SCALAR,int dim>
   template<typename PROBLEM>
   void IntegratorMultiMesh<INTEGRATORDATACONT, VECTOR, SCALAR, dim>
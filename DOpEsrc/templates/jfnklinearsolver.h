@@ -0,0 +1,382 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef JFNK_LINEAR_SOLVER_H_
+#define JFNK_LINEAR_SOLVER_H_
+
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#if DEAL_II_VERSION_GTE(8,5,0)
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#else
+#include <deal.II/lac/compressed_simple_sparsity_pattern.h>
+#endif
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/full_matrix.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <include/parameterreader.h>
+
+#include <wrapper/preconditioner_wrapper.h>
+
+#include <cmath>
+#include <vector>
+
+namespace DOpE
+{
+
+  /**
+   * @class JacobianFreeOperator
+   *
+   * Approximates the action of the Jacobian of the nonlinear residual
+   * computed by INTEGRATOR::ComputeNonlinearResidual by the forward
+   * difference quotient
+   * J(u)w = (R(u+hw)-R(u))/h.
+   * The linearization point u is the vector given to the integrator
+   * as domain data "last_newton_solution".
+   *
+   * The directions are made to satisfy the homogeneous constraints, and
+   * the rows of constrained degrees of freedom act as the identity,
+   * similar to the assembled matrix.
+   */
+  template <typename PROBLEM, typename INTEGRATOR, typename VECTOR>
+  class JacobianFreeOperator
+  {
+  public:
+    /**
+     * @param pde                   The problem.
+     * @param integr                The integrator used to compute the residuals.
+     * @param u                     The linearization point.
+     * @param residual              The residual R(u) at the linearization point.
+     * @param constrained_dofs      The locally owned constrained degrees of freedom.
+     * @param inhomogeneities       The inhomogeneities of the constraints of constrained_dofs.
+     * @param eps                   The relative step size of the difference quotient.
+     * @param u_pert                A work vector to store the perturbed linearization point.
+     * @param w                     A work vector to store the direction.
+     */
+    JacobianFreeOperator(PROBLEM &pde, INTEGRATOR &integr, const VECTOR &u,
+                         const VECTOR &residual,
+                         const std::vector<dealii::types::global_dof_index> &constrained_dofs,
+                         const std::vector<double> &inhomogeneities,
+                         double eps, VECTOR &u_pert, VECTOR &w)
+      : pde_(pde), integr_(integr), u_(u), residual_(residual),
+        constrained_dofs_(constrained_dofs), inhomogeneities_(inhomogeneities),
+        eps_(eps), u_pert_(u_pert), w_(w)
+    {
+      u_norm_ = u_.l2_norm();
+    }
+
+    /**
+     * Computes dst = J(u)src.
+     */
+    void vmult(VECTOR &dst, const VECTOR &src) const
+    {
+      //The direction needs to respect the homogeneous constraints, so the
+      //inhomogeneities added by distribute are removed again.
+      w_ = src;
+      pde_.GetDoFConstraints().distribute(w_);
+      for (unsigned int i = 0; i < constrained_dofs_.size(); i++)
+        {
+          w_(constrained_dofs_[i]) -= inhomogeneities_[i];
+        }
+
+      double w_norm = w_.l2_norm();
+      if (w_norm == 0.)
+        {
+          dst = 0.;
+        }
+      else
+        {
+          double h = eps_*(1.+u_norm_)/w_norm;
+          u_pert_ = u_;
+          u_pert_.add(h,w_);
+
+          integr_.DeleteDomainData("last_newton_solution");
+          integr_.AddDomainData("last_newton_solution",&u_pert_);
+          integr_.ComputeNonlinearResidual(pde_,dst);
+          integr_.DeleteDomainData("last_newton_solution");
+          integr_.AddDomainData("last_newton_solution",&u_);
+
+          dst -= residual_;
+          dst *= 1./h;
+        }
+      for (unsigned int i = 0; i < constrained_dofs_.size(); i++)
+        {
+          dst(constrained_dofs_[i]) = src(constrained_dofs_[i]);
+        }
+    }
+
+  private:
+    PROBLEM &pde_;
+    INTEGRATOR &integr_;
+    const VECTOR &u_;
+    const VECTOR &residual_;
+    const std::vector<dealii::types::global_dof_index> &constrained_dofs_;
+    const std::vector<double> &inhomogeneities_;
+    double eps_, u_norm_;
+    VECTOR &u_pert_;
+    VECTOR &w_;
+  };
+
+  /**
+   * @class JFNKLinearSolverWithMatrix
+   *
+   * This class provides a linear solve for the nonlinear solvers of DOpE
+   * which does not require the assembled Jacobian for the matrix-vector
+   * products (Jacobian-free Newton-Krylov). The action of the Jacobian is
+   * approximated by differences of the nonlinear residual, see JacobianFreeOperator,
+   * and the system is solved with the (right preconditioned) GMRES-Solver of dealii.
+   *
+   * The right hand side given to Solve has to be the negative residual -R(u) at
+   * the linearization point, as computed by INTEGRATOR::ComputeNonlinearResidual.
+   * This is the case in NewtonSolver; the time stepping solvers add the terms of
+   * the previous time step to the right hand side and can not be used with this
+   * solver.
+   *
+   * Only the preconditioner is build from an assembled matrix. This matrix is
+   * lagged, i.e., it is only reassembled if a rebuild of the matrix is requested by
+   * the nonlinear solver and the previous linear solve needed more than
+   * preconditioner_rebuild_iter iterations.
+   *
+   * @tparam <PRECONDITIONER>     The preconditioner class to be used with the solver
+   * @tparam <SPARSITYPATTERN>    The sparsity pattern for the matrix
+   * @tparam <MATRIX>             The matrix type that is used for the storage of the preconditioning matrix
+   * @tparam <VECTOR>             The vector type for the solution and righthandside data,
+   *
+   */
+  template <typename PRECONDITIONER, typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  class JFNKLinearSolverWithMatrix
+  {
+  public:
+    JFNKLinearSolverWithMatrix( ParameterReader &param_reader);
+    ~JFNKLinearSolverWithMatrix();
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+       This Function should be called once after grid refinement, or changes in boundary values
+       to  recompute sparsity patterns, and constraint matrices.
+     */
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde);
+
+    /**
+     * Solves the linear PDE in the form J(u)x = b using dealii::SolverGMRES
+     * and a Jacobian-free approximation of the action of J(u).
+     * The linearization point u is the vector registered as
+     * domain data "last_newton_solution" in the integrator.
+     *
+     *
+     * @tparam <PROBLEM>            The problem that we want to solve, this is passed on to the INTEGRATOR
+     *                              to calculate the residuals and the preconditioning matrix.
+     * @tparam <INTEGRATOR>         The integrator used to calculate the residuals.
+     * @param rhs                   Right Hand Side of the Equation, i.e., the VECTOR b.
+     *                              It has to be the negative residual -R(u).
+     * @param solution              The Approximate Solution of the Linear Equation.
+     *                              It is assumed to be zero! Upon completion this VECTOR stores x
+     * @param force_build_matrix    A boolean value, that indicates whether the preconditioning
+     *                              matrix should be rebuild. It is only rebuild if the last
+     *                              linear solve needed too many iterations.
+     *
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde,INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
+
+    /**
+     * Sets the relative reduction of the residual that is required in the
+     * following calls of Solve, as needed by inexact Newton methods.
+     * If it is zero (default) only the tolerances from the parameter file are used.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve.
+     */
+    double GetLastLinearResidual() const;
+
+  protected:
+
+  private:
+    SPARSITYPATTERN sparsity_pattern_;
+    MATRIX matrix_;
+    PRECONDITIONER *precondition_;
+    bool matrix_built_ = false;
+
+    bool constrained_dofs_initialized_ = false;
+    std::vector<dealii::types::global_dof_index> constrained_dofs_;
+    std::vector<double> inhomogeneities_;
+    VECTOR residual_, u_pert_, w_;
+
+    double linear_global_tol_, fd_eps_;
+    int  linear_maxiter_, no_tmp_vectors_, rebuild_iter_;
+    unsigned int last_n_iterations_ = 0;
+    double forcing_term_ = 0., last_linear_residual_ = 0.;
+  };
+
+  /*********************************Implementation************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("jfnk_withmatrix parameters");
+    param_reader.declare_entry("linear_global_tol", "1.e-10",Patterns::Double(0),"global tolerance for the gmres iteration");
+    param_reader.declare_entry("linear_maxiter", "1000",Patterns::Integer(0),"maximal number of gmres steps");
+    param_reader.declare_entry("no_tmp_vectors", "100",Patterns::Integer(0),"Number of temporary vectors");
+    param_reader.declare_entry("difference_quotient_eps", "1.e-8",Patterns::Double(0),"relative step size for the difference quotients of the residual");
+    param_reader.declare_entry("preconditioner_rebuild_iter", "20",Patterns::Integer(0),"number of gmres steps after which the preconditioning matrix is rebuild on request of the nonlinear solver");
+  }
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>
+  ::JFNKLinearSolverWithMatrix(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("jfnk_withmatrix parameters");
+    linear_global_tol_ = param_reader.get_double ("linear_global_tol");
+    linear_maxiter_    = param_reader.get_integer ("linear_maxiter");
+    no_tmp_vectors_    = param_reader.get_integer ("no_tmp_vectors");
+    fd_eps_            = param_reader.get_double ("difference_quotient_eps");
+    rebuild_iter_      = param_reader.get_integer ("preconditioner_rebuild_iter");
+    precondition_ = NULL;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::~JFNKLinearSolverWithMatrix()
+  {
+    if (precondition_ != NULL)
+      delete precondition_;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM>
+  void  JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::ReInit(PROBLEM &pde)
+  {
+    matrix_.clear();
+    pde.ComputeSparsityPattern(sparsity_pattern_);
+    matrix_.reinit(sparsity_pattern_);
+    if (precondition_ != NULL)
+      delete precondition_;
+    precondition_ = new PRECONDITIONER;
+    matrix_built_ = false;
+    last_n_iterations_ = 0;
+    //The constrained dofs are collected in the next Solve, where the
+    //locally owned part of the vectors is known.
+    constrained_dofs_initialized_ = false;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      VECTOR &rhs,
+      VECTOR &solution,
+      bool force_matrix_build)
+  {
+    if (!matrix_built_ || (force_matrix_build && (int)last_n_iterations_ > rebuild_iter_))
+      {
+        integr.ComputeMatrix (pde,matrix_);
+        DOpEWrapper::SetDiscretizationData(*precondition_, pde);
+        precondition_->initialize(matrix_);
+        matrix_built_ = true;
+      }
+
+    if (!constrained_dofs_initialized_)
+      {
+        constrained_dofs_.clear();
+        inhomogeneities_.clear();
+        const auto &C = pde.GetDoFConstraints();
+        const dealii::IndexSet owned = rhs.locally_owned_elements();
+        for (dealii::types::global_dof_index k = 0; k < owned.n_elements(); k++)
+          {
+            const dealii::types::global_dof_index i = owned.nth_index_in_set(k);
+            if (C.is_constrained(i))
+              {
+                constrained_dofs_.push_back(i);
+                inhomogeneities_.push_back(C.get_inhomogeneity(i));
+              }
+          }
+        constrained_dofs_initialized_ = true;
+      }
+
+    const VECTOR *u = integr.GetDomainData("last_newton_solution");
+    if (residual_.size() != rhs.size())
+      {
+        residual_.reinit(rhs);
+        u_pert_.reinit(rhs);
+        w_.reinit(rhs);
+      }
+    //The right hand side is -R(u), so there is no need to compute the residual again.
+    residual_ = rhs;
+    residual_ *= -1.;
+
+    JacobianFreeOperator<PROBLEM,INTEGRATOR,VECTOR> jacobian(pde,integr,*u,residual_,
+                                                             constrained_dofs_,inhomogeneities_,
+                                                             fd_eps_,u_pert_,w_);
+
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, forcing_term_,false,false);
+
+    dealii::GrowingVectorMemory<VECTOR> vector_memory;
+    typename dealii::SolverGMRES<VECTOR>::AdditionalData gmres_data;
+    gmres_data.max_n_tmp_vectors = no_tmp_vectors_;
+    //Right preconditioning, so the residual of the unpreconditioned system is controlled
+    gmres_data.right_preconditioning = true;
+
+    dealii::SolverGMRES<VECTOR> gmres (solver_control, vector_memory, gmres_data);
+    gmres.solve (jacobian, solution, rhs,
+                 *precondition_);
+
+    last_n_iterations_ = solver_control.last_step();
+    last_linear_residual_ = solver_control.last_value();
+    pde.GetDoFConstraints().distribute(solution);
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::SetForcingTerm(double eta)
+  {
+    forcing_term_ = eta;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  double JFNKLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::GetLastLinearResidual() const
+  {
+    return last_linear_residual_;
+  }
+
+
+}
+#endif
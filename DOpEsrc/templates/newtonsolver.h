@@ -28,11 +28,14 @@
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_sparse_matrix.h>
 #include <deal.II/numerics/vector_tools.h>
+#include <functional>
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 
+#include <include/forcingterm.h>
+#include <include/helper.h>
 #include <include/parameterreader.h>
 
 
@@ -97,15 +100,82 @@ namespace DOpE
                         bool force_matrix_build=false,
                         int priority = 5, std::string algo_level = "\t\t ");
 
+    /**
+     * Solves a linear PDE for several right hand sides sharing the same operator,
+     * e.g., different load cases given by ElementRhs or PointRhs.
+     * The matrix is assembled and factorized (or preconditioned) at most once,
+     * all right hand sides are assembled in one sweep through the integrator, see
+     * Integrator::ComputeNonlinearRhs, and the solves reuse the matrix of the
+     * linear solver.
+     *
+     * A single Newton step is done for each right hand side. If the residual
+     * afterwards does not meet the tolerances of NonlinearSolve, e.g., since
+     * the PDE is not linear in the solution, NonlinearSolve is called to
+     * continue the iteration for this right hand side.
+     *
+     * @tparam <PROBLEM>            The description of the problem we want to solve.
+     *
+     * @param pde                   The problem
+     * @param solutions             The vectors that will store the solutions upon completion,
+     *                              one for each right hand side. As in NonlinearSolve
+     *                              they are used as starting values.
+     * @param select_rhs            Is called with the number k of a right hand side
+     *                              before its terms (and boundary values) are evaluated. It
+     *                              should switch the problem to the k-th case.
+     * @param apply_boundary_values See NonlinearSolve.
+     * @param force_build_matrix    See NonlinearSolve.
+     * @param priority              A number that defines the offset for the priority of the output
+     * @param algo_level            A prefix string to adjust indentation of the output.
+     *
+     * @return a boolean, that indicates whether it should be required to build the matrix next time that
+     *         this method is used, e.g. the value for force_build_matrix of the next call.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolveMultipleRhs(PROBLEM &pde, std::vector<VECTOR *> &solutions,
+                                   const std::function<void(unsigned int)> &select_rhs,
+                                   bool apply_boundary_values=true,
+                                   bool force_matrix_build=false,
+                                   int priority = 5, std::string algo_level = "\t\t ");
+
+    /**
+     * Returns how many work vectors of this class had to be reallocated during the last call
+     * of NonlinearSolve. As long as the size of the problem does not change
+     * this is expected to be zero.
+     */
+    unsigned int GetNWorkVectorReallocations() const;
+
   protected:
 
     inline INTEGRATOR &GetIntegrator();
 
   private:
+    /**
+     * Resets the work vector to the layout of solution,
+     * reallocating only if the size has changed.
+     */
+    inline void PrepareWorkVector(VECTOR &work, const VECTOR &solution);
+
     INTEGRATOR &integrator_;
 
     bool build_matrix_;
 
+    /**
+     * Work vectors used in NonlinearSolve. They are kept between the calls
+     * to avoid the reallocation in each time step, and reset in ReInit.
+     */
+    VECTOR residual_, du_;
+    /**
+     * The right hand sides in NonlinearSolveMultipleRhs.
+     */
+    std::vector<VECTOR> rhs_;
+    unsigned int n_work_vector_reallocations_ = 0;
+
+    /**
+     * Computes the relative tolerances of the linear solves
+     * if an inexact Newton method is selected.
+     */
+    ForcingTerm forcing_;
+
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
     int nonlinear_maxiter_, line_maxiter_;
@@ -126,6 +196,7 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    ForcingTerm::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -134,7 +205,7 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::NewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -144,6 +215,7 @@ namespace DOpE
 
     line_maxiter_   = param_reader.get_integer ("line_maxiter");
     linesearch_rho_ = param_reader.get_double ("linesearch_rho");
+    forcing_.CheckLinearSolver<LINEARSOLVER>();
 
   }
 
@@ -162,6 +234,9 @@ namespace DOpE
   ::ReInit(PROBLEM &pde)
   {
     LINEARSOLVER::ReInit(pde);
+    VECTOR().swap(residual_);
+    VECTOR().swap(du_);
+    std::vector<VECTOR>().swap(rhs_);
   }
 
   /*******************************************************************************************/
@@ -176,13 +251,14 @@ namespace DOpE
                    std::string algo_level)
   {
     bool build_matrix = force_matrix_build;
-    VECTOR residual;
-    VECTOR du;
+    VECTOR &residual = residual_;
+    VECTOR &du = du_;
     std::stringstream out;
     pde.GetOutputHandler()->InitNewtonOut(out);
 
-    du.reinit(solution);
-    residual.reinit(solution);
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(du,solution);
+    PrepareWorkVector(residual,solution);
 
     if (apply_boundary_values)
       {
@@ -200,6 +276,10 @@ namespace DOpE
     double res = residual.linfty_norm();
     double firstres = res;
     double lastres = res;
+    if (forcing_.IsActive())
+      {
+        forcing_.Initialize(residual.l2_norm(),nonlinear_tol_);
+      }
 
 
     out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
@@ -225,6 +305,12 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
+        if (forcing_.IsActive())
+          {
+            //The forcing term is relative to the residual of the zero update.
+            du = 0.;
+            forcing_.Apply<LINEARSOLVER>(*this);
+          }
         LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
 
         //Linesearch
@@ -294,6 +380,10 @@ namespace DOpE
                   build_matrix=true;
                 }
               lastres=res;
+              if (forcing_.IsActive())
+                {
+                  forcing_.Update<LINEARSOLVER>(residual.l2_norm(),*this);
+                }
 
               out << algo_level
                   << "Newton step: "
@@ -314,9 +404,122 @@ namespace DOpE
       }
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
+    if (forcing_.IsActive())
+      {
+        forcing_.Release<LINEARSOLVER>(*this);
+      }
+
     return build_matrix;
   }
 
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  bool NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolveMultipleRhs(PROBLEM &pde,
+                              std::vector<VECTOR *> &solutions,
+                              const std::function<void(unsigned int)> &select_rhs,
+                              bool apply_boundary_values,
+                              bool force_matrix_build,
+                              int priority,
+                              std::string algo_level)
+  {
+    const unsigned int n_rhs = solutions.size();
+    bool build_matrix = force_matrix_build;
+    if (n_rhs == 0)
+      return build_matrix;
+
+    VECTOR &lhs = residual_;
+    VECTOR &du = du_;
+    std::stringstream out;
+    pde.GetOutputHandler()->InitNewtonOut(out);
+
+    n_work_vector_reallocations_ = 0;
+    PrepareWorkVector(du,*solutions[0]);
+    PrepareWorkVector(lhs,*solutions[0]);
+    rhs_.resize(n_rhs);
+    for (unsigned int k = 0; k < n_rhs; k++)
+      {
+        PrepareWorkVector(rhs_[k],*solutions[k]);
+        if (apply_boundary_values)
+          {
+            select_rhs(k);
+            GetIntegrator().ApplyInitialBoundaryValues(pde,*solutions[k]);
+          }
+      }
+
+    //The right hand sides don't depend on the solution, so they are all
+    //assembled in one sweep.
+    GetIntegrator().ComputeNonlinearRhs(pde,rhs_,select_rhs);
+
+    const VECTOR *lhs_solution = NULL;
+    for (unsigned int k = 0; k < n_rhs; k++)
+      {
+        select_rhs(k);
+        //Usually all starting values coincide, then the lhs is computed only once.
+        if (lhs_solution == NULL || !(*lhs_solution == *solutions[k]))
+          {
+            GetIntegrator().AddDomainData("last_newton_solution",solutions[k]);
+            GetIntegrator().ComputeNonlinearLhs(pde,lhs);
+            GetIntegrator().DeleteDomainData("last_newton_solution");
+            lhs_solution = solutions[k];
+          }
+        rhs_[k] -= lhs;
+
+        out<< algo_level << "Right hand side: " <<k<<"\t Residual (abs.): "
+           <<pde.GetOutputHandler()->ZeroTolerance(rhs_[k].linfty_norm(), 1.0);
+        pde.GetOutputHandler()->Write(out,priority);
+      }
+
+    //The matrix is only built for the first right hand side, the
+    //remaining solves reuse it.
+    VECTOR &residual = lhs;
+    for (unsigned int k = 0; k < n_rhs; k++)
+      {
+        select_rhs(k);
+        const double firstres = rhs_[k].linfty_norm();
+        GetIntegrator().AddDomainData("last_newton_solution",solutions[k]);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),rhs_[k],du,build_matrix);
+        build_matrix = false;
+
+        *solutions[k] += du;
+
+        //A single step only suffices if the problem is linear and the
+        //matrix is exact, otherwise the Newton method has to continue.
+        GetIntegrator().ComputeNonlinearResidual(pde,residual);
+        GetIntegrator().DeleteDomainData("last_newton_solution");
+        const double res = residual.linfty_norm();
+        if (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
+          {
+            out<< algo_level << "Right hand side: " <<k<<"\t Residual (rel.): "
+               <<pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
+               <<"\t Continue with Newton iteration";
+            pde.GetOutputHandler()->Write(out,priority);
+            build_matrix = NonlinearSolve(pde,*solutions[k],false,true,priority,algo_level);
+          }
+      }
+
+    return build_matrix;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::PrepareWorkVector(VECTOR &work, const VECTOR &solution)
+  {
+    const bool reallocated = DOpEHelper::reinit_work_vector(work,solution);
+    if (reallocated)
+      n_work_vector_reallocations_++;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  unsigned int NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetNWorkVectorReallocations() const
+  {
+    return n_work_vector_reallocations_;
+  }
+
   /*******************************************************************************************/
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   INTEGRATOR &NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
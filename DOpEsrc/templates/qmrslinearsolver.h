@@ -92,6 +92,18 @@ namespace DOpE
     template<typename PROBLEM, typename INTEGRATOR>
     void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
 
+    /**
+     * Sets the relative reduction of the residual that is required in the
+     * following calls of Solve, as needed by inexact Newton methods.
+     * If it is zero (default) only the tolerances from the parameter file are used.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve.
+     */
+    double GetLastLinearResidual() const;
+
   protected:
 
   private:
@@ -100,6 +112,7 @@ namespace DOpE
 
     double linear_global_tol_, linear_tol_;
     int  linear_maxiter_;
+    double forcing_term_ = 0., last_linear_residual_ = 0.;
   };
 
   /*********************************Implementation************************************************/
@@ -158,7 +171,7 @@ namespace DOpE
       }
 
 
-    dealii::SolverControl solver_control (linear_maxiter_, linear_global_tol_,false,true);//letzte Arg = false!
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, forcing_term_,false,true);//letzte Arg = false!
     dealii::SolverQMRS<VECTOR> qmres (solver_control);
     PRECONDITIONER precondition;
     precondition.initialize(matrix_);
@@ -168,10 +181,25 @@ namespace DOpE
     matrix_.vmult(tmp,solution);
     tmp-= rhs;
     std::cout<<"XXX"<<tmp.linfty_norm()<<" ---- "<<tmp.l2_norm()<<std::endl;
+    last_linear_residual_ = solver_control.last_value();
     pde.GetDoFConstraints().distribute(solution);
   }
   /******************************************************/
 
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void QMRSLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::SetForcingTerm(double eta)
+  {
+    forcing_term_ = eta;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  double QMRSLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::GetLastLinearResidual() const
+  {
+    return last_linear_residual_;
+  }
+
 
 
 }
@@ -0,0 +1,389 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef TIME_MATRIX_CACHING_INTEGRATOR_H_
+#define TIME_MATRIX_CACHING_INTEGRATOR_H_
+
+#include <basic/dopetypes.h>
+#include <include/helper.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DOpE
+{
+  /**
+   * @class TimeMatrixCachingIntegrator
+   *
+   * This class is handed to the linear solvers by the time stepping newton
+   * solvers in place of the INTEGRATOR. If the PDE declares its ElementTimeMatrix
+   * to be constant, see PDEInterface::HasConstantTimeMatrix, the time matrix is
+   * assembled only once for each problem type and kept until the next call of
+   * ReInit or until the SpaceTimeHandler invalidates the state ticket.
+   * The matrices of the time steps are then assembled without the
+   * time matrix which is added by a sparse matrix addition with the
+   * weight of the actual step part.
+   *
+   * Both parts are assembled with the constraints. The diagonal entries
+   * that distribute_local_to_global puts into the rows of constrained DoFs
+   * are taken out of the stored time matrix. They are only used after the
+   * sum of both parts is formed, and only in those constrained rows that got
+   * no diagonal entry from the remaining terms. Thus each constrained row
+   * carries the diagonal entry of one assembly, as without caching.
+   *
+   * All other calls are passed to the INTEGRATOR, so that this class can
+   * be used wherever the INTEGRATOR is expected.
+   *
+   * @tparam <INTEGRATOR>     The integrator to be used for the assembly.
+   */
+  template <typename INTEGRATOR>
+  class TimeMatrixCachingIntegrator
+  {
+  public:
+    TimeMatrixCachingIntegrator(INTEGRATOR &integrator);
+    ~TimeMatrixCachingIntegrator();
+
+    /**
+     * Deletes the stored time matrices. This function should be called
+     * after grid refinement.
+     */
+    void ReInit();
+
+    /**
+     * Computes the matrix of the problem, see Integrator::ComputeMatrix.
+     * If pde.HasConstantTimeMatrix() is true the stored time matrix is used.
+     */
+    template<typename PROBLEM, typename MATRIX>
+    void ComputeMatrix(PROBLEM &pde, MATRIX &matrix);
+
+    /**
+     * Returns the wrapped integrator.
+     */
+    INTEGRATOR &GetIntegrator()
+    {
+      return integrator_;
+    }
+
+    /**
+     * All other functions are passed to the INTEGRATOR unchanged,
+     * see Integrator for their documentation. Functions the INTEGRATOR
+     * does not provide are removed from overload resolution.
+     */
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeNonlinearResidual(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeNonlinearResidual(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeNonlinearResidual(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeNonlinearLhs(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeNonlinearLhs(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeNonlinearLhs(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeNonlinearRhs(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeNonlinearRhs(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeNonlinearRhs(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeNonlinearAlgebraicResidual(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeNonlinearAlgebraicResidual(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeNonlinearAlgebraicResidual(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeLocalControlConstraints(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeLocalControlConstraints(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeLocalControlConstraints(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeDomainScalar(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeDomainScalar(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeDomainScalar(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputePointScalar(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputePointScalar(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputePointScalar(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeBoundaryScalar(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeBoundaryScalar(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeBoundaryScalar(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeFaceScalar(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeFaceScalar(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeFaceScalar(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeAlgebraicScalar(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeAlgebraicScalar(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeAlgebraicScalar(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeScalars(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeScalars(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeScalars(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ApplyInitialBoundaryValues(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ApplyInitialBoundaryValues(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ApplyInitialBoundaryValues(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ApplyTransposedInitialBoundaryValues(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ApplyTransposedInitialBoundaryValues(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ApplyTransposedInitialBoundaryValues(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto AddDomainData(ARGS &&... args)
+    -> decltype(std::declval<INT &>().AddDomainData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.AddDomainData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto DeleteDomainData(ARGS &&... args)
+    -> decltype(std::declval<INT &>().DeleteDomainData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.DeleteDomainData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto AddParamData(ARGS &&... args)
+    -> decltype(std::declval<INT &>().AddParamData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.AddParamData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto DeleteParamData(ARGS &&... args)
+    -> decltype(std::declval<INT &>().DeleteParamData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.DeleteParamData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto DeleteAllData(ARGS &&... args)
+    -> decltype(std::declval<INT &>().DeleteAllData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.DeleteAllData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto ComputeRefinementIndicators(ARGS &&... args)
+    -> decltype(std::declval<INT &>().ComputeRefinementIndicators(std::forward<ARGS>(args)...))
+    {
+      return integrator_.ComputeRefinementIndicators(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto AddPresetRightHandSide(ARGS &&... args)
+    -> decltype(std::declval<INT &>().AddPresetRightHandSide(std::forward<ARGS>(args)...))
+    {
+      return integrator_.AddPresetRightHandSide(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto GetDomainData(ARGS &&... args) const
+    -> decltype(std::declval<const INT &>().GetDomainData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.GetDomainData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto GetParamData(ARGS &&... args) const
+    -> decltype(std::declval<const INT &>().GetParamData(std::forward<ARGS>(args)...))
+    {
+      return integrator_.GetParamData(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto GetIntegratorDataContainer(ARGS &&... args) const
+    -> decltype(std::declval<const INT &>().GetIntegratorDataContainer(std::forward<ARGS>(args)...))
+    {
+      return integrator_.GetIntegratorDataContainer(std::forward<ARGS>(args)...);
+    }
+
+    template<typename INT = INTEGRATOR, typename... ARGS>
+    auto GetIntegratorDataContainerFunc(ARGS &&... args) const
+    -> decltype(std::declval<const INT &>().GetIntegratorDataContainerFunc(std::forward<ARGS>(args)...))
+    {
+      return integrator_.GetIntegratorDataContainerFunc(std::forward<ARGS>(args)...);
+    }
+
+  private:
+    /**
+     * Storage for a time matrix of arbitrary type, the type is
+     * only known within ComputeMatrix.
+     */
+    struct StoredMatrixBase
+    {
+      virtual ~StoredMatrixBase() {}
+    };
+
+    template<typename MATRIX>
+    struct StoredMatrix : public StoredMatrixBase
+    {
+      MATRIX matrix;
+      //The diagonal entries of the constrained rows, which are zero in matrix.
+      std::vector<std::pair<dealii::types::global_dof_index, double> > constrained_diagonal;
+    };
+
+    /**
+     * Returns the time matrix for the problem pde, which is assembled
+     * if no valid one is stored.
+     */
+    template<typename PROBLEM, typename MATRIX>
+    const StoredMatrix<MATRIX> &GetTimeMatrix(PROBLEM &pde, const MATRIX &matrix);
+
+    INTEGRATOR &integrator_;
+    std::map<std::string, std::unique_ptr<StoredMatrixBase> > time_matrices_;
+    unsigned int state_ticket_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename INTEGRATOR>
+  TimeMatrixCachingIntegrator<INTEGRATOR>
+  ::TimeMatrixCachingIntegrator(INTEGRATOR &integrator)
+    : integrator_(integrator), state_ticket_(0)
+  {
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR>
+  TimeMatrixCachingIntegrator<INTEGRATOR>
+  ::~TimeMatrixCachingIntegrator()
+  {
+    ReInit();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR>
+  void TimeMatrixCachingIntegrator<INTEGRATOR>
+  ::ReInit()
+  {
+    time_matrices_.clear();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR>
+  template<typename PROBLEM, typename MATRIX>
+  void TimeMatrixCachingIntegrator<INTEGRATOR>
+  ::ComputeMatrix(PROBLEM &pde, MATRIX &matrix)
+  {
+    if (!pde.HasConstantTimeMatrix())
+      {
+        integrator_.ComputeMatrix(pde,matrix);
+        return;
+      }
+    const StoredMatrix<MATRIX> &time_matrix = GetTimeMatrix(pde,matrix);
+
+    pde.SetMatrixPart(DOpEtypes::MatrixPart::without_time_matrix);
+    integrator_.ComputeMatrix(pde,matrix);
+    pde.SetMatrixPart(DOpEtypes::MatrixPart::all_terms);
+
+    const double weight = pde.GetTimeMatrixWeight();
+    matrix.add(weight,time_matrix.matrix);
+
+    //The constrained rows of the sum get their diagonal entry from the time matrix
+    //only if the remaining terms gave none.
+    for (const auto &entry : time_matrix.constrained_diagonal)
+      {
+        if (matrix.el(entry.first,entry.first) == 0.)
+          matrix.set(entry.first,entry.first,weight*entry.second);
+      }
+    matrix.compress(dealii::VectorOperation::insert);
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR>
+  template<typename PROBLEM, typename MATRIX>
+  const typename TimeMatrixCachingIntegrator<INTEGRATOR>::template StoredMatrix<MATRIX> &
+  TimeMatrixCachingIntegrator<INTEGRATOR>
+  ::GetTimeMatrix(PROBLEM &pde, const MATRIX &matrix)
+  {
+    if (!pde.GetSpaceTimeHandler()->IsValidStateTicket(state_ticket_))
+      {
+        ReInit();
+      }
+
+    std::unique_ptr<StoredMatrixBase> &stored = time_matrices_[pde.GetType()];
+    StoredMatrix<MATRIX> *time_matrix = dynamic_cast<StoredMatrix<MATRIX>*>(stored.get());
+    if (time_matrix != NULL
+        && time_matrix->matrix.m() == matrix.m()
+        && time_matrix->matrix.n() == matrix.n())
+      {
+        return *time_matrix;
+      }
+
+    time_matrix = new StoredMatrix<MATRIX>;
+    stored.reset(time_matrix);
+
+    DOpEHelper::reinit_like(time_matrix->matrix,matrix);
+    pde.SetMatrixPart(DOpEtypes::MatrixPart::time_matrix_only);
+    integrator_.ComputeMatrix(pde,time_matrix->matrix);
+    pde.SetMatrixPart(DOpEtypes::MatrixPart::all_terms);
+    DOpEHelper::extract_constrained_diagonal(time_matrix->matrix,pde.GetDoFConstraints(),
+                                             time_matrix->constrained_diagonal);
+
+    return *time_matrix;
+  }
+
+  /*******************************************************************************************/
+
+}
+#endif
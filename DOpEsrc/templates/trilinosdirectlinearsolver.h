@@ -98,6 +98,18 @@ namespace DOpE
     template<typename PROBLEM, typename INTEGRATOR>
     void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
 
+    /**
+     * The system is solved directly, hence the forcing terms
+     * of inexact Newton methods are ignored.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve,
+     * which is zero for a direct solver.
+     */
+    double GetLastLinearResidual() const;
+
   protected:
 
   private:
@@ -184,5 +196,20 @@ namespace DOpE
   }
 
 
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void TrilinosDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::SetForcingTerm(double /*eta*/)
+  {
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  double TrilinosDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::GetLastLinearResidual() const
+  {
+    return 0.;
+  }
+
 }
 #endif
@@ -86,6 +86,18 @@ namespace DOpE
     template<typename PROBLEM, typename INTEGRATOR>
     void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
 
+    /**
+     * No system is solved here, hence the forcing terms
+     * of inexact Newton methods are ignored.
+     */
+    void SetForcingTerm(double eta);
+
+    /**
+     * Returns the norm of the linear residual reached in the last call of Solve,
+     * which is zero by definition.
+     */
+    double GetLastLinearResidual() const;
+
   protected:
 
   private:
@@ -132,5 +144,20 @@ namespace DOpE
   }
 
 
+  /******************************************************/
+
+  template <typename VECTOR>
+  void VoidLinearSolver<VECTOR>::SetForcingTerm(double /*eta*/)
+  {
+  }
+
+  /******************************************************/
+
+  template <typename VECTOR>
+  double VoidLinearSolver<VECTOR>::GetLastLinearResidual() const
+  {
+    return 0.;
+  }
+
 }
 #endif
@@ -146,23 +146,14 @@ namespace DOpE
     ElementEquation(const EDC &edc,
                     dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-          this->GetProblem().ElementEquation(edc, tmp,
-                                             scale,
-                                             scale);
-          local_vector += tmp;
-
-          tmp = 0.0;
-          this->GetProblem().ElementTimeEquation(edc, tmp, scale);
-          local_vector += tmp;
+          this->AddElementAndTimeEquation(edc, local_vector, scale, scale, scale);
 
           this->GetProblem().ElementTimeEquationExplicit(edc, local_vector,
                                                          scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().ElementTimeEquation(edc, local_vector,
                                                  (-1) * scale);
@@ -199,12 +190,12 @@ namespace DOpE
     ElementRhs(const EDC &edc,
                dealii::Vector<double> &local_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().ElementRhs(edc, local_vector,
                                         scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
         }
       else
@@ -245,12 +236,12 @@ namespace DOpE
       const std::map<std::string, const VECTOR *> &domain_values,
       VECTOR &rhs_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
                                       scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
         }
       else
@@ -297,20 +288,16 @@ namespace DOpE
     ElementMatrix(const EDC &edc,
                   dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
-      dealii::FullMatrix<double> m(local_matrix);
-
-      this->GetProblem().ElementMatrix(edc, local_matrix,
-                                       1.,1.);
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
 
-      m = 0.;
-      this->GetProblem().ElementTimeMatrix(edc, m);
-      local_matrix.add(1.0, m);
-
-      m = 0.;
-      this->GetProblem().ElementTimeMatrixExplicit(edc, m);
-      local_matrix.add(1.0, m);
+      this->AddElementAndTimeMatrix(edc, local_matrix, 1., 1., 1.);
 
+      if (this->AssembleMatrixTerms())
+        {
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
+          this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+          local_matrix.add(1.0, m);
+        }
     }
 
     /******************************************************/
@@ -336,13 +323,13 @@ namespace DOpE
                  dealii::Vector<double> &local_vector, double scale,
                  double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().FaceEquation(fdc, local_vector,
                                           scale,
                                           scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
         }
       else
@@ -375,13 +362,13 @@ namespace DOpE
                       dealii::Vector<double> &local_vector, double scale,
                       double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                scale,
                                                scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
         }
       else
@@ -433,7 +420,9 @@ namespace DOpE
     FaceMatrix(const FDC &fdc,
                dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       this->GetProblem().FaceMatrix(fdc, local_matrix,
                                     1.,1.);
 
@@ -457,13 +446,65 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       this->GetProblem().InterfaceMatrix(fdc, local_matrix,
                                          1.,1.);
     }
 
     /******************************************************/
 
+    /**
+     * Same as InterfaceEquation, but for the two-sided interface terms
+     * with the weights of the one-sided terms.
+     */
+    template<typename FDC>
+    void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale, double /*scale_ico*/)
+    {
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       scale, scale);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
+        {
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    /******************************************************/
+
+    /**
+     * Same as InterfaceMatrix, but for the two-sided interface matrices.
+     */
+    template<typename FDC>
+    void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix)
+    {
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
+      this->GetProblem().InterfaceMatrixTwoSided(fdc, local_entry_matrix,
+                                                 element_nbr_matrix,
+                                                 nbr_element_matrix, nbr_matrix,
+                                                 1., 1.);
+    }
+
+    /******************************************************/
+
     /**
      * Same functionality as for the ElementEquation, but on Boundaries.
     * Note that no time derivatives may occure on faces of the domain at present!
@@ -485,12 +526,12 @@ namespace DOpE
                      dealii::Vector<double> &local_vector, double scale,
                      double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector,
                                               scale, scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
         }
       else
@@ -543,7 +584,9 @@ namespace DOpE
     BoundaryMatrix(const FDC &fdc,
                    dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       this->GetProblem().BoundaryMatrix(fdc, local_matrix,
                                         1., 1.);
     }
@@ -102,34 +102,21 @@ namespace DOpE
     ElementEquation(const EDC &edc,
                     dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
-          dealii::Vector<double> tmp(local_vector);
-
-          tmp = 0.0;
           // The remaining parts; e.g. for fluid problems: laplace, convection, etc.
           // Multiplication by 1/2 due to CN discretization
-          this->GetProblem().ElementEquation(edc, tmp, 0.5 * scale, scale);
-          local_vector += tmp;
-
-          tmp = 0.0;
-          this->GetProblem().ElementTimeEquation(edc, tmp,
-                                                 scale);
-          local_vector += tmp;
+          this->AddElementAndTimeEquation(edc, local_vector, 0.5 * scale, scale, scale);
 
           this->GetProblem().ElementTimeEquationExplicit(edc, local_vector,
                                                          scale);
 
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-
           // The explicit parts with old_time_values; e.g. for fluid problems: laplace, convection, etc.
           // Multiplication by 1/2 due to CN discretization
-          this->GetProblem().ElementEquation(edc, tmp, 0.5 * scale, 0.);
-          local_vector += tmp;
+          this->GetProblem().ElementEquation(edc, local_vector, 0.5 * scale, 0.);
 
           this->GetProblem().ElementTimeEquation(
             edc,
@@ -149,11 +136,11 @@ namespace DOpE
     ElementRhs(const EDC &edc,
                dealii::Vector<double> &local_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().ElementRhs(edc, local_vector, 0.5 * scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().ElementRhs(edc, local_vector, 0.5 * scale);
         }
@@ -171,12 +158,12 @@ namespace DOpE
       const std::map<std::string, const VECTOR *> &domain_values,
       VECTOR &rhs_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
                                       0.5 * scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
                                       (0.5) * scale);
@@ -194,22 +181,18 @@ namespace DOpE
     ElementMatrix(const EDC &edc,
                   dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
-      dealii::FullMatrix<double> m(local_matrix);
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
 
       // multiplication with 1/2 for scale due to CN discretization,
       //no multiplication with 1/2 for scale_ico due to implicit treatment of pressure, etc. (in the case of fluid problems)
-      this->GetProblem().ElementMatrix(edc, local_matrix, 0.5, 1.);
-
-      m = 0.;
-      this->GetProblem().ElementTimeMatrix(edc, m);
-      local_matrix.add(
-        1.0, m);
+      this->AddElementAndTimeMatrix(edc, local_matrix, 0.5, 1., 1.);
 
-      m = 0.;
-      this->GetProblem().ElementTimeMatrixExplicit(edc, m);
-      local_matrix.add(
-        1.0, m);
+      if (this->AssembleMatrixTerms())
+        {
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
+          this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+          local_matrix.add(1.0, m);
+        }
     }
 
     /******************************************************/
@@ -219,11 +202,11 @@ namespace DOpE
     FaceEquation(const FDC &fdc,
                  dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().FaceEquation(fdc, local_vector, 0.5 * scale, scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().FaceEquation(fdc, local_vector, 0.5 * scale,0.);
         }
@@ -241,12 +224,12 @@ namespace DOpE
     InterfaceEquation(const FDC &fdc,
                       dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                0.5 * scale, scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().InterfaceEquation(fdc,  local_vector,
                                                0.5 * scale, 0.);
@@ -275,9 +258,11 @@ namespace DOpE
     FaceMatrix(const FDC &fdc,
                dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       // Hier nicht mit this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize() multiplizieren, da local_matrix schon skaliert ist
-      dealii::FullMatrix<double> m(local_matrix);
+      dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
 
       m = 0.;
       // Multiplication with 1/2 due to CN time discretization
@@ -293,8 +278,10 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
-      dealii::FullMatrix<double> m(local_matrix);
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
+      dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
 
       m = 0.;
       // Multiplication with 1/2 due to CN time discretization
@@ -305,16 +292,70 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Same as InterfaceEquation, but for the two-sided interface terms
+     * with the weights of the one-sided terms.
+     */
+    template<typename FDC>
+    void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale, double /*scale_ico*/)
+    {
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       0.5 * scale, scale);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       0.5 * scale, 0.);
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    /******************************************************/
+
+    /**
+     * Same as InterfaceMatrix, but for the two-sided interface matrices.
+     */
+    template<typename FDC>
+    void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix)
+    {
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
+      // Multiplication with 1/2 due to CN time discretization
+      this->GetProblem().InterfaceMatrixTwoSided(fdc, local_entry_matrix,
+                                                 element_nbr_matrix,
+                                                 nbr_element_matrix, nbr_matrix,
+                                                 0.5, 1.);
+    }
+
+    /******************************************************/
+
     template<typename FDC>
     void
     BoundaryEquation(const FDC &fdc,
                      dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector, 0.5 * scale, scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector, 0.5 * scale, 0.);
         }
@@ -342,8 +383,10 @@ namespace DOpE
     BoundaryMatrix(const FDC &fdc,
                    dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
-      dealii::FullMatrix<double> m(local_matrix);
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
+      dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
 
       m = 0.;
       // Multiplication with 1/2 due to CN time discretization
@@ -99,28 +99,17 @@ namespace DOpE
     ElementEquation(const EDC &edc,
                     dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-          this->GetProblem().ElementEquation(edc, tmp, 0., scale);
-          local_vector += tmp;
-
-          tmp = 0.0;
-          this->GetProblem().ElementTimeEquation(edc, tmp,
-                                                 scale );
-          local_vector += tmp;
+          this->AddElementAndTimeEquation(edc, local_vector, 0., scale, scale);
 
           this->GetProblem().ElementTimeEquationExplicit(edc, local_vector,
                                                          scale );
 
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-          this->GetProblem().ElementEquation(edc, tmp, scale, 0.);
-          local_vector += tmp;
+          this->GetProblem().ElementEquation(edc, local_vector, scale, 0.);
 
           this->GetProblem().ElementTimeEquation(
             edc,
@@ -140,11 +129,10 @@ namespace DOpE
     ElementRhs(const EDC &edc,
                dealii::Vector<double> &local_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
-
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().ElementRhs(edc, local_vector, scale);
         }
@@ -154,17 +142,16 @@ namespace DOpE
         }
     }
 
-
     void
     PointRhs(
       const std::map<std::string, const dealii::Vector<double>*> &param_values,
       const std::map<std::string, const VECTOR *> &domain_values,
       VECTOR &rhs_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector, scale);
         }
@@ -181,20 +168,16 @@ namespace DOpE
     ElementMatrix(const EDC &edc,
                   dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
-      dealii::FullMatrix<double> m(local_matrix);
-
-      this->GetProblem().ElementMatrix(edc, local_matrix, 0., 1.);
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
 
-      m = 0.;
-      this->GetProblem().ElementTimeMatrix(edc, m);
-      local_matrix.add(
-        1.0, m);
+      this->AddElementAndTimeMatrix(edc, local_matrix, 0., 1., 1.);
 
-      m = 0.;
-      this->GetProblem().ElementTimeMatrixExplicit(edc, m);
-      local_matrix.add(
-        1.0, m);
+      if (this->AssembleMatrixTerms())
+        {
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
+          this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+          local_matrix.add(1.0, m);
+        }
 
     }
 
@@ -205,11 +188,11 @@ namespace DOpE
     FaceEquation(const FDC &fdc,
                  dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().FaceEquation(fdc, local_vector, 0., scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().FaceEquation(fdc, local_vector, scale,0.);
         }
@@ -226,11 +209,11 @@ namespace DOpE
     InterfaceEquation(const FDC &fdc,
                       dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector, 0., scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector, scale,0.);
         }
@@ -258,7 +241,9 @@ namespace DOpE
     FaceMatrix(const FDC &fdc,
                dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       this->GetProblem().FaceMatrix(fdc, local_matrix, 0., 1.);
 
     }
@@ -270,23 +255,78 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       this->GetProblem().InterfaceMatrix(fdc, local_matrix, 0., 1.);
 
     }
 
     /******************************************************/
 
+    /**
+     * Same as InterfaceEquation, but for the two-sided interface terms
+     * with the weights of the one-sided terms.
+     */
+    template<typename FDC>
+    void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale, double /*scale_ico*/)
+    {
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       0., scale);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       scale, 0.);
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    /******************************************************/
+
+    /**
+     * Same as InterfaceMatrix, but for the two-sided interface matrices.
+     */
+    template<typename FDC>
+    void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix)
+    {
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
+      this->GetProblem().InterfaceMatrixTwoSided(fdc, local_entry_matrix,
+                                                 element_nbr_matrix,
+                                                 nbr_element_matrix, nbr_matrix,
+                                                 0., 1.);
+    }
+
+    /******************************************************/
+
     template<typename FDC>
     void
     BoundaryEquation(const FDC &fdc,
                      dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector, 0., scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector, scale,0.);
         }
@@ -314,7 +354,9 @@ namespace DOpE
     BoundaryMatrix(const FDC &fdc,
                    dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       this->GetProblem().BoundaryMatrix(fdc, local_matrix, 0., 1.);
     }
   private:
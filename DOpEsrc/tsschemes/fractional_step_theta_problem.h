@@ -110,79 +110,48 @@ namespace DOpE
     ElementEquation(const EDC &edc,
                     dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-          dealii::Vector<double> tmp(local_vector);
-
-          tmp = 0.0;
-          this->GetProblem().ElementEquation(edc, tmp,
-                                             scale * fs_alpha_,
-                                             scale);
-          local_vector += tmp;
-
-          tmp = 0.0;
-          this->GetProblem().ElementTimeEquation(edc, tmp, scale / (fs_theta_));
-          local_vector += tmp;
+          this->AddElementAndTimeEquation(edc, local_vector, scale * fs_alpha_,
+                                          scale, scale / (fs_theta_));
 
           this->GetProblem().ElementTimeEquationExplicit(edc, local_vector,
                                                          scale / (fs_theta_));
         }
-      else if (this->GetPart() == "Old_for_1st_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-
           // The explicit parts with old_time_values; e.g. for fluid problems: laplace, convection, etc.
-          this->GetProblem().ElementEquation(edc, tmp,
+          this->GetProblem().ElementEquation(edc, local_vector,
                                              scale * fs_beta_,
                                              0.);
-          local_vector += tmp;
 
           this->GetProblem().ElementTimeEquation(edc, local_vector,
                                                  (-1) * scale / (fs_theta_));
         }
-      else if (this->GetPart() == "Old_for_3rd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-
           // The explicit parts with old_time_values; e.g. for fluid problems: laplace, convection, etc.
-          this->GetProblem().ElementEquation(edc, tmp,
+          this->GetProblem().ElementEquation(edc, local_vector,
                                              scale * fs_beta_,
                                              0.);
-          local_vector += tmp;
 
           this->GetProblem().ElementTimeEquation(edc, local_vector,
                                                  (-1) * scale / (fs_theta_));
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
-          dealii::Vector<double> tmp(local_vector);
-
-          tmp = 0.0;
-          this->GetProblem().ElementEquation(edc, tmp,
-                                             scale * fs_beta_,
-                                             scale);
-          local_vector += tmp;
-
-          tmp = 0.0;
-          this->GetProblem().ElementTimeEquation(edc, tmp,
-                                                 scale / (fs_theta_prime_));
-          local_vector += tmp;
+          this->AddElementAndTimeEquation(edc, local_vector, scale * fs_beta_,
+                                          scale, scale / (fs_theta_prime_));
 
           this->GetProblem().ElementTimeEquationExplicit(edc, local_vector,
                                                          scale / (fs_theta_prime_));
         }
-      else if (this->GetPart() == "Old_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
         {
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-
           // The explicit parts with old_time_values; e.g. for fluid problems: laplace, convection, etc.
-          this->GetProblem().ElementEquation(edc, tmp,
+          this->GetProblem().ElementEquation(edc, local_vector,
                                              scale * fs_alpha_,
                                              0.);
-          local_vector += tmp;
 
           this->GetProblem().ElementTimeEquation(edc, local_vector,
                                                  (-1) * scale / (fs_theta_prime_));
@@ -200,22 +169,21 @@ namespace DOpE
     ElementRhs(const EDC &edc,
                dealii::Vector<double> &local_vector, double scale)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-
         }
-      else if (this->GetPart() == "Old_for_1st_cycle"
-               || this->GetPart() == "Old_for_3rd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle
+               || this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle)
         {
           this->GetProblem().ElementRhs(edc, local_vector,
                                         scale);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
           this->GetProblem().ElementRhs(edc, local_vector,
                                         scale);
         }
-      else if (this->GetPart() == "Old_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
         {
         }
       else
@@ -231,22 +199,21 @@ namespace DOpE
       const std::map<std::string, const VECTOR *> &domain_values,
       VECTOR &rhs_vector, double scale)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-
         }
-      else if (this->GetPart() == "Old_for_1st_cycle"
-               || this->GetPart() == "Old_for_3rd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle
+               || this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle)
         {
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
                                       scale);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
                                       scale);
         }
-      else if (this->GetPart() == "Old_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
         {
         }
       else
@@ -257,44 +224,48 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * The ElementTimeMatrix is weighted differently in the
+     * first and third and in the second substep.
+     */
+    double
+    GetTimeMatrixWeight() const
+    {
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
+        return 1.0 / (fs_theta_prime_);
+      return 1.0 / (fs_theta_);
+    }
+
+    /******************************************************/
+
     template<typename EDC>
     void
     ElementMatrix(const EDC &edc,
                   dealii::FullMatrix<double> &local_matrix)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
-          m = 0.;
-          this->GetProblem().ElementMatrix(edc, m,
-                                           fs_alpha_,
-                                           1.);
-          local_matrix.add(1.0, m);
+          this->AddElementAndTimeMatrix(edc, local_matrix, fs_alpha_, 1.,
+                                        1.0 / (fs_theta_));
 
-          m = 0.;
-          this->GetProblem().ElementTimeMatrix(edc, m);
-          local_matrix.add(1.0 / (fs_theta_), m);
-
-          m = 0.;
-          this->GetProblem().ElementTimeMatrixExplicit(edc, m);
-          local_matrix.add(1.0 / (fs_theta_), m);
+          if (this->AssembleMatrixTerms())
+            {
+              dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
+              this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+              local_matrix.add(1.0 / (fs_theta_), m);
+            }
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
-          m = 0.;
-          this->GetProblem().ElementMatrix(edc, local_matrix,
-                                           fs_beta_,
-                                           1.);
-          local_matrix.add(1.0, m);
-
-          m = 0.;
-          this->GetProblem().ElementTimeMatrix(edc, m);
-          local_matrix.add(1.0 / (fs_theta_prime_), m);
+          this->AddElementAndTimeMatrix(edc, local_matrix, fs_beta_, 1.,
+                                        1.0 / (fs_theta_prime_));
 
-          m = 0.;
-          this->GetProblem().ElementTimeMatrixExplicit(edc, m);
-          local_matrix.add(1.0 / (fs_theta_prime_), m);
+          if (this->AssembleMatrixTerms())
+            {
+              dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
+              this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+              local_matrix.add(1.0 / (fs_theta_prime_), m);
+            }
         }
     }
 
@@ -305,27 +276,27 @@ namespace DOpE
     FaceEquation(const FDC &fdc,
                  dealii::Vector<double> &local_vector, double scale, double)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
           this->GetProblem().FaceEquation(fdc, local_vector,
                                           scale * fs_alpha_,
                                           scale);
 
         }
-      else if ((this->GetPart() == "Old_for_1st_cycle")
-               || (this->GetPart() == "Old_for_3rd_cycle"))
+      else if ((this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle)
+               || (this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle))
         {
           this->GetProblem().FaceEquation(fdc, local_vector,
                                           scale * fs_beta_,
                                           0);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
           this->GetProblem().FaceEquation(fdc, local_vector,
                                           scale * fs_beta_,
                                           scale);
         }
-      else if (this->GetPart() == "Old_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
         {
           this->GetProblem().FaceEquation(fdc, local_vector,
                                           scale * fs_alpha_,
@@ -346,27 +317,27 @@ namespace DOpE
                       dealii::Vector<double> &local_vector, double scale,
                       double /*scale_ico*/)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                scale * fs_alpha_,
                                                scale);
 
         }
-      else if ((this->GetPart() == "Old_for_1st_cycle")
-               || (this->GetPart() == "Old_for_3rd_cycle"))
+      else if ((this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle)
+               || (this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle))
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                scale * fs_beta_,
                                                0);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                scale * fs_beta_,
                                                scale);
         }
-      else if (this->GetPart() == "Old_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
         {
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                scale * fs_alpha_,
@@ -397,18 +368,20 @@ namespace DOpE
     FaceMatrix(const FDC &fdc,
                dealii::FullMatrix<double> &local_matrix)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (!this->AssembleMatrixTerms())
+        return;
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
           m = 0.;
           this->GetProblem().FaceMatrix(fdc, m,
                                         fs_alpha_,
                                         1.);
           local_matrix.add(1., m);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
           m = 0.;
           this->GetProblem().FaceMatrix(fdc, m,
                                         fs_beta_,
@@ -425,18 +398,20 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (!this->AssembleMatrixTerms())
+        return;
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
           m = 0.;
           this->GetProblem().InterfaceMatrix(fdc, m,
                                              fs_alpha_,
                                              1.);
           local_matrix.add(1.0, m);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
           m = 0.;
           this->GetProblem().InterfaceMatrix(fdc, m,
                                              fs_beta_,
@@ -448,30 +423,105 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Same as InterfaceEquation, but for the two-sided interface terms
+     * with the weights of the one-sided terms.
+     */
+    template<typename FDC>
+    void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale, double /*scale_ico*/)
+    {
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       scale * fs_alpha_, scale);
+        }
+      else if ((this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle)
+               || (this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle))
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       scale * fs_beta_, 0.);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       scale * fs_beta_, scale);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
+        {
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       scale * fs_alpha_, 0.);
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    /******************************************************/
+
+    /**
+     * Same as InterfaceMatrix, but for the two-sided interface matrices.
+     */
+    template<typename FDC>
+    void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix)
+    {
+      if (!this->AssembleMatrixTerms())
+        return;
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
+        {
+          this->GetProblem().InterfaceMatrixTwoSided(fdc, local_entry_matrix,
+                                                     element_nbr_matrix,
+                                                     nbr_element_matrix, nbr_matrix,
+                                                     fs_alpha_, 1.);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
+        {
+          this->GetProblem().InterfaceMatrixTwoSided(fdc, local_entry_matrix,
+                                                     element_nbr_matrix,
+                                                     nbr_element_matrix, nbr_matrix,
+                                                     fs_beta_, 1.);
+        }
+    }
+
+    /******************************************************/
+
     template<typename FDC>
     void
     BoundaryEquation(const FDC &fdc,
                      dealii::Vector<double> &local_vector, double scale, double)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector,
                                               scale * fs_alpha_, scale);
         }
-      else if ((this->GetPart() == "Old_for_1st_cycle")
-               || (this->GetPart() == "Old_for_3rd_cycle"))
+      else if ((this->GetPart() == DOpEtypes::StepPart::old_for_1st_cycle)
+               || (this->GetPart() == DOpEtypes::StepPart::old_for_3rd_cycle))
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector,
                                               scale * fs_beta_,
                                               0.);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector,
                                               scale * fs_beta_,
                                               scale);
         }
-      else if (this->GetPart() == "Old_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_for_2nd_cycle)
         {
           this->GetProblem().BoundaryEquation(fdc, local_vector,
                                               scale * fs_alpha_,
@@ -502,18 +552,20 @@ namespace DOpE
     BoundaryMatrix(const FDC &fdc,
                    dealii::FullMatrix<double> &local_matrix)
     {
-      if (this->GetPart() == "New_for_1st_and_3rd_cycle")
+      if (!this->AssembleMatrixTerms())
+        return;
+      if (this->GetPart() == DOpEtypes::StepPart::new_for_1st_and_3rd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
           m = 0.;
           this->GetProblem().BoundaryMatrix(fdc, m,
                                             fs_alpha_,
                                             1.);
           local_matrix.add(1.0, m);
         }
-      else if (this->GetPart() == "New_for_2nd_cycle")
+      else if (this->GetPart() == DOpEtypes::StepPart::new_for_2nd_cycle)
         {
-          dealii::FullMatrix<double> m(local_matrix);
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
           m = 0.;
           this->GetProblem().BoundaryMatrix(fdc, m,
                                             fs_beta_,
@@ -203,6 +203,18 @@ namespace DOpE
     {
     }
 
+    /**
+     * Same as Init_InterfaceEquation, but for the two-sided interface terms.
+     */
+    template<typename FDC>
+    void
+    Init_InterfaceEquationTwoSided(const FDC & /*fdc*/,
+                                   dealii::Vector<double> &/*local_vector*/,
+                                   dealii::Vector<double> &/*nbr_local_vector*/,
+                                   double /*scale*/, double /*scale_ico*/)
+    {
+    }
+
     /**
      * Same functionality as for the ElementEquation, but on Boundaries.
     * Note that no time derivatives may occure on faces of the domain at present!
@@ -261,6 +273,20 @@ namespace DOpE
     {
     }
 
+    /**
+     * Same as Init_InterfaceMatrix, but for the two-sided interface matrices.
+     */
+    template<typename FDC>
+    void
+    Init_InterfaceMatrixTwoSided(const FDC & /*fdc*/,
+                                 FullMatrix<double> &/*local_entry_matrix*/,
+                                 FullMatrix<double> &/*element_nbr_matrix*/,
+                                 FullMatrix<double> &/*nbr_element_matrix*/,
+                                 FullMatrix<double> &/*nbr_matrix*/,
+                                 double /*scale*/, double /*scale_ico*/)
+    {
+    }
+
     /**
      * Same functionality as for the ElementMatrix, but on Boundaries.
     * Note that no time derivatives may occure on faces of the domain at present!
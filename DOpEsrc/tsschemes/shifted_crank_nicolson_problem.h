@@ -98,40 +98,28 @@ namespace DOpE
     ElementEquation(const EDC &dc,
                     dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
 
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
           // implicit parts; e.g. for fluid problems: pressure and incompressibilty of v, get scaled with scale
           // The remaining parts; e.g. for fluid problems: laplace, convection, etc.:
           // Multiplication by 1/2 + k due to CN discretization
 
-          this->GetProblem().ElementEquation(dc, tmp, damped_cn_theta * scale, scale);
-          local_vector += tmp;
-
-          tmp = 0.0;
-          this->GetProblem().ElementTimeEquation(dc, tmp,
-                                                 scale);
-          local_vector += tmp;
+          this->AddElementAndTimeEquation(dc, local_vector, damped_cn_theta * scale, scale, scale);
 
           this->GetProblem().ElementTimeEquationExplicit(dc, local_vector,
                                                          scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
 
-          dealii::Vector<double> tmp(local_vector);
-          tmp = 0.0;
-
           // The explicit parts with old_time_values; e.g. for fluid problems: laplace, convection, etc.
           // Multiplication by 1/2 + k due to CN discretization
-          this->GetProblem().ElementEquation(dc, tmp, (1.0 - damped_cn_theta) * scale, 0.);
-          local_vector += tmp;
+          this->GetProblem().ElementEquation(dc, local_vector, (1.0 - damped_cn_theta) * scale, 0.);
 
           this->GetProblem().ElementTimeEquation(dc, local_vector,
                                                  (-1) * scale);
@@ -149,13 +137,13 @@ namespace DOpE
     ElementRhs(const EDC &edc,
                dealii::Vector<double> &local_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
           this->GetProblem().ElementRhs(edc, local_vector, damped_cn_theta * scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
@@ -176,14 +164,14 @@ namespace DOpE
       const std::map<std::string, const VECTOR *> &domain_values,
       VECTOR &rhs_vector, double scale)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
           this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
                                       damped_cn_theta * scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
@@ -203,27 +191,21 @@ namespace DOpE
     ElementMatrix(const EDC &edc,
                   dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
       damped_cn_theta = 0.5
                         + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
-      dealii::FullMatrix<double> m(local_matrix);
 
       // multiplication with 1/2 + k due to CN discretization for the 'normal' parts
       // no multiplication with 1/2 + k for the implicit parts
       //due to implicit treatment of pressure, etc. (in the case of fluid problems)
-      this->GetProblem().ElementMatrix(edc, local_matrix, damped_cn_theta, 1.);
+      this->AddElementAndTimeMatrix(edc, local_matrix, damped_cn_theta, 1., 1.);
 
-      m = 0.;
-      this->GetProblem().ElementTimeMatrix(edc, m);
-      local_matrix.add(
-        1.0,
-        m);
-
-      m = 0.;
-      this->GetProblem().ElementTimeMatrixExplicit(edc, m);
-      local_matrix.add(
-        1.0,
-        m);
+      if (this->AssembleMatrixTerms())
+        {
+          dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
+          this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+          local_matrix.add(1.0, m);
+        }
     }
 
     /******************************************************/
@@ -233,13 +215,13 @@ namespace DOpE
     FaceEquation(const FDC &fdc,
                  dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
           this->GetProblem().FaceEquation(fdc, local_vector, damped_cn_theta * scale, scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
@@ -259,14 +241,14 @@ namespace DOpE
     InterfaceEquation(const FDC &fdc,
                       dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
           this->GetProblem().InterfaceEquation(fdc, local_vector,
                                                damped_cn_theta * scale,scale );
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
@@ -296,11 +278,13 @@ namespace DOpE
     FaceMatrix(const FDC &fdc,
                dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       damped_cn_theta = 0.5
                         + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
 
-      dealii::FullMatrix<double> m(local_matrix);
+      dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
 
       m = 0.;
       // Multiplication with 1/2 + k due to CN time discretization
@@ -317,11 +301,13 @@ namespace DOpE
     InterfaceMatrix(const FDC &fdc,
                     dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       damped_cn_theta = 0.5
                         + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
 
-      dealii::FullMatrix<double> m(local_matrix);
+      dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
 
       m = 0.;
       // Multiplication with 1/2 + k due to CN time discretization
@@ -333,19 +319,79 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Same as InterfaceEquation, but for the two-sided interface terms
+     * with the weights of the one-sided terms.
+     */
+    template<typename FDC>
+    void
+    InterfaceEquationTwoSided(const FDC &fdc,
+                              dealii::Vector<double> &local_vector,
+                              dealii::Vector<double> &nbr_local_vector,
+                              double scale, double /*scale_ico*/)
+    {
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
+        {
+          damped_cn_theta = 0.5
+                            + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       damped_cn_theta * scale, scale);
+        }
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
+        {
+          damped_cn_theta = 0.5
+                            + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
+          this->GetProblem().InterfaceEquationTwoSided(fdc, local_vector,
+                                                       nbr_local_vector,
+                                                       (1.0 - damped_cn_theta) * scale, 0.);
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    /******************************************************/
+
+    /**
+     * Same as InterfaceMatrix, but for the two-sided interface matrices.
+     */
+    template<typename FDC>
+    void
+    InterfaceMatrixTwoSided(const FDC &fdc,
+                            dealii::FullMatrix<double> &local_entry_matrix,
+                            dealii::FullMatrix<double> &element_nbr_matrix,
+                            dealii::FullMatrix<double> &nbr_element_matrix,
+                            dealii::FullMatrix<double> &nbr_matrix)
+    {
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
+      damped_cn_theta = 0.5
+                        + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
+      // Multiplication with 1/2 + k due to CN time discretization
+      this->GetProblem().InterfaceMatrixTwoSided(fdc, local_entry_matrix,
+                                                 element_nbr_matrix,
+                                                 nbr_element_matrix, nbr_matrix,
+                                                 damped_cn_theta, 1.);
+    }
+
+    /******************************************************/
+
     template<typename FDC>
     void
     BoundaryEquation(const FDC &fdc,
                      dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
     {
-      if (this->GetPart() == "New")
+      if (this->GetPart() == DOpEtypes::StepPart::new_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
           this->GetProblem().BoundaryEquation(fdc, local_vector,
                                               damped_cn_theta * scale,scale);
         }
-      else if (this->GetPart() == "Old")
+      else if (this->GetPart() == DOpEtypes::StepPart::old_part)
         {
           damped_cn_theta = 0.5
                             + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
@@ -376,10 +422,12 @@ namespace DOpE
     BoundaryMatrix(const FDC &fdc,
                    dealii::FullMatrix<double> &local_matrix)
     {
-      assert(this->GetPart() == "New");
+      assert(this->GetPart() == DOpEtypes::StepPart::new_part);
+      if (!this->AssembleMatrixTerms())
+        return;
       damped_cn_theta = 0.5
                         + this->GetProblem().GetBaseProblem().GetSpaceTimeHandler()->GetStepSize();
-      dealii::FullMatrix<double> m(local_matrix);
+      dealii::FullMatrix<double> &m = this->GetScratchMatrix(local_matrix);
 
       m = 0.;
       // Multiplication with 1/2 + k due to CN time discretization
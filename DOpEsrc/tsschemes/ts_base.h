@@ -24,10 +24,34 @@
 #ifndef TSBase_H_
 #define TSBase_H_
 
+#include <basic/dopetypes.h>
+
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/vector.h>
 
+#include <type_traits>
+#include <utility>
+
 namespace DOpE
 {
+  namespace internal
+  {
+    /**
+     * Is true if the problem wrapped by a time stepping scheme provides the
+     * fused element kernels, see PDEInterface::HasFusedElementTerms.
+     * Only the StateProblem does so.
+     */
+    template <typename OPTPROBLEM, typename = void>
+    struct has_fused_element_terms : std::false_type
+    {};
+
+    template <typename OPTPROBLEM>
+    struct has_fused_element_terms<OPTPROBLEM,
+      decltype((void)std::declval<const OPTPROBLEM &>().HasFusedElementTerms())>
+      : std::true_type
+    {};
+  }
+
   /**
    * This class contains the methods which all time stepping schemes share.
    *
@@ -59,14 +83,78 @@ namespace DOpE
      * Sets the step part which should actually computed, e.g.,
      * previous solution within the NewtonStepSolver or
      * last time step solutions.
-     * @param s    Name of the step part
+     * @param s    The step part
      */
     void
-    SetStepPart(std::string s)
+    SetStepPart(DOpEtypes::StepPart s)
     {
       part_ = s;
     }
 
+    /**
+     * Same as above, but the step part is given by its name,
+     * see DOpEtypesToString(const DOpEtypes::StepPart&).
+     */
+    void
+    SetStepPart(const std::string &s)
+    {
+      for (DOpEtypes::StepPart p :
+           { DOpEtypes::StepPart::new_part, DOpEtypes::StepPart::old_part,
+             DOpEtypes::StepPart::new_for_1st_and_3rd_cycle,
+             DOpEtypes::StepPart::old_for_1st_cycle,
+             DOpEtypes::StepPart::new_for_2nd_cycle,
+             DOpEtypes::StepPart::old_for_2nd_cycle,
+             DOpEtypes::StepPart::old_for_3rd_cycle
+           })
+        {
+          if (s == DOpEtypesToString(p))
+            {
+              part_ = p;
+              return;
+            }
+        }
+      throw DOpEException("Unknown step part " + s, "TSBase::SetStepPart");
+    }
+
+    /******************************************************/
+
+    /**
+     * Selects which terms are assembled by the matrix functions
+     * of the scheme, see DOpEtypes::MatrixPart. This is used to
+     * keep a constant time matrix between the time steps.
+     *
+     * @param part    The terms to be assembled.
+     */
+    void
+    SetMatrixPart(DOpEtypes::MatrixPart part)
+    {
+      matrix_part_ = part;
+    }
+
+    /******************************************************/
+
+    /**
+     * See pdeinterface.h
+     */
+    bool
+    HasConstantTimeMatrix() const
+    {
+      return OP_.HasConstantTimeMatrix();
+    }
+
+    /******************************************************/
+
+    /**
+     * Returns the weight of the ElementTimeMatrix in the matrix
+     * of the actual step part. Schemes with a different weight
+     * need to hide this function.
+     */
+    double
+    GetTimeMatrixWeight() const
+    {
+      return 1.;
+    }
+
     /******************************************************/
 
     /**
@@ -191,6 +279,18 @@ namespace DOpE
       return OP_.HasInterfaces();
     }
 
+    /******************************************************/
+    /**
+     * Are the interface terms given by InterfaceEquationTwoSided and
+     * InterfaceMatrixTwoSided? The time stepping schemes forward them
+     * with the same weights as the one-sided interface terms.
+     */
+    bool
+    HasTwoSidedInterfaces() const
+    {
+      return OP_.HasTwoSidedInterfaces();
+    }
+
     /******************************************************/
     /**
      * Returns whether vertex information is needed
@@ -493,20 +593,171 @@ namespace DOpE
     /******************************************************/
 
     /**
-     * Sets the step part which should actually computed, e.g.,
-     * previous solution within the NewtonStepSolver or
-     * last time step solutions.
-     * @param s    Name of the step part
+     * Returns the step part which should actually computed, see SetStepPart.
      */
-    std::string
+    DOpEtypes::StepPart
     GetPart() const
     {
       return part_;
     }
 
+    /******************************************************/
+
+    /**
+     * Returns whether the terms of the matrix besides the
+     * ElementTimeMatrix need to be assembled, see SetMatrixPart.
+     */
+    bool
+    AssembleMatrixTerms() const
+    {
+      return matrix_part_ != DOpEtypes::MatrixPart::time_matrix_only;
+    }
+
+    /**
+     * Returns whether the ElementTimeMatrix needs to be assembled,
+     * see SetMatrixPart.
+     */
+    bool
+    AssembleTimeMatrix() const
+    {
+      return matrix_part_ != DOpEtypes::MatrixPart::without_time_matrix;
+    }
+
+    /**
+     * Returns the weight of the ElementTimeMatrix to be used in the
+     * matrix functions, i.e., the given weight of the scheme, or one if only
+     * the time matrix is assembled.
+     */
+    double
+    TimeMatrixWeight(double weight) const
+    {
+      return (matrix_part_ == DOpEtypes::MatrixPart::time_matrix_only) ? 1. : weight;
+    }
+
+    /******************************************************/
+    /**
+     * Returns a scratch matrix of the same size as local_matrix, which is
+     * set to zero. The storage is kept by the scheme, so that no
+     * allocation is needed on each element.
+     */
+    dealii::FullMatrix<double> &
+    GetScratchMatrix(const dealii::FullMatrix<double> &local_matrix)
+    {
+      if (scratch_matrix_.m() != local_matrix.m()
+          || scratch_matrix_.n() != local_matrix.n())
+        {
+          scratch_matrix_.reinit(local_matrix.m(), local_matrix.n());
+        }
+      else
+        {
+          scratch_matrix_ = 0.;
+        }
+      return scratch_matrix_;
+    }
+
+    /******************************************************/
+    /**
+     * Adds ElementEquation(edc, local_vector, scale, scale_ico) and
+     * ElementTimeEquation(edc, local_vector, scale_time) of the problem
+     * to local_vector. If the PDE implements the fused element terms,
+     * see PDEInterface::HasFusedElementTerms, both are computed in one call.
+     */
+    template<typename EDC>
+    void
+    AddElementAndTimeEquation(const EDC &edc,
+                              dealii::Vector<double> &local_vector,
+                              double scale, double scale_ico, double scale_time)
+    {
+      if (UseFusedElementTerms(internal::has_fused_element_terms<OPTPROBLEM>()))
+        {
+          FusedElementEquation(edc, local_vector, scale, scale_ico, scale_time,
+                               internal::has_fused_element_terms<OPTPROBLEM>());
+        }
+      else
+        {
+          OP_.ElementEquation(edc, local_vector, scale, scale_ico);
+          OP_.ElementTimeEquation(edc, local_vector, scale_time);
+        }
+    }
+
+    /**
+     * Adds ElementMatrix(edc, local_matrix, scale, scale_ico) and the
+     * ElementTimeMatrix weighted by TimeMatrixWeight(time_weight) to
+     * local_matrix, as far as they are selected by SetMatrixPart.
+     * If both are needed and the PDE implements the fused element terms,
+     * they are computed in one call.
+     */
+    template<typename EDC>
+    void
+    AddElementAndTimeMatrix(const EDC &edc,
+                            dealii::FullMatrix<double> &local_matrix,
+                            double scale, double scale_ico, double time_weight)
+    {
+      if (AssembleMatrixTerms() && AssembleTimeMatrix()
+          && UseFusedElementTerms(internal::has_fused_element_terms<OPTPROBLEM>()))
+        {
+          FusedElementMatrix(edc, local_matrix, scale, scale_ico, time_weight,
+                             internal::has_fused_element_terms<OPTPROBLEM>());
+          return;
+        }
+      if (AssembleMatrixTerms())
+        {
+          OP_.ElementMatrix(edc, local_matrix, scale, scale_ico);
+        }
+      if (AssembleTimeMatrix())
+        {
+          dealii::FullMatrix<double> &m = GetScratchMatrix(local_matrix);
+          OP_.ElementTimeMatrix(edc, m);
+          local_matrix.add(TimeMatrixWeight(time_weight), m);
+        }
+    }
+
   private:
+    bool
+    UseFusedElementTerms(std::true_type) const
+    {
+      return OP_.HasFusedElementTerms();
+    }
+    bool
+    UseFusedElementTerms(std::false_type) const
+    {
+      return false;
+    }
+
+    template<typename EDC>
+    void
+    FusedElementEquation(const EDC &edc, dealii::Vector<double> &local_vector,
+                         double scale, double scale_ico, double scale_time,
+                         std::true_type)
+    {
+      OP_.ElementEquationAndTimeEquation(edc, local_vector, scale, scale_ico, scale_time);
+    }
+    template<typename EDC>
+    void
+    FusedElementEquation(const EDC &, dealii::Vector<double> &,
+                         double, double, double, std::false_type)
+    {
+    }
+
+    template<typename EDC>
+    void
+    FusedElementMatrix(const EDC &edc, dealii::FullMatrix<double> &local_matrix,
+                       double scale, double scale_ico, double time_weight,
+                       std::true_type)
+    {
+      OP_.ElementMatrixAndTimeMatrix(edc, local_matrix, scale, scale_ico, time_weight);
+    }
+    template<typename EDC>
+    void
+    FusedElementMatrix(const EDC &, dealii::FullMatrix<double> &,
+                       double, double, double, std::false_type)
+    {
+    }
+
     OPTPROBLEM &OP_;
-    std::string part_;
+    DOpEtypes::StepPart part_ = DOpEtypes::StepPart::new_part;
+    DOpEtypes::MatrixPart matrix_part_ = DOpEtypes::MatrixPart::all_terms;
+    dealii::FullMatrix<double> scratch_matrix_;
   };
 }
 #endif
@@ -30,6 +30,8 @@
 #endif
 #include <deal.II/fe/fe_system.h>
 
+#include <include/pointevaluationcache.h>
+
 namespace DOpEWrapper
 {
 #if DEAL_II_VERSION_GTE(9,3,0)
@@ -66,6 +68,47 @@ namespace DOpEWrapper
       return *this;
     }
 
+    /**
+     * Computes the values of the finite element function v in the
+     * point p. The element containing p and the shape values are
+     * stored, so repeated evaluations in the same point, e.g., in
+     * each time step, do not need to search the mesh.
+     * This can replace dealii::VectorTools::point_value for the state
+     * DoFHandler, the Integrator prepares the stored points before
+     * evaluating point functionals and point right hand sides, see
+     * PointEvaluationCache::Prepare.
+     */
+    template<typename VECTOR>
+    void
+    PointValue(const VECTOR &v, const dealii::Point<dim> &p,
+               dealii::Vector<double> &values) const
+    {
+      point_cache_.PointValue(GetDEALDoFHandler(), v, p, values);
+    }
+
+    /**
+     * Adds the point source with the given weights for each
+     * component in p to rhs, see DOpE::PointEvaluationCache.
+     */
+    template<typename VECTOR>
+    void
+    AddPointSource(const dealii::Point<dim> &p,
+                   const dealii::Vector<double> &weights, VECTOR &rhs) const
+    {
+      point_cache_.AddPointSource(GetDEALDoFHandler(), p, weights, rhs);
+    }
+
+    /**
+     * Returns the cache used by PointValue and AddPointSource.
+     */
+    DOpE::PointEvaluationCache<dim> &
+    GetPointEvaluationCache() const
+    {
+      return point_cache_;
+    }
+
+  private:
+    mutable DOpE::PointEvaluationCache<dim> point_cache_;
   };
 
   /**
@@ -164,6 +207,47 @@ namespace DOpEWrapper
       return *this;
     }
 
+    /**
+     * Computes the values of the finite element function v in the
+     * point p. The element containing p and the shape values are
+     * stored, so repeated evaluations in the same point, e.g., in
+     * each time step, do not need to search the mesh.
+     * This can replace dealii::VectorTools::point_value for the state
+     * DoFHandler, the Integrator prepares the stored points before
+     * evaluating point functionals and point right hand sides, see
+     * PointEvaluationCache::Prepare.
+     */
+    template<typename VECTOR>
+    void
+    PointValue(const VECTOR &v, const dealii::Point<dim> &p,
+               dealii::Vector<double> &values) const
+    {
+      point_cache_.PointValue(GetDEALDoFHandler(), v, p, values);
+    }
+
+    /**
+     * Adds the point source with the given weights for each
+     * component in p to rhs, see DOpE::PointEvaluationCache.
+     */
+    template<typename VECTOR>
+    void
+    AddPointSource(const dealii::Point<dim> &p,
+                   const dealii::Vector<double> &weights, VECTOR &rhs) const
+    {
+      point_cache_.AddPointSource(GetDEALDoFHandler(), p, weights, rhs);
+    }
+
+    /**
+     * Returns the cache used by PointValue and AddPointSource.
+     */
+    DOpE::PointEvaluationCache<dim> &
+    GetPointEvaluationCache() const
+    {
+      return point_cache_;
+    }
+
+  private:
+    mutable DOpE::PointEvaluationCache<dim> point_cache_;
   };
 
   //Template specialization DOFHANDLER = dealii::DoFHandler<dim>
@@ -181,6 +265,47 @@ namespace DOpEWrapper
       return *this;
     }
 
+    /**
+     * Computes the values of the finite element function v in the
+     * point p. The element containing p and the shape values are
+     * stored, so repeated evaluations in the same point, e.g., in
+     * each time step, do not need to search the mesh.
+     * This can replace dealii::VectorTools::point_value for the state
+     * DoFHandler, the Integrator prepares the stored points before
+     * evaluating point functionals and point right hand sides, see
+     * PointEvaluationCache::Prepare.
+     */
+    template<typename VECTOR>
+    void
+    PointValue(const VECTOR &v, const dealii::Point<dim> &p,
+               dealii::Vector<double> &values) const
+    {
+      point_cache_.PointValue(GetDEALDoFHandler(), v, p, values);
+    }
+
+    /**
+     * Adds the point source with the given weights for each
+     * component in p to rhs, see DOpE::PointEvaluationCache.
+     */
+    template<typename VECTOR>
+    void
+    AddPointSource(const dealii::Point<dim> &p,
+                   const dealii::Vector<double> &weights, VECTOR &rhs) const
+    {
+      point_cache_.AddPointSource(GetDEALDoFHandler(), p, weights, rhs);
+    }
+
+    /**
+     * Returns the cache used by PointValue and AddPointSource.
+     */
+    DOpE::PointEvaluationCache<dim> &
+    GetPointEvaluationCache() const
+    {
+      return point_cache_;
+    }
+
+  private:
+    mutable DOpE::PointEvaluationCache<dim> point_cache_;
   };
 
   //Template specialization DOFHANDLER = dealii::hp::DoFHandler<dim>
@@ -198,6 +323,48 @@ namespace DOpEWrapper
     {
       return *this;
     }
+
+    /**
+     * Computes the values of the finite element function v in the
+     * point p. The element containing p and the shape values are
+     * stored, so repeated evaluations in the same point, e.g., in
+     * each time step, do not need to search the mesh.
+     * This can replace dealii::VectorTools::point_value for the state
+     * DoFHandler, the Integrator prepares the stored points before
+     * evaluating point functionals and point right hand sides, see
+     * PointEvaluationCache::Prepare.
+     */
+    template<typename VECTOR>
+    void
+    PointValue(const VECTOR &v, const dealii::Point<dim> &p,
+               dealii::Vector<double> &values) const
+    {
+      point_cache_.PointValue(GetDEALDoFHandler(), v, p, values);
+    }
+
+    /**
+     * Adds the point source with the given weights for each
+     * component in p to rhs, see DOpE::PointEvaluationCache.
+     */
+    template<typename VECTOR>
+    void
+    AddPointSource(const dealii::Point<dim> &p,
+                   const dealii::Vector<double> &weights, VECTOR &rhs) const
+    {
+      point_cache_.AddPointSource(GetDEALDoFHandler(), p, weights, rhs);
+    }
+
+    /**
+     * Returns the cache used by PointValue and AddPointSource.
+     */
+    DOpE::PointEvaluationCache<dim> &
+    GetPointEvaluationCache() const
+    {
+      return point_cache_;
+    }
+
+  private:
+    mutable DOpE::PointEvaluationCache<dim> point_cache_;
   };
 
   /**
@@ -28,6 +28,23 @@
 #include <deal.II/lac/precondition_block.h>
 #include <deal.II/lac/sparse_ilu.h>
 
+#ifdef DOPELIB_WITH_TRILINOS
+#include <deal.II/base/point.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/lac/trilinos_precondition.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <ml_MultiLevelPreconditioner.h>
+
+#include <basic/dopetypes.h>
+#include <include/dopeexception.h>
+
+#include <map>
+#include <vector>
+#endif
+
 /**
  * @file preconditioner_wrapper.h
  *
@@ -125,6 +142,218 @@ namespace DOpEWrapper
       dealii::SparseILU<number>::initialize(A);
     }
   };
+#ifdef DOPELIB_WITH_TRILINOS
+  /**
+    * @class PreconditionAMG_Wrapper
+    *
+    * Wrapper for the dealii::TrilinosWrappers::PreconditionAMG preconditioner,
+    * i.e., the smoothed aggregation multigrid of ML.
+    *
+    * The multigrid hierarchy is build in the first call of initialize.
+    * Further calls with the same matrix only recompute the smoothers and
+    * coarse grid operators from the new entries, while the aggregates
+    * are kept, i.e., the expensive setup is done once per sparsity pattern
+    * and not in every newton step. The linear solvers create a new
+    * preconditioner in ReInit, i.e., whenever the sparsity pattern changes.
+    *
+    * If the linear solver calls SetDoFData before the first initialize,
+    * the near null space is passed to ML. It consists of the constant mode
+    * of each component and, if rigid_body_modes is true, of the rotations
+    * computed from the support points of the DoFs. In this case
+    * the first dim components need to be the displacements.
+    *
+    * @tparam <MATRIX>             The used matrix type, must be a TrilinosWrappers::SparseMatrix
+    * @tparam <rigid_body_modes>   Whether the rotations are part of the near null space,
+    *                              as needed for elasticity-type problems.
+    */
+  template <typename MATRIX, bool rigid_body_modes = false>
+  class PreconditionAMG_Wrapper : public dealii::TrilinosWrappers::PreconditionAMG
+  {
+  public:
+    void initialize(const MATRIX &A)
+    {
+      if (matrix_ == &A && n_rows_ == A.m())
+        {
+          dealii::TrilinosWrappers::PreconditionAMG::reinit();
+          return;
+        }
+      matrix_ = &A;
+      n_rows_ = A.m();
+
+      Teuchos::ParameterList parameter_list;
+      ML_Epetra::SetDefaults("SA", parameter_list);
+      parameter_list.set("smoother: type", "Chebyshev");
+      parameter_list.set("smoother: sweeps", 2);
+      parameter_list.set("aggregation: threshold", 1.e-4);
+      parameter_list.set("coarse: type", "Amesos-KLU");
+      parameter_list.set("coarse: max size", 2000);
+      parameter_list.set("ML output", 0);
+
+      const unsigned int n_modes = BuildNullSpace(A);
+      if (n_modes > 0)
+        {
+          parameter_list.set("null space: type", "pre-computed");
+          parameter_list.set("null space: dimension", static_cast<int>(n_modes));
+          parameter_list.set("null space: vectors", null_space_.data());
+        }
+      dealii::TrilinosWrappers::PreconditionAMG::initialize(A, parameter_list);
+    }
+
+    /**
+     * Returns true if the next call of initialize builds a new hierarchy
+     * and hence needs the data given to SetDoFData.
+     */
+    bool NeedsDoFData() const
+    {
+      return matrix_ == NULL;
+    }
+
+    /**
+     * Stores the information on the DoFs needed for the near null space.
+     *
+     * @param mapping          The mapping used to compute the support points.
+     * @param dof_handler      The DoFHandler the matrix belongs to.
+     */
+    template <int dim>
+    void SetDoFData(const dealii::Mapping<dim> &mapping,
+                    const dealii::DoFHandler<dim> &dof_handler)
+    {
+      constant_modes_.clear();
+      dealii::DoFTools::extract_constant_modes(dof_handler, dealii::ComponentMask(), constant_modes_);
+      coordinates_.clear();
+      if (rigid_body_modes)
+        {
+          if (constant_modes_.size() < dim)
+            {
+              throw DOpEException("Rigid body modes need at least dim components.",
+                                  "PreconditionAMG_Wrapper::SetDoFData");
+            }
+          //Only the locally relevant support points are computed.
+          std::map<dealii::types::global_dof_index, dealii::Point<dim> > support_points;
+          dealii::DoFTools::map_dofs_to_support_points(mapping, dof_handler, support_points);
+          const dealii::IndexSet &owned = dof_handler.locally_owned_dofs();
+          coordinates_.resize(dim, std::vector<double>(owned.n_elements()));
+          unsigned int i = 0;
+          for (auto dof : owned)
+            {
+              for (unsigned int d = 0; d < dim; d++)
+                coordinates_[d][i] = support_points[dof][d];
+              i++;
+            }
+        }
+    }
+
+  private:
+    /**
+     * Fills null_space_ column wise for the locally owned rows of A.
+     * Returns the number of modes, zero if no DoF data is given.
+     */
+    unsigned int BuildNullSpace(const MATRIX &A)
+    {
+      null_space_.clear();
+      if (constant_modes_.empty())
+        return 0;
+      const unsigned int n_local = A.local_range().second - A.local_range().first;
+      for (unsigned int c = 0; c < constant_modes_.size(); c++)
+        {
+          if (constant_modes_[c].size() != n_local)
+            {
+              throw DOpEException("The DoF data does not fit the matrix.",
+                                  "PreconditionAMG_Wrapper::initialize");
+            }
+        }
+      const unsigned int n_comp = constant_modes_.size();
+      const unsigned int dim = coordinates_.size();
+      const unsigned int n_rot = (dim == 2) ? 1 : ((dim == 3) ? 3 : 0);
+      const unsigned int n_modes = n_comp + n_rot;
+      null_space_.assign(n_modes * n_local, 0.);
+
+      for (unsigned int i = 0; i < n_local; i++)
+        {
+          for (unsigned int c = 0; c < n_comp; c++)
+            if (constant_modes_[c][i])
+              null_space_[c * n_local + i] = 1.;
+
+          if (n_rot == 0)
+            continue;
+          //The rotations act on the displacements only.
+          const double x = coordinates_[0][i];
+          const double y = coordinates_[1][i];
+          double *rot = &null_space_[n_comp * n_local];
+          if (dim == 2)
+            {
+              if (constant_modes_[0][i])
+                rot[i] = -y;
+              else if (constant_modes_[1][i])
+                rot[i] = x;
+            }
+          else
+            {
+              const double z = coordinates_[2][i];
+              //Rotations around the z-, x- and y-axis.
+              if (constant_modes_[0][i])
+                {
+                  rot[i] = -y;
+                  rot[2 * n_local + i] = z;
+                }
+              else if (constant_modes_[1][i])
+                {
+                  rot[i] = x;
+                  rot[n_local + i] = -z;
+                }
+              else if (constant_modes_[2][i])
+                {
+                  rot[n_local + i] = y;
+                  rot[2 * n_local + i] = -x;
+                }
+            }
+        }
+      return n_modes;
+    }
+
+    const MATRIX *matrix_ = NULL;
+    unsigned int n_rows_ = 0;
+    std::vector<std::vector<bool> > constant_modes_;
+    std::vector<std::vector<double> > coordinates_;
+    std::vector<double> null_space_;
+  };
+#endif
+
+  /**
+   * Provides the preconditioner with information on the discretization
+   * of pde before the linear solvers call initialize. Nothing needs to
+   * be done for most preconditioners, overloads exist for those that
+   * need more than the matrix.
+   */
+  template <typename PRECONDITIONER, typename PROBLEM>
+  void SetDiscretizationData(PRECONDITIONER & /*precondition*/, PROBLEM & /*pde*/)
+  {
+  }
+
+#ifdef DOPELIB_WITH_TRILINOS
+  /**
+   * The AMG preconditioner takes the DoFHandler the matrix of pde belongs to,
+   * i.e., the control DoFHandler for problems posed in the control space
+   * and the state DoFHandler otherwise, together with the mapping of the
+   * SpaceTimeHandler. This is only done when a new hierarchy is build.
+   */
+  template <typename MATRIX, bool rigid_body_modes, typename PROBLEM>
+  void SetDiscretizationData(PreconditionAMG_Wrapper<MATRIX, rigid_body_modes> &precondition,
+                             PROBLEM &pde)
+  {
+    if (precondition.NeedsDoFData())
+      {
+        auto *sth = pde.GetBaseProblem().GetSpaceTimeHandler();
+        const auto &dof_handlers = sth->GetDoFHandler();
+        //The same choice of the index as in the ElementDataContainer.
+        unsigned int index = sth->GetStateIndex();
+        if (pde.GetDoFType() == DOpEtypes::VectorType::control && dof_handlers.size() > 1)
+          index = (index == 1) ? 0 : 1;
+        precondition.SetDoFData(sth->GetMapping(),
+                                dof_handlers[index]->GetDEALDoFHandler());
+      }
+  }
+#endif
 }
 
 #endif
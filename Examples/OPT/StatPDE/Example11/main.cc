@@ -0,0 +1,234 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+#include <iostream>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/trilinos_sparsity_pattern.h>
+#include <deal.II/lac/trilinos_vector.h>
+
+#include <opt_algorithms/reducednewtonalgorithm.h>
+#include <container/optproblemcontainer.h>
+#include <interfaces/functionalinterface.h>
+#include <reducedproblems/statreducedproblem.h>
+#include <templates/gmreslinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_spacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <problemdata/noconstraints.h>
+#include <parallel/newtonsolver.h>
+#include <wrapper/preconditioner_wrapper.h>
+#include <container/integratordatacontainer.h>
+
+#include "localpde.h"
+#include "localfunctional.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+//Some abbreviations for better readability
+const static int DIM = 2;
+const static int CDIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+
+#if defined(DOPELIB_WITH_TRILINOS) && defined(DOPELIB_WITH_MPI)
+#if DEAL_II_VERSION_GTE(9,0,0)
+typedef TrilinosWrappers::SparseMatrix MATRIX;
+typedef TrilinosWrappers::SparsityPattern SPARSITYPATTERN;
+typedef TrilinosWrappers::MPI::Vector VECTOR;
+
+typedef LocalFunctional<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> COSTFUNCTIONAL;
+typedef FunctionalInterface<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> FUNCTIONALINTERFACE;
+
+typedef OptProblemContainer<FUNCTIONALINTERFACE, COSTFUNCTIONAL,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM>, SPARSITYPATTERN,
+        VECTOR, CDIM, DIM> OP;
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+
+typedef GMRESLinearSolverWithMatrix<
+DOpEWrapper::PreconditionIdentity_Wrapper<MATRIX>, SPARSITYPATTERN, MATRIX,
+            VECTOR> LINEARSOLVER;
+
+typedef Parallel::NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+
+typedef ReducedNewtonAlgorithm<OP, VECTOR> RNA;
+
+typedef StatReducedProblem<NLS, NLS, INTEGRATOR, INTEGRATOR, OP, VECTOR, CDIM,
+        DIM> RP;
+
+typedef MethodOfLines_SpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+        CDIM, DIM> STH;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * The optimization problem of OPT/StatPDE/Example1 on a distributed
+   * triangulation. State and control are trilinos MPI vectors, hence the
+   * scalar products and norms of the ReducedNewtonAlgorithm are computed
+   * over all processes. Run it with mpirun, the optimal value has to agree
+   * with the one of the sequential run.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+  const unsigned int c_fe_order = 1;
+  const unsigned int s_fe_order = 2;
+  const unsigned int q_order = std::max(c_fe_order, s_fe_order) + 1;
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  RNA::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+
+  pr.read_parameters(paramfile);
+
+  dealii::parallel::distributed::Triangulation<DIM> triangulation(
+    MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(5);
+
+  FE<CDIM> control_fe(FE_Q<CDIM>(c_fe_order), 1);
+  FE<DIM> state_fe(FE_Q<DIM>(s_fe_order), 1);
+
+  QUADRATURE quadrature_formula(q_order);
+  FACEQUADRATURE face_quadrature_formula(q_order);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+  const double alpha = 1.e-3;
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(alpha);
+  COSTFUNCTIONAL LFunc(alpha);
+
+  STH DOFH(triangulation, control_fe, state_fe, DOpEtypes::stationary);
+
+  NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> Constraints;
+
+  OP P(LFunc, LPDE, Constraints, DOFH);
+
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+  DOpEWrapper::ZeroFunction<2> zf(1);
+
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc, 2);
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  RNA Alg(&P, &solver, pr, &ex, &out);
+
+  Alg.ReInit();
+  out.ReInit();
+  ControlVector<VECTOR> q(&DOFH, DOpEtypes::VectorStorageType::fullmem,pr);
+
+  const double ex_value = 1. / 8. * (25 * M_PI * M_PI * M_PI * M_PI + 1. / alpha);
+  //The value of the sequential run of OPT/StatPDE/Example1 on this mesh.
+  const double seq_value = 429.404;
+
+  try
+    {
+      Alg.Solve(q);
+
+      const double value = solver.GetFunctionalValue(LFunc.GetName());
+      stringstream outp;
+      outp << "Processes: " << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+           << "\t Exact Value: " << ex_value << "\t Computed: " << value
+           << std::endl;
+      out.Write(outp, 1, 1, 1);
+
+      if (std::fabs(value - seq_value) > 1.e-5 * seq_value)
+        {
+          std::cout << "The distributed optimization does not reproduce the sequential value "
+                    << seq_value << ", computed " << value << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+#else //Dealii version too low.
+int
+main(int /*argc*/, char **/*argv*/)
+{
+  std::cout<<"This example requires deal.II v. 9.0.0 or newer"<<std::endl;
+  abort();
+}
+#endif
+#else
+int
+main(int /*argc*/, char **/*argv*/)
+{
+  std::cout<<"This example requires DOpE with  Trilinos and MPI"<<std::endl;
+  abort();
+}
+#endif //Dopelib with trilinos
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
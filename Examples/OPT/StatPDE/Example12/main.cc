@@ -0,0 +1,300 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <iostream>
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <opt_algorithms/reducednewtonalgorithm.h>
+#include <container/optproblemcontainer.h>
+#include <interfaces/functionalinterface.h>
+#include <reducedproblems/statreducedproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/cglinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_spacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <problemdata/noconstraints.h>
+#include <wrapper/preconditioner_wrapper.h>
+#include <container/integratordatacontainer.h>
+
+#include "localpde.h"
+#include "localfunctional.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+//Some abbreviations for better readability
+const static int DIM = 2;
+const static int CDIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef LocalFunctional<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> COSTFUNCTIONAL;
+typedef FunctionalInterface<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> FUNCTIONALINTERFACE;
+
+typedef OptProblemContainer<FUNCTIONALINTERFACE, COSTFUNCTIONAL,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM>, SPARSITYPATTERN,
+        VECTOR, CDIM, DIM> OP;
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+
+typedef CGLinearSolverWithMatrix<
+DOpEWrapper::PreconditionIdentity_Wrapper<MATRIX>, SPARSITYPATTERN, MATRIX,
+            VECTOR> LINEARSOLVER;
+
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+
+typedef ReducedNewtonAlgorithm<OP, VECTOR> RNA;
+
+typedef StatReducedProblem<NLS, NLS, INTEGRATOR, INTEGRATOR, OP, VECTOR, CDIM,
+        DIM> RP;
+
+typedef MethodOfLines_SpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+        CDIM, DIM> STH;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * The distributed control problem of OPT/StatPDE/Example1. We check
+   * the gradient and the hessian in two directions, once with the
+   * reduced problem alone and once with a second instance of the
+   * reduced problem that evaluates half of the difference quotients
+   * concurrently. Both tables have to agree. The checks are done around
+   * the nonzero control q = 0.5, and since the cost functional is
+   * quadratic the difference quotients have to match the gradient.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+  const unsigned int c_fe_order = 1;
+  const unsigned int s_fe_order = 2;
+  const unsigned int q_order = std::max(c_fe_order, s_fe_order) + 1;
+  const unsigned int niter = 3;
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  RNA::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+
+  pr.read_parameters(paramfile);
+
+  //The second instance writes into its own logfile.
+  ParameterReader pr_instance;
+  RP::declare_params(pr_instance);
+  RNA::declare_params(pr_instance);
+  DOpEOutputHandler<VECTOR>::declare_params(pr_instance);
+  pr_instance.read_parameters(paramfile);
+  pr_instance.SetSubsection("output parameters");
+  pr_instance.set("logfile", "dope_instance.log");
+
+  FE<CDIM> control_fe(FE_Q<CDIM>(c_fe_order), 1);
+  FE<DIM> state_fe(FE_Q<DIM>(s_fe_order), 1);
+  const double alpha = 1.e-3;
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+  DOpEWrapper::ZeroFunction<2> zf(1);
+
+  //The reduced problem
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(4);
+
+  QUADRATURE quadrature_formula(q_order);
+  FACEQUADRATURE face_quadrature_formula(q_order);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(alpha);
+  COSTFUNCTIONAL LFunc(alpha);
+  STH DOFH(triangulation, control_fe, state_fe, DOpEtypes::stationary);
+  NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> Constraints;
+  OP P(LFunc, LPDE, Constraints, DOFH);
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc, 2);
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+
+  //The second instance of the same problem, nothing that is modified
+  //during a solve may be shared with the first one.
+  Triangulation<DIM> triangulation_instance;
+  GridGenerator::hyper_cube(triangulation_instance, 0, 1);
+  triangulation_instance.refine_global(4);
+
+  QUADRATURE quadrature_formula_instance(q_order);
+  FACEQUADRATURE face_quadrature_formula_instance(q_order);
+  IDC idc_instance(quadrature_formula_instance, face_quadrature_formula_instance);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE_instance(alpha);
+  COSTFUNCTIONAL LFunc_instance(alpha);
+  STH DOFH_instance(triangulation_instance, control_fe, state_fe, DOpEtypes::stationary);
+  NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> Constraints_instance;
+  OP P_instance(LFunc_instance, LPDE_instance, Constraints_instance, DOFH_instance);
+  SimpleDirichletData<VECTOR, DIM> DD_instance(zf);
+  P_instance.SetDirichletBoundaryColors(0, comp_mask, &DD_instance);
+
+  RP solver_instance(&P_instance, DOpEtypes::VectorStorageType::fullmem, pr_instance,
+                     idc_instance, 2);
+  DOpEOutputHandler<VECTOR> out_instance(&solver_instance, pr_instance);
+  DOpEExceptionHandler<VECTOR> ex_instance(&out_instance);
+  P_instance.RegisterOutputHandler(&out_instance);
+  P_instance.RegisterExceptionHandler(&ex_instance);
+  solver_instance.RegisterOutputHandler(&out_instance);
+  solver_instance.RegisterExceptionHandler(&ex_instance);
+
+  RNA Alg(&P, &solver, pr, &ex, &out);
+  RNA Alg_concurrent(&P, &solver, pr, &ex, &out);
+  Alg_concurrent.AddReducedProblemInstance(&solver_instance);
+
+  Alg.ReInit();
+  solver_instance.ReInit();
+  out.ReInit();
+  out_instance.ReInit();
+
+  ControlVector<VECTOR> q(&DOFH, DOpEtypes::VectorStorageType::fullmem, pr);
+  ControlVector<VECTOR> dq1(q), dq2(q);
+  //A nonzero control, the difference quotients are taken around q.
+  q = 0.5;
+  dq1 = 1.;
+  //A second, non constant direction
+  dq2 = 1.;
+  dq2.GetSpacialVector()(0) = 2.;
+  std::vector<const ControlVector<VECTOR>*> directions;
+  directions.push_back(&dq1);
+  directions.push_back(&dq2);
+
+  try
+    {
+      Alg.CheckGrads(q, directions, niter);
+      Alg_concurrent.CheckGrads(q, directions, niter);
+      Alg.CheckHessian(q, directions, niter);
+      Alg_concurrent.CheckHessian(q, directions, niter);
+
+      //The same cost functional evaluations as in the tables above.
+      //The copy constructor only copies the layout of q, and the
+      //reserved capacity avoids copies on reallocation.
+      std::vector<ControlVector<VECTOR> > points;
+      points.reserve(2 * directions.size() * niter);
+      std::vector<double> epsilons;
+      for (unsigned int k = 0; k < directions.size(); k++)
+        {
+          double eps = 1.;
+          for (unsigned int i = 0; i < niter; i++)
+            {
+              epsilons.push_back(eps);
+              points.push_back(q);
+              points.back() = q;
+              points.back().add(eps, *directions[k]);
+              points.push_back(q);
+              points.back() = q;
+              points.back().add(-eps, *directions[k]);
+              eps /= 10.;
+            }
+        }
+      std::vector<double> costs, costs_concurrent;
+      Alg.ComputeReducedCostFunctionals(points, costs);
+      Alg_concurrent.ComputeReducedCostFunctionals(points, costs_concurrent);
+      for (unsigned int i = 0; i < points.size(); i++)
+        {
+          if (std::fabs(costs[i] - costs_concurrent[i]) > 1.e-12 * std::fabs(costs[i]))
+            {
+              std::cout << "The concurrent evaluation does not reproduce the sequential cost "
+                        << costs[i] << ", computed " << costs_concurrent[i] << std::endl;
+              return 1;
+            }
+        }
+
+      //The cost functional is quadratic, so the central difference
+      //quotients around q have to agree with the gradient at q.
+      ControlVector<VECTOR> gradient(q), gradient_transposed(q);
+      solver.ComputeReducedCostFunctional(q);
+      solver.ComputeReducedGradient(q, gradient, gradient_transposed);
+      for (unsigned int k = 0; k < directions.size(); k++)
+        {
+          const double exact = gradient * (*directions[k]);
+          for (unsigned int i = 0; i < niter; i++)
+            {
+              const unsigned int pos = 2 * (k * niter + i);
+              const double diffquot = (costs[pos] - costs[pos + 1]) / (2. * epsilons[k * niter + i]);
+              if (std::fabs(diffquot - exact) > 1.e-6 * std::fabs(exact))
+                {
+                  std::cout << "The difference quotient " << diffquot << " around q does not "
+                            << "match the gradient " << exact << std::endl;
+                  return 1;
+                }
+            }
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
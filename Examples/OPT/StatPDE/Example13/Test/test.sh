@@ -0,0 +1,16 @@
+#!/bin/bash
+if [ $# -ne 1 ]
+    then
+    echo "Usage: "$0" [Test|Store]"
+    exit 1
+fi
+
+PROGRAM=../DOpE-OPT-StatPDE-Example13
+
+#This example checks its results itself, there is no reference log.
+if [ $1 == "Store" ]
+then
+    echo "No log is stored for this example."
+    exit 0
+fi
+bash ../../../../test-single.sh Check $PROGRAM
@@ -0,0 +1,260 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <iostream>
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <container/optproblemcontainer.h>
+#include <interfaces/functionalinterface.h>
+#include <reducedproblems/statreducedproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_spacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <problemdata/noconstraints.h>
+#include <container/integratordatacontainer.h>
+
+#include "localpde.h"
+#include "localfunctional.h"
+#include "counting_directlinearsolver.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+//Some abbreviations for better readability
+const static int DIM = 2;
+const static int CDIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef LocalFunctional<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> COSTFUNCTIONAL;
+typedef FunctionalInterface<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> FUNCTIONALINTERFACE;
+
+typedef OptProblemContainer<FUNCTIONALINTERFACE, COSTFUNCTIONAL,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM>, SPARSITYPATTERN,
+        VECTOR, CDIM, DIM> OP;
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+
+typedef CountingDirectLinearSolver<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+
+typedef StatReducedProblem<NLS, NLS, INTEGRATOR, INTEGRATOR, OP, VECTOR, CDIM,
+        DIM> RP;
+
+typedef MethodOfLines_SpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+        CDIM, DIM> STH;
+
+/**
+ * The StatReducedProblem, giving access to the linear solver of the state
+ * equation to read its counter.
+ */
+class CountingStatReducedProblem : public RP
+{
+public:
+  using RP::RP;
+
+  const LINEARSOLVER &
+  GetLinearSolver()
+  {
+    return this->GetNonlinearSolver("state");
+  }
+};
+
+/**
+ * Evaluates the cost functional at the accepted controls q = 0.5 and q = 1,
+ * then at the rejected trial control q = -1, and finally again at q = 0.5.
+ * Returns the last value of the cost functional. The number of Newton
+ * steps needed for the last evaluation is returned in n_steps.
+ */
+double
+evaluate(ParameterReader &param_reader, unsigned int &n_steps)
+{
+  const unsigned int c_fe_order = 1;
+  const unsigned int s_fe_order = 2;
+  const unsigned int q_order = std::max(c_fe_order, s_fe_order) + 1;
+
+  FE<CDIM> control_fe(FE_Q<CDIM>(c_fe_order), 1);
+  FE<DIM> state_fe(FE_Q<DIM>(s_fe_order), 1);
+  const double alpha = 1.e-3;
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+  DOpEWrapper::ZeroFunction<2> zf(1);
+
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(4);
+
+  QUADRATURE quadrature_formula(q_order);
+  FACEQUADRATURE face_quadrature_formula(q_order);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(alpha);
+  COSTFUNCTIONAL LFunc(alpha);
+  STH DOFH(triangulation, control_fe, state_fe, DOpEtypes::stationary);
+  NoConstraints<EDC, FDC, DOFHANDLER, VECTOR, CDIM, DIM> Constraints;
+  OP P(LFunc, LPDE, Constraints, DOFH);
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  CountingStatReducedProblem solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  ControlVector<VECTOR> q(&DOFH, DOpEtypes::VectorStorageType::fullmem, param_reader);
+
+  q = 0.5;
+  solver.ComputeReducedCostFunctional(q);
+  solver.AcceptIterate(q);
+  q = 1.;
+  solver.ComputeReducedCostFunctional(q);
+  solver.AcceptIterate(q);
+  //A trial control rejected by a line search.
+  q = -1.;
+  solver.ComputeReducedCostFunctional(q);
+
+  q = 0.5;
+  const unsigned int n_solves = solver.GetLinearSolver().GetNSolves();
+  const double cost = solver.ComputeReducedCostFunctional(q);
+  n_steps = solver.GetLinearSolver().GetNSolves() - n_solves;
+  return cost;
+}
+
+/**
+ * Reads the parameter file and sets the number of stored iterates.
+ */
+void
+read_params(ParameterReader &param_reader, const std::string &paramfile,
+            const std::string &iterate_pool_size, const std::string &logfile)
+{
+  RP::declare_params(param_reader);
+  DOpEOutputHandler<VECTOR>::declare_params(param_reader);
+  param_reader.read_parameters(paramfile);
+  param_reader.SetSubsection("statreducedproblem parameters");
+  param_reader.set("iterate_pool_size", iterate_pool_size);
+  param_reader.SetSubsection("output parameters");
+  param_reader.set("logfile", logfile);
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * The distributed control problem of OPT/StatPDE/Example1. The cost
+   * functional is evaluated at two accepted controls and at a rejected
+   * trial control, and then again at the first accepted control. Without
+   * stored iterates the Newton method starts from the state of the trial
+   * control. With iterate_pool_size = 2 it starts from the stored state of
+   * the first control, which already solves the state equation, so no
+   * Newton step may be needed. The values of the cost functional have to
+   * agree.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr_no_pool, pr_pool;
+  read_params(pr_no_pool, paramfile, "0", "dope_no_pool.log");
+  read_params(pr_pool, paramfile, "2", "dope.log");
+
+  try
+    {
+      unsigned int n_steps_no_pool, n_steps_pool;
+      const double cost_no_pool = evaluate(pr_no_pool, n_steps_no_pool);
+      const double cost_pool = evaluate(pr_pool, n_steps_pool);
+
+      std::cout << "Newton steps for the accepted control: " << n_steps_no_pool
+                << " without stored iterates, " << n_steps_pool
+                << " with stored iterates" << std::endl;
+      if (n_steps_no_pool == 0 || n_steps_pool != 0)
+        {
+          std::cout << "The state of the accepted control has not been reused." << std::endl;
+          return 1;
+        }
+      if (std::fabs(cost_pool - cost_no_pool) > 1.e-10 * std::fabs(cost_no_pool))
+        {
+          std::cout << "The cost functional " << cost_pool << " with stored iterates differs from "
+                    << cost_no_pool << " without" << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -1006,6 +1006,31 @@ namespace DOpE
                           "AugmentedLagrangianProblem::BoundaryRhs");
     }
 
+    /******************************************************/
+    template<typename FACEDATACONTAINER>
+    void
+    InterfaceEquationTwoSided(const FACEDATACONTAINER & /*dc*/,
+                              dealii::Vector<double> &/*local_vector*/,
+                              dealii::Vector<double> &/*nbr_local_vector*/,
+                              double /*scale*/ = 1., double /*scale_ico*/ = 1.)
+    {
+      throw DOpEException("Not Implemented",
+                          "AugmentedLagrangianProblem::InterfaceEquationTwoSided");
+    }
+
+    /******************************************************/
+    template<typename FACEDATACONTAINER>
+    void
+    InterfaceMatrixTwoSided(const FACEDATACONTAINER & /*dc*/,
+                            dealii::FullMatrix<double> &/*local_entry_matrix*/,
+                            dealii::FullMatrix<double> &/*element_nbr_matrix*/,
+                            dealii::FullMatrix<double> &/*nbr_element_matrix*/,
+                            dealii::FullMatrix<double> &/*nbr_matrix*/,
+                            double /*scale*/ = 1., double /*scale_ico*/ = 1.)
+    {
+      throw DOpEException("Not Implemented",
+                          "AugmentedLagrangianProblem::InterfaceMatrixTwoSided");
+    }
     /******************************************************/
 
     void
@@ -1105,6 +1130,11 @@ namespace DOpE
       return OP_.HasInterfaces();
     }
     bool
+    HasTwoSidedInterfaces() const
+    {
+      return OP_.HasTwoSidedInterfaces();
+    }
+    bool
     HasVertices() const
     {
       return OP_.HasVertices();
@@ -415,7 +415,7 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
       }
     else
       {
@@ -456,7 +456,7 @@ namespace DOpE
               }
             else if (dopedim == 0)
               {
-                this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+                this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
               }
             else
               {
@@ -553,7 +553,7 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
       }
     else
       {
@@ -572,7 +572,7 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("last_newton_solution",&(gradient_transposed.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("last_newton_solution",&(gradient_transposed.GetSpacialVectorView()));
         this->GetControlIntegrator().ComputeNonlinearResidual(*(this->GetProblem()),gradient.GetSpacialVector());
 
         this->GetControlIntegrator().DeleteParamData("last_newton_solution");
@@ -664,7 +664,7 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
       }
     else
       {
@@ -734,7 +734,7 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
       }
     else
       {
@@ -826,8 +826,8 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("dq",&(direction.GetSpacialVectorCopy()));
-        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("dq",&(direction.GetSpacialVectorView()));
+        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
       }
     else
       {
@@ -847,7 +847,7 @@ namespace DOpE
         }
       else if (dopedim == 0)
         {
-          this->GetControlIntegrator().AddParamData("last_newton_solution",&(hessian_direction_transposed.GetSpacialVectorCopy()));
+          this->GetControlIntegrator().AddParamData("last_newton_solution",&(hessian_direction_transposed.GetSpacialVectorView()));
           this->GetControlIntegrator().ComputeNonlinearResidual(*(this->GetProblem()),hessian_direction.GetSpacialVector());
           this->GetControlIntegrator().DeleteParamData("last_newton_solution");
           hessian_direction_transposed.UnLockCopy();
@@ -997,8 +997,8 @@ namespace DOpE
       }
     else if (dopedim == 0)
       {
-        this->GetControlIntegrator().AddParamData("dq",&(rhs.GetSpacialVectorCopy()));
-        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorCopy()));
+        this->GetControlIntegrator().AddParamData("dq",&(rhs.GetSpacialVectorView()));
+        this->GetControlIntegrator().AddParamData("control",&(q.GetSpacialVectorView()));
       }
     else
       {
@@ -387,8 +387,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(0);
   }
@@ -446,8 +445,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(0);
   }
@@ -513,8 +511,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(0);
   }
@@ -583,8 +580,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(0);
   }
@@ -645,8 +641,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(1);
   }
@@ -704,8 +699,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(1);
   }
@@ -771,8 +765,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(1);
   }
@@ -841,8 +834,7 @@ public:
       domain_values.find("state");
     Vector<double> tmp_vector(4);
 
-    VectorTools::point_value(state_dof_handler, *(it->second), p,
-                             tmp_vector);
+    state_dof_handler.PointValue(*(it->second), p, tmp_vector);
 
     return tmp_vector(1);
   }
@@ -0,0 +1,109 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef LOCALFunctionalS_
+#define LOCALFunctionalS_
+
+#include <interfaces/pdeinterface.h>
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+/****************************************************************************************/
+
+/**
+ * The value of the state at x = 0.5 at the end time.
+ */
+#if DEAL_II_VERSION_GTE(9,3,0)
+template<
+  template<bool DH, typename VECTOR, int dealdim> class EDC,
+  template<bool DH, typename VECTOR, int dealdim> class FDC,
+  bool DH, typename VECTOR, int dopedim, int dealdim>
+class LocalPointFunctional : public FunctionalInterface<EDC, FDC, DH, VECTOR,
+  dopedim, dealdim>
+#else
+template<
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class EDC,
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class FDC,
+  template<int, int> class DH, typename VECTOR, int dopedim, int dealdim>
+class LocalPointFunctional : public FunctionalInterface<EDC, FDC, DH, VECTOR,
+  dopedim, dealdim>
+#endif
+{
+public:
+  LocalPointFunctional(double end_time) :
+    end_time_(end_time)
+  {
+  }
+
+  bool
+  NeedTime() const override
+  {
+    if (fabs(this->GetTime() - end_time_) < 1.e-12)
+      return true;
+    else
+      return false;
+  }
+
+  double
+  PointValue(
+#if DEAL_II_VERSION_GTE(9,3,0)
+    const DOpEWrapper::DoFHandler<dopedim> &/* control_dof_handler*/,
+    const DOpEWrapper::DoFHandler<dealdim> &state_dof_handler,
+#else
+    const DOpEWrapper::DoFHandler<dopedim, DH> &/* control_dof_handler*/,
+    const DOpEWrapper::DoFHandler<dealdim, DH> &state_dof_handler,
+#endif
+    const std::map<std::string, const dealii::Vector<double>*> &/*param_values*/,
+    const std::map<std::string, const VECTOR *> &domain_values) override
+  {
+    Point<1> evaluation_point(0.5);
+
+    typename map<string, const VECTOR *>::const_iterator it =
+      domain_values.find("state");
+
+    double point_value = VectorTools::point_value(state_dof_handler,
+                                                  *(it->second), evaluation_point);
+
+    return point_value;
+  }
+
+  string
+  GetType() const override
+  {
+    return "point timelocal";
+  }
+  string
+  GetName() const override
+  {
+    return "Midpoint value";
+  }
+
+private:
+  double end_time_;
+};
+
+/****************************************************************************************/
+
+#endif
@@ -0,0 +1,296 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+//deal.ii includes
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+//DOpE includes
+#include <include/parameterreader.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+#include <templates/newtonsolver.h>
+
+#include <reducedproblems/instatpdeproblem.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <templates/instat_step_explicitsolver.h>
+#include <container/instatpdeproblemcontainer.h>
+
+#include <tsschemes/forward_euler_problem.h>
+#include <tsschemes/backward_euler_problem.h>
+
+//Problem specific includes
+#include "localpde.h"
+#include "functionals.h"
+#include "my_functions.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+// Define dimensions for control- and state problem
+const static int DIM = 1;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef BlockSparseMatrix<double> MATRIX;
+typedef BlockSparsityPattern SPARSITYPATTERN;
+typedef BlockVector<double> VECTOR;
+
+// Typedefs for timestep problem
+#define TSP1 ForwardEulerProblem
+#define TSP2 BackwardEulerProblem
+//FIXME: This should be a reasonable dual timestepping scheme
+#define DTSP1 ForwardEulerProblem
+#define DTSP2 BackwardEulerProblem
+
+typedef InstatPDEProblemContainer<TSP1, DTSP1,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        SPARSITYPATTERN,
+        VECTOR, DIM> OP1;
+typedef InstatPDEProblemContainer<TSP2, DTSP2,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        SPARSITYPATTERN,
+        VECTOR, DIM> OP2;
+
+#undef TSP1
+#undef TSP2
+#undef DTSP1
+#undef DTSP2
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE,
+        FACEQUADRATURE, VECTOR, DIM> IDC;
+
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+
+typedef InstatStepExplicitSolver<INTEGRATOR, LINEARSOLVER, VECTOR> ENLS;
+typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+
+typedef InstatPDEProblem<ENLS, INTEGRATOR, OP1, VECTOR, DIM> RP1;
+typedef InstatPDEProblem<NLS, INTEGRATOR, OP2, VECTOR, DIM> RP2;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * In this example we solve the one dimensional heat equation
+   * with the explicit solver, i.e., with a lumped mass matrix and
+   * without linear solves in the time steps. The results are compared
+   * to the exact solution and to the backward Euler method.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  //First, declare the parameters and read them in.
+  ParameterReader pr;
+  RP1::declare_params(pr);
+  RP2::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  //Create the triangulation.
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0., 1.);
+  triangulation.refine_global(4);
+
+  //Define the Finite Elements and quadrature formulas for the state.
+  FESystem<DIM> state_fe(FE_Q<DIM>(1), 1);
+
+  QGauss<DIM> quadrature_formula(3);
+  QGauss<DIM - 1> face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+
+  //Time grid of [0,0.1]. The explicit schemes are stable for
+  //k < h^2/2 = 1/512 with the lumped mass, we take k = 1/1000.
+  const double end_time = 0.1;
+  Triangulation<1> times;
+  GridGenerator::subdivided_hyper_cube(times, 100, 0., end_time);
+
+  LocalPointFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM> LPF(end_time);
+
+  MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+                                      DIM> DOFH(triangulation, state_fe, times);
+
+  OP1 P1(LPDE, DOFH);
+  OP2 P2(LPDE, DOFH);
+
+  P1.AddFunctional(&LPF);
+  P2.AddFunctional(&LPF);
+
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+
+  //Here we use zero boundary values
+  DOpEWrapper::ZeroFunction<DIM> zf;
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P1.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+  P1.SetDirichletBoundaryColors(1, comp_mask, &DD1);
+  P2.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+  P2.SetDirichletBoundaryColors(1, comp_mask, &DD1);
+
+  //prepare the initial data
+  InitialData initial_data;
+  P1.SetInitialValues(&initial_data);
+  P2.SetInitialValues(&initial_data);
+
+  //The forward euler method and the two-stage runge-kutta method
+  //use the same problem, but different solvers.
+  pr.SetSubsection("explicitsolver parameters");
+  pr.set("explicit_scheme", "forward_euler");
+  RP1 solver_fe(&P1, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  pr.SetSubsection("explicitsolver parameters");
+  pr.set("explicit_scheme", "ssp_rk2");
+  RP1 solver_rk(&P1, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  RP2 solver_be(&P2, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+
+  //Use one outputhandler for all problems
+  DOpEOutputHandler<VECTOR> output(&solver_fe, pr);
+  DOpEExceptionHandler<VECTOR> ex(&output);
+
+  P1.RegisterOutputHandler(&output);
+  P1.RegisterExceptionHandler(&ex);
+  P2.RegisterOutputHandler(&output);
+  P2.RegisterExceptionHandler(&ex);
+  solver_fe.RegisterOutputHandler(&output);
+  solver_fe.RegisterExceptionHandler(&ex);
+  solver_rk.RegisterOutputHandler(&output);
+  solver_rk.RegisterExceptionHandler(&ex);
+  solver_be.RegisterOutputHandler(&output);
+  solver_be.RegisterExceptionHandler(&ex);
+
+  const std::string names[3] = { "Explicit forward euler", "Explicit SSP-RK2", "Backward euler" };
+  double values[3];
+  try
+    {
+      solver_fe.ReInit();
+      solver_rk.ReInit();
+      solver_be.ReInit();
+      output.ReInit();
+
+      stringstream outp;
+      for (unsigned int i = 0; i < 3; i++)
+        {
+          outp << "**************************************************\n";
+          outp << "*             Starting Forward Solve             *\n";
+          outp << "*   Solving : " << names[i] << "\t*\n";
+          outp << "*   SDoFs   : ";
+          solver_be.StateSizeInfo(outp);
+          outp << "**************************************************";
+          output.Write(outp, 1, 1, 1);
+
+          if (i == 0)
+            {
+              solver_fe.ComputeReducedFunctionals();
+              values[i] = solver_fe.GetTimeFunctionalValue(LPF.GetName()).back();
+            }
+          else if (i == 1)
+            {
+              solver_rk.ComputeReducedFunctionals();
+              values[i] = solver_rk.GetTimeFunctionalValue(LPF.GetName()).back();
+            }
+          else
+            {
+              solver_be.ComputeReducedFunctionals();
+              values[i] = solver_be.GetTimeFunctionalValue(LPF.GetName()).back();
+            }
+        }
+
+      //All methods have to approximate the exact solution
+      //up to the discretization error.
+      const double exact = ExactMidpointValue(end_time);
+      bool passed = true;
+      for (unsigned int i = 0; i < 3; i++)
+        {
+          double error = fabs(values[i] - exact) / exact;
+          outp << names[i] << ": u(" << end_time << ",0.5) = " << values[i]
+               << "\t relative error: " << error << std::endl;
+          if (error > 1.e-2)
+            passed = false;
+        }
+      outp << "Exact: u(" << end_time << ",0.5) = " << exact << std::endl;
+      output.Write(outp, 0);
+
+      if (!passed)
+        {
+          throw DOpEException("The error of the computed solution is too large!",
+                              "main");
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,80 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef MY_FUNCTIONS_
+#define MY_FUNCTIONS_
+
+#include <wrapper/function_wrapper.h>
+
+using namespace dealii;
+
+/**
+ * The initial values u_0(x) = sin(pi x). Then the solution of the heat
+ * equation is u(t,x) = exp(-pi^2 t) sin(pi x).
+ */
+class InitialData : public DOpEWrapper::Function<1>
+{
+public:
+  InitialData() :
+    DOpEWrapper::Function<1>()
+  {
+
+  }
+  virtual double
+  value(const Point<1> &p, const unsigned int component = 0) const override;
+  virtual void
+  vector_value(const Point<1> &p, Vector<double> &value) const override;
+
+private:
+
+};
+
+/******************************************************/
+
+double
+InitialData::value(const Point<1> &p, const unsigned int /*component*/) const
+{
+  return std::sin(M_PI * p[0]);
+}
+
+/******************************************************/
+
+void
+InitialData::vector_value(const Point<1> &p, Vector<double> &values) const
+{
+  for (unsigned int c = 0; c < this->n_components; ++c)
+    values(c) = InitialData::value(p, c);
+}
+
+/******************************************************/
+
+/**
+ * The exact solution at x = 0.5.
+ */
+double
+ExactMidpointValue(double t)
+{
+  return std::exp(-M_PI * M_PI * t);
+}
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef LOCALFunctionalS_
+#define LOCALFunctionalS_
+
+#include <interfaces/pdeinterface.h>
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+/****************************************************************************************/
+
+/**
+ * The integral of the state over the domain at the end time.
+ * As a domain functional it is summed over the locally owned elements
+ * of all processes.
+ */
+#if DEAL_II_VERSION_GTE(9,3,0)
+template<
+  template<bool DH, typename VECTOR, int dealdim> class EDC,
+  template<bool DH, typename VECTOR, int dealdim> class FDC,
+  bool DH, typename VECTOR, int dopedim, int dealdim>
+class LocalDomainFunctional : public FunctionalInterface<EDC, FDC, DH, VECTOR,
+  dopedim, dealdim>
+#else
+template<
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class EDC,
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class FDC,
+  template<int, int> class DH, typename VECTOR, int dopedim, int dealdim>
+class LocalDomainFunctional : public FunctionalInterface<EDC, FDC, DH, VECTOR,
+  dopedim, dealdim>
+#endif
+{
+public:
+  LocalDomainFunctional(double end_time) :
+    end_time_(end_time)
+  {
+  }
+
+  bool
+  NeedTime() const override
+  {
+    if (fabs(this->GetTime() - end_time_) < 1.e-12)
+      return true;
+    else
+      return false;
+  }
+
+  double
+  ElementValue(const EDC<DH, VECTOR, dealdim> &edc) override
+  {
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+    unsigned int n_q_points = edc.GetNQPoints();
+
+    uvalues_.resize(n_q_points);
+    edc.GetValuesState("state", uvalues_);
+
+    double ret = 0.;
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        ret += uvalues_[q_point] * state_fe_values.JxW(q_point);
+      }
+    return ret;
+  }
+
+  UpdateFlags
+  GetUpdateFlags() const override
+  {
+    return update_values | update_quadrature_points;
+  }
+
+  string
+  GetType() const override
+  {
+    return "domain timelocal";
+  }
+
+  string
+  GetName() const override
+  {
+    return "Mean value";
+  }
+
+private:
+  double end_time_;
+  vector<double> uvalues_;
+};
+
+/****************************************************************************************/
+
+#endif
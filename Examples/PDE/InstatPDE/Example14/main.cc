@@ -0,0 +1,275 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+//deal.ii includes
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/distributed/tria.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/trilinos_sparsity_pattern.h>
+#include <deal.II/lac/trilinos_vector.h>
+
+//DOpE includes
+#include <include/parameterreader.h>
+#include <templates/gmreslinearsolver.h>
+#include <templates/integrator.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+#include <wrapper/preconditioner_wrapper.h>
+
+#include <reducedproblems/instatpdeproblem.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <container/instatpdeproblemcontainer.h>
+
+#include <tsschemes/crank_nicolson_problem.h>
+
+//Problem specific includes
+#include "localpde.h"
+#include "functionals.h"
+#include "my_functions.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+
+#if defined(DOPELIB_WITH_TRILINOS) && defined(DOPELIB_WITH_MPI)
+#if DEAL_II_VERSION_GTE(9,0,0)
+typedef TrilinosWrappers::SparseMatrix MATRIX;
+typedef TrilinosWrappers::SparsityPattern SPARSITYPATTERN;
+typedef TrilinosWrappers::MPI::Vector VECTOR;
+
+// Typedefs for timestep problem
+#define TSP CrankNicolsonProblem
+//FIXME: This should be a reasonable dual timestepping scheme
+#define DTSP CrankNicolsonProblem
+typedef InstatPDEProblemContainer<TSP, DTSP,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        SPARSITYPATTERN,
+        VECTOR, DIM> OP;
+#undef TSP
+#undef DTSP
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE,
+        FACEQUADRATURE, VECTOR, DIM> IDC;
+
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+
+typedef GMRESLinearSolverWithMatrix<
+DOpEWrapper::PreconditionIdentity_Wrapper<MATRIX>, SPARSITYPATTERN, MATRIX,
+            VECTOR> LINEARSOLVER;
+
+typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef InstatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * In this example we solve the heat equation on a distributed
+   * triangulation with trilinos MPI vectors. The time steps are solved by
+   * the InstatStepNewtonSolver, which does its iteration on vectors
+   * without ghost entries. The problem is solved with the state kept in
+   * memory and stored on disc, the latter writes each time point with
+   * MPI-IO. Run it with mpirun, the results have to agree with each
+   * other and with the exact solution.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  //First, declare the parameters and read them in.
+  ParameterReader pr;
+  RP::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  //Create the triangulation.
+  dealii::parallel::distributed::Triangulation<DIM> triangulation(
+    MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(triangulation, 0., 1.);
+  triangulation.refine_global(5);
+
+  //Define the Finite Elements and quadrature formulas for the state.
+  FESystem<DIM> state_fe(FE_Q<DIM>(1), 1);
+
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+
+  //Time grid of [0,0.1] with 50 subintervals.
+  const double end_time = 0.1;
+  Triangulation<1> times;
+  GridGenerator::subdivided_hyper_cube(times, 50, 0., end_time);
+
+  LocalDomainFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM> LDF(end_time);
+
+  MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+                                      DIM> DOFH(triangulation, state_fe, times);
+
+  OP P(LPDE, DOFH);
+
+  P.AddFunctional(&LDF);
+
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+
+  //Here we use zero boundary values
+  DOpEWrapper::ZeroFunction<DIM> zf;
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  //prepare the initial data
+  InitialData initial_data;
+  P.SetInitialValues(&initial_data);
+
+  const std::string names[2] = { "fullmem", "store_on_disc" };
+  const DOpEtypes::VectorStorageType storage[2] =
+  {
+    DOpEtypes::VectorStorageType::fullmem,
+    DOpEtypes::VectorStorageType::store_on_disc
+  };
+  double values[2];
+  try
+    {
+      for (unsigned int i = 0; i < 2; i++)
+        {
+          //Each solver is destroyed at the end of its iteration. With
+          //store_on_disc this removes the temporary files, which
+          //is a collective operation as well.
+          RP solver(&P, storage[i], pr, idc);
+
+          DOpEOutputHandler<VECTOR> output(&solver, pr);
+          DOpEExceptionHandler<VECTOR> ex(&output);
+          P.RegisterOutputHandler(&output);
+          P.RegisterExceptionHandler(&ex);
+          solver.RegisterOutputHandler(&output);
+          solver.RegisterExceptionHandler(&ex);
+
+          solver.ReInit();
+          output.ReInit();
+
+          stringstream outp;
+          outp << "**************************************************\n";
+          outp << "*             Starting Forward Solve             *\n";
+          outp << "*   Solving : " << P.GetName() << "\t*\n";
+          outp << "*   Storage : " << names[i] << "\t*\n";
+          outp << "*   SDoFs   : ";
+          solver.StateSizeInfo(outp);
+          outp << "**************************************************";
+          output.Write(outp, 1, 1, 1);
+
+          solver.ComputeReducedFunctionals();
+          values[i] = solver.GetTimeFunctionalValue(LDF.GetName()).back();
+
+          const double exact = ExactDomainValue(end_time);
+          const double error = fabs(values[i] - exact) / exact;
+          outp << "Processes: " << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+               << "\t Storage: " << names[i]
+               << "\t Computed: " << values[i]
+               << "\t Exact: " << exact
+               << "\t relative error: " << error << std::endl;
+          output.Write(outp, 0);
+
+          if (error > 1.e-2)
+            {
+              throw DOpEException("The error of the computed solution is too large!",
+                                  "main");
+            }
+        }
+      if (fabs(values[1] - values[0]) > 1.e-10 * fabs(values[0]))
+        {
+          throw DOpEException("The solution stored on disc differs from the one kept in memory!",
+                              "main");
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+#else //Dealii version too low.
+int
+main(int /*argc*/, char **/*argv*/)
+{
+  std::cout<<"This example requires deal.II v. 9.0.0 or newer"<<std::endl;
+  abort();
+}
+#endif
+#else
+int
+main(int /*argc*/, char **/*argv*/)
+{
+  std::cout<<"This example requires DOpE with  Trilinos and MPI"<<std::endl;
+  abort();
+}
+#endif //Dopelib with trilinos
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,101 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef INSTAT_STEP_CHECKED_NEWTON_SOLVER_H_
+#define INSTAT_STEP_CHECKED_NEWTON_SOLVER_H_
+
+#include <templates/instat_step_newtonsolver.h>
+#include <include/dopeexception.h>
+
+namespace DOpE
+{
+  /**
+   * The InstatStepNewtonSolver with an additional check:
+   * The work vectors of the Newton method (and of the linear solver) are
+   * allocated in the first time step after a ReInit. In all later time steps
+   * they have to be reused, otherwise an exception is thrown.
+   */
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  class InstatStepCheckedNewtonSolver : public InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR>
+  {
+  public:
+    typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> BASE;
+
+    InstatStepCheckedNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
+      : BASE(integrator, param_reader)
+    {
+    }
+
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde)
+    {
+      BASE::ReInit(pde);
+      n_steps_ = 0;
+    }
+
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
+                        bool apply_boundary_values=true,
+                        bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ")
+    {
+      bool build_matrix = BASE::NonlinearSolve(pde, last_time_solution, solution, apply_boundary_values,
+                                               force_matrix_build, priority, algo_level);
+      CheckReallocations();
+      return build_matrix;
+    }
+
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution,
+                        const VECTOR &initial_guess, VECTOR &solution,
+                        bool apply_boundary_values=true,
+                        bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ")
+    {
+      bool build_matrix = BASE::NonlinearSolve(pde, last_time_solution, initial_guess, solution,
+                                               apply_boundary_values, force_matrix_build, priority, algo_level);
+      CheckReallocations();
+      return build_matrix;
+    }
+
+  private:
+    void CheckReallocations()
+    {
+      if (n_steps_ > 0 && this->GetNWorkVectorReallocations() != 0)
+        {
+          throw DOpEException("Newton work vectors have been reallocated in time step "
+                              + std::to_string(n_steps_),
+                              "InstatStepCheckedNewtonSolver::NonlinearSolve");
+        }
+      if (n_steps_ > 0 && this->GetNSolveWorkVectorReallocations() != 0)
+        {
+          throw DOpEException("Linear solver work vectors have been reallocated in time step "
+                              + std::to_string(n_steps_),
+                              "InstatStepCheckedNewtonSolver::NonlinearSolve");
+        }
+      n_steps_++;
+    }
+
+    unsigned int n_steps_ = 0;
+  };
+}
+
+#endif
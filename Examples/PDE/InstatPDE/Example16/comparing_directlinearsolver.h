@@ -0,0 +1,158 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef COMPARING_DIRECT_LINEAR_SOLVER_H_
+#define COMPARING_DIRECT_LINEAR_SOLVER_H_
+
+#include <templates/directlinearsolver.h>
+#include <templates/timematrixcachingintegrator.h>
+#include <include/dopeexception.h>
+
+#include <cmath>
+#include <string>
+
+namespace DOpE
+{
+  /**
+   * The DirectLinearSolverWithMatrix with an additional check:
+   * Whenever the matrix is built by a TimeMatrixCachingIntegrator, it is
+   * also built by the underlying integrator without the cached time matrix.
+   * Both matrices share the sparsity pattern of the block matrices used
+   * here. In the rows of unconstrained DoFs they have to agree. In the rows
+   * of constrained DoFs the off-diagonal entries have to vanish and the
+   * diagonal entry has to be the one of a single assembly, i.e., the one of
+   * the terms without the time matrix. Otherwise an exception is thrown.
+   */
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  class ComparingDirectLinearSolver : public DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR>
+  {
+  public:
+    typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> BASE;
+
+    ComparingDirectLinearSolver(ParameterReader &param_reader)
+      : BASE(param_reader)
+    {
+    }
+
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde)
+    {
+      BASE::ReInit(pde);
+      cached_.clear();
+      uncached_.clear();
+      remaining_.clear();
+      pde.ComputeSparsityPattern(sparsity_pattern_);
+      cached_.reinit(sparsity_pattern_);
+      uncached_.reinit(sparsity_pattern_);
+      remaining_.reinit(sparsity_pattern_);
+      n_comparisons_ = 0;
+    }
+
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution,
+               bool force_matrix_build=false)
+    {
+      BASE::Solve(pde, integr, rhs, solution, force_matrix_build);
+    }
+
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, TimeMatrixCachingIntegrator<INTEGRATOR> &integr, VECTOR &rhs,
+               VECTOR &solution, bool force_matrix_build=false)
+    {
+      if (force_matrix_build && pde.HasConstantTimeMatrix())
+        {
+          Compare(pde, integr);
+        }
+      BASE::Solve(pde, integr, rhs, solution, force_matrix_build);
+    }
+
+    /**
+     * Returns the number of matrices compared since the last ReInit.
+     */
+    unsigned int GetNComparisons() const
+    {
+      return n_comparisons_;
+    }
+
+  private:
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Compare(PROBLEM &pde, TimeMatrixCachingIntegrator<INTEGRATOR> &integr)
+    {
+      integr.ComputeMatrix(pde, cached_);
+      integr.GetIntegrator().ComputeMatrix(pde, uncached_);
+      pde.SetMatrixPart(DOpEtypes::MatrixPart::without_time_matrix);
+      integr.GetIntegrator().ComputeMatrix(pde, remaining_);
+      pde.SetMatrixPart(DOpEtypes::MatrixPart::all_terms);
+
+      const double tol = 1.e-12 * uncached_.linfty_norm();
+      for (unsigned int bi = 0; bi < cached_.n_block_rows(); bi++)
+        {
+          for (unsigned int bj = 0; bj < cached_.n_block_cols(); bj++)
+            {
+              auto c = cached_.block(bi, bj).begin();
+              auto u = uncached_.block(bi, bj).begin();
+              auto r = remaining_.block(bi, bj).begin();
+              for (; c != cached_.block(bi, bj).end(); ++c, ++u, ++r)
+                {
+                  const dealii::types::global_dof_index i
+                    = cached_.get_row_indices().local_to_global(bi, c->row());
+                  const dealii::types::global_dof_index j
+                    = cached_.get_column_indices().local_to_global(bj, c->column());
+                  if (!pde.GetDoFConstraints().is_constrained(i))
+                    {
+                      Check(std::fabs(c->value() - u->value()) <= tol, i, j,
+                            "differs from the uncached matrix");
+                    }
+                  else if (i != j)
+                    {
+                      Check(c->value() == 0., i, j, "is not zero in a constrained row");
+                    }
+                  else
+                    {
+                      Check(r->value() > 0. && std::fabs(c->value() - r->value()) <= tol, i, j,
+                            "is not the diagonal entry of a single assembly");
+                    }
+                }
+            }
+        }
+      n_comparisons_++;
+    }
+
+    void Check(bool condition, dealii::types::global_dof_index i,
+               dealii::types::global_dof_index j, const std::string &what) const
+    {
+      if (!condition)
+        {
+          throw DOpEException("The entry (" + std::to_string(i) + "," + std::to_string(j)
+                              + ") of the cached matrix " + what,
+                              "ComparingDirectLinearSolver::Compare");
+        }
+    }
+
+    SPARSITYPATTERN sparsity_pattern_;
+    MATRIX cached_, uncached_, remaining_;
+    unsigned int n_comparisons_ = 0;
+  };
+}
+
+#endif
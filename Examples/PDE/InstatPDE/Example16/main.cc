@@ -0,0 +1,263 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+
+//deal.ii includes
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+//DOpE includes
+#include <include/parameterreader.h>
+#include <templates/integrator.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include <reducedproblems/instatpdeproblem.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <container/instatpdeproblemcontainer.h>
+
+#include <tsschemes/backward_euler_problem.h>
+
+//Problem specific includes
+#include "localpde.h"
+#include "my_functions.h"
+#include "comparing_directlinearsolver.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+// Define dimensions for control- and state problem
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef BlockSparseMatrix<double> MATRIX;
+typedef BlockSparsityPattern SPARSITYPATTERN;
+typedef BlockVector<double> VECTOR;
+
+#define TSP BackwardEulerProblem
+//FIXME: This should be a reasonable dual timestepping scheme
+#define DTSP BackwardEulerProblem
+
+typedef InstatPDEProblemContainer<TSP, DTSP,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        SPARSITYPATTERN,
+        VECTOR, DIM> OP;
+#undef TSP
+#undef DTSP
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE,
+        FACEQUADRATURE, VECTOR, DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef ComparingDirectLinearSolver<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef InstatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+
+/**
+ * The InstatPDEProblem, giving access to the linear solver to read its counter.
+ */
+class ComparingInstatPDEProblem : public RP
+{
+public:
+  using RP::RP;
+
+  const LINEARSOLVER &
+  GetLinearSolver()
+  {
+    return this->GetNonlinearSolver("state");
+  }
+};
+
+/**
+ * Solves the problem with or without a cached time matrix and returns
+ * u * u of the solution. The number of matrices compared with the uncached
+ * ones is returned in n_comparisons.
+ */
+double
+solve(ParameterReader &param_reader, bool constant_time_matrix,
+      unsigned int &n_comparisons)
+{
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0., numbers::PI);
+  triangulation.refine_global(3);
+  //Refine one element to get hanging nodes.
+  triangulation.begin_active()->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+
+  FESystem<DIM> state_fe(FE_Q<DIM>(1), 1);
+
+  QGauss<DIM> quadrature_formula(3);
+  QGauss<DIM - 1> face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(constant_time_matrix);
+
+  //Time grid of [0,1]
+  Triangulation<1> times;
+  GridGenerator::subdivided_hyper_cube(times, 10);
+
+  MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+                                      DIM> DOFH(triangulation, state_fe, times);
+
+  OP P(LPDE, DOFH);
+
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+
+  //Here we use zero boundary values
+  DOpEWrapper::ZeroFunction<DIM> zf;
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  //prepare the initial data
+  InitialData initial_data;
+  P.SetInitialValues(&initial_data);
+
+  ComparingInstatPDEProblem solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  stringstream outp;
+  outp << "**************************************************\n";
+  outp << "*             Starting Forward Solve             *\n";
+  outp << "*   Solving : " << P.GetName() << "\t*\n";
+  outp << "*   SDoFs   : ";
+  solver.StateSizeInfo(outp);
+  outp << "**************************************************";
+  out.Write(outp, 1, 1, 1);
+
+  solver.ComputeReducedFunctionals();
+
+  n_comparisons = solver.GetLinearSolver().GetNComparisons();
+
+  SolutionExtractor<RP, VECTOR> a(solver);
+  const StateVector<VECTOR> &statevec = a.GetU();
+  return statevec * statevec;
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * In this example we solve the nonlinear, timedependent heat equation
+   * of Example5 on a mesh with hanging nodes. The mass matrix is marked as
+   * constant, so the time stepping newton solver caches it. Each matrix
+   * built this way is compared with the matrix assembled without caching.
+   * The solution has to agree with the one computed without caching.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr_cached, pr_uncached;
+  RP::declare_params(pr_cached);
+  DOpEOutputHandler<VECTOR>::declare_params(pr_cached);
+  pr_cached.read_parameters(paramfile);
+  RP::declare_params(pr_uncached);
+  DOpEOutputHandler<VECTOR>::declare_params(pr_uncached);
+  pr_uncached.read_parameters(paramfile);
+  pr_uncached.SetSubsection("output parameters");
+  pr_uncached.set("logfile", "dope_uncached.log");
+
+  try
+    {
+      unsigned int n_comparisons;
+
+      const double cached = solve(pr_cached, true, n_comparisons);
+      if (n_comparisons == 0)
+        {
+          std::cout << "No matrix has been built with the cached time matrix." << std::endl;
+          return 1;
+        }
+
+      const double uncached = solve(pr_uncached, false, n_comparisons);
+      if (n_comparisons != 0)
+        {
+          std::cout << "The time matrix has been cached although it is not constant." << std::endl;
+          return 1;
+        }
+
+      std::cout << "Backward euler: u * u = " << cached << " with cached time matrix, "
+                << uncached << " without" << std::endl;
+      if (std::fabs(cached - uncached) > 1.e-10 * std::fabs(uncached))
+        {
+          std::cout << "The cached time matrix changes the solution." << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,266 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+
+//deal.ii includes
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+//DOpE includes
+#include <include/parameterreader.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include <reducedproblems/instatpdeproblem.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <container/instatpdeproblemcontainer.h>
+
+#include <tsschemes/crank_nicolson_problem.h>
+
+//Problem specific includes
+#include "localpde.h"
+#include "my_functions.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+// Define dimensions for control- and state problem
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef BlockSparseMatrix<double> MATRIX;
+typedef BlockSparsityPattern SPARSITYPATTERN;
+typedef BlockVector<double> VECTOR;
+
+#define TSP CrankNicolsonProblem
+#define DTSP CrankNicolsonProblem
+
+typedef InstatPDEProblemContainer<TSP, DTSP,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        SPARSITYPATTERN,
+        VECTOR, DIM> OP;
+#undef TSP
+#undef DTSP
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE,
+        FACEQUADRATURE, VECTOR, DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef InstatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+
+/**
+ * Solves the problem on the temporal mesh with n_intervals intervals
+ * of [0,1] and returns u * u at the final time. The time points of the
+ * temporal mesh after the solve are returned in times.
+ */
+double
+solve(ParameterReader &param_reader, unsigned int n_intervals,
+      std::vector<double> &times)
+{
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0., numbers::PI);
+  triangulation.refine_global(4);
+
+  FESystem<DIM> state_fe(FE_Q<DIM>(1), 1);
+
+  QGauss<DIM> quadrature_formula(3);
+  QGauss<DIM - 1> face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+
+  //Time grid of [0,1]
+  Triangulation<1> time_triangulation;
+  GridGenerator::subdivided_hyper_cube(time_triangulation, n_intervals);
+
+  MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+                                      DIM> DOFH(triangulation, state_fe, time_triangulation);
+
+  OP P(LPDE, DOFH);
+
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+
+  //Here we use zero boundary values
+  DOpEWrapper::ZeroFunction<DIM> zf;
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  //prepare the initial data
+  InitialData initial_data;
+  P.SetInitialValues(&initial_data);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  stringstream outp;
+  outp << "**************************************************\n";
+  outp << "*             Starting Forward Solve             *\n";
+  outp << "*   Solving : " << P.GetName() << "\t*\n";
+  outp << "*   SDoFs   : ";
+  solver.StateSizeInfo(outp);
+  outp << "**************************************************";
+  out.Write(outp, 1, 1, 1);
+
+  solver.ComputeReducedFunctionals();
+
+  //The adaptive time loop leaves the refined temporal mesh in the
+  //space time handler.
+  times = DOFH.GetTimes();
+
+  SolutionExtractor<RP, VECTOR> a(solver);
+  const StateVector<VECTOR> &statevec = a.GetU();
+  return statevec * statevec;
+}
+
+/**
+ * Reads the parameter file and switches the adaptive time stepping on or off.
+ */
+void
+read_params(ParameterReader &param_reader, const std::string &paramfile,
+            const std::string &adaptive_time_stepping, const std::string &logfile)
+{
+  RP::declare_params(param_reader);
+  DOpEOutputHandler<VECTOR>::declare_params(param_reader);
+  param_reader.read_parameters(paramfile);
+  param_reader.SetSubsection("instatpdeproblem parameters");
+  param_reader.set("adaptive_time_stepping", adaptive_time_stepping);
+  param_reader.SetSubsection("output parameters");
+  param_reader.set("logfile", logfile);
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * In this example we solve a nonlinear heat equation whose right hand
+   * side contains a short pulse in time. The Crank-Nicolson scheme chooses
+   * its time steps adaptively by comparison with the embedded backward
+   * Euler scheme, starting from a coarse temporal mesh. The steps have to
+   * be refined around the pulse, and the solution has to be closer to the
+   * one on a fine uniform temporal mesh than the one on the coarse mesh.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  const unsigned int n_coarse = 10;
+  const unsigned int n_fine = 1280;
+
+  ParameterReader pr_coarse, pr_adaptive, pr_fine;
+  read_params(pr_coarse, paramfile, "false", "dope_coarse.log");
+  read_params(pr_adaptive, paramfile, "true", "dope.log");
+  read_params(pr_fine, paramfile, "false", "dope_fine.log");
+
+  try
+    {
+      std::vector<double> times;
+
+      const double coarse = solve(pr_coarse, n_coarse, times);
+      const double fine = solve(pr_fine, n_fine, times);
+      const double adaptive = solve(pr_adaptive, n_coarse, times);
+
+      double min_step = times.back() - times.front(), max_step = 0.;
+      for (unsigned int i = 1; i < times.size(); i++)
+        {
+          min_step = std::min(min_step, times[i] - times[i - 1]);
+          max_step = std::max(max_step, times[i] - times[i - 1]);
+        }
+      std::cout << "Adaptive temporal mesh: " << times.size() - 1 << " intervals, steps from "
+                << min_step << " to " << max_step << std::endl;
+      if (times.size() - 1 <= n_coarse || min_step >= max_step)
+        {
+          std::cout << "The time steps have not been adapted to the pulse." << std::endl;
+          return 1;
+        }
+
+      std::cout << "Crank-Nicolson: u * u = " << coarse << " with " << n_coarse
+                << " steps, " << adaptive << " with adaptive steps, "
+                << fine << " with " << n_fine << " steps" << std::endl;
+      if (std::fabs(adaptive - fine) >= std::fabs(coarse - fine))
+        {
+          std::cout << "The adaptive time steps do not improve the solution." << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
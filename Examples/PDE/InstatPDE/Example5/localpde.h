@@ -236,6 +236,90 @@ public:
 
   }
 
+  // ElementEquation and ElementTimeEquation evaluated in one quadrature loop
+  void
+  ElementEquationAndTimeEquation(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    dealii::Vector<double> &local_vector, double scale,
+    double /*scale_ico*/, double scale_time) override
+  {
+    assert(this->problem_type_ == "state");
+
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+
+    uvalues_.resize(n_q_points);
+    ugrads_.resize(n_q_points);
+
+    edc.GetValuesState("last_newton_solution", uvalues_);
+    edc.GetGradsState("last_newton_solution", ugrads_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            const double phi_i = state_fe_values.shape_value(i, q_point);
+            const Tensor<1, dealdim> phi_i_grads = state_fe_values.shape_grad(i,
+                                                   q_point);
+
+            local_vector(i) += (scale
+                                * ((ugrads_[q_point] * phi_i_grads)
+                                   + uvalues_[q_point] * uvalues_[q_point] * phi_i)
+                                + scale_time * uvalues_[q_point] * phi_i)
+                               * state_fe_values.JxW(q_point);
+          }
+      }
+  }
+
+  void
+  ElementMatrixAndTimeMatrix(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    FullMatrix<double> &local_matrix, double scale,
+    double /*scale_ico*/, double scale_time) override
+  {
+    assert(this->problem_type_ == "state");
+
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+
+    uvalues_.resize(n_q_points);
+    edc.GetValuesState("last_newton_solution", uvalues_);
+
+    phi_values_.resize(n_dofs_per_element);
+    phi_grads_.resize(n_dofs_per_element);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        for (unsigned int k = 0; k < n_dofs_per_element; k++)
+          {
+            phi_values_[k] = state_fe_values.shape_value(k, q_point);
+            phi_grads_[k] = state_fe_values.shape_grad(k, q_point);
+          }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            for (unsigned int j = 0; j < n_dofs_per_element; j++)
+              {
+                local_matrix(i, j) += (scale
+                                       * ((phi_grads_[j] * phi_grads_[i])
+                                          + 2 * uvalues_[q_point] * phi_values_[j] * phi_values_[i])
+                                       + scale_time * phi_values_[j] * phi_values_[i])
+                                      * state_fe_values.JxW(q_point);
+              }
+          }
+      }
+  }
+
+  bool
+  HasFusedElementTerms() const override
+  {
+    return true;
+  }
+
   // Values for boundary integrals
   void
   BoundaryEquation(
@@ -317,6 +401,8 @@ private:
   vector<double> uvalues_;
 
   vector<Tensor<1, dealdim> > ugrads_;
+  vector<double> phi_values_;
+  vector<Tensor<1, dealdim> > phi_grads_;
 
   vector<unsigned int> state_block_component_;
   vector<unsigned int> control_block_components_;
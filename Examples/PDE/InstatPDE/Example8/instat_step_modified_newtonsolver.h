@@ -239,7 +239,7 @@ namespace DOpE
     residual =0.;
     GetIntegrator().AddDomainData("last_newton_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
-    pde.SetStepPart("Old");
+    pde.SetStepPart(DOpEtypes::StepPart::old_part);
     GetIntegrator().ComputeNonlinearLhs(pde,residual);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
@@ -429,7 +429,7 @@ namespace DOpE
     // Righthandside for the current timestep f^{n+1}
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
-    pde.SetStepPart("New");
+    pde.SetStepPart(DOpEtypes::StepPart::new_part);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
     tmp_residual *= -1;
     residual += tmp_residual;
@@ -0,0 +1,317 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_in.h>
+#if DEAL_II_VERSION_GTE(9,1,1)
+#else
+#include <deal.II/grid/tria_boundary_lib.h>
+#endif
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/numerics/vector_tools.h>
+#if DEAL_II_VERSION_GTE(9,0,0)
+#include <deal.II/grid/manifold_lib.h>
+#endif
+
+#include <container/pdeproblemcontainer.h>
+#include <interfaces/functionalinterface.h>
+#include <interfaces/pdeinterface.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/directlinearsolver.h>
+#include <include/userdefineddofconstraints.h>
+#include <include/sparsitymaker.h>
+#include <container/integratordatacontainer.h>
+
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <interfaces/active_fe_index_setter_interface.h>
+
+#include "localpde.h"
+#include "functionals.h"
+#include <container/higher_order_dwrc.h>
+#include <container/patch_interpolation_dwrc.h>
+#include "myfunctions.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDELaplace<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE,
+        VECTOR, DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+typedef HigherOrderDWRContainer<STH, IDC, EDC<DOFHANDLER, VECTOR, DIM>,
+        FDC<DOFHANDLER, VECTOR, DIM>, VECTOR> HO_DWRC;
+typedef PatchInterpolationDWRContainer<STH, IDC, EDC<DOFHANDLER, VECTOR, DIM>,
+        FDC<DOFHANDLER, VECTOR, DIM>, VECTOR> PI_DWRC;
+
+void
+declare_params(ParameterReader &param_reader)
+{
+  param_reader.SetSubsection("main parameters");
+  param_reader.declare_entry("max_iter", "1", Patterns::Integer(0),
+                             "How many iterations?");
+  param_reader.declare_entry("quad order", "2", Patterns::Integer(1),
+                             "Order of the quad formula?");
+  param_reader.declare_entry("facequad order", "2", Patterns::Integer(1),
+                             "Order of the face quad formula?");
+  param_reader.declare_entry("order fe", "2", Patterns::Integer(1),
+                             "Order of the finite element?");
+  param_reader.declare_entry("prerefine", "1", Patterns::Integer(1),
+                             "How often should we refine the coarse grid?");
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * We solve the laplace equation of PDE/StatPDE/Example5 and
+   * compare the DWR estimator with weights by patchwise higher order
+   * interpolation to the one with the HigherOrderDWRContainer.
+   * The mesh is refined by the indicators of the former.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+  ParameterReader pr;
+
+  RP::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  declare_params(pr);
+
+  pr.read_parameters(paramfile);
+
+  //************************************************
+  //define some constants
+  pr.SetSubsection("main parameters");
+  int max_iter = pr.get_integer("max_iter");
+  int prerefine = pr.get_integer("prerefine");
+
+  //*************************************************
+
+  //Make triangulation *************************************************
+  Triangulation<DIM> triangulation(
+    Triangulation<DIM>::MeshSmoothing::patch_level_1);
+  GridGenerator::hyper_cube_with_cylindrical_hole(triangulation, 0.5, 2., 1, 1);
+  const Point<DIM> center(0, 0);
+#if DEAL_II_VERSION_GTE(9,0,0)
+  static const SphericalManifold<DIM> boundary(center);
+  triangulation.set_all_manifold_ids_on_boundary(1,1);
+  triangulation.set_manifold(1,boundary);
+#else
+  const HyperShellBoundary<DIM> boundary_description(center);
+  triangulation.set_boundary(1, boundary_description);
+#endif
+  triangulation.refine_global(1); //because we need the face located at x==0;
+  for (auto it = triangulation.begin_active(); it != triangulation.end(); it++)
+    if (it->center()[1] <= 0)
+      {
+        if (it->center()[0] < 0)
+          {
+            it->set_material_id(1);
+          }
+        else
+          {
+            it->set_material_id(2);
+          }
+      }
+  if (prerefine > 0)
+    triangulation.refine_global(prerefine);
+  //*************************************************************
+
+  //FiniteElemente*************************************************
+  pr.SetSubsection("main parameters");
+  FE<DIM> state_fe(FE_Q<DIM>(pr.get_integer("order fe")), 1);
+
+  //Quadrature formulas*************************************************
+  pr.SetSubsection("main parameters");
+  QGauss<DIM> quadrature_formula(pr.get_integer("quad order"));
+  QGauss<1> face_quadrature_formula(pr.get_integer("facequad order"));
+  IDC idc(quadrature_formula, face_quadrature_formula);
+  //**************************************************************************
+
+  //Functionals*************************************************
+  LocalFaceFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM> LFF;
+  LocalPDELaplace<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+  //*************************************************
+
+  //space time handler***********************************/
+  STH DOFH(triangulation, state_fe);
+  /***********************************/
+
+  OP P(LPDE, DOFH);
+  P.AddFunctional(&LFF);
+  //Boundary conditions************************************************
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+
+  ExactSolution ex_sol;
+
+  SimpleDirichletData<VECTOR, DIM> DD1(ex_sol);
+  //Set dirichlet boundary values all around
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+  P.SetDirichletBoundaryColors(1, comp_mask, &DD1);
+  /************************************************/
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+
+  //Only needed for pure PDE Problems
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+  /**********************************************************************/
+  //DWR**********************************************************************/
+  //Set dual functional for ee
+  P.SetFunctionalForErrorEstimation(LFF.GetName());
+  //FiniteElemente for DWR*************************************************
+  pr.SetSubsection("main parameters");
+  FE<DIM> state_fe_high(FE_Q<DIM>(2 * pr.get_integer("order fe")), 1);
+  //Quadrature formulas for DWR*************************************************
+  pr.SetSubsection("main parameters");
+  QUADRATURE quadrature_formula_high(pr.get_integer("quad order") + 1);
+  FACEQUADRATURE face_quadrature_formula_high(
+    pr.get_integer("facequad order") + 1);
+  IDC idc_high(quadrature_formula_high, face_quadrature_formula_high);
+  STH DOFH_higher_order(triangulation, state_fe_high);
+  HO_DWRC dwrc(DOFH_higher_order, idc_high, DOpEtypes::VectorStorageType::fullmem, pr,
+               DOpEtypes::primal_only);
+
+  //The patch interpolation represents its weights in the same higher order space.
+  IDC idc_patch(quadrature_formula_high, face_quadrature_formula_high);
+  STH DOFH_patch(triangulation, state_fe_high);
+  PI_DWRC patch_dwrc(DOFH_patch, idc_patch, DOpEtypes::VectorStorageType::fullmem, pr,
+                     DOpEtypes::primal_only);
+
+  P.InitializeDWRC(dwrc);
+  P.InitializeDWRC(patch_dwrc);
+  //**************************************************************************************************
+
+  const double exact_value = 0.441956231972232;
+  for (int i = 0; i < max_iter; i++)
+    {
+      try
+        {
+          solver.ReInit();
+          out.ReInit();
+          stringstream outp;
+
+          outp << "**************************************************\n";
+          outp << "*             Starting Forward Solve             *\n";
+          outp << "*   Solving : " << P.GetName() << "\t*\n";
+          outp << "*   SDoFs   : ";
+          solver.StateSizeInfo(outp);
+          outp << "**************************************************";
+          out.Write(outp, 1, 1, 1);
+
+          solver.ComputeReducedFunctionals();
+          solver.ComputeRefinementIndicators(dwrc, LPDE);
+          solver.ComputeRefinementIndicators(patch_dwrc, LPDE);
+
+          double error = exact_value - solver.GetFunctionalValue(LFF.GetName());
+          const double ieff_high = dwrc.GetError() / error;
+          const double ieff_patch = patch_dwrc.GetError() / error;
+          outp << "Mean value error: " << error << std::endl;
+          outp << "Ieff (eh/e) higher order DWR: " << ieff_high << std::endl;
+          outp << "Ieff (eh/e) patch interpolation DWR: " << ieff_patch << std::endl;
+          out.Write(outp, 1, 1, 1);
+
+          //Both estimators use the same higher order interpolant on the patches.
+          if (std::fabs(ieff_patch - ieff_high) > 1.e-2 * std::fabs(ieff_high))
+            {
+              throw DOpEException("The effectivity indices of the two DWR estimators differ!",
+                                  "main");
+            }
+        }
+      catch (DOpEException &e)
+        {
+          std::cout
+              << "Warning: During execution of `" + e.GetThrowingInstance()
+              + "` the following Problem occurred!" << std::endl;
+          std::cout << e.GetErrorMessage() << std::endl;
+          return 1;
+        }
+      if (i != max_iter - 1)
+        {
+          Vector<float> error_ind(patch_dwrc.GetErrorIndicators()[0]);
+          DOFH.RefineSpace(RefineOptimized(error_ind));
+        }
+    }
+  return 0;
+}
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,656 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef LOCALPDE_H_
+#define LOCALPDE_H_
+
+#include <interfaces/pdeinterface.h>
+#include "myfunctions.h"
+#include <deal.II/base/numbers.h>
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+/***********************************************************************************************/
+#if DEAL_II_VERSION_GTE(9,3,0)
+template<
+  template<bool DH, typename VECTOR, int dealdim> class EDC,
+  template<bool DH, typename VECTOR, int dealdim> class FDC,
+  bool DH, typename VECTOR, int dealdim>
+class LocalPDE : public PDEInterface<EDC, FDC, DH, VECTOR, dealdim>
+#else
+template<
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class EDC,
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class FDC,
+  template<int, int> class DH, typename VECTOR, int dealdim>
+class LocalPDE : public PDEInterface<EDC, FDC, DH, VECTOR, dealdim>
+#endif
+{
+public:
+  LocalPDE() :
+    state_block_component_(1, 0), two_sided_(false)
+  {
+  }
+
+  /**
+   * Selects whether the interior faces are integrated once by
+   * InterfaceEquationTwoSided and InterfaceMatrixTwoSided or from
+   * both sides by FaceEquation and InterfaceEquation.
+   */
+  void
+  SetTwoSidedInterfaces(bool two_sided)
+  {
+    two_sided_ = two_sided;
+  }
+
+  void
+  ElementEquation(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    dealii::Vector<double> &local_vector, double scale,
+    double/*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+
+    assert(this->problem_type_ == "state");
+
+    uvalues_.resize(n_q_points);
+    edc.GetValuesState("last_newton_solution", uvalues_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double b1 = 0.;
+        double b2 = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          if ( r != 0 )
+            {
+              b1 = -y/r;
+              b2 = x/r;
+            }
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            local_vector(i) -= scale * uvalues_[q_point]
+                               * (b1 * state_fe_values.shape_grad(i,q_point)[0]
+                                  + b2 * state_fe_values.shape_grad(i,q_point)[1]
+                                 )
+                               * state_fe_values.JxW(q_point);
+          }
+      }
+  }
+
+  void
+  BoundaryEquation(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    dealii::Vector<double> &local_vector, double scale,
+    double /*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+    unsigned int color = fdc.GetBoundaryIndicator();
+    const auto &state_fe_values =
+      fdc.GetFEFaceValuesState();
+
+    assert(this->problem_type_ == "state");
+
+    uvalues_.resize(n_q_points);
+    fdc.GetFaceValuesState("last_newton_solution", uvalues_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            if (color == 1 || color == 2)
+              {
+                assert(bn < 0);
+                local_vector(i) += scale
+                                   * (ex_sol_.value(state_fe_values.quadrature_point(q_point))
+                                      * bn
+                                      * state_fe_values.shape_value(i,q_point)
+                                     )
+                                   * state_fe_values.JxW(q_point);
+              }
+            else
+              {
+                assert(bn > 0);
+                local_vector(i) += scale
+                                   * (uvalues_[q_point]
+                                      * bn
+                                      * state_fe_values.shape_value(i,q_point)
+                                     )
+                                   * state_fe_values.JxW(q_point);
+              }
+          }
+      }
+  }
+
+  void
+  FaceEquation(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    dealii::Vector<double> &local_vector, double scale,
+    double /*scale_ico*/) override
+  {
+    //The face equation contains the coupling of the element DOFs
+    //with the DOFs from the same element induced by the face integrals
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+    const auto &state_fe_values = fdc.GetFEFaceValuesState();
+
+    assert(this->problem_type_ == "state");
+
+    uvalues_.resize(n_q_points);
+    fdc.GetFaceValuesState("last_newton_solution", uvalues_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            if (bn < 0)
+              {
+                //This is the downstream element, i.e., $(u^-, [\beta n v_h])$ has no
+                //inner element coupling
+              }
+            else
+              {
+                assert(bn > 0); //This is the upstream element, i.e., u^- = u
+                local_vector(i) += scale
+                                   * (uvalues_[q_point]
+                                      * bn
+                                      * state_fe_values.shape_value(i,q_point)
+                                     )
+                                   * state_fe_values.JxW(q_point);
+              }
+          }
+      }
+  }
+  void
+  InterfaceEquation(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    dealii::Vector<double> &local_vector, double scale,
+    double /*scale_ico*/) override
+  {
+    //The interface equation contains the coupling of the element DOFs
+    //with the DOFs from the neigbouring element induced by the face integrals
+    //The face equation contains the coupling of the element DOFs
+    //with the DOFs from the same element induced by the face integrals
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+    const auto &state_fe_values = fdc.GetFEFaceValuesState();
+
+    assert(this->problem_type_ == "state");
+
+    uvalues_nbr_.resize(n_q_points);
+    fdc.GetNbrFaceValuesState("last_newton_solution", uvalues_nbr_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            if (bn < 0)
+              {
+                //This is the downstream element, i.e., u^- is the u from the adjacent element
+                local_vector(i) += scale
+                                   * (uvalues_nbr_[q_point]
+                                      * bn
+                                      * state_fe_values.shape_value(i,q_point)
+                                     )
+                                   * state_fe_values.JxW(q_point);
+              }
+            else
+              {
+                assert(bn >= 0); //This is the upstream element, i.e., there is no interelement coupling on this face
+              }
+          }
+      }
+  }
+
+  void
+  BoundaryMatrix(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    FullMatrix<double> &local_matrix, double scale,
+    double/*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+    unsigned int color = fdc.GetBoundaryIndicator();
+    const auto &state_fe_values =
+      fdc.GetFEFaceValuesState();
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            for (unsigned int j = 0; j < n_dofs_per_element; j++)
+              {
+                if (color == 1 || color == 2)
+                  {
+                    assert(bn < 0);
+                  }
+                else
+                  {
+                    assert(bn > 0);
+                    local_matrix(i,j) += scale * bn * state_fe_values.shape_value(i, q_point)
+                                         * state_fe_values.shape_value(j, q_point)
+                                         * state_fe_values.JxW(q_point);
+                  }
+              }
+          }
+      }
+  }
+  void
+  FaceMatrix(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    FullMatrix<double> &local_matrix, double scale,
+    double/*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+
+    const auto &state_fe_values = fdc.GetFEFaceValuesState();
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            for (unsigned int j = 0; j < n_dofs_per_element; j++)
+              {
+                if (bn < 0)
+                  {
+                    //This is the downstream element, i.e., $(u^-, [\beta n v_h])$ has no
+                    //inner element coupling
+                  }
+                else
+                  {
+                    assert(bn > 0); //This is the upstream element, i.e., u^- = u
+                    local_matrix(i,j) += scale
+                                         * (state_fe_values.shape_value(j,q_point)
+                                            * bn
+                                            * state_fe_values.shape_value(i,q_point)
+                                           )
+                                         * state_fe_values.JxW(q_point);
+                  }
+              }
+          }
+      }
+  }
+
+  void
+  InterfaceMatrix(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    FullMatrix<double> &local_matrix, double scale,
+    double/*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_dofs_per_element_nbr = fdc.GetNbrNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+
+    const auto &state_fe_values = fdc.GetFEFaceValuesState();
+    const auto &state_fe_values_nbr = fdc.GetNbrFEFaceValuesState();
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            for (unsigned int j = 0; j < n_dofs_per_element_nbr; j++)
+              {
+                if (bn < 0)
+                  {
+                    //This is the downstream element, i.e., u^- is the u from the adjacent element
+                    local_matrix(i,j) += scale
+                                         * (state_fe_values_nbr.shape_value(j,q_point)
+                                            * bn
+                                            * state_fe_values.shape_value(i,q_point)
+                                           )
+                                         * state_fe_values.JxW(q_point);
+                  }
+                else
+                  {
+                    assert(bn >= 0); //This is the upstream element, i.e., there is no interelement coupling on this face
+                  }
+              }
+          }
+      }
+  }
+
+  void
+  InterfaceEquationTwoSided(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    dealii::Vector<double> &local_vector,
+    dealii::Vector<double> &nbr_local_vector, double scale,
+    double /*scale_ico*/) override
+  {
+    //Both parts of the jump term $(u_h^-,[\beta \cdot n v_h])_F$ at once,
+    //the normal is the outward normal of the element.
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_dofs_per_element_nbr = fdc.GetNbrNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+    const auto &state_fe_values = fdc.GetFEFaceValuesState();
+    const auto &state_fe_values_nbr = fdc.GetNbrFEFaceValuesState();
+
+    assert(this->problem_type_ == "state");
+
+    uvalues_.resize(n_q_points);
+    uvalues_nbr_.resize(n_q_points);
+    fdc.GetFaceValuesState("last_newton_solution", uvalues_);
+    fdc.GetNbrFaceValuesState("last_newton_solution", uvalues_nbr_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+        //The upstream value u^-
+        const double u_up = (bn > 0) ? uvalues_[q_point] : uvalues_nbr_[q_point];
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            local_vector(i) += scale
+                               * (u_up
+                                  * bn
+                                  * state_fe_values.shape_value(i,q_point)
+                                 )
+                               * state_fe_values.JxW(q_point);
+          }
+        for (unsigned int i = 0; i < n_dofs_per_element_nbr; i++)
+          {
+            //The outward normal of the neighbor is -n
+            nbr_local_vector(i) -= scale
+                                   * (u_up
+                                      * bn
+                                      * state_fe_values_nbr.shape_value(i,q_point)
+                                     )
+                                   * state_fe_values.JxW(q_point);
+          }
+      }
+  }
+
+  void
+  InterfaceMatrixTwoSided(
+    const FDC<DH, VECTOR, dealdim> &fdc,
+    FullMatrix<double> &local_entry_matrix,
+    FullMatrix<double> &element_nbr_matrix,
+    FullMatrix<double> &nbr_element_matrix,
+    FullMatrix<double> &nbr_matrix, double scale,
+    double/*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = fdc.GetNDoFsPerElement();
+    unsigned int n_dofs_per_element_nbr = fdc.GetNbrNDoFsPerElement();
+    unsigned int n_q_points = fdc.GetNQPoints();
+
+    const auto &state_fe_values = fdc.GetFEFaceValuesState();
+    const auto &state_fe_values_nbr = fdc.GetNbrFEFaceValuesState();
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double bn = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          double n1 = state_fe_values.normal_vector(q_point)[0];
+          double n2 = state_fe_values.normal_vector(q_point)[1];
+          if ( r != 0 )
+            bn = (-y*n1+x*n2)/r;
+        }
+        const double w = scale * bn * state_fe_values.JxW(q_point);
+
+        if (bn > 0)
+          {
+            //The element is upstream, u^- = u
+            for (unsigned int i = 0; i < n_dofs_per_element; i++)
+              for (unsigned int j = 0; j < n_dofs_per_element; j++)
+                local_entry_matrix(i,j) += w
+                                           * state_fe_values.shape_value(j,q_point)
+                                           * state_fe_values.shape_value(i,q_point);
+            for (unsigned int i = 0; i < n_dofs_per_element_nbr; i++)
+              for (unsigned int j = 0; j < n_dofs_per_element; j++)
+                nbr_element_matrix(i,j) -= w
+                                           * state_fe_values.shape_value(j,q_point)
+                                           * state_fe_values_nbr.shape_value(i,q_point);
+          }
+        else
+          {
+            //The neighbor is upstream, u^- is the u from the adjacent element
+            for (unsigned int i = 0; i < n_dofs_per_element; i++)
+              for (unsigned int j = 0; j < n_dofs_per_element_nbr; j++)
+                element_nbr_matrix(i,j) += w
+                                           * state_fe_values_nbr.shape_value(j,q_point)
+                                           * state_fe_values.shape_value(i,q_point);
+            for (unsigned int i = 0; i < n_dofs_per_element_nbr; i++)
+              for (unsigned int j = 0; j < n_dofs_per_element_nbr; j++)
+                nbr_matrix(i,j) -= w
+                                   * state_fe_values_nbr.shape_value(j,q_point)
+                                   * state_fe_values_nbr.shape_value(i,q_point);
+          }
+      }
+  }
+
+  void
+  ElementMatrix(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    FullMatrix<double> &local_matrix, double scale,
+    double/*scale_ico*/) override
+  {
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        double b1 = 0.;
+        double b2 = 0.;
+        {
+          double x = state_fe_values.quadrature_point(q_point)[0];
+          double y = state_fe_values.quadrature_point(q_point)[1];
+          double r = sqrt(x*x+y*y);
+          if ( r != 0 )
+            {
+              b1 = -y/r;
+              b2 = x/r;
+            }
+        }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            for (unsigned int j = 0; j < n_dofs_per_element; j++)
+              {
+                local_matrix(i,j) -= scale * state_fe_values.shape_value(j, q_point)
+                                     * (b1 * state_fe_values.shape_grad(i,q_point)[0]
+                                        + b2 * state_fe_values.shape_grad(i,q_point)[1]
+                                       )
+                                     * state_fe_values.JxW(q_point);
+              }
+          }
+      }
+  }
+
+  void
+  ElementRightHandSide(
+    const EDC<DH, VECTOR, dealdim> & /*edc*/,
+    dealii::Vector<double> &/*local_vector*/, double /*scale*/) override
+  {
+
+  }
+
+  void
+  FaceRightHandSide(
+    const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+    dealii::Vector<double> &/*local_vector*/, double /*scale*/) override
+  {
+  }
+
+  void
+  BoundaryRightHandSide(
+    const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+    dealii::Vector<double> &/*local_vector*/, double /*scale*/) override
+  {
+  }
+  UpdateFlags
+  GetUpdateFlags() const override
+  {
+    return update_values | update_gradients
+           | update_quadrature_points;
+  }
+
+  UpdateFlags
+  GetFaceUpdateFlags() const override
+  {
+    return update_values | update_gradients | update_normal_vectors
+           | update_quadrature_points;
+  }
+
+  unsigned int
+  GetStateNBlocks() const override
+  {
+    return 1;
+  }
+  std::vector<unsigned int> &
+  GetStateBlockComponent() override
+  {
+    return state_block_component_;
+  }
+  const std::vector<unsigned int> &
+  GetStateBlockComponent() const override
+  {
+    return state_block_component_;
+  }
+  bool
+  HasFaces() const override
+  {
+    return true;
+  }
+  bool
+  HasInterfaces() const override
+  {
+    return true;
+  }
+  bool
+  HasTwoSidedInterfaces() const override
+  {
+    return two_sided_;
+  }
+  template<typename ELEMENTITERATOR>
+  bool
+  AtInterface(ELEMENTITERATOR &element, unsigned int face) const
+  {
+    if (element[0]->neighbor_index(face) != -1) //make shure its no boundary
+      return true;
+    return false;
+  }
+private:
+
+  vector<double> fvalues_;
+  vector<double> uvalues_;
+  vector<double> uvalues_nbr_;
+
+  vector<Tensor<1, dealdim> > ugrads_;
+  vector<unsigned int> state_block_component_;
+  ExactSolution ex_sol_;
+  bool two_sided_;
+}
+;
+//**********************************************************************************
+
+#endif
+
@@ -0,0 +1,238 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <include/batchdriver.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include <iostream>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include "localpde.h"
+#include "functionals.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+void
+declare_params(ParameterReader &param_reader)
+{
+  RP::declare_params(param_reader);
+  DOpEOutputHandler<VECTOR>::declare_params(param_reader);
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(param_reader);
+}
+
+/**
+ * Solves the problem with the parameters given in param_reader on the
+ * discretization of DOFH and returns the mean value of the solution.
+ */
+double
+solve(ParameterReader &param_reader, STH &DOFH)
+{
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(param_reader);
+  MeanValueFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM> MVF;
+
+  OP P(LPDE, DOFH);
+  P.AddFunctional(&MVF);
+
+  std::vector<bool> comp_mask(1, true);
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  stringstream outp;
+  outp << "**************************************************\n";
+  outp << "*             Starting Forward Solve             *\n";
+  outp << "*   Solving : " << P.GetName() << "\t*\n";
+  outp << "*   SDoFs   : ";
+  solver.StateSizeInfo(outp);
+  outp << "**************************************************";
+  out.Write(outp, 1, 1, 1);
+
+  solver.ComputeReducedFunctionals();
+
+  return solver.GetFunctionalValue(MVF.GetName());
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  In this example we solve the Laplace equation with a constant
+   *  right hand side for several values of the right hand side. All
+   *  scenarios are solved by a BatchDriver on one mesh and DoF
+   *  numbering. The mean values of the solutions are compared to those
+   *  of separate runs with their own discretization.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  const std::vector<std::string> sources = {"1.", "2.", "-0.5"};
+  //The first scenario writes into the results_dir of the param file.
+  ParameterReader pr;
+  declare_params(pr);
+  pr.read_parameters(paramfile);
+  pr.SetSubsection("output parameters");
+  const std::string results_dir = pr.get_string("results_dir");
+
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+
+  try
+    {
+      //Separate runs, each on its own discretization
+      std::vector<double> separate_values(sources.size());
+      for (unsigned int i = 0; i < sources.size(); i++)
+        {
+          ParameterReader pr_separate;
+          declare_params(pr_separate);
+          pr_separate.read_parameters(paramfile);
+          pr_separate.SetSubsection("localpde parameters");
+          pr_separate.set("source", sources[i]);
+          pr_separate.SetSubsection("output parameters");
+          pr_separate.set("results_dir", results_dir + "Separate" + std::to_string(i) + "/");
+
+          Triangulation<DIM> triangulation;
+          GridGenerator::hyper_cube(triangulation, 0, 1);
+          triangulation.refine_global(4);
+          STH DOFH(triangulation, state_fe);
+
+          separate_values[i] = solve(pr_separate, DOFH);
+        }
+
+      //All scenarios on one discretization
+      Triangulation<DIM> triangulation;
+      GridGenerator::hyper_cube(triangulation, 0, 1);
+      triangulation.refine_global(4);
+      STH DOFH(triangulation, state_fe);
+
+      std::vector<double> batch_values(sources.size());
+      BatchDriver<STH> batch(DOFH, paramfile, declare_params,
+                             [&batch_values](ParameterReader &param_reader, STH &sth, unsigned int i)
+      {
+        batch_values[i] = solve(param_reader, sth);
+      });
+      for (unsigned int i = 0; i < sources.size(); i++)
+        {
+          unsigned int scenario = batch.AddScenario(
+                                    i == 0 ? results_dir : results_dir + "Scenario" + std::to_string(i) + "/");
+          batch.SetParameter(scenario, "localpde parameters", "source", sources[i]);
+        }
+      batch.Run();
+
+      for (unsigned int i = 0; i < sources.size(); i++)
+        {
+          std::cout << "Source: " << sources[i] << "\t Separate: " << separate_values[i]
+                    << "\t Batch: " << batch_values[i] << std::endl;
+          if (std::fabs(separate_values[i] - batch_values[i]) > 1.e-12 * std::fabs(separate_values[i]))
+            {
+              std::cout << "The batch does not reproduce the separate run of scenario "
+                        << i << std::endl;
+              return 1;
+            }
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,276 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <include/forcingterm.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <wrapper/preconditioner_wrapper.h>
+#include <container/integratordatacontainer.h>
+
+#include <iostream>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include "localpde.h"
+#include "functionals.h"
+#include "recording_gmreslinearsolver.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DOpEWrapper::PreconditionSSOR_Wrapper<MATRIX> PRECONDITIONERSSOR;
+typedef RecordingGMRESLinearSolver<PRECONDITIONERSSOR, SPARSITYPATTERN, MATRIX,
+        VECTOR> LINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+/**
+ * The StatPDEProblem, giving access to the linear solver to read its records.
+ */
+class RecordingStatPDEProblem : public RP
+{
+public:
+  using RP::RP;
+
+  const LINEARSOLVER &
+  GetLinearSolver()
+  {
+    return this->GetNonlinearSolver("state");
+  }
+};
+
+/**
+ * Solves the problem with the parameters given in param_reader and returns
+ * the mean value of the solution. The records of the linear solver are
+ * copied to forcing_terms, rhs_norms, and linear_residuals.
+ */
+double
+solve(ParameterReader &param_reader, std::vector<double> &forcing_terms,
+      std::vector<double> &rhs_norms, std::vector<double> &linear_residuals)
+{
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(4);
+  STH DOFH(triangulation, state_fe);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(param_reader);
+  MeanValueFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM> MVF;
+
+  OP P(LPDE, DOFH);
+  P.AddFunctional(&MVF);
+
+  std::vector<bool> comp_mask(1, true);
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  RecordingStatPDEProblem solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  stringstream outp;
+  outp << "**************************************************\n";
+  outp << "*             Starting Forward Solve             *\n";
+  outp << "*   Solving : " << P.GetName() << "\t*\n";
+  outp << "*   SDoFs   : ";
+  solver.StateSizeInfo(outp);
+  outp << "**************************************************";
+  out.Write(outp, 1, 1, 1);
+
+  solver.ComputeReducedFunctionals();
+
+  forcing_terms = solver.GetLinearSolver().GetForcingTerms();
+  rhs_norms = solver.GetLinearSolver().GetRhsNorms();
+  linear_residuals = solver.GetLinearSolver().GetLinearResiduals();
+
+  return solver.GetFunctionalValue(MVF.GetName());
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  In this example we solve the semilinear equation -Laplace u + u^3 = f
+   *  with an inexact Newton method, where GMRES solves the linear systems
+   *  only up to the forcing terms of Eisenstat and Walker. We check that
+   *  the linear solver receives the expected forcing terms and reaches
+   *  them, and that the result agrees with the one of the Newton method
+   *  with the tolerances of the linear solver.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  pr.SetSubsection("newtonsolver parameters");
+  const double nonlinear_tol = pr.get_double("nonlinear_tol");
+  pr.SetSubsection("gmres_withmatrix parameters");
+  const double linear_global_tol = pr.get_double("linear_global_tol");
+
+  try
+    {
+      std::vector<double> forcing_terms, rhs_norms, linear_residuals;
+      const double inexact_value = solve(pr, forcing_terms, rhs_norms, linear_residuals);
+
+      //The forcing terms computed from the recorded residuals.
+      ForcingTerm forcing(pr);
+      if (!forcing.IsActive())
+        {
+          std::cout << "This example requires an inexact_newton method." << std::endl;
+          return 1;
+        }
+      if (forcing_terms.size() < 2)
+        {
+          std::cout << "The inexact Newton method needed less than two steps." << std::endl;
+          return 1;
+        }
+      forcing.Initialize(rhs_norms[0], nonlinear_tol);
+      for (unsigned int k = 0; k < forcing_terms.size(); k++)
+        {
+          if (k > 0)
+            forcing.Update(rhs_norms[k], linear_residuals[k - 1]);
+          std::cout << "Newton step: " << k + 1 << "\t Forcing term: " << forcing_terms[k]
+                    << "\t Linear residual (rel.): " << linear_residuals[k] / rhs_norms[k] << std::endl;
+          if (std::fabs(forcing_terms[k] - forcing.Get()) > 1.e-12 * forcing.Get())
+            {
+              std::cout << "The linear solver received the forcing term " << forcing_terms[k]
+                        << " in Newton step " << k + 1 << ", expected " << forcing.Get() << std::endl;
+              return 1;
+            }
+          if (linear_residuals[k] > std::max(linear_global_tol, forcing_terms[k] * rhs_norms[k]))
+            {
+              std::cout << "The linear solver did not reach the forcing term in Newton step "
+                        << k + 1 << std::endl;
+              return 1;
+            }
+        }
+
+      //The same problem with the tolerances of the linear solver.
+      ParameterReader pr_exact;
+      RP::declare_params(pr_exact);
+      DOpEOutputHandler<VECTOR>::declare_params(pr_exact);
+      LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(pr_exact);
+      pr_exact.read_parameters(paramfile);
+      pr_exact.SetSubsection("newtonsolver parameters");
+      pr_exact.set("inexact_newton", "none");
+      pr_exact.SetSubsection("output parameters");
+      pr_exact.set("logfile", "dope_exact.log");
+
+      std::vector<double> exact_forcing_terms, exact_rhs_norms, exact_linear_residuals;
+      const double exact_value = solve(pr_exact, exact_forcing_terms, exact_rhs_norms,
+                                       exact_linear_residuals);
+      for (unsigned int k = 0; k < exact_forcing_terms.size(); k++)
+        {
+          if (exact_forcing_terms[k] != 0.)
+            {
+              std::cout << "A forcing term was set without inexact_newton." << std::endl;
+              return 1;
+            }
+        }
+
+      std::cout << "Mean value inexact: " << inexact_value << "\t exact: " << exact_value << std::endl;
+      if (std::fabs(inexact_value - exact_value) > 1.e-8 * std::fabs(exact_value))
+        {
+          std::cout << "The inexact Newton method does not reproduce the mean value." << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,86 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef RECORDING_GMRES_LINEAR_SOLVER_H_
+#define RECORDING_GMRES_LINEAR_SOLVER_H_
+
+#include <templates/gmreslinearsolver.h>
+
+#include <vector>
+
+namespace DOpE
+{
+  /**
+   * The GMRESLinearSolverWithMatrix, which additionally records for each
+   * call of Solve the forcing term, the norm of the right hand side (i.e.,
+   * of the nonlinear residual in a Newton method) and the norm of the
+   * linear residual reached by the solver.
+   */
+  template <typename PRECONDITIONER, typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  class RecordingGMRESLinearSolver : public GMRESLinearSolverWithMatrix<PRECONDITIONER, SPARSITYPATTERN, MATRIX, VECTOR>
+  {
+  public:
+    typedef GMRESLinearSolverWithMatrix<PRECONDITIONER, SPARSITYPATTERN, MATRIX, VECTOR> BASE;
+
+    RecordingGMRESLinearSolver(ParameterReader &param_reader)
+      : BASE(param_reader)
+    {
+    }
+
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false)
+    {
+      forcing_terms_.push_back(forcing_term_);
+      rhs_norms_.push_back(rhs.l2_norm());
+      BASE::Solve(pde, integr, rhs, solution, force_matrix_build);
+      linear_residuals_.push_back(this->GetLastLinearResidual());
+    }
+
+    void SetForcingTerm(double eta)
+    {
+      forcing_term_ = eta;
+      BASE::SetForcingTerm(eta);
+    }
+
+    const std::vector<double> &GetForcingTerms() const
+    {
+      return forcing_terms_;
+    }
+
+    const std::vector<double> &GetRhsNorms() const
+    {
+      return rhs_norms_;
+    }
+
+    const std::vector<double> &GetLinearResiduals() const
+    {
+      return linear_residuals_;
+    }
+
+  private:
+    double forcing_term_ = 0.;
+    std::vector<double> forcing_terms_, rhs_norms_, linear_residuals_;
+  };
+}
+
+#endif
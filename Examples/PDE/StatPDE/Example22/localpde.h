@@ -0,0 +1,230 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef LOCALPDE_
+#define LOCALPDE_
+
+#include <interfaces/pdeinterface.h>
+#include <include/parameterreader.h>
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+template<
+  template<bool DH, typename VECTOR, int dealdim> class EDC,
+  template<bool DH, typename VECTOR, int dealdim> class FDC,
+  bool DH, typename VECTOR, int dealdim>
+class LocalPDE : public PDEInterface<EDC, FDC, DH, VECTOR, dealdim>
+#else
+template<
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class EDC,
+  template<template<int, int> class DH, typename VECTOR, int dealdim> class FDC,
+  template<int, int> class DH, typename VECTOR, int dealdim>
+class LocalPDE : public PDEInterface<EDC, FDC, DH, VECTOR, dealdim>
+#endif
+{
+public:
+  LocalPDE(ParameterReader &param_reader) : state_block_component_(1, 0)
+  {
+    param_reader.SetSubsection("localpde parameters");
+    source_ = param_reader.get_double("source");
+  }
+
+  static void
+  declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("localpde parameters");
+    param_reader.declare_entry("source", "50.", Patterns::Double(),
+                               "constant right hand side");
+  }
+
+  void
+  ElementEquation(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    dealii::Vector<double> &local_vector, double scale, double) override
+  {
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+
+    assert(this->problem_type_ == "state");
+
+    uvalues_.resize(n_q_points);
+    ugrads_.resize(n_q_points, Tensor<1, dealdim>());
+    edc.GetValuesState("last_newton_solution", uvalues_);
+    edc.GetGradsState("last_newton_solution", ugrads_);
+
+    const FEValuesExtractors::Scalar velocities(0);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        Tensor<1, 2> vgrads;
+        vgrads.clear();
+        vgrads[0] = ugrads_[q_point][0];
+        vgrads[1] = ugrads_[q_point][1];
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            const Tensor<1, 2> phi_i_grads_v =
+              state_fe_values[velocities].gradient(i, q_point);
+
+            const double phi_i_v =
+              state_fe_values[velocities].value(i, q_point);
+
+            local_vector(i) += scale * (vgrads * phi_i_grads_v
+                                        + uvalues_[q_point] * uvalues_[q_point]
+                                        * uvalues_[q_point] * phi_i_v)
+                               * state_fe_values.JxW(q_point);
+          }
+      }
+  }
+
+  void
+  ElementMatrix(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    FullMatrix<double> &local_matrix, double scale, double) override
+  {
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+    //unsigned int material_id = edc.GetMaterialId();
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+
+    const FEValuesExtractors::Scalar velocities(0);
+
+    std::vector<double> phi_v(n_dofs_per_element);
+    std::vector<Tensor<1, 2> > phi_grads_v(n_dofs_per_element);
+
+    uvalues_.resize(n_q_points);
+    edc.GetValuesState("last_newton_solution", uvalues_);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+      {
+        for (unsigned int k = 0; k < n_dofs_per_element; k++)
+          {
+            phi_v[k] = state_fe_values[velocities].value(k, q_point);
+            phi_grads_v[k] = state_fe_values[velocities].gradient(k, q_point);
+          }
+
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            for (unsigned int j = 0; j < n_dofs_per_element; j++)
+              {
+
+                local_matrix(i, j) += scale * (phi_grads_v[j] * phi_grads_v[i]
+                                               + 3. * uvalues_[q_point] * uvalues_[q_point]
+                                               * phi_v[j] * phi_v[i])
+                                      * state_fe_values.JxW(q_point);
+              }
+          }
+      }
+  }
+
+  void
+  ElementRightHandSide(
+    const EDC<DH, VECTOR, dealdim> &edc,
+    dealii::Vector<double> &local_vector, double scale) override
+  {
+    assert(this->problem_type_ == "state");
+    unsigned int n_dofs_per_element = edc.GetNDoFsPerElement();
+    unsigned int n_q_points = edc.GetNQPoints();
+    const DOpEWrapper::FEValues<dealdim> &state_fe_values =
+      edc.GetFEValuesState();
+
+    const FEValuesExtractors::Scalar velocities(0);
+
+    for (unsigned int q_point = 0; q_point < n_q_points; ++q_point)
+      {
+        for (unsigned int i = 0; i < n_dofs_per_element; i++)
+          {
+            local_vector(i) += scale * source_
+                               * state_fe_values[velocities].value(i, q_point)
+                               * state_fe_values.JxW(q_point);
+          }
+      } //endfor qpoint
+  }
+
+  void
+  BoundaryEquation(
+    const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+    dealii::Vector<double> &, double /*scale*/, double /*scale_ico*/) override
+  {
+
+  }
+
+  void
+  BoundaryMatrix(
+    const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+    dealii::FullMatrix<double> & /*local_matrix*/, double /*scale*/,
+    double /*scale_ico*/) override
+  {
+  }
+
+  void
+  BoundaryRightHandSide(
+    const FDC<DH, VECTOR, dealdim> & /*fdc*/,
+    dealii::Vector<double> &/*local_vector*/, double /*scale*/) override
+  {
+  }
+
+  UpdateFlags
+  GetUpdateFlags() const override
+  {
+    return update_values | update_gradients;
+  }
+
+  UpdateFlags
+  GetFaceUpdateFlags() const override
+  {
+    return update_values | update_gradients | update_normal_vectors
+           | update_quadrature_points;
+  }
+
+  unsigned int
+  GetStateNBlocks() const override
+  {
+    return 1;
+  }
+  std::vector<unsigned int> &
+  GetStateBlockComponent() override
+  {
+    return state_block_component_;
+  }
+  const std::vector<unsigned int> &
+  GetStateBlockComponent() const override
+  {
+    return state_block_component_;
+  }
+
+private:
+  double source_;
+
+  vector<double> uvalues_;
+  vector<Tensor<1, dealdim> > ugrads_;
+
+  vector<unsigned int> state_block_component_;
+};
+#endif
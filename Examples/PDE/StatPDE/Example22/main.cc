@@ -0,0 +1,216 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/jfnklinearsolver.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <wrapper/preconditioner_wrapper.h>
+#include <container/integratordatacontainer.h>
+
+#include <iostream>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include "localpde.h"
+#include "functionals.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DOpEWrapper::PreconditionSSOR_Wrapper<MATRIX> PRECONDITIONERSSOR;
+//The Jacobian-free solver and, for comparison, the direct solver with the assembled matrix
+typedef JFNKLinearSolverWithMatrix<PRECONDITIONERSSOR, SPARSITYPATTERN, MATRIX,
+        VECTOR> JFNKSOLVER;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> DIRECTSOLVER;
+typedef NewtonSolver<INTEGRATOR, JFNKSOLVER, VECTOR> NLSJFNK;
+typedef NewtonSolver<INTEGRATOR, DIRECTSOLVER, VECTOR> NLSDIRECT;
+typedef StatPDEProblem<NLSJFNK, INTEGRATOR, OP, VECTOR, DIM> RPJFNK;
+typedef StatPDEProblem<NLSDIRECT, INTEGRATOR, OP, VECTOR, DIM> RPDIRECT;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+void
+declare_params(ParameterReader &param_reader)
+{
+  RPJFNK::declare_params(param_reader);
+  RPDIRECT::declare_params(param_reader);
+  DOpEOutputHandler<VECTOR>::declare_params(param_reader);
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(param_reader);
+}
+
+/**
+ * Solves the problem with the reduced problem RP and returns the mean
+ * value of the solution. The mesh has hanging nodes and the boundary
+ * values are not zero.
+ */
+template<typename RP>
+double
+solve(ParameterReader &param_reader)
+{
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(3);
+  triangulation.begin_active()->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+  STH DOFH(triangulation, state_fe);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(param_reader);
+  MeanValueFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM> MVF;
+
+  OP P(LPDE, DOFH);
+  P.AddFunctional(&MVF);
+
+  std::vector<bool> comp_mask(1, true);
+  DOpEWrapper::ConstantFunction<DIM> cf(1., 1);
+  SimpleDirichletData<VECTOR, DIM> DD(cf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  stringstream outp;
+  outp << "**************************************************\n";
+  outp << "*             Starting Forward Solve             *\n";
+  outp << "*   Solving : " << P.GetName() << "\t*\n";
+  outp << "*   SDoFs   : ";
+  solver.StateSizeInfo(outp);
+  outp << "**************************************************";
+  out.Write(outp, 1, 1, 1);
+
+  solver.ComputeReducedFunctionals();
+
+  return solver.GetFunctionalValue(MVF.GetName());
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  In this example we solve the semilinear equation -Laplace u + u^3 = f
+   *  with non-homogeneous Dirichlet data on a mesh with hanging nodes by
+   *  a Jacobian-free Newton-Krylov method with the forcing terms of
+   *  Eisenstat and Walker. The result is compared to the one of the
+   *  Newton method with the assembled matrix.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  ParameterReader pr_direct;
+  declare_params(pr_direct);
+  pr_direct.read_parameters(paramfile);
+  pr_direct.SetSubsection("newtonsolver parameters");
+  pr_direct.set("inexact_newton", "none");
+  pr_direct.SetSubsection("output parameters");
+  pr_direct.set("logfile", "dope_direct.log");
+
+  try
+    {
+      const double jfnk_value = solve<RPJFNK>(pr);
+      const double direct_value = solve<RPDIRECT>(pr_direct);
+
+      std::cout << "Mean value JFNK: " << jfnk_value << "\t assembled: " << direct_value << std::endl;
+      if (std::fabs(jfnk_value - direct_value) > 1.e-8 * std::fabs(direct_value))
+        {
+          std::cout << "The Jacobian-free Newton method does not reproduce the mean value." << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,71 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#ifndef COUNTING_DIRECT_LINEAR_SOLVER_H_
+#define COUNTING_DIRECT_LINEAR_SOLVER_H_
+
+#include <templates/directlinearsolver.h>
+
+namespace DOpE
+{
+  /**
+   * The DirectLinearSolverWithMatrix, which additionally counts the
+   * calls of Solve with a new matrix since the last ReInit.
+   */
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  class CountingDirectLinearSolver : public DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR>
+  {
+  public:
+    typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> BASE;
+
+    CountingDirectLinearSolver(ParameterReader &param_reader)
+      : BASE(param_reader)
+    {
+    }
+
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde)
+    {
+      BASE::ReInit(pde);
+      n_matrices_ = 0;
+    }
+
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false)
+    {
+      if (force_matrix_build)
+        n_matrices_++;
+      BASE::Solve(pde, integr, rhs, solution, force_matrix_build);
+    }
+
+    unsigned int GetNMatrices() const
+    {
+      return n_matrices_;
+    }
+
+  private:
+    unsigned int n_matrices_ = 0;
+  };
+}
+
+#endif
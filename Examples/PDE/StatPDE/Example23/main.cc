@@ -0,0 +1,263 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include <iostream>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include "localpde.h"
+#include "functionals.h"
+#include "counting_directlinearsolver.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef CountingDirectLinearSolver<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+/**
+ * The StatPDEProblem, giving access to the linear solver to read its counters.
+ */
+class CountingStatPDEProblem : public RP
+{
+public:
+  using RP::RP;
+
+  const LINEARSOLVER &
+  GetLinearSolver()
+  {
+    return this->GetNonlinearSolver("state");
+  }
+};
+
+void
+declare_params(ParameterReader &param_reader)
+{
+  RP::declare_params(param_reader);
+  DOpEOutputHandler<VECTOR>::declare_params(param_reader);
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(param_reader);
+}
+
+/**
+ * Solves the problem with the parameters given in param_reader and returns
+ * the mean value of the solution. The number of matrices and factorizations
+ * of the linear solver are returned in n_matrices and n_factorizations.
+ */
+double
+solve(ParameterReader &param_reader, unsigned int &n_matrices,
+      unsigned int &n_factorizations)
+{
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(4);
+  STH DOFH(triangulation, state_fe);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(param_reader);
+  MeanValueFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM> MVF;
+
+  OP P(LPDE, DOFH);
+  P.AddFunctional(&MVF);
+
+  std::vector<bool> comp_mask(1, true);
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  CountingStatPDEProblem solver(&P, DOpEtypes::VectorStorageType::fullmem, param_reader, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, param_reader);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  solver.ReInit();
+  out.ReInit();
+
+  stringstream outp;
+  outp << "**************************************************\n";
+  outp << "*             Starting Forward Solve             *\n";
+  outp << "*   Solving : " << P.GetName() << "\t*\n";
+  outp << "*   SDoFs   : ";
+  solver.StateSizeInfo(outp);
+  outp << "**************************************************";
+  out.Write(outp, 1, 1, 1);
+
+  solver.ComputeReducedFunctionals();
+
+  n_matrices = solver.GetLinearSolver().GetNMatrices();
+  n_factorizations = solver.GetLinearSolver().GetNFactorizations();
+
+  return solver.GetFunctionalValue(MVF.GetName());
+}
+
+/**
+ * Reads the parameter file and sets the parameters of the direct solver.
+ */
+void
+read_params(ParameterReader &param_reader, const std::string &paramfile,
+            const std::string &reuse_factorization, const std::string &refinement_rate,
+            const std::string &logfile)
+{
+  declare_params(param_reader);
+  param_reader.read_parameters(paramfile);
+  param_reader.SetSubsection("directlinearsolver parameters");
+  param_reader.set("reuse_factorization", reuse_factorization);
+  param_reader.set("refinement_rate", refinement_rate);
+  param_reader.SetSubsection("output parameters");
+  param_reader.set("logfile", logfile);
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  In this example we solve the semilinear equation -Laplace u + u^3 = f,
+   *  where the Newton method builds a new matrix in each step. With
+   *  reuse_factorization the direct solver keeps the first factorization
+   *  and uses it for an iterative refinement. We check that this happens
+   *  and that a too demanding refinement_rate leads to new factorizations.
+   *  Both have to give the result of the solver without reuse.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr_reference, pr_reuse, pr_stall;
+  read_params(pr_reference, paramfile, "false", "0.5", "dope.log");
+  read_params(pr_reuse, paramfile, "true", "0.5", "dope_reuse.log");
+  //The refinement converges, but not fast enough.
+  read_params(pr_stall, paramfile, "true", "1.e-3", "dope_stall.log");
+
+  try
+    {
+      unsigned int n_matrices, n_factorizations;
+
+      const double reference_value = solve(pr_reference, n_matrices, n_factorizations);
+      std::cout << "Without reuse: " << n_matrices << " matrices, "
+                << n_factorizations << " factorizations" << std::endl;
+      if (n_factorizations != n_matrices)
+        {
+          std::cout << "Each matrix has to be factorized without reuse_factorization." << std::endl;
+          return 1;
+        }
+
+      const double reuse_value = solve(pr_reuse, n_matrices, n_factorizations);
+      std::cout << "Reuse: " << n_matrices << " matrices, "
+                << n_factorizations << " factorizations" << std::endl;
+      if (n_matrices < 2 || n_factorizations != 1)
+        {
+          std::cout << "The first factorization has not been reused for all matrices." << std::endl;
+          return 1;
+        }
+
+      const double stall_value = solve(pr_stall, n_matrices, n_factorizations);
+      std::cout << "Stalling refinement: " << n_matrices << " matrices, "
+                << n_factorizations << " factorizations" << std::endl;
+      if (n_factorizations < 2)
+        {
+          std::cout << "The matrix has not been factorized again after the refinement stalled." << std::endl;
+          return 1;
+        }
+
+      std::cout << "Mean value without reuse: " << reference_value << "\t reuse: " << reuse_value
+                << "\t stalling refinement: " << stall_value << std::endl;
+      if (std::fabs(reuse_value - reference_value) > 1.e-8 * std::fabs(reference_value)
+          || std::fabs(stall_value - reference_value) > 1.e-8 * std::fabs(reference_value))
+        {
+          std::cout << "The reuse of the factorization changes the mean value." << std::endl;
+          return 1;
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -0,0 +1,230 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include <iostream>
+#include <memory>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include "localpde.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+/**
+ * The StatPDEProblem with the evaluation of the residual of the state
+ * equation for a given state.
+ */
+class ResidualStatPDEProblem : public RP
+{
+public:
+  using RP::RP;
+
+  /**
+   * Returns the linfty norm of the residual of the state equation at u
+   * for the right hand side the PDE is currently switched to.
+   */
+  double
+  ComputeStateResidual(const StateVector<VECTOR> &u)
+  {
+    this->SetProblemType("state");
+    auto &problem = this->GetProblem()->GetStateProblem();
+    VECTOR residual(u.GetSpacialVector());
+
+    this->GetProblem()->AddAuxiliaryToIntegrator(this->GetIntegrator());
+    this->GetIntegrator().AddDomainData("last_newton_solution",
+                                        &(u.GetSpacialVector()));
+    this->GetIntegrator().ComputeNonlinearResidual(problem, residual);
+    this->GetIntegrator().DeleteDomainData("last_newton_solution");
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetIntegrator());
+
+    return residual.linfty_norm();
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  In this example we solve the Laplace equation with a constant
+   *  right hand side for several values of the right hand side, the
+   *  load cases. All load cases are solved at once by
+   *  StatPDEProblem::ComputeReducedStates, which assembles and
+   *  factorizes the matrix only once. Afterwards the residual of
+   *  each state is compared to the residual of the zero state.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  ResidualStatPDEProblem::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(4);
+
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(pr);
+
+  STH DOFH(triangulation, state_fe);
+
+  OP P(LPDE, DOFH);
+
+  std::vector<bool> comp_mask(1, true);
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD(zf);
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD);
+
+  ResidualStatPDEProblem solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+
+  const std::vector<double> sources = {1., 2., -0.5};
+  auto select_rhs = [&LPDE, &sources](unsigned int k)
+  {
+    LPDE.SetSource(sources[k]);
+  };
+
+  try
+    {
+      solver.ReInit();
+      out.ReInit();
+
+      stringstream outp;
+      outp << "**************************************************\n";
+      outp << "*             Starting Forward Solve             *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      //The state of the source given in the param file, the
+      //states of the load cases are created with it as initial values.
+      solver.ComputeReducedFunctionals();
+
+      std::vector<std::unique_ptr<StateVector<VECTOR> > > states(sources.size());
+      solver.ComputeReducedStates(states, select_rhs);
+
+      //The layout of the states is used for the zero state.
+      StateVector<VECTOR> zero(*states[0]);
+      zero = 0.;
+      for (unsigned int k = 0; k < sources.size(); k++)
+        {
+          select_rhs(k);
+          const double initial_residual = solver.ComputeStateResidual(zero);
+          const double residual = solver.ComputeStateResidual(*states[k]);
+          std::cout << "Source: " << sources[k] << "\t Residual: " << residual
+                    << "\t Residual of the zero state: " << initial_residual << std::endl;
+          if (!(residual <= 1.e-10 * initial_residual))
+            {
+              std::cout << "The state of the load case " << k
+                        << " does not solve the equation" << std::endl;
+              return 1;
+            }
+        }
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -1,23 +1,68 @@
 #!/bin/bash
-if [ $# -ne 2 ]
+if [ $# -ne 2 ] && [ $# -ne 3 ]
     then
-    echo "Usage: "$0" [Test|Store] [Executable]"
+    echo "Usage: "$0" [Test|Store|Check] [Executable] [Number of MPI processes]"
     exit 1
 fi
 
+#Distributed examples are run with the given number of processes
+RUN=""
+if [ $# -eq 3 ]
+then
+    RUN="mpirun -np $3"
+fi
+
 if [ -f dope.log ]
 then
 	rm dope.log
 fi
 
+#Examples that check their results themselves have no reference log,
+#they are tested by the exit status of the program.
+if [ $1 == "Check" ]
+then
+    if [ -f $2 ]
+    then
+	echo "Running Program $RUN $2 test.prm"
+	($RUN $2 test.prm 2>&1) > /dev/null
+	status=$?
+	if [ -f dope.log ]
+	then
+	    rm dope.log
+	fi
+	if [ -d Mesh0 ] 
+	then
+	    rm -r Mesh?/
+	fi
+	if [ -f grid.eps ]
+	then 
+	    rm grid.eps
+	fi
+	if [ -d tmp_state ]
+	then
+	    rm -r tmp_*
+	fi
+	if [ $status -ne 0 ]
+	then
+	    echo "The program reported a failure"
+	    exit 1
+	fi
+	echo "The program checked its results successfully"
+	exit 0
+    else
+	echo "Executable '"$2" not found."
+	exit 1
+    fi
+fi
+
 if [ $1 == "Test" ]
 then
     if [ -f test.dlog ]
     then
 	if [ -f $2 ]
 	    then
-	    echo "Running Program $2 test.prm"
-	    ($2 test.prm 2>&1) > /dev/null
+	    echo "Running Program $RUN $2 test.prm"
+	    ($RUN $2 test.prm 2>&1) > /dev/null
 	    #Which Version of Deal.II are we using?
 	    if [ ! -f dope.log ]
 	    then
@@ -79,8 +124,8 @@ else
     then
 	if [ -f $2 ]
 	then
-	    echo "Running Program $2 test.prm"
-	    ($2 test.prm 2>&1) > /dev/null
+	    echo "Running Program $RUN $2 test.prm"
+	    ($RUN $2 test.prm 2>&1) > /dev/null
 	    echo "Run completed. Cleaning up ..."
 	    mv dope.log test.dlog
 	    if [ -d Mesh0 ] 